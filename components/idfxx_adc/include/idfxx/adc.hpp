@@ -17,7 +17,9 @@
  *   battery-voltage or sensor-divider case.
  * - @ref sampler converts one or more pins round-robin at a fixed rate in
  *   the background, delivering results as parsed per-pin samples — the
- *   waveform-capture and signal-statistics case.
+ *   waveform-capture and signal-statistics case. A @ref sampler::consumer
+ *   can drain it on a dedicated task, woken by the conversion-done
+ *   interrupt, instead of the application polling @ref sampler::read.
  *
  * In both modes the ADC unit and channel are resolved from the GPIO pin,
  * and readings convert to typed voltages (`electro::millivolts`) with the
@@ -28,6 +30,7 @@
  * @{
  */
 
+#include <idfxx/cpu>
 #include <idfxx/error>
 #include <idfxx/gpio>
 
@@ -36,6 +39,7 @@
 #include <cstdint>
 #include <electro/electro>
 #include <frequency/frequency>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <span>
@@ -232,6 +236,10 @@ private:
  * @endcode
  */
 class sampler {
+    /// @cond INTERNAL
+    struct state;
+    /// @endcond
+
 public:
     /**
      * @headerfile <idfxx/adc>
@@ -271,6 +279,99 @@ public:
         [[nodiscard]] constexpr bool operator==(const sample&) const noexcept = default;
     };
 
+    /**
+     * @headerfile <idfxx/adc>
+     * @brief A view of one driver frame, lent by @ref try_read_frame.
+     *
+     * Refers to the raw conversion results in the sampler's staging buffer
+     * instead of copying them into @ref sample structs. Decode single entries
+     * with `operator[]`, or split the whole frame into one contiguous run of
+     * raw values per pin with @ref try_demux — a single pass with no
+     * per-sample pin search, suited to feeding per-channel filters.
+     *
+     * A frame is valid until the next read from its sampler, or until the
+     * sampler is destroyed. A default-constructed frame is empty.
+     *
+     * @code
+     * // Two pins, default 256-sample frames: at most 129 values per pin.
+     * std::array<int16_t, 129> a, b;
+     * std::array<std::span<int16_t>, 2> channels{a, b};
+     * auto frame = mic.read_frame();
+     * frame.demux(channels); // channels[i] now holds mic.pins()[i]'s values
+     * @endcode
+     */
+    class frame {
+    public:
+        /** @brief Constructs an empty frame. */
+        constexpr frame() noexcept = default;
+
+        /**
+         * @brief Returns the number of conversion results in the frame.
+         *
+         * Includes any entries for channels the sampler did not configure
+         * (occasional arbiter artifacts), which decode with an unconnected pin
+         * and are skipped by @ref try_demux.
+         */
+        [[nodiscard]] size_t size() const noexcept;
+
+        /** @brief Returns true if the frame holds no conversion results. */
+        [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+        /**
+         * @brief Decodes one conversion result.
+         *
+         * @param i Index of the result; must be less than @ref size.
+         * @return The result, tagged with its pin (`gpio::nc()` for an
+         *         unconfigured channel).
+         */
+        [[nodiscard]] sample operator[](size_t i) const noexcept;
+
+        /** @brief Returns the raw driver bytes the frame refers to. */
+        [[nodiscard]] std::span<const uint8_t> bytes() const noexcept { return _bytes; }
+
+#ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
+        /**
+         * @brief Splits the frame into one run of raw values per pin.
+         *
+         * @param channels One span per configured pin, in @ref pins order;
+         *                 each is trimmed to the values written.
+         * @return The total number of values written.
+         * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+         * @throws std::system_error with idfxx::errc::invalid_arg if the
+         *         number of spans differs from the number of pins.
+         */
+        size_t demux(std::span<std::span<int16_t>> channels) const { return unwrap(try_demux(channels)); }
+#endif
+
+        /**
+         * @brief Splits the frame into one run of raw values per pin.
+         *
+         * Walks the frame once, appending each result's raw value to the span
+         * for its pin and skipping unconfigured channels. Values that do not
+         * fit in their span are dropped; a span of `size()` values always
+         * suffices, and for round-robin conversion
+         * `size() / pins().size() + 1` does.
+         *
+         * @param channels One span per configured pin, in @ref pins order;
+         *                 each is trimmed to the values written.
+         * @return The total number of values written, or an error.
+         * @retval idfxx::errc::invalid_arg The number of spans differs from
+         *         the number of pins.
+         */
+        [[nodiscard]] result<size_t> try_demux(std::span<std::span<int16_t>> channels) const;
+
+    private:
+        friend class sampler;
+        frame(std::span<const uint8_t> bytes, const state* s) noexcept
+            : _bytes(bytes)
+            , _state(s) {}
+
+        std::span<const uint8_t> _bytes{};
+        const state* _state = nullptr;
+    };
+
+    class consumer;
+
 #ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
     /**
      * @brief Constructs a continuous sampler.
@@ -358,6 +459,8 @@ public:
      * @brief Stops continuous conversion.
      *
      * Idempotent: stopping a sampler that is not running has no effect.
+     * With a @ref consumer attached, first waits for any read the consumer
+     * task has in progress.
      *
      * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
      * @throws std::system_error on driver failure.
@@ -380,7 +483,8 @@ public:
      * @brief Stops continuous conversion.
      *
      * Idempotent: stopping a sampler that is not running succeeds with no
-     * effect.
+     * effect. With a @ref consumer attached, first waits for any read the
+     * consumer task has in progress.
      *
      * @return Success, or an error.
      */
@@ -398,8 +502,8 @@ public:
      * @return The number of samples written to `out` (always at least 1).
      * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
      * @throws std::system_error with idfxx::errc::invalid_state if the
-     *         sampler is not running, or idfxx::errc::invalid_arg if `out`
-     *         is empty.
+     *         sampler is not running or has a consumer, or
+     *         idfxx::errc::invalid_arg if `out` is empty.
      */
     [[nodiscard]] size_t read(std::span<sample> out) { return unwrap(try_read(out)); }
 
@@ -418,7 +522,7 @@ public:
      * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
      * @throws std::system_error with idfxx::errc::timeout if no sample
      *         arrived within the timeout, or idfxx::errc::invalid_state if
-     *         the sampler is not running.
+     *         the sampler is not running or has a consumer.
      */
     template<typename Rep, typename Period>
     [[nodiscard]] size_t read(std::span<sample> out, const std::chrono::duration<Rep, Period>& timeout) {
@@ -438,8 +542,8 @@ public:
      * @param out Destination for the voltages (must not be empty).
      * @return The number of voltages written to `out` (always at least 1).
      * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
-     * @throws std::system_error with idfxx::errc::invalid_state if the sampler is not running,
-     *         idfxx::errc::invalid_arg if `out` is empty, or idfxx::errc::not_supported if a
+     * @throws std::system_error with idfxx::errc::invalid_state if the sampler is not running or
+     *         has a consumer, idfxx::errc::invalid_arg if `out` is empty, or idfxx::errc::not_supported if a
      *         sampled pin has no usable calibration data (check @ref calibrated).
      */
     [[nodiscard]] size_t read(std::span<electro::millivolts> out) { return unwrap(try_read(out)); }
@@ -459,13 +563,43 @@ public:
      * @return The number of voltages written to `out` (always at least 1).
      * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
      * @throws std::system_error with idfxx::errc::timeout if no sample arrived within the timeout,
-     *         idfxx::errc::invalid_state if the sampler is not running, or
+     *         idfxx::errc::invalid_state if the sampler is not running or has a consumer, or
      *         idfxx::errc::not_supported if a sampled pin has no usable calibration data.
      */
     template<typename Rep, typename Period>
     [[nodiscard]] size_t read(std::span<electro::millivolts> out, const std::chrono::duration<Rep, Period>& timeout) {
         return unwrap(try_read(out, timeout));
     }
+
+    /**
+     * @brief Reads one driver frame without copying it, blocking until one is available.
+     *
+     * Lends a view of up to `frame_samples` conversion results in the
+     * sampler's staging buffer; see @ref frame for its lifetime.
+     *
+     * @return The frame (never empty).
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error with idfxx::errc::invalid_state if the sampler is not running
+     *         or has a consumer.
+     */
+    [[nodiscard]] frame read_frame() { return unwrap(try_read_frame()); }
+
+    /**
+     * @brief Reads one driver frame without copying it, blocking until one is available or the
+     *        timeout expires.
+     *
+     * @tparam Rep The representation type of the duration.
+     * @tparam Period The period type of the duration.
+     * @param timeout Maximum time to wait for a frame.
+     * @return The frame (never empty).
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error with idfxx::errc::timeout if no frame arrived within the timeout,
+     *         or idfxx::errc::invalid_state if the sampler is not running or has a consumer.
+     */
+    template<typename Rep, typename Period>
+    [[nodiscard]] frame read_frame(const std::chrono::duration<Rep, Period>& timeout) {
+        return unwrap(try_read_frame(timeout));
+    }
 #endif
 
     /**
@@ -478,7 +612,7 @@ public:
      * @param out Destination for the samples (must not be empty).
      * @return The number of samples written to `out` (always at least 1), or
      *         an error.
-     * @retval idfxx::errc::invalid_state The sampler is not running.
+     * @retval idfxx::errc::invalid_state The sampler is not running, or a @ref consumer is attached.
      * @retval idfxx::errc::invalid_arg `out` is empty.
      */
     [[nodiscard]] result<size_t> try_read(std::span<sample> out) { return _try_read(out, std::nullopt); }
@@ -497,7 +631,7 @@ public:
      * @return The number of samples written to `out` (always at least 1), or
      *         an error.
      * @retval idfxx::errc::timeout No sample arrived within the timeout.
-     * @retval idfxx::errc::invalid_state The sampler is not running.
+     * @retval idfxx::errc::invalid_state The sampler is not running, or a @ref consumer is attached.
      * @retval idfxx::errc::invalid_arg `out` is empty.
      */
     template<typename Rep, typename Period>
@@ -518,7 +652,7 @@ public:
      *
      * @param out Destination for the voltages (must not be empty).
      * @return The number of voltages written to `out` (always at least 1), or an error.
-     * @retval idfxx::errc::invalid_state The sampler is not running.
+     * @retval idfxx::errc::invalid_state The sampler is not running, or a @ref consumer is attached.
      * @retval idfxx::errc::invalid_arg `out` is empty.
      * @retval idfxx::errc::not_supported A sampled pin has no usable calibration data (check
      *         @ref calibrated).
@@ -541,7 +675,7 @@ public:
      * @param timeout Maximum time to wait for a sample.
      * @return The number of voltages written to `out` (always at least 1), or an error.
      * @retval idfxx::errc::timeout No sample arrived within the timeout.
-     * @retval idfxx::errc::invalid_state The sampler is not running.
+     * @retval idfxx::errc::invalid_state The sampler is not running, or a @ref consumer is attached.
      * @retval idfxx::errc::not_supported A sampled pin has no usable calibration data.
      */
     template<typename Rep, typename Period>
@@ -550,6 +684,34 @@ public:
         return _read_voltage(out, std::chrono::ceil<std::chrono::milliseconds>(timeout));
     }
 
+    /**
+     * @brief Reads one driver frame without copying it, blocking until one is available.
+     *
+     * Lends a view of up to `frame_samples` conversion results in the
+     * sampler's staging buffer, skipping the per-sample parse into
+     * @ref sample structs; see @ref frame for its lifetime.
+     *
+     * @return The frame (never empty), or an error.
+     * @retval idfxx::errc::invalid_state The sampler is not running, or a @ref consumer is attached.
+     */
+    [[nodiscard]] result<frame> try_read_frame() { return _read_frame(std::nullopt); }
+
+    /**
+     * @brief Reads one driver frame without copying it, blocking until one is available or the
+     *        timeout expires.
+     *
+     * @tparam Rep The representation type of the duration.
+     * @tparam Period The period type of the duration.
+     * @param timeout Maximum time to wait for a frame.
+     * @return The frame (never empty), or an error.
+     * @retval idfxx::errc::timeout No frame arrived within the timeout.
+     * @retval idfxx::errc::invalid_state The sampler is not running, or a @ref consumer is attached.
+     */
+    template<typename Rep, typename Period>
+    [[nodiscard]] result<frame> try_read_frame(const std::chrono::duration<Rep, Period>& timeout) {
+        return _read_frame(std::chrono::ceil<std::chrono::milliseconds>(timeout));
+    }
+
 #ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
     /**
      * @brief Converts a sample to a voltage using factory calibration.
@@ -645,17 +807,127 @@ public:
 
 private:
     /// @cond INTERNAL
-    struct state;
     explicit sampler(std::unique_ptr<state> s) noexcept;
     // A nullopt timeout means wait forever.
     [[nodiscard]] result<size_t> _try_read(std::span<sample> out, std::optional<std::chrono::milliseconds> timeout);
     [[nodiscard]] result<size_t>
     _read_voltage(std::span<electro::millivolts> out, std::optional<std::chrono::milliseconds> timeout);
+    [[nodiscard]] result<frame> _read_frame(std::optional<std::chrono::milliseconds> timeout);
     /// @endcond
 
     std::unique_ptr<state> _state;
 };
 
+/**
+ * @headerfile <idfxx/adc>
+ * @brief Drains a sampler on a dedicated task, delivering each frame to a callback.
+ *
+ * Replaces an application read loop that must keep up with the sample rate.
+ * A worker task sleeps until the driver's conversion-done interrupt reports
+ * a finished frame, then reads every frame waiting in the pool and passes
+ * each to the callback as a lent @ref sampler::frame. Give the task a
+ * priority above the application's so the pool is drained within a frame
+ * or two of each interrupt, however busy the rest of the system is, and pin
+ * it to a core to keep it clear of other time-critical work.
+ *
+ * While a consumer is attached, the sampler's own reads fail with
+ * `idfxx::errc::invalid_state`; @ref sampler::start, @ref sampler::stop, and
+ * the accessors are unaffected. Frames are only delivered while the sampler
+ * is running.
+ *
+ * This type is non-copyable and move-only. The sampler must outlive it.
+ *
+ * @code
+ * idfxx::adc::sampler mic({.pins = {idfxx::gpio_3}, .sample_rate = 40_kHz});
+ * idfxx::adc::sampler::consumer drain(mic, {
+ *     .callback = [&](const idfxx::adc::sampler::frame& f) {
+ *         // runs on the consumer task; f is valid until this returns
+ *         f.demux(channels);
+ *         chain.process(channels[0]);
+ *     },
+ *     .core_affinity = idfxx::core_id::core_1,
+ * });
+ * mic.start();
+ * @endcode
+ */
+class sampler::consumer {
+public:
+    /**
+     * @headerfile <idfxx/adc>
+     * @brief Consumer configuration.
+     */
+    struct config {
+        /** @brief Called on the worker task with each frame, valid until it returns (required). */
+        std::move_only_function<void(const frame&)> callback = nullptr;
+        /** @brief Worker task priority; above the default application priority of 5. */
+        task_priority priority = 10;
+        /** @brief Worker task stack size in bytes; the callback runs on this stack. */
+        size_t stack_size = 4096;
+        /** @brief Core to pin the worker task to (nullopt = any core). */
+        std::optional<core_id> core_affinity = std::nullopt;
+    };
+
+#ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
+    /**
+     * @brief Starts draining a sampler.
+     *
+     * Does not take ownership of @p sampler. It is the caller's responsibility to ensure that
+     * the consumer does not outlive the sampler.
+     *
+     * @param sampler The sampler to drain; it may be running or not.
+     * @param cfg     Consumer configuration.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error with idfxx::errc::invalid_arg if no callback is set, or
+     *         idfxx::errc::invalid_state if the sampler was moved from or already has a consumer.
+     */
+    [[nodiscard]] explicit consumer(sampler& sampler, config cfg);
+#endif
+
+    /**
+     * @brief Starts draining a sampler.
+     *
+     * Does not take ownership of @p sampler. It is the caller's responsibility to ensure that
+     * the consumer does not outlive the sampler.
+     *
+     * @param sampler The sampler to drain; it may be running or not.
+     * @param cfg     Consumer configuration.
+     *
+     * @return The running consumer, or an error.
+     * @retval idfxx::errc::invalid_arg No callback is set.
+     * @retval idfxx::errc::invalid_state The sampler was moved from, or already has a consumer.
+     */
+    [[nodiscard]] static result<consumer> make(sampler& sampler, config cfg);
+
+    /**
+     * @brief Stops the consumer.
+     *
+     * Detaches from the sampler and joins the worker task, waiting for a
+     * callback in progress to return. The sampler keeps running; its reads
+     * work again.
+     */
+    ~consumer();
+
+    consumer(const consumer&) = delete;
+    consumer& operator=(const consumer&) = delete;
+    consumer(consumer&&) noexcept;
+    consumer& operator=(consumer&&) noexcept;
+
+    /**
+     * @brief Returns the number of frames delivered to the callback.
+     * @return The frame count; 0 for a moved-from consumer.
+     */
+    [[nodiscard]] size_t frames() const noexcept;
+
+private:
+    /// @cond INTERNAL
+    struct context;
+    explicit consumer(std::unique_ptr<context> ctx) noexcept;
+    /// @endcond
+
+    std::unique_ptr<context> _context;
+};
+
 /** @} */ // end of idfxx_adc
 
 } // namespace idfxx::adc
@@ -2,17 +2,22 @@
 // Copyright 2026 Chris Leishman
 
 #include <idfxx/adc.hpp>
+#include <idfxx/task>
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <cstring>
 #include <esp_adc/adc_cali.h>
 #include <esp_adc/adc_cali_scheme.h>
 #include <esp_adc/adc_continuous.h>
 #include <esp_adc/adc_oneshot.h>
+#include <esp_attr.h>
+#include <freertos/FreeRTOS.h>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <sdkconfig.h>
 #include <soc/soc_caps.h>
@@ -33,6 +38,30 @@ static_assert(ADC_MAX_DELAY == std::numeric_limits<uint32_t>::max());
 
 namespace {
 
+// One parsed driver result.
+struct digi_result {
+    uint32_t channel;
+    int raw;
+};
+
+// Decodes the driver result at `p`, which need not be aligned.
+digi_result decode(const uint8_t* p) {
+    adc_digi_output_data_t data;
+    std::memcpy(&data, p, sizeof(data));
+#if CONFIG_IDF_TARGET_ESP32
+    return {data.type1.channel, static_cast<int>(data.type1.data)};
+#else
+    return {data.type2.channel, static_cast<int>(data.type2.data)};
+#endif
+}
+
+// Clamps a millisecond count to the driver-wait range, reserving
+// ADC_MAX_DELAY for "wait forever".
+uint32_t clamp_ms(int64_t ms) {
+    constexpr int64_t max_ms = ADC_MAX_DELAY - 1;
+    return static_cast<uint32_t>(ms < 0 ? 0 : (ms > max_ms ? max_ms : ms));
+}
+
 // The enumerators map one-to-one onto adc_atten_t, as the static_asserts above enforce.
 adc_atten_t to_idf(attenuation a) {
     return static_cast<adc_atten_t>(a);
@@ -190,10 +219,14 @@ result<electro::millivolts> input::try_read_voltage() {
 struct sampler::state {
     config cfg{};
     adc_continuous_handle_t handle = nullptr;
-    bool running = false;
-    size_t overruns = 0;
+    // Atomic because an attached consumer's task reads them.
+    std::atomic<bool> running = false;
+    std::atomic<size_t> overruns = 0;
     // Reverse map used when parsing: channel number -> configured pin (nc = unconfigured).
     std::array<idfxx::gpio, SOC_ADC_MAX_CHANNEL_NUM> chan_pin{};
+    // Channel number -> index in cfg.pins (no_slot = unconfigured), for demuxing frames.
+    static constexpr uint8_t no_slot = 0xFF;
+    std::array<uint8_t, SOC_ADC_MAX_CHANNEL_NUM> chan_slot{};
     // Calibration handle per configured pin, in cfg.pins order. With curve fitting
     // each pin owns its own handle; with line fitting every pin aliases one
     // per-unit handle.
@@ -202,6 +235,36 @@ struct sampler::state {
     std::vector<uint8_t> staging{};
     // Reused scratch for the fused voltage read: holds raw samples between read and conversion.
     std::vector<sample> read_scratch{};
+    // The attached consumer's worker, woken from the conversion-done ISR. The
+    // pointer is guarded by consumer_mux so the ISR never notifies a task that
+    // is being torn down; `consumed` alone gates the sampler's own reads, and
+    // is atomic because the sampler's reads check it from the caller's task.
+    portMUX_TYPE consumer_mux = portMUX_INITIALIZER_UNLOCKED;
+    idfxx::task* consumer_task = nullptr;
+    std::atomic<bool> consumed = false;
+    // Serializes starting and stopping the driver with the consumer's reads,
+    // so a stop never runs while the consumer task is inside a read.
+    std::mutex control_mtx;
+
+    static bool on_conv_done(adc_continuous_handle_t, const adc_continuous_evt_data_t*, void* user_data);
+
+    // Reads up to `want_bytes` of driver results into the staging buffer,
+    // counting pool overflows. Returns the number of bytes read.
+    result<uint32_t> read(size_t want_bytes, uint32_t wait_ms) {
+        uint32_t out_len = 0;
+        esp_err_t err = adc_continuous_read(handle, staging.data(), want_bytes, &out_len, wait_ms);
+        if (err == ESP_ERR_TIMEOUT) {
+            return error(errc::timeout);
+        }
+        if (err == ESP_ERR_INVALID_STATE) {
+            // The internal pool overflowed and samples were dropped; the bytes
+            // returned by this read are still valid.
+            ++overruns;
+        } else if (err != ESP_OK) {
+            return error(err);
+        }
+        return out_len;
+    }
 
     ~state() {
         if (handle && running) {
@@ -220,6 +283,15 @@ struct sampler::state {
     }
 };
 
+bool IRAM_ATTR
+sampler::state::on_conv_done(adc_continuous_handle_t, const adc_continuous_evt_data_t*, void* user_data) {
+    auto* s = static_cast<state*>(user_data);
+    portENTER_CRITICAL_ISR(&s->consumer_mux);
+    const bool woken = s->consumer_task != nullptr && s->consumer_task->notify_from_isr();
+    portEXIT_CRITICAL_ISR(&s->consumer_mux);
+    return woken;
+}
+
 #ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
 sampler::sampler(config cfg)
     : sampler(unwrap(make(std::move(cfg)))) {}
@@ -247,6 +319,7 @@ result<sampler> sampler::make(config cfg) {
     auto s = std::make_unique<state>();
     s->cfg = std::move(cfg);
     s->chan_pin.fill(gpio::nc());
+    s->chan_slot.fill(state::no_slot);
 
     // The digital (continuous) controller only serves ADC1 on the supported targets.
     std::vector<adc_channel_t> channels;
@@ -260,6 +333,7 @@ result<sampler> sampler::make(config cfg) {
         if (s->chan_pin[channel].is_connected()) {
             return error(errc::invalid_arg);
         }
+        s->chan_slot[channel] = static_cast<uint8_t>(channels.size());
         channels.push_back(channel);
         s->chan_pin[channel] = pin;
     }
@@ -294,6 +368,14 @@ result<sampler> sampler::make(config cfg) {
         return error(e.error());
     }
 
+    // Callbacks can only be registered before the first start, so the ISR hook
+    // is always installed; without a consumer it does nothing.
+    adc_continuous_evt_cbs_t cbs{};
+    cbs.on_conv_done = state::on_conv_done;
+    if (auto e = wrap(adc_continuous_register_event_callbacks(s->handle, &cbs, s.get())); !e) {
+        return error(e.error());
+    }
+
     // Factory calibration: best effort — reads still work uncalibrated.
     [[maybe_unused]] const auto atten = to_idf(s->cfg.attenuation);
     [[maybe_unused]] const auto bitwidth = static_cast<adc_bitwidth_t>(SOC_ADC_DIGI_MAX_BITWIDTH);
@@ -337,11 +419,15 @@ bool sampler::calibrated() const noexcept {
 }
 
 size_t sampler::overruns() const noexcept {
-    return _state ? _state->overruns : 0;
+    return _state ? _state->overruns.load() : 0;
 }
 
 result<void> sampler::try_start() {
-    if (!_state || _state->running) {
+    if (!_state) {
+        return error(errc::invalid_state);
+    }
+    std::scoped_lock lock(_state->control_mtx);
+    if (_state->running) {
         return error(errc::invalid_state);
     }
     if (auto e = wrap(adc_continuous_start(_state->handle)); !e) {
@@ -356,6 +442,7 @@ result<void> sampler::try_stop() {
     if (!_state) {
         return error(errc::invalid_state);
     }
+    std::scoped_lock lock(_state->control_mtx);
     if (!_state->running) {
         return {};
     }
@@ -367,7 +454,7 @@ result<void> sampler::try_stop() {
 }
 
 result<size_t> sampler::_try_read(std::span<sample> out, std::optional<std::chrono::milliseconds> timeout) {
-    if (!_state || !_state->running) {
+    if (!_state || !_state->running || _state->consumed) {
         return error(errc::invalid_state);
     }
     if (out.empty()) {
@@ -382,43 +469,20 @@ result<size_t> sampler::_try_read(std::span<sample> out, std::optional<std::chro
     }
     const size_t want_bytes = std::min(out.size() * SOC_ADC_DIGI_RESULT_BYTES, _state->staging.size());
 
-    // Clamps a millisecond count to the driver-wait range, reserving
-    // ADC_MAX_DELAY for "wait forever".
-    const auto clamp_ms = [](int64_t ms) {
-        constexpr int64_t max_ms = ADC_MAX_DELAY - 1;
-        return static_cast<uint32_t>(ms < 0 ? 0 : (ms > max_ms ? max_ms : ms));
-    };
-
     // A driver read can return only arbiter garbage (entries for channels we never
     // configured), so loop against the deadline until at least one valid sample lands.
     size_t count = 0;
     uint32_t remaining_ms = timeout ? clamp_ms(timeout->count()) : ADC_MAX_DELAY;
     while (count == 0) {
-        uint32_t out_len = 0;
-        esp_err_t err = adc_continuous_read(_state->handle, _state->staging.data(), want_bytes, &out_len, remaining_ms);
-        if (err == ESP_ERR_TIMEOUT) {
-            return error(errc::timeout);
-        }
-        if (err == ESP_ERR_INVALID_STATE) {
-            // The internal pool overflowed and samples were dropped; the bytes
-            // returned by this read are still valid.
-            ++_state->overruns;
-        } else if (err != ESP_OK) {
-            return error(err);
+        auto out_len = _state->read(want_bytes, remaining_ms);
+        if (!out_len) {
+            return error(out_len.error());
         }
 
         const uint8_t* buf = _state->staging.data();
-        for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= out_len && count < out.size();
+        for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= *out_len && count < out.size();
              i += SOC_ADC_DIGI_RESULT_BYTES) {
-            adc_digi_output_data_t data;
-            std::memcpy(&data, buf + i, sizeof(data));
-#if CONFIG_IDF_TARGET_ESP32
-            const uint32_t channel = data.type1.channel;
-            const int raw = data.type1.data;
-#else
-            const uint32_t channel = data.type2.channel;
-            const int raw = data.type2.data;
-#endif
+            const auto [channel, raw] = decode(buf + i);
             const idfxx::gpio pin = channel < SOC_ADC_MAX_CHANNEL_NUM ? _state->chan_pin[channel] : gpio::nc();
             if (!pin.is_connected()) {
                 continue;
@@ -437,6 +501,70 @@ result<size_t> sampler::_try_read(std::span<sample> out, std::optional<std::chro
     return count;
 }
 
+result<sampler::frame> sampler::_read_frame(std::optional<std::chrono::milliseconds> timeout) {
+    if (!_state || !_state->running || _state->consumed) {
+        return error(errc::invalid_state);
+    }
+
+    std::chrono::steady_clock::time_point deadline{};
+    if (timeout) {
+        deadline = std::chrono::steady_clock::now() + *timeout;
+    }
+    uint32_t remaining_ms = timeout ? clamp_ms(timeout->count()) : ADC_MAX_DELAY;
+    while (true) {
+        auto out_len = _state->read(_state->staging.size(), remaining_ms);
+        if (!out_len) {
+            return error(out_len.error());
+        }
+        if (*out_len >= SOC_ADC_DIGI_RESULT_BYTES) {
+            return frame{std::span<const uint8_t>{_state->staging.data(), *out_len}, _state.get()};
+        }
+        if (timeout) {
+            auto now = std::chrono::steady_clock::now();
+            if (now >= deadline) {
+                return error(errc::timeout);
+            }
+            remaining_ms = clamp_ms(std::chrono::ceil<std::chrono::milliseconds>(deadline - now).count());
+        }
+    }
+}
+
+size_t sampler::frame::size() const noexcept {
+    return _bytes.size() / SOC_ADC_DIGI_RESULT_BYTES;
+}
+
+sampler::sample sampler::frame::operator[](size_t i) const noexcept {
+    const auto [channel, raw] = decode(_bytes.data() + i * SOC_ADC_DIGI_RESULT_BYTES);
+    const idfxx::gpio pin = channel < SOC_ADC_MAX_CHANNEL_NUM ? _state->chan_pin[channel] : gpio::nc();
+    return {.pin = pin, .raw = raw};
+}
+
+result<size_t> sampler::frame::try_demux(std::span<std::span<int16_t>> channels) const {
+    const size_t pins = _state ? _state->cfg.pins.size() : 0;
+    if (channels.size() != pins) {
+        return error(errc::invalid_arg);
+    }
+
+    // Write cursors, one per pin; the spans are trimmed to them at the end.
+    std::array<size_t, SOC_ADC_PATT_LEN_MAX> fill{};
+    size_t total = 0;
+    const uint8_t* p = _bytes.data();
+    const uint8_t* const end = p + size() * SOC_ADC_DIGI_RESULT_BYTES;
+    for (; p != end; p += SOC_ADC_DIGI_RESULT_BYTES) {
+        const auto [channel, raw] = decode(p);
+        const uint8_t slot = channel < SOC_ADC_MAX_CHANNEL_NUM ? _state->chan_slot[channel] : state::no_slot;
+        if (slot == state::no_slot || fill[slot] == channels[slot].size()) {
+            continue;
+        }
+        channels[slot][fill[slot]++] = static_cast<int16_t>(raw);
+        ++total;
+    }
+    for (size_t i = 0; i < pins; ++i) {
+        channels[i] = channels[i].first(fill[i]);
+    }
+    return total;
+}
+
 result<electro::millivolts> sampler::try_to_voltage(const sample& s) const {
     electro::millivolts mv{0};
     if (auto e = try_to_voltage(std::span{&s, 1}, std::span{&mv, 1}); !e) {
@@ -507,4 +635,110 @@ sampler::_read_voltage(std::span<electro::millivolts> out, std::optional<std::ch
     return *n;
 }
 
+
+struct sampler::consumer::context {
+    sampler::state* state;
+    std::move_only_function<void(const frame&)> callback;
+    std::atomic<size_t> frames{0};
+    std::optional<task> worker;
+
+    context(sampler::state* s, config& cfg)
+        : state(s)
+        , callback(std::move(cfg.callback)) {}
+
+    ~context() {
+        if (worker) {
+            // Detach before joining, so the ISR never sees a task that is
+            // being torn down.
+            portENTER_CRITICAL(&state->consumer_mux);
+            state->consumer_task = nullptr;
+            portEXIT_CRITICAL(&state->consumer_mux);
+            worker->request_stop();
+            // Wake the worker if it is waiting for an interrupt.
+            (void)worker->try_notify();
+            worker.reset();
+        }
+        state->consumed = false;
+    }
+
+    // Delivers every frame waiting in the pool. A notification can stand for
+    // several frames, and on a multi-core chip can arrive just before the
+    // driver queues its frame; that frame is then delivered on the next wake,
+    // one frame period later.
+    void drain() {
+        for (;;) {
+            result<uint32_t> out_len;
+            {
+                // Never read from a driver that a concurrent stop() is
+                // stopping. The callback runs unlocked, so it may stop the
+                // sampler itself.
+                std::scoped_lock lock(state->control_mtx);
+                if (!state->running) {
+                    return;
+                }
+                out_len = state->read(state->staging.size(), 0);
+            }
+            if (!out_len || *out_len < SOC_ADC_DIGI_RESULT_BYTES) {
+                return;
+            }
+            callback(frame{std::span<const uint8_t>{state->staging.data(), *out_len}, state});
+            frames.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void run(task::self& self) {
+        while (!self.stop_requested()) {
+            self.wait();
+            drain();
+        }
+    }
+};
+
+sampler::consumer::consumer(std::unique_ptr<context> ctx) noexcept
+    : _context(std::move(ctx)) {}
+
+result<sampler::consumer> sampler::consumer::make(sampler& sampler, config cfg) {
+    if (!cfg.callback) {
+        return error(errc::invalid_arg);
+    }
+    if (!sampler._state || sampler._state->consumed.exchange(true)) {
+        return error(errc::invalid_state);
+    }
+
+    auto* s = sampler._state.get();
+    auto ctx = std::make_unique<context>(s, cfg);
+    auto* raw = ctx.get();
+    ctx->worker.emplace(
+        task::config{
+            .name = "adc_consumer",
+            .stack_size = cfg.stack_size,
+            .priority = cfg.priority,
+            .core_affinity = cfg.core_affinity,
+        },
+        [raw](task::self& self) { raw->run(self); }
+    );
+
+    portENTER_CRITICAL(&s->consumer_mux);
+    s->consumer_task = &*ctx->worker;
+    portEXIT_CRITICAL(&s->consumer_mux);
+
+    // Frames pooled before the consumer attached raised their interrupts
+    // already; drain them now.
+    (void)ctx->worker->try_notify();
+    return consumer{std::move(ctx)};
+}
+
+#ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
+sampler::consumer::consumer(sampler& sampler, config cfg)
+    : consumer(unwrap(make(sampler, std::move(cfg)))) {}
+#endif
+
+sampler::consumer::consumer(consumer&&) noexcept = default;
+sampler::consumer& sampler::consumer::operator=(consumer&&) noexcept = default;
+sampler::consumer::~consumer() = default;
+
+size_t sampler::consumer::frames() const noexcept {
+    return _context ? _context->frames.load(std::memory_order_relaxed) : 0;
+}
+
 } // namespace idfxx::adc
@@ -9,12 +9,16 @@
 // run on hardware.
 
 #include "idfxx/adc"
+#include "idfxx/sched"
 #include "sdkconfig.h"
 #include "unity.h"
 
 #include <array>
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <electro/electro>
+#include <span>
 #include <type_traits>
 
 using namespace idfxx::adc;
@@ -51,6 +55,16 @@ static_assert(std::is_move_assignable_v<sampler>);
 static_assert(std::is_default_constructible_v<sampler::config>);
 static_assert(std::is_default_constructible_v<sampler::sample>);
 
+// Frames are cheap views: copyable, and empty when default-constructed.
+static_assert(std::is_trivially_copyable_v<sampler::frame>);
+static_assert(std::is_default_constructible_v<sampler::frame>);
+
+// consumer is move-only.
+static_assert(!std::is_copy_constructible_v<sampler::consumer>);
+static_assert(!std::is_copy_assignable_v<sampler::consumer>);
+static_assert(std::is_move_constructible_v<sampler::consumer>);
+static_assert(std::is_move_assignable_v<sampler::consumer>);
+
 // =============================================================================
 // Runtime tests
 // =============================================================================
@@ -208,3 +222,93 @@ TEST_CASE("adc sampler reads calibrated voltages", "[idfxx][adc]") {
 
     TEST_ASSERT_TRUE(s->try_stop().has_value());
 }
+
+TEST_CASE("adc sampler frame read before start is an error", "[idfxx][adc]") {
+    auto s = sampler::make({.pins = {test_pin}});
+    TEST_ASSERT_TRUE(s.has_value());
+
+    auto f = s->try_read_frame(10ms);
+    TEST_ASSERT_FALSE(f.has_value());
+    TEST_ASSERT_TRUE(f.error() == idfxx::errc::invalid_state);
+}
+
+TEST_CASE("adc sampler frame demux rejects a mismatched channel count", "[idfxx][adc]") {
+    sampler::frame empty;
+    TEST_ASSERT_TRUE(empty.empty());
+    std::array<int16_t, 4> values{};
+    std::array<std::span<int16_t>, 1> channels{values};
+    auto r = empty.try_demux(channels);
+    TEST_ASSERT_FALSE(r.has_value());
+    TEST_ASSERT_TRUE(r.error() == idfxx::errc::invalid_arg);
+}
+
+TEST_CASE("adc sampler lends frames and demuxes them per pin", "[idfxx][adc]") {
+    auto s = sampler::make({.pins = {test_pin}, .frame_samples = 64, .buffer_samples = 256});
+    TEST_ASSERT_TRUE(s.has_value());
+    TEST_ASSERT_TRUE(s->try_start().has_value());
+
+    auto f = s->try_read_frame(1s);
+    TEST_ASSERT_TRUE(f.has_value());
+    TEST_ASSERT_GREATER_THAN(0, f->size());
+    TEST_ASSERT_LESS_OR_EQUAL(64, f->size());
+
+    // The frame decodes to the same samples the demuxed run holds.
+    std::array<int16_t, 64> values{};
+    std::array<std::span<int16_t>, 1> channels{values};
+    auto n = f->try_demux(channels);
+    TEST_ASSERT_TRUE(n.has_value());
+    TEST_ASSERT_EQUAL(*n, channels[0].size());
+    size_t j = 0;
+    for (size_t i = 0; i < f->size(); ++i) {
+        auto sample = (*f)[i];
+        if (sample.pin == test_pin) {
+            TEST_ASSERT_EQUAL(sample.raw, channels[0][j++]);
+        }
+    }
+    TEST_ASSERT_EQUAL(*n, j);
+
+    TEST_ASSERT_TRUE(s->try_stop().has_value());
+}
+
+TEST_CASE("adc sampler consumer requires a callback", "[idfxx][adc]") {
+    auto s = sampler::make({.pins = {test_pin}});
+    TEST_ASSERT_TRUE(s.has_value());
+    auto c = sampler::consumer::make(*s, {});
+    TEST_ASSERT_FALSE(c.has_value());
+    TEST_ASSERT_TRUE(c.error() == idfxx::errc::invalid_arg);
+}
+
+TEST_CASE("adc sampler consumer delivers frames in place of reads", "[idfxx][adc]") {
+    auto s = sampler::make({.pins = {test_pin}, .frame_samples = 64, .buffer_samples = 256});
+    TEST_ASSERT_TRUE(s.has_value());
+
+    std::atomic<size_t> samples{0};
+    {
+        auto c = sampler::consumer::make(*s, {.callback = [&](const sampler::frame& f) {
+            samples.fetch_add(f.size(), std::memory_order_relaxed);
+        }});
+        TEST_ASSERT_TRUE(c.has_value());
+
+        // One consumer per sampler.
+        auto second = sampler::consumer::make(*s, {.callback = [](const sampler::frame&) {}});
+        TEST_ASSERT_FALSE(second.has_value());
+        TEST_ASSERT_TRUE(second.error() == idfxx::errc::invalid_state);
+
+        TEST_ASSERT_TRUE(s->try_start().has_value());
+        idfxx::delay(100ms);
+
+        // The consumer owns the pool; the sampler's reads are refused.
+        auto f = s->try_read_frame(10ms);
+        TEST_ASSERT_FALSE(f.has_value());
+        TEST_ASSERT_TRUE(f.error() == idfxx::errc::invalid_state);
+
+        // 100 ms at 20 kHz is 2000 samples; allow for start-up.
+        TEST_ASSERT_GREATER_THAN(0, c->frames());
+        TEST_ASSERT_GREATER_THAN(1000, samples.load());
+    }
+
+    // Reads work again once the consumer is gone.
+    auto f = s->try_read_frame(1s);
+    TEST_ASSERT_TRUE(f.has_value());
+    TEST_ASSERT_TRUE(s->try_stop().has_value());
+}
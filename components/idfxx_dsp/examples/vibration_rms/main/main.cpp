@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: Apache-2.0
+
+// Samples a vibration sensor at 20 kHz and logs its RMS level ten times a
+// second. A sampler consumer, woken by the conversion-done interrupt, hands
+// each driver frame to a callback on its own task, which splits out the
+// pin's run and pushes it through a fixed-point pipeline: DC removal, a
+// 3rd-order CIC decimating to 1 kHz, a 100 Hz low-pass, and windowed
+// statistics. Only the latest window's statistics cross to the main task,
+// through a one-slot mailbox queue.
+
+#include <idfxx/adc>
+#include <idfxx/dsp/pipeline>
+#include <idfxx/log>
+#include <idfxx/queue>
+
+#include <array>
+#include <span>
+
+using namespace frequency_literals;
+
+static constexpr idfxx::log::logger logger{"example"};
+
+// ADC1-capable pin carrying the sensor output (change as needed).
+static constexpr auto sensor_pin = idfxx::gpio_3;
+
+static constexpr size_t frame_samples = 256;
+
+extern "C" void app_main() {
+    idfxx::adc::sampler sampler({.pins = {sensor_pin}, .sample_rate = 20_kHz, .frame_samples = frame_samples});
+    idfxx::queue<idfxx::dsp::statistics> reports(1);
+
+    idfxx::dsp::pipeline chain{
+        idfxx::dsp::dc_blocker{},
+        idfxx::dsp::cic_decimator<3>{20},
+        idfxx::dsp::biquad{*idfxx::dsp::biquad::lowpass(0.1)},
+        idfxx::dsp::window_stats{100, [&reports](const idfxx::dsp::statistics& s) { reports.overwrite(s); }},
+    };
+
+    // The consumer task runs above the default priority, so the pool drains
+    // before the driver has to drop frames.
+    std::array<int16_t, frame_samples> run;
+    idfxx::adc::sampler::consumer dsp(sampler, {.callback = [&](const idfxx::adc::sampler::frame& frame) {
+        std::array<std::span<int16_t>, 1> channels{run};
+        frame.demux(channels);
+        chain.process(channels[0]);
+    }});
+
+    sampler.start();
+
+    while (true) {
+        auto s = reports.receive();
+        logger.info(
+            "rms {} (min {} max {} mean {}) | {} overruns", s.rms, s.min, s.max, s.mean, sampler.overruns()
+        );
+    }
+}
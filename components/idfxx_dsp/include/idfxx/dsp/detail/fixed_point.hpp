@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+#pragma once
+
+/**
+ * @headerfile <idfxx/dsp/detail/fixed_point.hpp>
+ * @file fixed_point.hpp
+ * @brief Integer helpers shared by the DSP stages and the FFT.
+ * @ingroup idfxx_dsp
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+/// @cond INTERNAL
+
+namespace idfxx::dsp::detail {
+
+constexpr int16_t saturate(int64_t v) noexcept {
+    return static_cast<int16_t>(
+        std::clamp<int64_t>(v, std::numeric_limits<int16_t>::min(), std::numeric_limits<int16_t>::max())
+    );
+}
+
+// Divides by 2^shift, rounding to nearest, and saturates to int16_t.
+constexpr int16_t round_shift(int64_t v, int shift) noexcept {
+    return saturate((v + (int64_t{1} << (shift - 1))) >> shift);
+}
+
+constexpr uint32_t isqrt(uint64_t v) noexcept {
+    uint64_t root = 0;
+    uint64_t bit = uint64_t{1} << 62;
+    while (bit > v) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (v >= root + bit) {
+            v -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return static_cast<uint32_t>(root);
+}
+
+} // namespace idfxx::dsp::detail
+
+/// @endcond
@@ -0,0 +1,390 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+#pragma once
+
+/**
+ * @headerfile <idfxx/dsp/fft>
+ * @file fft.hpp
+ * @brief Fixed-point FFT, windows, and spectrum helpers.
+ * @ingroup idfxx_dsp
+ *
+ * @ref idfxx::dsp::fft transforms a block of Q15 complex values in place with
+ * radix-4 butterflies (plus one radix-2 pass when the size is not a power of
+ * four), using a twiddle table computed at compile time. Each pass scales by
+ * the butterfly's radix, so the result is the DFT divided by the size and
+ * real input cannot overflow.
+ *
+ * @code
+ * // 1024-point magnitude spectrum of a block of ADC samples.
+ * using fft = idfxx::dsp::fft<1024>;
+ * static constexpr auto hann = idfxx::dsp::make_window<1024>(idfxx::dsp::window::hann);
+ * std::array<idfxx::dsp::complex16, 1024> bins;
+ * std::array<uint16_t, 513> spectrum;
+ *
+ * fft::load(samples, hann, bins, 3); // 12-bit samples scaled to 15 bits
+ * fft::transform(bins);
+ * idfxx::dsp::magnitude(std::span(bins).first(513), spectrum);
+ * uint64_t hum = idfxx::dsp::band_power(bins, fft::bin(45, fs), fft::bin(55, fs) + 1);
+ * @endcode
+ */
+
+#include <idfxx/dsp/detail/fixed_point.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <span>
+
+namespace idfxx::dsp {
+
+/**
+ * @headerfile <idfxx/dsp/fft>
+ * @brief A complex value with Q15 real and imaginary parts.
+ */
+struct complex16 {
+    int16_t re = 0; ///< Real part
+    int16_t im = 0; ///< Imaginary part
+
+    /** @brief Compares two values for equality. */
+    friend constexpr bool operator==(const complex16&, const complex16&) noexcept = default;
+};
+
+/**
+ * @headerfile <idfxx/dsp/fft>
+ * @brief Window functions for spectral analysis.
+ *
+ * Windows taper a block towards its ends so a tone that does not fit a whole
+ * number of cycles leaks less energy into distant bins. All are the periodic
+ * forms, which suit FFT analysis.
+ */
+enum class window : uint8_t {
+    rectangular, ///< No tapering: narrowest main lobe, most leakage.
+    hann,        ///< Good general-purpose compromise.
+    hamming,     ///< Lower nearest side lobe than Hann, slower fall-off.
+    blackman,    ///< Lowest leakage, widest main lobe.
+};
+
+/// @cond INTERNAL
+namespace detail {
+
+// Sine and cosine of 2π·num/den, accurate to well below one Q15 step, usable
+// in constant expressions.
+struct sin_cos {
+    double sin;
+    double cos;
+};
+
+constexpr sin_cos unit_circle(size_t num, size_t den) noexcept {
+    // Reduce to an angle in [-π/4, π/4] plus a quadrant.
+    const size_t eighths = (num % den * 8 + den / 2) / den; // nearest multiple of π/4
+    const double x = 2 * std::numbers::pi * (static_cast<double>(num % den) / static_cast<double>(den)) -
+                     static_cast<double>(eighths) * std::numbers::pi / 4;
+    double s = 0;
+    double c = 0;
+    double term_s = x;
+    double term_c = 1;
+    for (int n = 0; n < 12; ++n) {
+        s += term_s;
+        c += term_c;
+        term_s *= -x * x / ((2 * n + 2) * (2 * n + 3));
+        term_c *= -x * x / ((2 * n + 1) * (2 * n + 2));
+    }
+    // Rotate by the nearest multiple of π/4.
+    constexpr double r = std::numbers::sqrt2 / 2;
+    switch (eighths % 8) {
+    case 0:
+        return {s, c};
+    case 1:
+        return {r * (s + c), r * (c - s)};
+    case 2:
+        return {c, -s};
+    case 3:
+        return {r * (c - s), -r * (s + c)};
+    case 4:
+        return {-s, -c};
+    case 5:
+        return {-r * (s + c), r * (s - c)};
+    case 6:
+        return {-c, s};
+    default:
+        return {r * (s - c), r * (s + c)};
+    }
+}
+
+// Rounds to Q15, clamping to ±32767 so that 1 and -1 are symmetric.
+constexpr int16_t to_q15(double v) noexcept {
+    const double scaled = v * 32768;
+    return static_cast<int16_t>(
+        std::clamp<int64_t>(static_cast<int64_t>(scaled < 0 ? scaled - 0.5 : scaled + 0.5), -32767, 32767)
+    );
+}
+
+// Complex multiply by a Q15 twiddle, rounding and saturating.
+constexpr complex16 rotate(int32_t re, int32_t im, complex16 w) noexcept {
+    return {
+        round_shift(static_cast<int64_t>(re * w.re - im * w.im), 15),
+        round_shift(static_cast<int64_t>(re * w.im + im * w.re), 15),
+    };
+}
+
+} // namespace detail
+/// @endcond
+
+/**
+ * @headerfile <idfxx/dsp/fft>
+ * @brief Computes a window's Q15 coefficients.
+ *
+ * Evaluates at compile time when used to initialize a `constexpr` table.
+ *
+ * @tparam N Window length.
+ * @param w  Window function.
+ * @return The coefficients, at most 32767.
+ */
+template<size_t N>
+[[nodiscard]] constexpr std::array<int16_t, N> make_window(window w) noexcept {
+    std::array<int16_t, N> coefficients{};
+    for (size_t i = 0; i < N; ++i) {
+        const double c1 = detail::unit_circle(i, N).cos;
+        const double c2 = detail::unit_circle(2 * i, N).cos;
+        double v = 1;
+        switch (w) {
+        case window::rectangular:
+            break;
+        case window::hann:
+            v = 0.5 - 0.5 * c1;
+            break;
+        case window::hamming:
+            v = 0.54 - 0.46 * c1;
+            break;
+        case window::blackman:
+            v = 0.42 - 0.5 * c1 + 0.08 * c2;
+            break;
+        }
+        coefficients[i] = detail::to_q15(v);
+    }
+    return coefficients;
+}
+
+/**
+ * @headerfile <idfxx/dsp/fft>
+ * @brief In-place fixed-point fast Fourier transform of a fixed size.
+ *
+ * The transform is the DFT divided by `N`, in natural bin order: bin `k`
+ * holds the component at `k * sample_rate / N`, and for real input bins
+ * above `N / 2` mirror those below. A full-scale sine of amplitude `A`
+ * therefore shows as `A / 2` in its bin (and its mirror). Values whose
+ * magnitude exceeds 32767 — both parts near full scale at once — may
+ * saturate; real input never does.
+ *
+ * The twiddle table (`3N/4` values of 4 bytes) is computed at compile time
+ * and shared by every transform of the same size. Transforms allocate
+ * nothing and keep no state, so any task may call them.
+ *
+ * @tparam N Transform size: a power of two from 4 to 4096.
+ */
+template<size_t N>
+class fft {
+    static_assert(std::has_single_bit(N) && N >= 4 && N <= 4096, "fft size must be a power of two from 4 to 4096");
+
+public:
+    /** @brief The transform size. */
+    static constexpr size_t size = N;
+
+    /**
+     * @brief Loads real samples as complex input, zero-padding a short block.
+     *
+     * @param samples Real samples; at most `N` are used.
+     * @param out     Transform input.
+     * @param shift   Left shift applied to each sample, e.g. 3 to bring
+     *                12-bit ADC values towards full scale.
+     */
+    static void load(std::span<const int16_t> samples, std::span<complex16, N> out, int shift = 0) noexcept {
+        const size_t n = std::min(samples.size(), N);
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = {detail::saturate(int64_t{samples[i]} << shift), 0};
+        }
+        std::fill(out.begin() + static_cast<ptrdiff_t>(n), out.end(), complex16{});
+    }
+
+    /**
+     * @brief Loads real samples as complex input, applying a window.
+     *
+     * @param samples     Real samples; at most `N` are used, and a short block is zero-padded.
+     * @param coefficients Q15 window coefficients, as from @ref make_window.
+     * @param out         Transform input.
+     * @param shift       Left shift applied to each sample before windowing.
+     */
+    static void load(
+        std::span<const int16_t> samples,
+        std::span<const int16_t, N> coefficients,
+        std::span<complex16, N> out,
+        int shift = 0
+    ) noexcept {
+        const size_t n = std::min(samples.size(), N);
+        for (size_t i = 0; i < n; ++i) {
+            const int16_t x = detail::saturate(int64_t{samples[i]} << shift);
+            out[i] = {detail::round_shift(int32_t{x} * coefficients[i], 15), 0};
+        }
+        std::fill(out.begin() + static_cast<ptrdiff_t>(n), out.end(), complex16{});
+    }
+
+    /**
+     * @brief Transforms a block in place.
+     * @param data `N` complex values; overwritten with the spectrum divided by `N`.
+     */
+    static constexpr void transform(std::span<complex16, N> data) noexcept {
+        size_t length = N;
+        // Radix-4 passes. Each butterfly is two radix-2 decimation-in-frequency
+        // steps fused, with its outputs stored in radix-2 order, so a plain
+        // bit reversal puts the bins in order at the end.
+        for (; length >= 4; length /= 4) {
+            const size_t quarter = length / 4;
+            const size_t stride = N / length;
+            for (size_t j = 0; j < quarter; ++j) {
+                const complex16 w1 = twiddles[j * stride];
+                const complex16 w2 = twiddles[2 * j * stride];
+                const complex16 w3 = twiddles[3 * j * stride];
+                for (size_t i = j; i < N; i += length) {
+                    butterfly4(data, i, quarter, w1, w2, w3);
+                }
+            }
+        }
+        // One radix-2 pass when log2(N) is odd.
+        if (length == 2) {
+            for (size_t i = 0; i < N; i += 2) {
+                const complex16 a = data[i];
+                const complex16 b = data[i + 1];
+                data[i] = {half(a.re + b.re), half(a.im + b.im)};
+                data[i + 1] = {half(a.re - b.re), half(a.im - b.im)};
+            }
+        }
+        bit_reverse(data);
+    }
+
+    /**
+     * @brief Returns the centre frequency of a bin.
+     * @param k           Bin index.
+     * @param sample_rate Sample rate of the transformed block, in Hz.
+     * @return The frequency in Hz.
+     */
+    [[nodiscard]] static constexpr double bin_frequency(size_t k, double sample_rate) noexcept {
+        return static_cast<double>(k) * sample_rate / N;
+    }
+
+    /**
+     * @brief Returns the bin nearest a frequency.
+     * @param frequency   Frequency in Hz, from 0 to `sample_rate`.
+     * @param sample_rate Sample rate of the transformed block, in Hz.
+     * @return The bin index, clamped to `N - 1`.
+     */
+    [[nodiscard]] static constexpr size_t bin(double frequency, double sample_rate) noexcept {
+        const double k = frequency * N / sample_rate + 0.5;
+        return k <= 0 ? 0 : std::min(static_cast<size_t>(k), N - 1);
+    }
+
+    /** @brief The twiddle factors e^(-2πi·m/N) for m < 3N/4, in Q15. */
+    static constexpr std::array<complex16, 3 * N / 4> twiddles = [] {
+        std::array<complex16, 3 * N / 4> t{};
+        for (size_t m = 0; m < t.size(); ++m) {
+            const auto [s, c] = detail::unit_circle(m, N);
+            t[m] = {detail::to_q15(c), detail::to_q15(-s)};
+        }
+        return t;
+    }();
+
+private:
+    static constexpr int16_t half(int32_t v) noexcept { return static_cast<int16_t>((v + 1) >> 1); }
+
+    static constexpr int32_t quarter_of(int32_t v) noexcept { return (v + 2) >> 2; }
+
+    // Fuses two radix-2 DIF steps on x[i], x[i+q], x[i+2q], x[i+3q], scaling by 1/4.
+    static constexpr void butterfly4(
+        std::span<complex16, N> x,
+        size_t i,
+        size_t q,
+        complex16 w1,
+        complex16 w2,
+        complex16 w3
+    ) noexcept {
+        const complex16 x0 = x[i];
+        const complex16 x1 = x[i + q];
+        const complex16 x2 = x[i + 2 * q];
+        const complex16 x3 = x[i + 3 * q];
+        const int32_t s02_re = x0.re + x2.re, s02_im = x0.im + x2.im;
+        const int32_t d02_re = x0.re - x2.re, d02_im = x0.im - x2.im;
+        const int32_t s13_re = x1.re + x3.re, s13_im = x1.im + x3.im;
+        const int32_t d13_re = x1.re - x3.re, d13_im = x1.im - x3.im;
+
+        x[i] = {detail::saturate(quarter_of(s02_re + s13_re)), detail::saturate(quarter_of(s02_im + s13_im))};
+        x[i + q] = detail::rotate(quarter_of(s02_re - s13_re), quarter_of(s02_im - s13_im), w2);
+        // (x0 - x2) - i(x1 - x3), then (x0 - x2) + i(x1 - x3).
+        x[i + 2 * q] = detail::rotate(quarter_of(d02_re + d13_im), quarter_of(d02_im - d13_re), w1);
+        x[i + 3 * q] = detail::rotate(quarter_of(d02_re - d13_im), quarter_of(d02_im + d13_re), w3);
+    }
+
+    static constexpr void bit_reverse(std::span<complex16, N> x) noexcept {
+        for (size_t i = 1, j = 0; i < N; ++i) {
+            size_t bit = N >> 1;
+            for (; j & bit; bit >>= 1) {
+                j ^= bit;
+            }
+            j |= bit;
+            if (i < j) {
+                std::swap(x[i], x[j]);
+            }
+        }
+    }
+};
+
+/**
+ * @headerfile <idfxx/dsp/fft>
+ * @brief Returns the squared magnitude of a bin.
+ * @param v A spectrum value.
+ * @return `re² + im²`.
+ */
+[[nodiscard]] constexpr uint32_t power(complex16 v) noexcept {
+    return static_cast<uint32_t>(int32_t{v.re} * v.re) + static_cast<uint32_t>(int32_t{v.im} * v.im);
+}
+
+/**
+ * @headerfile <idfxx/dsp/fft>
+ * @brief Computes the magnitude of each bin.
+ *
+ * @param spectrum Spectrum values, typically the first `N / 2 + 1` bins of a
+ *                 real signal's transform.
+ * @param out      Destination for the magnitudes, rounded down.
+ * @return The number of magnitudes written: the smaller of the two sizes.
+ */
+constexpr size_t magnitude(std::span<const complex16> spectrum, std::span<uint16_t> out) noexcept {
+    const size_t n = std::min(spectrum.size(), out.size());
+    for (size_t k = 0; k < n; ++k) {
+        out[k] = static_cast<uint16_t>(detail::isqrt(power(spectrum[k])));
+    }
+    return n;
+}
+
+/**
+ * @headerfile <idfxx/dsp/fft>
+ * @brief Sums the squared magnitudes of a range of bins.
+ *
+ * For a real signal, a band's power is split between its bins and their
+ * mirrors above `N / 2`; summing only the lower half gives half of it.
+ *
+ * @param spectrum Spectrum values.
+ * @param first    First bin of the band.
+ * @param last     One past the last bin of the band; clamped to the spectrum size.
+ * @return The sum of `re² + im²` over the band.
+ */
+[[nodiscard]] constexpr uint64_t band_power(std::span<const complex16> spectrum, size_t first, size_t last) noexcept {
+    uint64_t sum = 0;
+    for (size_t k = first; k < std::min(last, spectrum.size()); ++k) {
+        sum += power(spectrum[k]);
+    }
+    return sum;
+}
+
+} // namespace idfxx::dsp
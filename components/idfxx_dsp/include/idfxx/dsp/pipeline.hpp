@@ -0,0 +1,688 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+#pragma once
+
+/**
+ * @headerfile <idfxx/dsp/pipeline>
+ * @file pipeline.hpp
+ * @brief Streaming fixed-point signal processing stages.
+ *
+ * @defgroup idfxx_dsp DSP Component
+ * @brief Fixed-point filters, decimators, statistics, and FFTs for sampled signals.
+ *
+ * Every stage works in place on a block of `int16_t` samples — typically one
+ * pin's run from `adc::sampler::frame::demux` — and returns the part of the
+ * block holding its output: the whole block for filters, a shorter prefix
+ * for decimators. A @ref idfxx::dsp::pipeline chains stages so a block
+ * flows through all of them in one call. Stages keep their state between
+ * blocks, so a signal can be fed in blocks of any size, and none allocates
+ * after construction.
+ *
+ * Filters use integer arithmetic throughout: FIR taps are Q15, biquad
+ * coefficients Q14, with wide accumulators and saturation on output.
+ *
+ * For spectral analysis of a block, see @ref idfxx::dsp::fft in
+ * `<idfxx/dsp/fft>`.
+ *
+ * @code
+ * // 20 kHz in, 1 kHz out: remove DC, decimate, low-pass at 100 Hz, and
+ * // report RMS over each 100 ms.
+ * idfxx::dsp::pipeline chain{
+ *     idfxx::dsp::dc_blocker{},
+ *     idfxx::dsp::cic_decimator<3>{20},
+ *     idfxx::dsp::biquad{*idfxx::dsp::biquad::lowpass(0.1)},
+ *     idfxx::dsp::window_stats{100, [](const idfxx::dsp::statistics& s) { report(s.rms); }},
+ * };
+ * auto out = chain.process(run); // run: std::span<int16_t>; out: the decimated prefix
+ * @endcode
+ * @{
+ */
+
+#include <idfxx/dsp/detail/fixed_point.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numbers>
+#include <optional>
+#include <span>
+#include <tuple>
+#include <utility>
+
+/**
+ * @headerfile <idfxx/dsp/pipeline>
+ * @brief Signal processing classes.
+ */
+namespace idfxx::dsp {
+
+/**
+ * @headerfile <idfxx/dsp/pipeline>
+ * @brief A processing stage: transforms a block in place and returns its output.
+ *
+ * `process(block)` returns a prefix of `block` holding the stage's output;
+ * `reset()` returns the stage to its initial state.
+ */
+template<typename S>
+concept stage = requires(S& s, std::span<int16_t> block) {
+    { s.process(block) } -> std::same_as<std::span<int16_t>>;
+    s.reset();
+};
+
+/**
+ * @headerfile <idfxx/dsp/pipeline>
+ * @brief Cascaded integrator-comb decimator.
+ *
+ * Reduces the sample rate by `factor`, low-pass filtering with `Order`
+ * cascaded moving averages of length `factor` — additions only, no
+ * multiplies. The output is normalized by the filter's gain, so a constant
+ * input passes through unchanged. Order 1 is a plain boxcar average of each
+ * `factor` consecutive samples (see @ref boxcar_decimator); higher orders
+ * reject aliases more strongly at the cost of a wider transition band.
+ *
+ * @tparam Order Number of integrator/comb pairs, 1 to 4.
+ */
+template<size_t Order>
+class cic_decimator {
+    static_assert(Order >= 1 && Order <= 4, "cic_decimator supports orders 1 to 4");
+
+public:
+    /**
+     * @brief Checks whether a decimation factor is usable.
+     * @param factor The decimation factor.
+     * @return True if `factor` is at least 1 and `factor^Order` is at most 32768,
+     *         which keeps the integrators exact in 32 bits.
+     */
+    [[nodiscard]] static constexpr bool valid(uint32_t factor) noexcept {
+        if (factor < 1) {
+            return false;
+        }
+        uint64_t gain = 1;
+        for (size_t i = 0; i < Order; ++i) {
+            gain *= factor;
+        }
+        return gain <= 32768;
+    }
+
+    /**
+     * @brief Constructs a decimator.
+     *
+     * A zero factor is rejected: it fails an assertion, and is not a
+     * constant expression. With assertions disabled it decimates by 1
+     * rather than dividing by zero.
+     *
+     * @param factor Decimation factor. Must satisfy @ref valid.
+     */
+    constexpr explicit cic_decimator(uint32_t factor) noexcept
+        : _factor(std::max<uint32_t>(factor, 1)) {
+        assert(factor >= 1);
+        for (size_t i = 0; i < Order; ++i) {
+            _gain *= static_cast<int32_t>(_factor);
+        }
+    }
+
+    /**
+     * @brief Decimates a block in place.
+     *
+     * Input left over from the previous block carries forward, so the output
+     * has one sample for every `factor` input samples fed in total.
+     *
+     * @param block Input samples; overwritten with the output.
+     * @return The prefix of `block` holding the output samples.
+     */
+    constexpr std::span<int16_t> process(std::span<int16_t> block) noexcept {
+        size_t out = 0;
+        for (size_t i = 0; i < block.size(); ++i) {
+            // Two's-complement wraparound in the integrators cancels in the
+            // combs, so the output is exact as long as it fits in 32 bits.
+            uint32_t v = static_cast<uint32_t>(static_cast<int32_t>(block[i]));
+            for (auto& integrator : _integrators) {
+                integrator += v;
+                v = integrator;
+            }
+            if (++_phase < _factor) {
+                continue;
+            }
+            _phase = 0;
+            for (auto& comb : _combs) {
+                const uint32_t previous = comb;
+                comb = v;
+                v -= previous;
+            }
+            const int32_t sum = static_cast<int32_t>(v);
+            const int32_t half = _gain / 2;
+            block[out++] = static_cast<int16_t>(sum >= 0 ? (sum + half) / _gain : -((-sum + half) / _gain));
+        }
+        return block.first(out);
+    }
+
+    /** @brief Clears the filter state and any partially accumulated input. */
+    constexpr void reset() noexcept {
+        _integrators.fill(0);
+        _combs.fill(0);
+        _phase = 0;
+    }
+
+    /** @brief Returns the decimation factor. */
+    [[nodiscard]] constexpr uint32_t factor() const noexcept { return _factor; }
+
+private:
+    uint32_t _factor;
+    int32_t _gain = 1;
+    uint32_t _phase = 0;
+    std::array<uint32_t, Order> _integrators{};
+    std::array<uint32_t, Order> _combs{};
+};
+
+/**
+ * @headerfile <idfxx/dsp/pipeline>
+ * @brief Decimator averaging each `factor` consecutive samples into one.
+ */
+using boxcar_decimator = cic_decimator<1>;
+
+/**
+ * @headerfile <idfxx/dsp/pipeline>
+ * @brief Finite impulse response filter with Q15 taps.
+ *
+ * Computes `y[n] = Σ h[k]·x[n-k]` with a 32-bit accumulator. The history is
+ * kept twice over so each output is one contiguous dot product with no
+ * wraparound inside the loop.
+ *
+ * @tparam Taps Number of taps.
+ */
+template<size_t Taps>
+class fir {
+    static_assert(Taps >= 1, "fir needs at least one tap");
+
+public:
+    /** @brief Filter taps, `h[0]` first, in Q15 (32767 ≈ 1.0). */
+    using coefficients = std::array<int16_t, Taps>;
+
+    /**
+     * @brief Checks whether a set of taps is usable.
+     * @param taps The taps.
+     * @return True if the taps' absolute values sum to at most 1.0 (32768),
+     *         which guarantees the accumulator cannot overflow.
+     */
+    [[nodiscard]] static constexpr bool valid(const coefficients& taps) noexcept {
+        int64_t sum = 0;
+        for (int16_t h : taps) {
+            sum += h < 0 ? -int64_t{h} : int64_t{h};
+        }
+        return sum <= 32768;
+    }
+
+    /**
+     * @brief Constructs a filter with zeroed history.
+     * @param taps Filter taps. Must satisfy @ref valid.
+     */
+    constexpr explicit fir(const coefficients& taps) noexcept {
+        // Reversed, so the newest sample meets h[0] at the end of the window.
+        for (size_t i = 0; i < Taps; ++i) {
+            _reversed[i] = taps[Taps - 1 - i];
+        }
+    }
+
+    /**
+     * @brief Filters a block in place.
+     * @param block Input samples; overwritten with the output.
+     * @return `block`.
+     */
+    constexpr std::span<int16_t> process(std::span<int16_t> block) noexcept {
+        for (auto& x : block) {
+            _history[_pos] = x;
+            _history[_pos + Taps] = x;
+            _pos = _pos + 1 == Taps ? 0 : _pos + 1;
+            // _history[_pos .. _pos + Taps) now holds the last Taps inputs, oldest first.
+            const int16_t* window = _history.data() + _pos;
+            int32_t acc = 0;
+            for (size_t i = 0; i < Taps; ++i) {
+                acc += int32_t{_reversed[i]} * window[i];
+            }
+            x = detail::round_shift(acc, 15);
+        }
+        return block;
+    }
+
+    /** @brief Clears the filter history. */
+    constexpr void reset() noexcept {
+        _history.fill(0);
+        _pos = 0;
+    }
+
+private:
+    coefficients _reversed{};
+    std::array<int16_t, 2 * Taps> _history{};
+    size_t _pos = 0;
+};
+
+/**
+ * @headerfile <idfxx/dsp/pipeline>
+ * @brief Second-order IIR section with Q14 coefficients.
+ *
+ * Computes `y[n] = b0·x[n] + b1·x[n-1] + b2·x[n-2] - a1·y[n-1] - a2·y[n-2]`
+ * (direct form I) with a 64-bit accumulator. Chain several in a
+ * @ref pipeline for higher orders.
+ *
+ * Q14 coefficients resolve poles close to the unit circle poorly, so keep
+ * cutoffs above about 1% of the sample rate — decimating first brings a low
+ * cutoff into range. The designers return `std::nullopt` for a cutoff whose
+ * quantized coefficients would miss the passband gain by more than 5%.
+ */
+class biquad {
+public:
+    /**
+     * @headerfile <idfxx/dsp/pipeline>
+     * @brief Biquad coefficients in Q14 (16384 = 1.0), normalized so a0 = 1.
+     */
+    struct coefficients {
+        int16_t b0 = 16384; ///< Feed-forward, current input
+        int16_t b1 = 0;     ///< Feed-forward, previous input
+        int16_t b2 = 0;     ///< Feed-forward, input before that
+        int16_t a1 = 0;     ///< Feedback, previous output
+        int16_t a2 = 0;     ///< Feedback, output before that
+
+        /** @brief Compares two coefficient sets for equality. */
+        friend constexpr bool operator==(const coefficients&, const coefficients&) noexcept = default;
+    };
+
+    /**
+     * @brief Designs a second-order Butterworth-style low-pass section.
+     *
+     * @param cutoff Cutoff frequency as a fraction of the sample rate, in (0, 0.5).
+     * @param q      Quality factor; 1/√2 gives a maximally flat passband.
+     *
+     * @return The coefficients, or `std::nullopt` if `cutoff` or `q` is out of range, or
+     *         too low for Q14 coefficients to hold the passband gain within 5% of unity.
+     */
+    [[nodiscard]] static std::optional<coefficients> lowpass(double cutoff, double q = std::numbers::sqrt2 / 2) {
+        return _design(cutoff, q, false);
+    }
+
+    /**
+     * @brief Designs a second-order Butterworth-style high-pass section.
+     *
+     * @param cutoff Cutoff frequency as a fraction of the sample rate, in (0, 0.5).
+     * @param q      Quality factor; 1/√2 gives a maximally flat passband.
+     *
+     * @return The coefficients, or `std::nullopt` if `cutoff` or `q` is out of range, or
+     *         too close to Nyquist for Q14 coefficients to hold the passband gain within 5% of unity.
+     */
+    [[nodiscard]] static std::optional<coefficients> highpass(double cutoff, double q = std::numbers::sqrt2 / 2) {
+        return _design(cutoff, q, true);
+    }
+
+    /**
+     * @brief Constructs a section with zeroed history.
+     * @param c Coefficients.
+     */
+    constexpr explicit biquad(const coefficients& c) noexcept
+        : _c(c) {}
+
+    /**
+     * @brief Filters a block in place.
+     * @param block Input samples; overwritten with the output.
+     * @return `block`.
+     */
+    constexpr std::span<int16_t> process(std::span<int16_t> block) noexcept {
+        for (auto& x : block) {
+            const int64_t acc = int64_t{_c.b0} * x + int64_t{_c.b1} * _x1 + int64_t{_c.b2} * _x2 -
+                                int64_t{_c.a1} * _y1 - int64_t{_c.a2} * _y2 + _residue;
+            const int16_t y = detail::round_shift(acc, 14);
+            // Carry the rounding error into the next output; without it, poles
+            // near DC hold the output on a small constant instead of decaying.
+            _residue = std::clamp<int64_t>(acc - (int64_t{y} << 14), -(1 << 13), 1 << 13);
+            _x2 = _x1;
+            _x1 = x;
+            _y2 = _y1;
+            _y1 = y;
+            x = y;
+        }
+        return block;
+    }
+
+    /** @brief Clears the filter history. */
+    constexpr void reset() noexcept {
+        _x1 = _x2 = _y1 = _y2 = 0;
+        _residue = 0;
+    }
+
+    /** @brief Returns the coefficients. */
+    [[nodiscard]] constexpr const coefficients& get_coefficients() const noexcept { return _c; }
+
+private:
+    // Audio EQ cookbook designs, quantized to Q14.
+    static std::optional<coefficients> _design(double cutoff, double q, bool high) {
+        if (!(cutoff > 0 && cutoff < 0.5) || !(q > 0)) {
+            return std::nullopt;
+        }
+        const double w0 = 2 * std::numbers::pi * cutoff;
+        const double cosw = std::cos(w0);
+        const double alpha = std::sin(w0) / (2 * q);
+        const double a0 = 1 + alpha;
+        const auto quantize = [a0](double v) {
+            return detail::saturate(std::lround(v / a0 * 16384));
+        };
+        // b1 = ∓2·b0 exactly, so the zeros stay at DC (high-pass) or Nyquist
+        // (low-pass) after rounding.
+        const int16_t b0 = quantize((high ? 1 + cosw : 1 - cosw) / 2);
+        const int16_t b1 = detail::saturate(high ? -2 * int32_t{b0} : 2 * int32_t{b0});
+        const int16_t a1 = quantize(-2 * cosw);
+        const int16_t a2 = quantize(1 - alpha);
+        // Passband gain, at DC (low-pass) or Nyquist (high-pass), is 4·b0
+        // over this. Near the edges of the band rounding leaves both terms a
+        // few counts wide, and the gain far from unity, or b0 at zero.
+        const int32_t den = 16384 + (high ? -int32_t{a1} : int32_t{a1}) + a2;
+        if (b0 == 0 || den <= 0 || std::abs(4 * int32_t{b0} - den) * 20 > den) {
+            return std::nullopt;
+        }
+        return coefficients{b0, b1, b0, a1, a2};
+    }
+
+    coefficients _c;
+    int16_t _x1 = 0, _x2 = 0, _y1 = 0, _y2 = 0;
+    int64_t _residue = 0;
+};
+
+/**
+ * @headerfile <idfxx/dsp/pipeline>
+ * @brief Removes the DC offset from a signal.
+ *
+ * Tracks the signal's mean with a first-order low-pass of time constant
+ * 2^`shift` samples and subtracts it — an ADC's mid-scale bias, for
+ * instance. The estimate starts at the first sample, so there is no long
+ * settling transient.
+ */
+class dc_blocker {
+public:
+    /**
+     * @brief Checks whether a time constant is usable.
+     * @param shift Base-2 logarithm of the time constant in samples.
+     * @return True if `shift` is 1 to 16.
+     */
+    [[nodiscard]] static constexpr bool valid(uint8_t shift) noexcept { return shift >= 1 && shift <= 16; }
+
+    /**
+     * @brief Constructs a DC blocker.
+     * @param shift Base-2 logarithm of the time constant in samples (default 256).
+     *              Must satisfy @ref valid.
+     */
+    constexpr explicit dc_blocker(uint8_t shift = 8) noexcept
+        : _shift(shift) {}
+
+    /**
+     * @brief Removes the DC offset from a block in place.
+     * @param block Input samples; overwritten with the output.
+     * @return `block`.
+     */
+    constexpr std::span<int16_t> process(std::span<int16_t> block) noexcept {
+        for (auto& x : block) {
+            const int64_t scaled = int64_t{x} << frac_bits;
+            if (!_primed) {
+                _dc = scaled;
+                _primed = true;
+            }
+            _dc += (scaled - _dc) >> _shift;
+            x = detail::saturate(x - ((_dc + (int64_t{1} << (frac_bits - 1))) >> frac_bits));
+        }
+        return block;
+    }
+
+    /** @brief Forgets the DC estimate; the next sample restarts it. */
+    constexpr void reset() noexcept {
+        _dc = 0;
+        _primed = false;
+    }
+
+    /** @brief Returns the current DC estimate, rounded to the nearest sample value. */
+    [[nodiscard]] constexpr int16_t offset() const noexcept {
+        return detail::saturate((_dc + (int64_t{1} << (frac_bits - 1))) >> frac_bits);
+    }
+
+private:
+    // Fractional bits kept by the estimate so slow drift is not lost to truncation.
+    static constexpr int frac_bits = 16;
+
+    uint8_t _shift;
+    bool _primed = false;
+    int64_t _dc = 0;
+};
+
+/**
+ * @headerfile <idfxx/dsp/pipeline>
+ * @brief Summary of one window of samples.
+ */
+struct statistics {
+    int16_t min = 0;    ///< Smallest sample
+    int16_t max = 0;    ///< Largest sample
+    int16_t mean = 0;   ///< Mean, rounded to nearest
+    uint16_t rms = 0;   ///< Root mean square, rounded down
+    uint32_t count = 0; ///< Samples in the window
+};
+
+/**
+ * @headerfile <idfxx/dsp/pipeline>
+ * @brief Reports min, max, mean, and RMS over consecutive windows.
+ *
+ * Passes samples through unchanged, so it can sit at any point in a
+ * @ref pipeline; each time `window` samples have passed it calls the
+ * callback with their @ref statistics and starts the next window.
+ */
+class window_stats {
+public:
+    /** @brief Receives each completed window's statistics. */
+    using callback_type = std::move_only_function<void(const statistics&)>;
+
+    /**
+     * @brief Constructs a statistics stage.
+     * @param window   Samples per window (at least 1).
+     * @param callback Called with each window's statistics, from @ref process.
+     */
+    window_stats(uint32_t window, callback_type callback)
+        : _window(std::max<uint32_t>(window, 1))
+        , _callback(std::move(callback)) {}
+
+    /**
+     * @brief Accumulates a block, reporting every window it completes.
+     * @param block Input samples; left unchanged.
+     * @return `block`.
+     */
+    std::span<int16_t> process(std::span<int16_t> block) {
+        for (int16_t x : block) {
+            _min = std::min(_min, x);
+            _max = std::max(_max, x);
+            _sum += x;
+            _sum_squares += static_cast<uint64_t>(int64_t{x} * x);
+            if (++_count < _window) {
+                continue;
+            }
+            const int64_t n = _count;
+            statistics s{
+                .min = _min,
+                .max = _max,
+                .mean = static_cast<int16_t>(_sum >= 0 ? (_sum + n / 2) / n : -((-_sum + n / 2) / n)),
+                .rms = static_cast<uint16_t>(std::min<uint32_t>(detail::isqrt(_sum_squares / _count), 65535)),
+                .count = _count,
+            };
+            reset();
+            if (_callback) {
+                _callback(s);
+            }
+        }
+        return block;
+    }
+
+    /** @brief Discards the partially accumulated window. */
+    void reset() noexcept {
+        _min = std::numeric_limits<int16_t>::max();
+        _max = std::numeric_limits<int16_t>::min();
+        _sum = 0;
+        _sum_squares = 0;
+        _count = 0;
+    }
+
+private:
+    uint32_t _window;
+    callback_type _callback;
+    int16_t _min = std::numeric_limits<int16_t>::max();
+    int16_t _max = std::numeric_limits<int16_t>::min();
+    int64_t _sum = 0;
+    uint64_t _sum_squares = 0;
+    uint32_t _count = 0;
+};
+
+/**
+ * @headerfile <idfxx/dsp/pipeline>
+ * @brief A crossing of a @ref threshold_detector's thresholds.
+ */
+struct threshold_event {
+    /** @brief Direction of the crossing. */
+    enum class kind : uint8_t {
+        rising,  ///< The signal reached the high threshold
+        falling, ///< The signal fell to the low threshold
+    };
+
+    kind type = kind::rising; ///< Event type
+    int16_t value = 0;        ///< The sample that crossed
+    uint64_t sample = 0;      ///< Index of that sample among all the stage has seen since reset
+};
+
+/**
+ * @headerfile <idfxx/dsp/pipeline>
+ * @brief Reports threshold crossings with hysteresis.
+ *
+ * Passes samples through unchanged. Starting low, it reports a rising event
+ * when a sample reaches `high`, then a falling event when one drops to
+ * `low`, and so on; the gap between the two thresholds keeps a noisy signal
+ * near one of them from producing a burst of events.
+ */
+class threshold_detector {
+public:
+    /** @brief Receives each crossing. */
+    using callback_type = std::move_only_function<void(const threshold_event&)>;
+
+    /**
+     * @brief Constructs a detector in the low state.
+     * @param high     Level at or above which a rising event is reported.
+     * @param low      Level at or below which a falling event is reported;
+     *                 values above `high` are treated as `high`.
+     * @param callback Called with each crossing, from @ref process.
+     */
+    threshold_detector(int16_t high, int16_t low, callback_type callback)
+        : _high(high)
+        , _low(std::min(low, high))
+        , _callback(std::move(callback)) {}
+
+    /**
+     * @brief Scans a block for crossings.
+     * @param block Input samples; left unchanged.
+     * @return `block`.
+     */
+    std::span<int16_t> process(std::span<int16_t> block) {
+        for (int16_t x : block) {
+            const uint64_t index = _seen++;
+            if (!_above && x >= _high) {
+                _above = true;
+                _emit({threshold_event::kind::rising, x, index});
+            } else if (_above && x <= _low) {
+                _above = false;
+                _emit({threshold_event::kind::falling, x, index});
+            }
+        }
+        return block;
+    }
+
+    /** @brief Returns to the low state and restarts the sample count. */
+    void reset() noexcept {
+        _above = false;
+        _seen = 0;
+    }
+
+    /** @brief Returns true between a rising event and the next falling one. */
+    [[nodiscard]] bool above() const noexcept { return _above; }
+
+private:
+    void _emit(const threshold_event& ev) {
+        if (_callback) {
+            _callback(ev);
+        }
+    }
+
+    int16_t _high;
+    int16_t _low;
+    callback_type _callback;
+    bool _above = false;
+    uint64_t _seen = 0;
+};
+
+/**
+ * @headerfile <idfxx/dsp/pipeline>
+ * @brief A chain of stages applied in order.
+ *
+ * Each call passes the block through every stage, handing each the previous
+ * stage's output, and returns the last stage's output — a prefix of the
+ * input block. Stages are held by value; reach one with @ref get.
+ *
+ * For several channels, keep one pipeline per channel: the stages' state is
+ * per signal.
+ *
+ * @tparam Stages The stage types, in processing order.
+ */
+template<stage... Stages>
+class pipeline {
+public:
+    /**
+     * @brief Constructs a pipeline from its stages.
+     * @param stages The stages, in processing order.
+     */
+    explicit pipeline(Stages... stages)
+        : _stages(std::move(stages)...) {}
+
+    /**
+     * @brief Runs a block through every stage in place.
+     * @param block Input samples; overwritten with intermediate and final output.
+     * @return The prefix of `block` holding the final output.
+     */
+    std::span<int16_t> process(std::span<int16_t> block) {
+        std::apply([&block](auto&... s) { ((block = s.process(block)), ...); }, _stages);
+        return block;
+    }
+
+    /** @brief Resets every stage. */
+    void reset() {
+        std::apply([](auto&... s) { (s.reset(), ...); }, _stages);
+    }
+
+    /**
+     * @brief Returns a stage.
+     * @tparam I Index of the stage, in processing order.
+     * @return A reference to the stage.
+     */
+    template<size_t I>
+    [[nodiscard]] auto& get() noexcept {
+        return std::get<I>(_stages);
+    }
+
+    /**
+     * @brief Returns a stage.
+     * @tparam I Index of the stage, in processing order.
+     * @return A reference to the stage.
+     */
+    template<size_t I>
+    [[nodiscard]] const auto& get() const noexcept {
+        return std::get<I>(_stages);
+    }
+
+private:
+    std::tuple<Stages...> _stages;
+};
+
+/** @} */ // end of idfxx_dsp
+
+} // namespace idfxx::dsp
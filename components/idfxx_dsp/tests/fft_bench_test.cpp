@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+// FFT benchmarks for idfxx::dsp
+// Each case logs cycles per transform and the sample rate one core could keep
+// up with; run a single case from the Unity menu, or the whole set with the
+// [bench] tag. The cases also run in the default suite under QEMU, where the
+// cycle counts say nothing about real timing; take timings from a device.
+
+#include "idfxx/dsp/fft"
+#include "idfxx/log"
+#include "unity.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <esp_cpu.h>
+#include <span>
+#include <string_view>
+
+using namespace idfxx::dsp;
+
+namespace {
+
+constexpr const char* TAG = "dsp_bench";
+
+// Runs op() `iterations` times and logs the cost of one run, and the highest
+// sample rate sustainable if each run consumes `samples` samples.
+template<typename Op>
+void bench(std::string_view name, size_t iterations, size_t samples, Op&& op) {
+    op(); // warm caches
+    uint64_t cycles = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        // Per-run deltas: the 32-bit cycle counter wraps within seconds.
+        const uint32_t before = esp_cpu_get_cycle_count();
+        op();
+        cycles += esp_cpu_get_cycle_count() - before;
+    }
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const double samples_per_second = elapsed > 0 ? static_cast<double>(samples * iterations) / elapsed : 0;
+    idfxx::log::info(
+        TAG,
+        "{:<40} {:>10} cycles/op {:>8.2f} cycles/sample {:>10.0f} samples/s",
+        name,
+        cycles / iterations,
+        static_cast<double>(cycles) / static_cast<double>(samples * iterations),
+        samples_per_second
+    );
+}
+
+template<size_t N>
+void bench_spectrum(std::string_view name, size_t iterations) {
+    static constexpr auto hann = make_window<N>(window::hann);
+    static std::array<int16_t, N> samples;
+    static std::array<complex16, N> bins;
+    static std::array<uint16_t, N / 2 + 1> magnitudes;
+    for (size_t i = 0; i < N; ++i) {
+        samples[i] = static_cast<int16_t>((i * 2654435761u) >> 20); // 12-bit noise
+    }
+    bench(name, iterations, N, [&] {
+        fft<N>::load(samples, hann, bins, 3);
+        fft<N>::transform(bins);
+        magnitude(std::span(bins).first(N / 2 + 1), magnitudes);
+    });
+}
+
+} // namespace
+
+TEST_CASE("dsp bench fft transform", "[idfxx][dsp][bench]") {
+    static std::array<complex16, 1024> bins{};
+    bench("fft<64> transform", 200, 64, [] { fft<64>::transform(std::span(bins).first<64>()); });
+    bench("fft<256> transform", 100, 256, [] { fft<256>::transform(std::span(bins).first<256>()); });
+    bench("fft<512> transform", 50, 512, [] { fft<512>::transform(std::span(bins).first<512>()); });
+    bench("fft<1024> transform", 50, 1024, [] { fft<1024>::transform(bins); });
+    TEST_ASSERT_EQUAL(0, bins[0].re);
+}
+
+TEST_CASE("dsp bench fft spectrum", "[idfxx][dsp][bench]") {
+    bench_spectrum<256>("fft<256> hann + transform + magnitude", 100);
+    bench_spectrum<1024>("fft<1024> hann + transform + magnitude", 50);
+}
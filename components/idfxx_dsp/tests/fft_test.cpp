@@ -0,0 +1,187 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+// Unit tests for idfxx::dsp FFT, windows and spectrum helpers
+// Uses ESP-IDF Unity test framework with compile-time static_asserts
+
+#include "idfxx/dsp/fft"
+#include "unity.h"
+
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <numbers>
+#include <span>
+#include <vector>
+
+using namespace idfxx::dsp;
+
+// =============================================================================
+// Compile-time tests (static_assert)
+// These verify correctness at compile time - if this file compiles, they pass.
+// =============================================================================
+
+// Twiddles are e^(-2πi·m/N), clamped to the Q15 range
+static_assert(fft<16>::twiddles.size() == 12);
+static_assert(fft<16>::twiddles[0] == complex16{32767, 0});
+static_assert(fft<16>::twiddles[4] == complex16{0, -32767});
+static_assert(fft<16>::twiddles[8] == complex16{-32767, 0});
+static_assert(fft<16>::twiddles[2] == complex16{23170, -23170});
+static_assert(fft<1024>::twiddles[128] == complex16{23170, -23170});
+
+// Windows start at zero (except rectangular) and are symmetric about N/2
+static_assert(make_window<8>(window::rectangular)[3] == 32767);
+static_assert(make_window<8>(window::hann)[0] == 0);
+static_assert(make_window<8>(window::hann)[4] == 32767);
+static_assert(make_window<8>(window::hann)[2] == 16384);
+static_assert(make_window<8>(window::hamming)[0] == 2621);
+static_assert(make_window<64>(window::blackman)[16] == make_window<64>(window::blackman)[48]);
+
+// An impulse transforms to a flat spectrum of 1/N, at compile time
+static_assert([] {
+    std::array<complex16, 16> x{};
+    x[0] = {16000, 0};
+    fft<16>::transform(x);
+    for (auto v : x) {
+        if (v != complex16{1000, 0}) {
+            return false;
+        }
+    }
+    return true;
+}());
+
+// A constant lands entirely in bin 0, for both radix-4 and mixed sizes
+static_assert([] {
+    std::array<complex16, 32> x{};
+    x.fill({-4096, 2048});
+    fft<32>::transform(x);
+    for (size_t k = 1; k < x.size(); ++k) {
+        if (x[k] != complex16{}) {
+            return false;
+        }
+    }
+    return x[0] == complex16{-4096, 2048};
+}());
+
+// Bin helpers
+static_assert(fft<1024>::bin(50, 1000) == 51);
+static_assert(fft<1024>::bin(2000, 1000) == 1023);
+static_assert(fft<1024>::bin_frequency(512, 1024) == 512);
+static_assert(power({3, -4}) == 25);
+static_assert(power({-32768, -32768}) == 2147483648u);
+
+// =============================================================================
+// Runtime tests (Unity TEST_CASE)
+// =============================================================================
+
+namespace {
+
+// Transforms x in place and checks it against a double-precision DFT / N.
+template<size_t N>
+int max_error(std::array<complex16, N>& x) {
+    std::vector<std::complex<double>> expected(N);
+    for (size_t k = 0; k < N; ++k) {
+        for (size_t n = 0; n < N; ++n) {
+            const double angle = -2 * std::numbers::pi * static_cast<double>(k * n % N) / N;
+            expected[k] += std::complex<double>(x[n].re, x[n].im) * std::polar(1.0, angle);
+        }
+        expected[k] /= N;
+    }
+    fft<N>::transform(x);
+    double worst = 0;
+    for (size_t k = 0; k < N; ++k) {
+        worst = std::max(worst, std::abs(std::complex<double>(x[k].re, x[k].im) - expected[k]));
+    }
+    return static_cast<int>(std::ceil(worst));
+}
+
+template<size_t N>
+std::array<complex16, N> noise(uint32_t seed) {
+    std::array<complex16, N> x;
+    for (auto& v : x) {
+        seed = seed * 1664525 + 1013904223;
+        v.re = static_cast<int16_t>(seed >> 17) - 16384;
+        seed = seed * 1664525 + 1013904223;
+        v.im = static_cast<int16_t>(seed >> 17) - 16384;
+    }
+    return x;
+}
+
+template<size_t N>
+std::array<int16_t, N> tone(double cycles, double amplitude) {
+    std::array<int16_t, N> x;
+    for (size_t i = 0; i < N; ++i) {
+        x[i] = static_cast<int16_t>(std::lround(amplitude * std::sin(2 * std::numbers::pi * cycles * i / N)));
+    }
+    return x;
+}
+
+} // namespace
+
+TEST_CASE("fft matches a reference DFT", "[idfxx][dsp]") {
+    auto a = noise<64>(1);
+    TEST_ASSERT_LESS_THAN(4, max_error(a));
+    auto b = noise<128>(2);
+    TEST_ASSERT_LESS_THAN(4, max_error(b));
+    auto c = noise<1024>(3);
+    TEST_ASSERT_LESS_THAN(6, max_error(c));
+}
+
+TEST_CASE("fft puts a tone in its bin and its mirror", "[idfxx][dsp]") {
+    constexpr size_t N = 256;
+    std::array<complex16, N> x;
+    fft<N>::load(tone<N>(20, 30000), x);
+    fft<N>::transform(x);
+
+    std::array<uint16_t, N> m;
+    TEST_ASSERT_EQUAL(N, magnitude(x, m));
+    TEST_ASSERT_INT_WITHIN(4, 15000, m[20]);
+    TEST_ASSERT_INT_WITHIN(4, 15000, m[N - 20]);
+    for (size_t k = 0; k < N; ++k) {
+        if (k != 20 && k != N - 20) {
+            TEST_ASSERT_LESS_THAN(4, m[k]);
+        }
+    }
+}
+
+TEST_CASE("fft load scales, windows and zero-pads", "[idfxx][dsp]") {
+    std::array<complex16, 8> x;
+    x.fill({1, 1});
+    std::array<int16_t, 3> samples{100, -100, 4095};
+    fft<8>::load(samples, x, 3);
+    TEST_ASSERT_TRUE((x == std::array<complex16, 8>{{{800, 0}, {-800, 0}, {32760, 0}}}));
+
+    constexpr auto hann = make_window<8>(window::hann);
+    fft<8>::load(samples, hann, x, 3);
+    TEST_ASSERT_EQUAL(0, x[0].re);
+    TEST_ASSERT_EQUAL(-117, x[1].re);
+    TEST_ASSERT_EQUAL(16380, x[2].re);
+    TEST_ASSERT_EQUAL(0, x[3].re);
+}
+
+TEST_CASE("a window reduces leakage from an off-bin tone", "[idfxx][dsp]") {
+    constexpr size_t N = 256;
+    const auto signal = tone<N>(20.5, 30000);
+    auto far_leakage = [&](std::span<const int16_t, N> coefficients) {
+        std::array<complex16, N> x;
+        fft<N>::load(signal, coefficients, x);
+        fft<N>::transform(x);
+        return band_power(x, 25, N / 2);
+    };
+    constexpr auto rectangular = make_window<N>(window::rectangular);
+    constexpr auto hann = make_window<N>(window::hann);
+    constexpr auto blackman = make_window<N>(window::blackman);
+    const uint64_t r = far_leakage(rectangular);
+    const uint64_t h = far_leakage(hann);
+    const uint64_t b = far_leakage(blackman);
+    TEST_ASSERT_TRUE(h * 100 < r);
+    TEST_ASSERT_TRUE(b * 4 < h);
+}
+
+TEST_CASE("band_power sums a band and clamps its end", "[idfxx][dsp]") {
+    std::array<complex16, 4> x{{{3, 4}, {1, 0}, {0, -2}, {10, 0}}};
+    TEST_ASSERT_EQUAL(25 + 1 + 4, band_power(x, 0, 3));
+    TEST_ASSERT_EQUAL(104, band_power(x, 2, 100));
+    TEST_ASSERT_EQUAL(0, band_power(x, 3, 3));
+}
@@ -0,0 +1,225 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+// Unit tests for idfxx::dsp pipeline stages
+// Uses ESP-IDF Unity test framework with compile-time static_asserts
+
+#include "idfxx/dsp/pipeline"
+#include "unity.h"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <span>
+#include <vector>
+
+using namespace idfxx::dsp;
+
+// =============================================================================
+// Compile-time tests (static_assert)
+// These verify correctness at compile time - if this file compiles, they pass.
+// =============================================================================
+
+// Every stage satisfies the stage concept
+static_assert(stage<cic_decimator<3>>);
+static_assert(stage<fir<8>>);
+static_assert(stage<biquad>);
+static_assert(stage<dc_blocker>);
+static_assert(stage<window_stats>);
+static_assert(stage<threshold_detector>);
+
+// CIC gain must fit in 16 bits
+static_assert(cic_decimator<1>::valid(32768));
+static_assert(cic_decimator<3>::valid(32));
+static_assert(!cic_decimator<3>::valid(33));
+static_assert(!cic_decimator<2>::valid(0));
+
+// FIR taps must sum to at most 1.0 in magnitude
+static_assert(fir<2>::valid({16384, 16384}));
+static_assert(!fir<2>::valid({16384, -16385}));
+
+// A boxcar decimator averages each group of samples, carrying partial groups over
+static_assert([] {
+    boxcar_decimator d(4);
+    std::array<int16_t, 6> a{1, 2, 3, 4, 10, 10};
+    auto out = d.process(a);
+    std::array<int16_t, 2> b{10, 10};
+    auto out2 = d.process(b);
+    return out.size() == 1 && out[0] == 3 && out2.size() == 1 && out2[0] == 10;
+}());
+
+// A constant passes through a higher-order CIC unchanged once it has settled
+static_assert([] {
+    cic_decimator<3> d(8);
+    std::array<int16_t, 64> a{};
+    a.fill(-1234);
+    auto out = d.process(a);
+    return out.size() == 8 && out[7] == -1234;
+}());
+
+// An FIR filter's impulse response is its taps
+static_assert([] {
+    fir<3> f({8192, 16384, -8192});
+    std::array<int16_t, 4> a{32767, 0, 0, 0};
+    f.process(a);
+    return a[0] == 8192 && a[1] == 16384 && a[2] == -8192 && a[3] == 0;
+}());
+
+// =============================================================================
+// Runtime tests (Unity TEST_CASE)
+// =============================================================================
+
+namespace {
+
+std::vector<int16_t> tone(size_t n, double cycles_per_sample, double amplitude, int16_t offset = 0) {
+    std::vector<int16_t> v(n);
+    for (size_t i = 0; i < n; ++i) {
+        const double phase = 2 * std::numbers::pi * cycles_per_sample * static_cast<double>(i);
+        v[i] = static_cast<int16_t>(offset + std::lround(amplitude * std::sin(phase)));
+    }
+    return v;
+}
+
+// Peak absolute value over the second half, after transients.
+int peak(std::span<const int16_t> v) {
+    int p = 0;
+    for (size_t i = v.size() / 2; i < v.size(); ++i) {
+        p = std::max(p, std::abs(int{v[i]}));
+    }
+    return p;
+}
+
+} // namespace
+
+TEST_CASE("cic_decimator output does not depend on block boundaries", "[idfxx][dsp]") {
+    auto signal = tone(480, 0.01, 8000, 2000);
+
+    cic_decimator<3> whole(16);
+    auto a = signal;
+    auto expected = whole.process(a);
+
+    cic_decimator<3> split(16);
+    auto b = signal;
+    std::vector<int16_t> got;
+    for (size_t i = 0; i < b.size(); i += 37) {
+        auto out = split.process(std::span(b).subspan(i, std::min<size_t>(37, b.size() - i)));
+        got.insert(got.end(), out.begin(), out.end());
+    }
+    TEST_ASSERT_EQUAL(30, expected.size());
+    TEST_ASSERT_EQUAL(expected.size(), got.size());
+    TEST_ASSERT_EQUAL_INT16_ARRAY(expected.data(), got.data(), got.size());
+}
+
+TEST_CASE("biquad lowpass passes low tones and attenuates high ones", "[idfxx][dsp]") {
+    auto c = biquad::lowpass(0.05);
+    TEST_ASSERT_TRUE(c.has_value());
+    TEST_ASSERT_FALSE(biquad::lowpass(0.5).has_value());
+    TEST_ASSERT_FALSE(biquad::lowpass(0.1, 0).has_value());
+
+    biquad low(*c);
+    auto pass = tone(2000, 0.005, 10000);
+    low.process(pass);
+    TEST_ASSERT_INT_WITHIN(500, 10000, peak(pass));
+
+    biquad high(*c);
+    auto stop = tone(2000, 0.25, 10000);
+    high.process(stop);
+    TEST_ASSERT_LESS_THAN(400, peak(stop));
+}
+
+TEST_CASE("biquad rejects cutoffs Q14 cannot represent", "[idfxx][dsp]") {
+    // Rounding zeroes b0, or leaves the DC gain far from unity
+    TEST_ASSERT_FALSE(biquad::lowpass(0.001).has_value());
+    TEST_ASSERT_FALSE(biquad::lowpass(0.002).has_value());
+    TEST_ASSERT_TRUE(biquad::lowpass(0.01).has_value());
+    TEST_ASSERT_TRUE(biquad::highpass(0.001).has_value());
+    TEST_ASSERT_TRUE(biquad::highpass(0.49).has_value());
+
+    // An accepted design holds a constant at its level
+    biquad f(*biquad::lowpass(0.01));
+    std::vector<int16_t> v(4000, 3000);
+    f.process(v);
+    TEST_ASSERT_INT_WITHIN(150, 3000, v.back());
+}
+
+TEST_CASE("biquad highpass removes a constant", "[idfxx][dsp]") {
+    biquad f(*biquad::highpass(0.02));
+    std::vector<int16_t> v(1000, 3000);
+    f.process(v);
+    TEST_ASSERT_INT_WITHIN(2, 0, v.back());
+}
+
+TEST_CASE("dc_blocker removes a bias and keeps the signal", "[idfxx][dsp]") {
+    dc_blocker blocker(10);
+    auto v = tone(4000, 0.02, 1000, 2048);
+    blocker.process(v);
+    TEST_ASSERT_INT_WITHIN(20, 2048, blocker.offset());
+    TEST_ASSERT_INT_WITHIN(60, 1000, peak(v));
+
+    int64_t sum = 0;
+    for (size_t i = 2000; i < 4000; ++i) {
+        sum += v[i];
+    }
+    TEST_ASSERT_INT_WITHIN(10, 0, static_cast<int>(sum / 2000));
+}
+
+TEST_CASE("window_stats reports each complete window", "[idfxx][dsp]") {
+    std::vector<statistics> reports;
+    window_stats stats(4, [&](const statistics& s) { reports.push_back(s); });
+
+    std::array<int16_t, 6> a{3, -4, 3, -4, 100, 100};
+    auto out = stats.process(a);
+    TEST_ASSERT_EQUAL(6, out.size());
+    TEST_ASSERT_EQUAL(100, a[5]);
+    TEST_ASSERT_EQUAL(1, reports.size());
+    TEST_ASSERT_EQUAL(-4, reports[0].min);
+    TEST_ASSERT_EQUAL(3, reports[0].max);
+    TEST_ASSERT_EQUAL(-1, reports[0].mean); // -0.5, rounded away from zero
+    TEST_ASSERT_EQUAL(3, reports[0].rms);
+    TEST_ASSERT_EQUAL(4, reports[0].count);
+
+    std::array<int16_t, 2> b{100, 100};
+    stats.process(b);
+    TEST_ASSERT_EQUAL(2, reports.size());
+    TEST_ASSERT_EQUAL(100, reports[1].mean);
+    TEST_ASSERT_EQUAL(100, reports[1].rms);
+}
+
+TEST_CASE("threshold_detector reports crossings with hysteresis", "[idfxx][dsp]") {
+    std::vector<threshold_event> events;
+    threshold_detector detector(100, 50, [&](const threshold_event& ev) { events.push_back(ev); });
+
+    std::array<int16_t, 8> a{0, 120, 90, 110, 60, 40, 80, 100};
+    detector.process(a);
+    TEST_ASSERT_EQUAL(3, events.size());
+    TEST_ASSERT_TRUE(events[0].type == threshold_event::kind::rising);
+    TEST_ASSERT_EQUAL(1, events[0].sample);
+    TEST_ASSERT_EQUAL(120, events[0].value);
+    TEST_ASSERT_TRUE(events[1].type == threshold_event::kind::falling);
+    TEST_ASSERT_EQUAL(5, events[1].sample);
+    TEST_ASSERT_TRUE(events[2].type == threshold_event::kind::rising);
+    TEST_ASSERT_EQUAL(7, events[2].sample);
+    TEST_ASSERT_TRUE(detector.above());
+}
+
+TEST_CASE("pipeline chains stages and returns the decimated prefix", "[idfxx][dsp]") {
+    std::vector<statistics> reports;
+    pipeline chain{
+        dc_blocker{12},
+        cic_decimator<2>{10},
+        biquad{*biquad::lowpass(0.2)},
+        window_stats{50, [&](const statistics& s) { reports.push_back(s); }},
+    };
+
+    auto v = tone(2000, 0.002, 4000, 2048);
+    auto out = chain.process(v);
+    TEST_ASSERT_EQUAL(200, out.size());
+    TEST_ASSERT_TRUE(out.data() == v.data());
+    TEST_ASSERT_EQUAL(4, reports.size());
+    // A 4000-amplitude sine has an RMS of about 2828.
+    TEST_ASSERT_INT_WITHIN(150, 2828, reports.back().rms);
+
+    chain.reset();
+    TEST_ASSERT_EQUAL(0, chain.get<0>().offset());
+}
@@ -9,7 +9,7 @@
  * @brief Drawing primitives for pixel surfaces.
  *
  * @defgroup idfxx_gfx Graphics Component
- * @brief Rectangles, lines, and text drawing on any pixel surface.
+ * @brief Rectangles, lines, text, and image drawing on any pixel surface.
  *
  * Provides integer drawing primitives over the @ref idfxx::gfx::pixel_surface
  * concept: any type with `set_pixel(x, y, pixel)` and reported dimensions can
@@ -18,6 +18,11 @@
  * functions render "ink only": they write the requested pixels and leave
  * everything else untouched, so drawing composes over existing content.
  *
+ * Surfaces may also provide bulk hooks — @ref idfxx::gfx::span_fillable,
+ * @ref idfxx::gfx::block_fillable, and @ref idfxx::gfx::blittable — which the
+ * primitives detect and route through instead of writing pixel by pixel.
+ * Both idfxx framebuffers implement them.
+ *
  * The primitives are available two ways: as members of @ref
  * idfxx::gfx::canvas, a lightweight view bundling a surface with the drawing
  * operations, and as free functions taking the surface as their first
@@ -37,14 +42,23 @@
 
 #include <idfxx/error.hpp>
 #include <idfxx/font.hpp>
+#include <idfxx/future.hpp>
 
 #include <algorithm>
+#include <array>
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
 #include <string_view>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 /**
  * @headerfile <idfxx/gfx>
@@ -75,6 +89,55 @@ concept pixel_surface = requires(S& s, const S& cs, size_t x, size_t y, typename
     { cs.height() } -> std::convertible_to<size_t>;
 };
 
+/**
+ * @headerfile <idfxx/gfx>
+ * @brief A pixel surface that can fill a horizontal run of pixels in one call.
+ *
+ * `fill_span(x, y, length, pixel)` sets @p length pixels starting at
+ * (x, y) and extending to the right. The drawing functions only call it
+ * with a non-empty run lying entirely within the surface.
+ *
+ * @tparam S The surface type.
+ */
+template<typename S>
+concept span_fillable =
+    pixel_surface<S> && requires(S& s, size_t x, size_t y, size_t length, typename S::pixel_type pixel) {
+        { s.fill_span(x, y, length, pixel) } noexcept;
+    };
+
+/**
+ * @headerfile <idfxx/gfx>
+ * @brief A pixel surface that can fill a rectangle of pixels in one call.
+ *
+ * `fill_block(x, y, width, height, pixel)` sets every pixel of the
+ * rectangle whose top-left corner is (x, y). The drawing functions only
+ * call it with a non-empty rectangle lying entirely within the surface.
+ *
+ * @tparam S The surface type.
+ */
+template<typename S>
+concept block_fillable =
+    pixel_surface<S> && requires(S& s, size_t x, size_t y, size_t width, size_t height, typename S::pixel_type pixel) {
+        { s.fill_block(x, y, width, height, pixel) } noexcept;
+    };
+
+/**
+ * @headerfile <idfxx/gfx>
+ * @brief A pixel surface that can copy a rectangle of pixels in one call.
+ *
+ * `blit(x, y, width, height, pixels, stride)` copies a rectangle of
+ * pixel values to the surface with its top-left corner at (x, y). Source
+ * row `r` starts at `pixels + r * stride`. The drawing functions only call
+ * it with a non-empty rectangle lying entirely within the surface.
+ *
+ * @tparam S The surface type.
+ */
+template<typename S>
+concept blittable = pixel_surface<S> &&
+    requires(S& s, size_t x, size_t y, size_t width, size_t height, const typename S::pixel_type* pixels) {
+        { s.blit(x, y, width, height, pixels, width) } noexcept;
+    };
+
 /**
  * @brief Fills a rectangle with the given ink.
  *
@@ -104,11 +167,69 @@ void fill_rect(
     if (x >= surface_width || y >= surface_height) {
         return;
     }
-    const size_t x_end = x + std::min(width, surface_width - x);
-    const size_t y_end = y + std::min(height, surface_height - y);
-    for (size_t py = y; py < y_end; ++py) {
-        for (size_t px = x; px < x_end; ++px) {
-            surface.set_pixel(px, py, ink);
+    width = std::min(width, surface_width - x);
+    height = std::min(height, surface_height - y);
+    if (width == 0 || height == 0) {
+        return;
+    }
+    if constexpr (block_fillable<Surface>) {
+        surface.fill_block(x, y, width, height, ink);
+    } else if constexpr (span_fillable<Surface>) {
+        for (size_t py = y; py < y + height; ++py) {
+            surface.fill_span(x, py, width, ink);
+        }
+    } else {
+        for (size_t py = y; py < y + height; ++py) {
+            for (size_t px = x; px < x + width; ++px) {
+                surface.set_pixel(px, py, ink);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Copies a rectangle of pixel values to the surface.
+ *
+ * The rectangle's top-left corner lands at (@p x, @p y) and it spans
+ * @p width columns and @p height rows. Source row `r` starts at
+ * `pixels + r * stride`. Any part falling outside the surface is clipped.
+ *
+ * @tparam Surface The surface type (satisfies @ref pixel_surface).
+ * @param surface The surface to draw on.
+ * @param x       Left edge of the destination, in pixels.
+ * @param y       Top edge of the destination, in pixels.
+ * @param width   Width of the rectangle, in pixels.
+ * @param height  Height of the rectangle, in pixels.
+ * @param pixels  The source pixels, row-major.
+ * @param stride  Distance between the starts of successive source rows, in pixels.
+ */
+template<pixel_surface Surface>
+void blit(
+    Surface& surface,
+    size_t x,
+    size_t y,
+    size_t width,
+    size_t height,
+    const typename Surface::pixel_type* pixels,
+    size_t stride
+) noexcept {
+    const size_t surface_width = surface.width();
+    const size_t surface_height = surface.height();
+    if (x >= surface_width || y >= surface_height) {
+        return;
+    }
+    width = std::min(width, surface_width - x);
+    height = std::min(height, surface_height - y);
+    if (width == 0 || height == 0) {
+        return;
+    }
+    if constexpr (blittable<Surface>) {
+        surface.blit(x, y, width, height, pixels, stride);
+    } else {
+        for (size_t row = 0; row < height; ++row, pixels += stride) {
+            for (size_t col = 0; col < width; ++col) {
+                surface.set_pixel(x + col, y + row, pixels[col]);
+            }
         }
     }
 }
@@ -212,6 +333,14 @@ void draw_line(
     if (std::min(x0, x1) >= surface.width() || std::min(y0, y1) >= surface.height()) {
         return; // the endpoints' bounding box lies entirely off the surface
     }
+    if (y0 == y1) {
+        fill_rect(surface, std::min(x0, x1), y0, (x0 < x1 ? x1 - x0 : x0 - x1) + 1, 1, ink);
+        return;
+    }
+    if (x0 == x1) {
+        fill_rect(surface, x0, std::min(y0, y1), 1, (y0 < y1 ? y1 - y0 : y0 - y1) + 1, ink);
+        return;
+    }
     // Bresenham's algorithm; the walk stays within the endpoints' bounding
     // box, so intermediate coordinates never go negative.
     ptrdiff_t px = static_cast<ptrdiff_t>(x0);
@@ -249,7 +378,9 @@ void draw_line(
  * content (on a monochrome surface, pass `ink = false` to erase ink pixels
  * instead, e.g. for inverse text on a filled banner). Characters outside
  * the font's range advance the cursor without drawing. Pixels falling
- * outside the surface are clipped.
+ * outside the surface are clipped. Each horizontal run of ink in a glyph
+ * row is drawn as one @ref fill_rect, so surfaces with bulk hooks fill
+ * runs rather than single pixels.
  *
  * @tparam Surface The surface type (satisfies @ref pixel_surface).
  * @param surface The surface to draw on.
@@ -289,19 +420,29 @@ void draw_text(
             for (size_t row = 0; row < font.height; ++row) {
                 const uint8_t* row_bits = glyph + row * bpr;
                 uint8_t bits = 0;
-                for (size_t col = 0; col < font.width; ++col, bits <<= 1) {
-                    if (col % 8 == 0) {
+                size_t run_start = 0;
+                size_t run_length = 0;
+                // One column past the glyph flushes a run reaching its right edge.
+                for (size_t col = 0; col <= font.width; ++col, bits <<= 1) {
+                    if (col % 8 == 0 && col < font.width) {
                         bits = row_bits[col / 8];
                     }
-                    if (!(bits & 0x80u)) {
+                    if (col < font.width && (bits & 0x80u)) {
+                        if (run_length++ == 0) {
+                            run_start = col;
+                        }
                         continue;
                     }
-                    const size_t px = cell_x + col * scale;
-                    const size_t py = y + row * scale;
-                    for (unsigned sy = 0; sy < scale; ++sy) {
-                        for (unsigned sx = 0; sx < scale; ++sx) {
-                            surface.set_pixel(px + sx, py + sy, ink);
-                        }
+                    if (run_length > 0) {
+                        fill_rect(
+                            surface,
+                            cell_x + run_start * scale,
+                            y + row * scale,
+                            run_length * scale,
+                            scale,
+                            ink
+                        );
+                        run_length = 0;
                     }
                 }
             }
@@ -330,6 +471,512 @@ void draw_text(Surface& surface, const font::mono_font& font, size_t x, size_t y
     draw_text(surface, font, x, y, text, true);
 }
 
+/**
+ * @headerfile <idfxx/gfx>
+ * @brief A cache of glyphs expanded to whole cells of surface pixels.
+ *
+ * Rendering text glyph by glyph decodes each 1-bpp font row and scales it
+ * up on every draw. For opaque text — glyph ink over a solid background —
+ * a glyph cache instead keeps each glyph as a ready-made tile of
+ * `font.width * scale` x `font.height * scale` pixels in the surface's
+ * pixel format, so drawing a character is a single @ref blit (a memcpy per
+ * tile row on `idfxx::lcd::rgb565_framebuffer`). Use it through the opaque
+ * @ref draw_text overloads.
+ *
+ * Tiles are keyed by font, character, scale, ink, and background. The
+ * cache is direct-mapped: each key hashes to one of @ref capacity slots,
+ * and a miss overwrites whatever the slot held, so lookups are constant
+ * time. Size the capacity to comfortably exceed the distinct characters
+ * (per font, scale, and color pair) on screen. Each slot's tile storage is
+ * allocated on first use and reused afterwards.
+ *
+ * @code
+ * idfxx::gfx::glyph_cache<idfxx::lcd::rgb565> glyphs(64);
+ * canvas.draw_text(glyphs, idfxx::font::spleen_8x16, 8, 8, "23.7", white, navy, 2);
+ * @endcode
+ *
+ * @tparam Pixel The pixel type of the surfaces drawn on; trivially copyable
+ *               and equality comparable.
+ */
+template<typename Pixel>
+    requires std::is_trivially_copyable_v<Pixel> && std::equality_comparable<Pixel>
+class glyph_cache {
+public:
+    /** @brief The pixel type of the cached tiles. */
+    using pixel_type = Pixel;
+
+    /**
+     * @brief Creates an empty cache with the given number of slots.
+     *
+     * @param capacity Number of glyph tiles held at once; 0 is treated as 1.
+     */
+    explicit glyph_cache(size_t capacity)
+        : _slots(std::max(capacity, size_t{1})) {}
+
+    /** @brief Returns the number of slots. */
+    [[nodiscard]] size_t capacity() const noexcept { return _slots.size(); }
+
+    /** @brief Returns the number of lookups served from the cache since creation or @ref clear. */
+    [[nodiscard]] size_t hits() const noexcept { return _hits; }
+
+    /** @brief Returns the number of lookups that had to expand a glyph since creation or @ref clear. */
+    [[nodiscard]] size_t misses() const noexcept { return _misses; }
+
+    /** @brief Forgets every cached tile, keeping the tile storage allocated. */
+    void clear() noexcept {
+        for (slot& s : _slots) {
+            s.font = nullptr;
+        }
+        _hits = 0;
+        _misses = 0;
+    }
+
+    /**
+     * @brief Returns the tile for a glyph, expanding it on a miss.
+     *
+     * The tile holds `font.width * scale` x `font.height * scale` pixels,
+     * row-major with a stride of its width: @p ink where the glyph has ink
+     * and @p background elsewhere. Characters outside the font's range
+     * give an all-background tile. The pointer stays valid until the slot
+     * is reused by a later lookup or the cache is destroyed.
+     *
+     * @param font       The font; must outlive the cache entry.
+     * @param c          The character.
+     * @param scale      Integer magnification factor (>= 1; 0 is treated as 1).
+     * @param ink        The pixel value for glyph ink.
+     * @param background The pixel value for the rest of the cell.
+     * @return The tile's pixels.
+     */
+    [[nodiscard]] const pixel_type*
+    tile(const font::mono_font& font, char c, unsigned scale, pixel_type ink, pixel_type background) {
+        scale = std::max(scale, 1u);
+        slot& s = _slots[_hash(font, c, scale, ink, background) % _slots.size()];
+        if (s.font == &font && s.c == c && s.scale == scale && s.ink == ink && s.background == background) {
+            ++_hits;
+            return s.pixels.get();
+        }
+        ++_misses;
+        _expand(s, font, c, scale, ink, background);
+        s.font = &font;
+        s.c = c;
+        s.scale = scale;
+        s.ink = ink;
+        s.background = background;
+        return s.pixels.get();
+    }
+
+private:
+    struct slot {
+        const font::mono_font* font = nullptr; // null when empty
+        char c = 0;
+        unsigned scale = 0;
+        pixel_type ink{};
+        pixel_type background{};
+        // Not a vector: std::vector<bool> has no contiguous storage.
+        std::unique_ptr<pixel_type[]> pixels;
+        size_t allocated = 0;
+    };
+
+    static size_t
+    _hash(const font::mono_font& font, char c, unsigned scale, pixel_type ink, pixel_type background) noexcept {
+        // FNV-1a over the key. The character goes last, so the glyphs of one
+        // font, scale, and color pair spread across consecutive slots.
+        size_t h = 2166136261u;
+        auto mix = [&h](const void* data, size_t size) {
+            const auto* bytes = static_cast<const unsigned char*>(data);
+            for (size_t i = 0; i < size; ++i) {
+                h = (h ^ bytes[i]) * 16777619u;
+            }
+        };
+        const font::mono_font* font_ptr = &font;
+        mix(&font_ptr, sizeof(font_ptr));
+        mix(&scale, sizeof(scale));
+        mix(&ink, sizeof(ink));
+        mix(&background, sizeof(background));
+        return h + static_cast<unsigned char>(c);
+    }
+
+    static void
+    _expand(slot& s, const font::mono_font& font, char c, unsigned scale, pixel_type ink, pixel_type background) {
+        const size_t tile_width = size_t{font.width} * scale;
+        const size_t size = tile_width * font.height * scale;
+        if (s.allocated < size) {
+            s.pixels = std::make_unique_for_overwrite<pixel_type[]>(size);
+            s.allocated = size;
+        }
+        pixel_type* pixels = s.pixels.get();
+        std::fill_n(pixels, size, background);
+        if (!font.contains(c)) {
+            return;
+        }
+        const uint8_t* glyph = font.glyph(c);
+        const size_t bpr = font.bytes_per_row();
+        for (size_t row = 0; row < font.height; ++row) {
+            pixel_type* first = pixels + row * scale * tile_width;
+            const uint8_t* row_bits = glyph + row * bpr;
+            for (size_t col = 0; col < font.width; ++col) {
+                if (row_bits[col / 8] & (0x80u >> (col % 8))) {
+                    std::fill_n(first + col * scale, scale, ink);
+                }
+            }
+            for (size_t copy = 1; copy < scale; ++copy) {
+                std::copy_n(first, tile_width, first + copy * tile_width);
+            }
+        }
+    }
+
+    std::vector<slot> _slots;
+    size_t _hits = 0;
+    size_t _misses = 0;
+};
+
+/**
+ * @brief Draws opaque text through a glyph cache.
+ *
+ * Renders @p text left-to-right starting with its top-left corner at
+ * (@p x, @p y), writing every pixel of each character cell: @p ink for
+ * glyph ink and @p background elsewhere. Characters outside the font's
+ * range draw a background cell. Each cell is one @ref blit of a tile from
+ * @p cache, so on surfaces with a bulk `blit` text costs a row copy per
+ * cell row rather than per-pixel decoding. Pixels falling outside the
+ * surface are clipped.
+ *
+ * @tparam Surface The surface type (satisfies @ref pixel_surface).
+ * @param surface    The surface to draw on.
+ * @param cache      The glyph cache supplying the cell tiles.
+ * @param font       Font to render with.
+ * @param x          Left edge of the first glyph cell, in pixels.
+ * @param y          Top edge of the glyph cells, in pixels.
+ * @param text       The text to draw.
+ * @param ink        The pixel value to write for glyph ink.
+ * @param background The pixel value to write for the rest of each cell.
+ * @param scale      Integer magnification factor (>= 1; 0 is treated as 1);
+ *                   each font pixel becomes a scale x scale block.
+ */
+template<pixel_surface Surface>
+void draw_text(
+    Surface& surface,
+    glyph_cache<typename Surface::pixel_type>& cache,
+    const font::mono_font& font,
+    size_t x,
+    size_t y,
+    std::string_view text,
+    typename Surface::pixel_type ink,
+    typename Surface::pixel_type background,
+    unsigned scale = 1
+) {
+    scale = std::max(scale, 1u);
+    if (y >= surface.height()) {
+        return; // every glyph row would clip
+    }
+    const size_t cell_width = size_t{font.width} * scale;
+    const size_t cell_height = size_t{font.height} * scale;
+    size_t cell_x = x;
+    for (char c : text) {
+        if (cell_x >= surface.width()) {
+            break; // rendering is left-to-right; nothing further can draw
+        }
+        blit(surface, cell_x, y, cell_width, cell_height, cache.tile(font, c, scale, ink, background), cell_width);
+        cell_x += font.advance(c) * scale;
+    }
+}
+
+/**
+ * @headerfile <idfxx/gfx>
+ * @brief How an @ref image stores its pixels.
+ */
+enum class image_encoding : uint8_t {
+    /**
+     * Uncompressed rows, top to bottom. Multi-byte pixels are stored in
+     * their in-memory representation (panel byte order for
+     * `idfxx::lcd::rgb565`). One-bit (`bool`) images pack eight pixels per
+     * byte, most significant bit leftmost, with each row starting on a byte
+     * boundary — the layout of idfxx_font glyphs.
+     */
+    raw,
+    /**
+     * Run-length encoded pixels in row-major order; a run may continue onto
+     * the next row. Multi-byte pixels use PackBits-style packets: a control
+     * byte `c` below 0x80 is followed by `c + 1` literal pixels, and one at
+     * or above 0x80 by a single pixel repeated `c - 0x7F` times. One-bit
+     * images use one byte per run: bit 7 is the pixel value and bits 0-6
+     * hold the run length minus one.
+     */
+    rle,
+};
+
+/**
+ * @headerfile <idfxx/gfx>
+ * @brief A read-only image or sprite drawn straight from its encoded data.
+ *
+ * An image is a non-owning view of encoded pixel data — typically a
+ * `const` array in flash (rodata) or a region of a data partition mapped
+ * with `idfxx::partition::mmap` — plus its dimensions, @ref image_encoding,
+ * and an optional transparent color key. @ref draw_image decodes it on the
+ * fly into the surface, so assets are never copied into RAM.
+ *
+ * Pixels equal to the key are skipped, so sprites compose over existing
+ * content; on monochrome surfaces a key of `false` draws only the set
+ * pixels, like text.
+ *
+ * @code
+ * // Generated from a PNG; panel byte order, 2-byte aligned.
+ * alignas(2) static const uint8_t wifi_icon_data[] = {...};
+ * constexpr idfxx::gfx::image<idfxx::lcd::rgb565> wifi_icon(
+ *     16, 16, idfxx::gfx::image_encoding::rle, wifi_icon_data, idfxx::lcd::rgb565(255, 0, 255)
+ * );
+ *
+ * canvas.draw_image(220, 2, wifi_icon);
+ * @endcode
+ *
+ * Raw multi-byte images whose data is aligned for @p Pixel and that have
+ * no key draw as a single @ref blit straight from the data; unaligned
+ * data is copied through a small stack buffer instead. Data shorter than
+ * the dimensions call for draws only the pixels it holds.
+ *
+ * @tparam Pixel The pixel type of the surfaces drawn on; trivially copyable
+ *               and equality comparable.
+ */
+template<typename Pixel>
+    requires std::is_trivially_copyable_v<Pixel> && std::equality_comparable<Pixel>
+class image {
+public:
+    /** @brief The pixel type of the image. */
+    using pixel_type = Pixel;
+
+    /**
+     * @brief Creates an image over encoded pixel data.
+     *
+     * @param width    Width in pixels.
+     * @param height   Height in pixels.
+     * @param encoding How @p data is encoded.
+     * @param data     The encoded pixels; must outlive the image.
+     * @param key      Transparent color: pixels equal to it are not drawn.
+     */
+    constexpr image(
+        size_t width,
+        size_t height,
+        image_encoding encoding,
+        std::span<const uint8_t> data,
+        std::optional<pixel_type> key = std::nullopt
+    ) noexcept
+        : _data(data)
+        , _width(width)
+        , _height(height)
+        , _encoding(encoding)
+        , _key(key) {}
+
+    /** @brief Returns the width, in pixels. */
+    [[nodiscard]] constexpr size_t width() const noexcept { return _width; }
+
+    /** @brief Returns the height, in pixels. */
+    [[nodiscard]] constexpr size_t height() const noexcept { return _height; }
+
+    /** @brief Returns how the data is encoded. */
+    [[nodiscard]] constexpr image_encoding encoding() const noexcept { return _encoding; }
+
+    /** @brief Returns the encoded data. */
+    [[nodiscard]] constexpr std::span<const uint8_t> data() const noexcept { return _data; }
+
+    /** @brief Returns the transparent color key, if any. */
+    [[nodiscard]] constexpr std::optional<pixel_type> key() const noexcept { return _key; }
+
+    /**
+     * @brief Returns a copy of this image with a different transparent color key.
+     *
+     * @param key Transparent color, or `std::nullopt` for an opaque image.
+     * @return The re-keyed image, viewing the same data.
+     */
+    [[nodiscard]] constexpr image with_key(std::optional<pixel_type> key) const noexcept {
+        image copy(*this);
+        copy._key = key;
+        return copy;
+    }
+
+private:
+    std::span<const uint8_t> _data;
+    size_t _width;
+    size_t _height;
+    image_encoding _encoding;
+    std::optional<pixel_type> _key;
+};
+
+/// @cond INTERNAL
+namespace detail {
+
+// Writes decoded image segments — a single pixel repeated, or literal pixels
+// from the encoded data — one row at a time, skipping keyed pixels.
+template<pixel_surface Surface>
+class image_writer {
+public:
+    using pixel_type = typename Surface::pixel_type;
+
+    image_writer(Surface& surface, std::optional<pixel_type> key) noexcept
+        : _surface(surface)
+        , _key(key) {}
+
+    void repeat(size_t x, size_t y, size_t length, pixel_type pixel) noexcept {
+        if (!_key || pixel != *_key) {
+            fill_rect(_surface, x, y, length, 1, pixel);
+        }
+    }
+
+    // Literal pixels in their in-memory representation, possibly unaligned.
+    void literal(size_t x, size_t y, size_t length, const uint8_t* bytes) noexcept {
+        if (reinterpret_cast<uintptr_t>(bytes) % alignof(pixel_type) == 0) {
+            _runs(x, y, length, reinterpret_cast<const pixel_type*>(bytes));
+            return;
+        }
+        std::array<pixel_type, 32> chunk;
+        while (length > 0) {
+            const size_t count = std::min(length, chunk.size());
+            std::memcpy(chunk.data(), bytes, count * sizeof(pixel_type));
+            _runs(x, y, count, chunk.data());
+            x += count;
+            bytes += count * sizeof(pixel_type);
+            length -= count;
+        }
+    }
+
+private:
+    // Blits each stretch of non-key pixels.
+    void _runs(size_t x, size_t y, size_t length, const pixel_type* pixels) noexcept {
+        if (!_key) {
+            blit(_surface, x, y, length, 1, pixels, length);
+            return;
+        }
+        size_t start = 0;
+        for (size_t i = 0; i <= length; ++i) {
+            if (i == length || pixels[i] == *_key) {
+                if (i > start) {
+                    blit(_surface, x + start, y, i - start, 1, pixels + start, i - start);
+                }
+                start = i + 1;
+            }
+        }
+    }
+
+    Surface& _surface;
+    std::optional<pixel_type> _key;
+};
+
+// Row-major position within an image, splitting runs at row ends.
+struct image_cursor {
+    size_t width;
+    size_t rows; // rows to decode; decoding stops below them
+    size_t col = 0;
+    size_t row = 0;
+
+    [[nodiscard]] bool done() const noexcept { return row >= rows; }
+
+    // Calls segment(col, row, length, offset) for each row-bounded piece of
+    // a run of `length` pixels, where offset counts pixels into the run.
+    template<typename F>
+    void advance(size_t length, F&& segment) {
+        for (size_t offset = 0; offset < length && !done();) {
+            const size_t piece = std::min(length - offset, width - col);
+            segment(col, row, piece, offset);
+            offset += piece;
+            col += piece;
+            if (col == width) {
+                col = 0;
+                ++row;
+            }
+        }
+    }
+};
+
+} // namespace detail
+/// @endcond
+
+/**
+ * @brief Draws an image with its top-left corner at (@p x, @p y).
+ *
+ * Decodes @p img on the fly, writing each run of identical pixels as one
+ * @ref fill_rect row and each stretch of distinct pixels as one @ref blit
+ * row, so surfaces with bulk hooks never see per-pixel writes. Pixels equal
+ * to the image's key are left untouched. Decoding stops at the surface's
+ * bottom edge; everything outside the surface is clipped.
+ *
+ * @tparam Surface The surface type (satisfies @ref pixel_surface).
+ * @param surface The surface to draw on.
+ * @param x       Left edge of the image, in pixels.
+ * @param y       Top edge of the image, in pixels.
+ * @param img     The image to draw.
+ */
+template<pixel_surface Surface>
+void draw_image(Surface& surface, size_t x, size_t y, const image<typename Surface::pixel_type>& img) noexcept {
+    using pixel_type = typename Surface::pixel_type;
+    const size_t width = img.width();
+    if (x >= surface.width() || y >= surface.height() || width == 0) {
+        return;
+    }
+    const std::span<const uint8_t> data = img.data();
+    detail::image_writer<Surface> out(surface, img.key());
+    detail::image_cursor cursor{.width = width, .rows = std::min(img.height(), surface.height() - y)};
+
+    if constexpr (std::same_as<pixel_type, bool>) {
+        if (img.encoding() == image_encoding::raw) {
+            const size_t bpr = (width + 7) / 8;
+            cursor.rows = std::min(cursor.rows, data.size() / bpr);
+            for (size_t row = 0; row < cursor.rows; ++row) {
+                const uint8_t* bits = data.data() + row * bpr;
+                size_t start = 0;
+                for (size_t col = 1; col <= width; ++col) {
+                    const bool value = bits[start / 8] & (0x80u >> (start % 8));
+                    if (col == width || static_cast<bool>(bits[col / 8] & (0x80u >> (col % 8))) != value) {
+                        out.repeat(x + start, y + row, col - start, value);
+                        start = col;
+                    }
+                }
+            }
+        } else {
+            for (size_t pos = 0; pos < data.size() && !cursor.done(); ++pos) {
+                const bool value = data[pos] & 0x80u;
+                cursor.advance((data[pos] & 0x7Fu) + 1u, [&](size_t col, size_t row, size_t length, size_t) {
+                    out.repeat(x + col, y + row, length, value);
+                });
+            }
+        }
+    } else {
+        constexpr size_t pixel_size = sizeof(pixel_type);
+        if (img.encoding() == image_encoding::raw) {
+            const size_t row_size = width * pixel_size;
+            cursor.rows = std::min(cursor.rows, data.size() / row_size);
+            if (!img.key() && reinterpret_cast<uintptr_t>(data.data()) % alignof(pixel_type) == 0) {
+                blit(surface, x, y, width, cursor.rows, reinterpret_cast<const pixel_type*>(data.data()), width);
+                return;
+            }
+            for (size_t row = 0; row < cursor.rows; ++row) {
+                out.literal(x, y + row, width, data.data() + row * row_size);
+            }
+        } else {
+            size_t pos = 0;
+            while (pos < data.size() && !cursor.done()) {
+                const uint8_t control = data[pos++];
+                if (control >= 0x80u) {
+                    if (data.size() - pos < pixel_size) {
+                        break;
+                    }
+                    pixel_type pixel;
+                    std::memcpy(&pixel, data.data() + pos, pixel_size);
+                    pos += pixel_size;
+                    cursor.advance(control - 0x7Fu, [&](size_t col, size_t row, size_t length, size_t) {
+                        out.repeat(x + col, y + row, length, pixel);
+                    });
+                } else {
+                    const size_t count = std::min<size_t>(control + 1u, (data.size() - pos) / pixel_size);
+                    const uint8_t* literal = data.data() + pos;
+                    pos += (control + 1u) * pixel_size;
+                    cursor.advance(count, [&](size_t col, size_t row, size_t length, size_t offset) {
+                        out.literal(x + col, y + row, length, literal + offset * pixel_size);
+                    });
+                }
+            }
+        }
+    }
+}
+
 /**
  * @headerfile <idfxx/gfx>
  * @brief A drawing view bundling a pixel surface with the drawing primitives.
@@ -353,7 +1000,10 @@ void draw_text(Surface& surface, const font::mono_font& font, size_t x, size_t y
  * applied to the underlying surface, with the same ink-only rendering and
  * clipping contract. @ref fill and @ref clear use the surface's own
  * `fill`/`clear` when it provides them (framebuffers fill their backing
- * store directly), falling back to per-pixel writes otherwise. When the
+ * store directly), falling back to per-pixel writes otherwise. The canvas
+ * also provides the bulk hooks (`fill_span`, `fill_block`, `blit`),
+ * clipping and translating them onto the surface's own hooks where it has
+ * them. When the
  * surface can push its content onward (the framebuffers' `flush` /
  * `try_flush` to a panel), @ref flush and @ref try_flush forward to it, so
  * the full draw-then-transfer cycle reads off the one object.
@@ -408,6 +1058,8 @@ public:
         : _surface(&surface)
         , _dx(0)
         , _dy(0)
+        , _left(0)
+        , _top(0)
         , _width(surface.width())
         , _height(surface.height()) {}
 
@@ -430,6 +1082,8 @@ public:
         : _surface(&surface)
         , _dx(static_cast<ptrdiff_t>(x))
         , _dy(static_cast<ptrdiff_t>(y))
+        , _left(0)
+        , _top(0)
         , _width(x + surface.width())
         , _height(y + surface.height()) {}
 
@@ -482,11 +1136,72 @@ public:
         canvas sub(*this);
         sub._dx = _dx - static_cast<ptrdiff_t>(x);
         sub._dy = _dy - static_cast<ptrdiff_t>(y);
+        sub._left = _left > x ? _left - x : 0;
+        sub._top = _top > y ? _top - y : 0;
         sub._width = x < _width ? std::min(width, _width - x) : 0;
         sub._height = y < _height ? std::min(height, _height - y) : 0;
         return sub;
     }
 
+    /**
+     * @brief Returns a canvas with the same coordinates, drawing only inside a rectangle.
+     *
+     * Unlike @ref window, the returned canvas keeps this canvas's
+     * coordinates: drawing code runs unchanged, and only pixels inside the
+     * rectangle (and inside this canvas's own clip) are written. This is
+     * how a damaged region is redrawn without disturbing the pixels around
+     * it. The requested rectangle is clamped to this canvas's bounds; an
+     * empty result is allowed and draws nothing.
+     *
+     * @code
+     * auto damaged = canvas.clip(40, 60, 16, 16);
+     * damaged.fill_rect(0, 0, damaged.width(), damaged.height(), black);
+     * draw_frame(damaged); // only the 16x16 square changes
+     * @endcode
+     *
+     * @param x      Left edge of the clip rectangle, in pixels.
+     * @param y      Top edge of the clip rectangle, in pixels.
+     * @param width  Width of the clip rectangle, in pixels.
+     * @param height Height of the clip rectangle, in pixels.
+     * @return A canvas over the same surface and coordinates, restricted to the rectangle.
+     */
+    [[nodiscard]] canvas clip(size_t x, size_t y, size_t width, size_t height) const noexcept {
+        canvas sub(*this);
+        sub._left = std::max(_left, x);
+        sub._top = std::max(_top, y);
+        sub._width = std::min(_width, x + std::min(width, SIZE_MAX - x));
+        sub._height = std::min(_height, y + std::min(height, SIZE_MAX - y));
+        return sub;
+    }
+
+    /**
+     * @brief Returns true if any part of a rectangle would land on the surface.
+     *
+     * A rectangle for which this returns false draws nothing, so callers
+     * may skip it entirely — @ref display_list uses this to replay only the
+     * commands touching the current band.
+     *
+     * @param x      Left edge of the rectangle, in pixels.
+     * @param y      Top edge of the rectangle, in pixels.
+     * @param width  Width of the rectangle, in pixels.
+     * @param height Height of the rectangle, in pixels.
+     * @return Whether the rectangle overlaps the drawable region.
+     */
+    [[nodiscard]] bool intersects(size_t x, size_t y, size_t width, size_t height) const noexcept {
+        // The drawable region, in canvas coordinates.
+        const ptrdiff_t left = std::max({_dx, ptrdiff_t{0}, static_cast<ptrdiff_t>(_left)});
+        const ptrdiff_t top = std::max({_dy, ptrdiff_t{0}, static_cast<ptrdiff_t>(_top)});
+        const ptrdiff_t right = std::min(static_cast<ptrdiff_t>(_width), _dx + static_cast<ptrdiff_t>(_surface->width()));
+        const ptrdiff_t bottom =
+            std::min(static_cast<ptrdiff_t>(_height), _dy + static_cast<ptrdiff_t>(_surface->height()));
+        if (right <= left || bottom <= top || width == 0 || height == 0) {
+            return false;
+        }
+        return x < static_cast<size_t>(right) && y < static_cast<size_t>(bottom) &&
+            x + std::min(width, SIZE_MAX - x) > static_cast<size_t>(left) &&
+            y + std::min(height, SIZE_MAX - y) > static_cast<size_t>(top);
+    }
+
     /**
      * @brief Sets a single pixel to the given ink.
      *
@@ -498,7 +1213,7 @@ public:
      * @param ink The pixel value to write.
      */
     void set_pixel(size_t x, size_t y, pixel_type ink) noexcept {
-        if (x >= _width || y >= _height) {
+        if (x < _left || y < _top || x >= _width || y >= _height) {
             return;
         }
         // Coordinates left of or above the surface wrap to huge values and
@@ -613,8 +1328,8 @@ public:
         // Clamp the start to the drawable region in canvas coordinates so
         // the translated start is never left of or above the surface; the
         // surface-level fill_rect clips the far edges.
-        const size_t sx = std::max(x, _dx > 0 ? static_cast<size_t>(_dx) : size_t{0});
-        const size_t sy = std::max(y, _dy > 0 ? static_cast<size_t>(_dy) : size_t{0});
+        const size_t sx = std::max({x, _left, _dx > 0 ? static_cast<size_t>(_dx) : size_t{0}});
+        const size_t sy = std::max({y, _top, _dy > 0 ? static_cast<size_t>(_dy) : size_t{0}});
         if (sx >= _width || sy >= _height || sx - x >= width || sy - y >= height) {
             return;
         }
@@ -628,6 +1343,61 @@ public:
         );
     }
 
+    /**
+     * @brief Fills a horizontal run of pixels (equivalent to `fill_rect(x, y, length, 1, ink)`).
+     *
+     * @param x      Column of the run's left end, in pixels.
+     * @param y      Row of the run, in pixels.
+     * @param length Length of the run, in pixels.
+     * @param ink    The pixel value to write.
+     */
+    void fill_span(size_t x, size_t y, size_t length, pixel_type ink) noexcept { fill_rect(x, y, length, 1, ink); }
+
+    /**
+     * @brief Fills a rectangle (equivalent to @ref fill_rect).
+     *
+     * @param x      Left edge of the rectangle, in pixels.
+     * @param y      Top edge of the rectangle, in pixels.
+     * @param width  Width of the rectangle, in pixels.
+     * @param height Height of the rectangle, in pixels.
+     * @param ink    The pixel value to write.
+     */
+    void fill_block(size_t x, size_t y, size_t width, size_t height, pixel_type ink) noexcept {
+        fill_rect(x, y, width, height, ink);
+    }
+
+    /**
+     * @brief Copies a rectangle of pixel values to the canvas.
+     *
+     * The rectangle's top-left corner lands at (@p x, @p y) and it spans
+     * @p width columns and @p height rows. Source row `r` starts at
+     * `pixels + r * stride`. Any part falling outside the canvas is clipped.
+     *
+     * @param x      Left edge of the destination, in pixels.
+     * @param y      Top edge of the destination, in pixels.
+     * @param width  Width of the rectangle, in pixels.
+     * @param height Height of the rectangle, in pixels.
+     * @param pixels The source pixels, row-major.
+     * @param stride Distance between the starts of successive source rows, in pixels.
+     */
+    void blit(size_t x, size_t y, size_t width, size_t height, const pixel_type* pixels, size_t stride) noexcept {
+        // As for fill_rect, but the source skips whatever the clamp cuts off.
+        const size_t sx = std::max({x, _left, _dx > 0 ? static_cast<size_t>(_dx) : size_t{0}});
+        const size_t sy = std::max({y, _top, _dy > 0 ? static_cast<size_t>(_dy) : size_t{0}});
+        if (sx >= _width || sy >= _height || sx - x >= width || sy - y >= height) {
+            return;
+        }
+        gfx::blit(
+            *_surface,
+            static_cast<size_t>(static_cast<ptrdiff_t>(sx) - _dx),
+            static_cast<size_t>(static_cast<ptrdiff_t>(sy) - _dy),
+            std::min(width - (sx - x), _width - sx),
+            std::min(height - (sy - y), _height - sy),
+            pixels + (sy - y) * stride + (sx - x),
+            stride
+        );
+    }
+
     /**
      * @brief Draws a horizontal line with the given ink.
      *
@@ -734,21 +1504,436 @@ public:
         gfx::draw_text(*this, font, x, y, text);
     }
 
+    /**
+     * @brief Draws opaque text through a glyph cache.
+     *
+     * Writes every pixel of each character cell — @p ink for glyph ink and
+     * @p background elsewhere — as one blit of a cached tile per cell; see
+     * the free @ref gfx::draw_text "draw_text" overload taking a
+     * @ref glyph_cache for the full contract. Pixels falling outside the
+     * canvas are clipped.
+     *
+     * @param cache      The glyph cache supplying the cell tiles.
+     * @param font       Font to render with.
+     * @param x          Left edge of the first glyph cell, in pixels.
+     * @param y          Top edge of the glyph cells, in pixels.
+     * @param text       The text to draw.
+     * @param ink        The pixel value to write for glyph ink.
+     * @param background The pixel value to write for the rest of each cell.
+     * @param scale      Integer magnification factor (>= 1; 0 is treated as 1).
+     */
+    void draw_text(
+        glyph_cache<pixel_type>& cache,
+        const font::mono_font& font,
+        size_t x,
+        size_t y,
+        std::string_view text,
+        pixel_type ink,
+        pixel_type background,
+        unsigned scale = 1
+    ) {
+        gfx::draw_text(*this, cache, font, x, y, text, ink, background, scale);
+    }
+
+    /**
+     * @brief Draws an image with its top-left corner at (@p x, @p y).
+     *
+     * Decodes the image straight from its data; see the free
+     * @ref gfx::draw_image "draw_image" for the full contract. An image
+     * missing the drawable region entirely (see @ref intersects) is skipped
+     * without decoding. Pixels falling outside the canvas are clipped.
+     *
+     * @param x   Left edge of the image, in pixels.
+     * @param y   Top edge of the image, in pixels.
+     * @param img The image to draw.
+     */
+    void draw_image(size_t x, size_t y, const image<pixel_type>& img) noexcept {
+        if (intersects(x, y, img.width(), img.height())) {
+            gfx::draw_image(*this, x, y, img);
+        }
+    }
+
 private:
     // True when the drawable region spans the entire surface (the identity
     // and whole-band cases), enabling the surface's native fill/clear.
     [[nodiscard]] bool _covers_surface() const noexcept {
-        return _dx >= 0 && _dy >= 0 && static_cast<size_t>(_dx) + _surface->width() <= _width &&
+        return _dx >= 0 && _dy >= 0 && _left <= static_cast<size_t>(_dx) && _top <= static_cast<size_t>(_dy) &&
+            static_cast<size_t>(_dx) + _surface->width() <= _width &&
             static_cast<size_t>(_dy) + _surface->height() <= _height;
     }
 
     Surface* _surface;
     ptrdiff_t _dx; // canvas-coordinate position of the surface's (0, 0)
     ptrdiff_t _dy;
-    size_t _width; // canvas-coordinate clip bounds
+    size_t _left; // canvas-coordinate clip bounds
+    size_t _top;
+    size_t _width;
     size_t _height;
 };
 
+/**
+ * @headerfile <idfxx/gfx>
+ * @brief A recorded sequence of drawing commands, replayed with per-band culling.
+ *
+ * Banded rendering runs the frame's drawing once per band, so every
+ * primitive is re-rasterised — and clipped away — in each pass. A
+ * display_list records the frame once instead: its members mirror the
+ * @ref canvas drawing operations, each storing its parameters and bounding
+ * box. @ref replay then executes only the commands whose bounding box
+ * touches the canvas's drawable region, so a band skips everything drawn
+ * elsewhere on the screen.
+ *
+ * @code
+ * idfxx::gfx::display_list<idfxx::lcd::rgb565> frame(240, 320);
+ * for (;;) {
+ *     frame.reset();
+ *     frame.clear();         // records a background fill, as on a canvas
+ *     draw_dashboard(frame); // same code that would draw on a canvas
+ *     idfxx::gfx::render_banded(band, panel, 320, [&](auto& canvas) { frame.replay(canvas); });
+ * }
+ * @endcode
+ *
+ * Text is copied into the list, so the strings passed to @ref draw_text
+ * need not outlive it; fonts, glyph caches, and images are referenced and
+ * must.
+ * @ref reset keeps the
+ * allocated capacity, so re-recording a frame of similar size does not
+ * allocate.
+ *
+ * @tparam Pixel The ink type, matching the surfaces the list is replayed on.
+ */
+template<typename Pixel>
+class display_list {
+public:
+    /** @brief The ink type of the recorded commands. */
+    using pixel_type = Pixel;
+
+    /**
+     * @brief Creates an empty display list for a frame of the given size.
+     *
+     * The dimensions are reported by @ref width and @ref height, so drawing
+     * code written against a canvas (e.g. centering text) records the same
+     * commands here.
+     *
+     * @param width  Frame width, in pixels.
+     * @param height Frame height, in pixels.
+     */
+    display_list(size_t width, size_t height) noexcept
+        : _width(width)
+        , _height(height) {}
+
+    /** @brief Returns the frame width, in pixels. */
+    [[nodiscard]] size_t width() const noexcept { return _width; }
+
+    /** @brief Returns the frame height, in pixels. */
+    [[nodiscard]] size_t height() const noexcept { return _height; }
+
+    /** @brief Returns the number of recorded commands. */
+    [[nodiscard]] size_t size() const noexcept { return _commands.size(); }
+
+    /** @brief Returns true if no commands are recorded. */
+    [[nodiscard]] bool empty() const noexcept { return _commands.empty(); }
+
+    /** @brief Removes every command, keeping the allocated capacity. */
+    void reset() noexcept {
+        _commands.clear();
+        _text.clear();
+    }
+
+    /**
+     * @brief Records a fill of the whole frame (see @ref canvas::fill).
+     * @param ink The pixel value to fill with.
+     */
+    void fill(pixel_type ink) { fill_rect(0, 0, _width, _height, ink); }
+
+    /**
+     * @brief Records a fill of the whole frame with the default value (see @ref canvas::clear).
+     *
+     * Unlike @ref reset, this adds a command rather than removing them.
+     */
+    void clear() { fill(pixel_type{}); }
+
+    /**
+     * @brief Records a filled rectangle (see @ref canvas::fill_rect).
+     *
+     * @param x      Left edge of the rectangle, in pixels.
+     * @param y      Top edge of the rectangle, in pixels.
+     * @param width  Width of the rectangle, in pixels.
+     * @param height Height of the rectangle, in pixels.
+     * @param ink    The pixel value to write.
+     */
+    void fill_rect(size_t x, size_t y, size_t width, size_t height, pixel_type ink) {
+        _record({.op = kind::fill_rect, .x = x, .y = y, .width = width, .height = height, .ink = ink});
+    }
+
+    /**
+     * @brief Records a horizontal line (see @ref canvas::draw_hline).
+     *
+     * @param x      Column of the line's left end, in pixels.
+     * @param y      Row of the line, in pixels.
+     * @param length Length of the line, in pixels.
+     * @param ink    The pixel value to write.
+     */
+    void draw_hline(size_t x, size_t y, size_t length, pixel_type ink) { fill_rect(x, y, length, 1, ink); }
+
+    /**
+     * @brief Records a vertical line (see @ref canvas::draw_vline).
+     *
+     * @param x      Column of the line, in pixels.
+     * @param y      Row of the line's top end, in pixels.
+     * @param length Length of the line, in pixels.
+     * @param ink    The pixel value to write.
+     */
+    void draw_vline(size_t x, size_t y, size_t length, pixel_type ink) { fill_rect(x, y, 1, length, ink); }
+
+    /**
+     * @brief Records an outlined rectangle (see @ref canvas::draw_rect).
+     *
+     * @param x      Left edge of the rectangle, in pixels.
+     * @param y      Top edge of the rectangle, in pixels.
+     * @param width  Width of the rectangle, in pixels.
+     * @param height Height of the rectangle, in pixels.
+     * @param ink    The pixel value to write.
+     */
+    void draw_rect(size_t x, size_t y, size_t width, size_t height, pixel_type ink) {
+        _record({.op = kind::draw_rect, .x = x, .y = y, .width = width, .height = height, .ink = ink});
+    }
+
+    /**
+     * @brief Records a straight line between two points (see @ref canvas::draw_line).
+     *
+     * @param x0  Column of the first endpoint, in pixels.
+     * @param y0  Row of the first endpoint, in pixels.
+     * @param x1  Column of the second endpoint, in pixels.
+     * @param y1  Row of the second endpoint, in pixels.
+     * @param ink The pixel value to write.
+     */
+    void draw_line(size_t x0, size_t y0, size_t x1, size_t y1, pixel_type ink) {
+        // The bounding box spans both endpoints, inclusive; replay recovers
+        // the endpoints from the box and the direction flags.
+        _record({
+            .op = kind::draw_line,
+            .x = std::min(x0, x1),
+            .y = std::min(y0, y1),
+            .width = (std::max(x0, x1) - std::min(x0, x1)) + 1,
+            .height = (std::max(y0, y1) - std::min(y0, y1)) + 1,
+            .ink = ink,
+            .flip_x = x0 > x1,
+            .flip_y = y0 > y1,
+        });
+    }
+
+    /**
+     * @brief Records text (see @ref canvas::draw_text).
+     *
+     * @param font  Font to render with; must outlive the list.
+     * @param x     Left edge of the first glyph cell, in pixels.
+     * @param y     Top edge of the glyph cells, in pixels.
+     * @param text  The text to draw; copied into the list.
+     * @param ink   The pixel value to write for glyph ink.
+     * @param scale Integer magnification factor (>= 1; 0 is treated as 1).
+     */
+    void draw_text(
+        const font::mono_font& font,
+        size_t x,
+        size_t y,
+        std::string_view text,
+        pixel_type ink,
+        unsigned scale = 1
+    ) {
+        scale = std::max(scale, 1u);
+        const size_t offset = _text.size();
+        _text.append(text);
+        _record({
+            .op = kind::draw_text,
+            .x = x,
+            .y = y,
+            .width = font::text_width(font, text, scale),
+            .height = size_t{font.height} * scale,
+            .ink = ink,
+            .font = &font,
+            .text_offset = offset,
+            .text_length = text.size(),
+            .scale = scale,
+        });
+    }
+
+    /**
+     * @brief Records opaque text drawn through a glyph cache (see @ref canvas::draw_text).
+     *
+     * @param cache      The glyph cache supplying the cell tiles; must outlive the list.
+     * @param font       Font to render with; must outlive the list.
+     * @param x          Left edge of the first glyph cell, in pixels.
+     * @param y          Top edge of the glyph cells, in pixels.
+     * @param text       The text to draw; copied into the list.
+     * @param ink        The pixel value to write for glyph ink.
+     * @param background The pixel value to write for the rest of each cell.
+     * @param scale      Integer magnification factor (>= 1; 0 is treated as 1).
+     */
+    void draw_text(
+        glyph_cache<pixel_type>& cache,
+        const font::mono_font& font,
+        size_t x,
+        size_t y,
+        std::string_view text,
+        pixel_type ink,
+        pixel_type background,
+        unsigned scale = 1
+    ) {
+        scale = std::max(scale, 1u);
+        const size_t offset = _text.size();
+        _text.append(text);
+        _record({
+            .op = kind::draw_text_opaque,
+            .x = x,
+            .y = y,
+            .width = font::text_width(font, text, scale),
+            .height = size_t{font.height} * scale,
+            .ink = ink,
+            .background = background,
+            .font = &font,
+            .cache = &cache,
+            .text_offset = offset,
+            .text_length = text.size(),
+            .scale = scale,
+        });
+    }
+
+    /**
+     * @brief Records an image (see @ref canvas::draw_image).
+     *
+     * @param x   Left edge of the image, in pixels.
+     * @param y   Top edge of the image, in pixels.
+     * @param img The image to draw; it and its data must outlive the list.
+     */
+    void draw_image(size_t x, size_t y, const image<pixel_type>& img) {
+        _record({
+            .op = kind::draw_image,
+            .x = x,
+            .y = y,
+            .width = img.width(),
+            .height = img.height(),
+            .ink = {}, // unused: images carry their own pixels
+            .img = &img,
+        });
+    }
+
+    /**
+     * @brief Records text on a monochrome frame, setting glyph ink pixels.
+     *
+     * Equivalent to @ref draw_text with `ink = true`.
+     *
+     * @param font Font to render with; must outlive the list.
+     * @param x    Left edge of the first glyph cell, in pixels.
+     * @param y    Top edge of the glyph cells, in pixels.
+     * @param text The text to draw; copied into the list.
+     */
+    void draw_text(const font::mono_font& font, size_t x, size_t y, std::string_view text)
+        requires std::same_as<pixel_type, bool>
+    {
+        draw_text(font, x, y, text, true);
+    }
+
+    /**
+     * @brief Draws the commands touching the canvas's drawable region, in recording order.
+     *
+     * Commands whose bounding box misses the region (see
+     * @ref canvas::intersects) are skipped without being rasterised; the
+     * rest render exactly as if drawn on the canvas directly.
+     *
+     * @tparam Surface The canvas's surface type, with a matching pixel type.
+     * @param c The canvas to draw on.
+     */
+    template<pixel_surface Surface>
+        requires std::same_as<typename Surface::pixel_type, pixel_type>
+    void replay(canvas<Surface>& c) const {
+        for (const command& cmd : _commands) {
+            if (!c.intersects(cmd.x, cmd.y, cmd.width, cmd.height)) {
+                continue;
+            }
+            switch (cmd.op) {
+            case kind::fill_rect:
+                c.fill_rect(cmd.x, cmd.y, cmd.width, cmd.height, cmd.ink);
+                break;
+            case kind::draw_rect:
+                c.draw_rect(cmd.x, cmd.y, cmd.width, cmd.height, cmd.ink);
+                break;
+            case kind::draw_line: {
+                const size_t x_far = cmd.x + cmd.width - 1;
+                const size_t y_far = cmd.y + cmd.height - 1;
+                c.draw_line(
+                    cmd.flip_x ? x_far : cmd.x,
+                    cmd.flip_y ? y_far : cmd.y,
+                    cmd.flip_x ? cmd.x : x_far,
+                    cmd.flip_y ? cmd.y : y_far,
+                    cmd.ink
+                );
+                break;
+            }
+            case kind::draw_text:
+                c.draw_text(
+                    *cmd.font,
+                    cmd.x,
+                    cmd.y,
+                    std::string_view(_text).substr(cmd.text_offset, cmd.text_length),
+                    cmd.ink,
+                    cmd.scale
+                );
+                break;
+            case kind::draw_text_opaque:
+                c.draw_text(
+                    *cmd.cache,
+                    *cmd.font,
+                    cmd.x,
+                    cmd.y,
+                    std::string_view(_text).substr(cmd.text_offset, cmd.text_length),
+                    cmd.ink,
+                    cmd.background,
+                    cmd.scale
+                );
+                break;
+            case kind::draw_image:
+                c.draw_image(cmd.x, cmd.y, *cmd.img);
+                break;
+            }
+        }
+    }
+
+private:
+    enum class kind : uint8_t { fill_rect, draw_rect, draw_line, draw_text, draw_text_opaque, draw_image };
+
+    // The bounding box doubles as the primitive's geometry for rectangles
+    // and lines.
+    struct command {
+        kind op;
+        size_t x;
+        size_t y;
+        size_t width;
+        size_t height;
+        pixel_type ink;
+        pixel_type background{}; // opaque text only
+        bool flip_x = false;     // lines: x0 is the right end
+        bool flip_y = false;     // lines: y0 is the bottom end
+        const font::mono_font* font = nullptr;
+        glyph_cache<pixel_type>* cache = nullptr; // opaque text only
+        const image<pixel_type>* img = nullptr;
+        size_t text_offset = 0;
+        size_t text_length = 0;
+        unsigned scale = 1;
+    };
+
+    void _record(const command& cmd) {
+        if (cmd.width != 0 && cmd.height != 0) {
+            _commands.push_back(cmd);
+        }
+    }
+
+    size_t _width;
+    size_t _height;
+    std::vector<command> _commands;
+    std::string _text;
+};
+
 /**
  * @cond INTERNAL
  * @brief Constraint for the banded-rendering functions: the draw callback
@@ -762,10 +1947,34 @@ concept banded_renderable = pixel_surface<Surface> && requires(canvas<Surface>&
 };
 /** @endcond */
 
+/**
+ * @cond INTERNAL
+ * @brief Constraint for pipelined banded rendering: the draw callback
+ * accepts a canvas over a band, and a band can start an asynchronous flush
+ * to the destination through the transfer tracker.
+ */
+template<typename Surface, typename Dest, typename Tracker, typename DrawFn>
+concept pipelined_renderable =
+    pixel_surface<Surface> && requires(canvas<Surface>& c, const Surface& s, Dest& dest, Tracker& tracker, DrawFn& draw) {
+        draw(c);
+        { s.try_flush_async(dest, tracker, size_t{}, size_t{}) } -> std::same_as<result<future<void>>>;
+    };
+/** @endcond */
+
 /** @cond INTERNAL */
 template<pixel_surface Surface, typename Dest, typename DrawFn>
     requires banded_renderable<Surface, Dest, DrawFn>
 [[nodiscard]] result<void> try_render_banded(Surface& band, Dest& dest, size_t frame_height, DrawFn&& draw);
+
+template<pixel_surface Surface, size_t Extent, typename Dest, typename Tracker, typename DrawFn>
+    requires pipelined_renderable<Surface, Dest, Tracker, DrawFn>
+[[nodiscard]] result<void> try_render_banded(
+    std::span<Surface, Extent> bands,
+    Dest& dest,
+    Tracker& tracker,
+    size_t frame_height,
+    DrawFn&& draw
+);
 /** @endcond */
 
 #ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
@@ -811,6 +2020,49 @@ template<pixel_surface Surface, typename Dest, typename DrawFn>
 void render_banded(Surface& band, Dest& dest, size_t frame_height, DrawFn&& draw) {
     unwrap(try_render_banded(band, dest, frame_height, draw));
 }
+
+/**
+ * @brief Renders a frame band by band, drawing each band while the previous ones transfer.
+ *
+ * As the single-band @ref render_banded, but rotates through several band
+ * buffers and flushes each asynchronously, so drawing band k+1 overlaps the
+ * transfer of band k. Before a buffer is reused, the pass waits for the
+ * transfer of the band it last held. A full redraw then takes roughly the
+ * larger of the drawing and transfer times rather than their sum.
+ *
+ * Each band flushes with `try_flush_async(dest, tracker, 0, y)`, which for
+ * `idfxx::lcd::rgb565_framebuffer` queues the transfer through an
+ * `idfxx::lcd::transfer_tracker` installed as the panel I/O's
+ * `on_color_transfer_done` callback. The call returns once every band has
+ * finished transferring, so the buffers may be redrawn straight away.
+ *
+ * @code
+ * std::array<idfxx::lcd::rgb565_framebuffer, 2> bands{{{240, 40}, {240, 40}}};
+ * idfxx::gfx::render_banded(std::span(bands), panel, tracker, 320, [&](auto& canvas) {
+ *     canvas.draw_text(idfxx::font::spleen_8x16, 8, 8, "title", white, 2);
+ * });
+ * @endcode
+ *
+ * @tparam Surface The band's surface type (satisfies @ref pixel_surface).
+ * @tparam Extent  The band count, or `std::dynamic_extent`.
+ * @tparam Dest    The flush destination type (e.g. a panel).
+ * @tparam Tracker The transfer tracker type passed to `try_flush_async`.
+ * @tparam DrawFn  The draw callback type, invocable with `canvas<Surface>&`.
+ * @param bands        The band buffers to rotate through; all must have the same dimensions.
+ * @param dest         The destination the bands flush to.
+ * @param tracker      The tracker reporting transfer completion.
+ * @param frame_height Height of the frame, in pixels; must be a non-zero
+ *                     multiple of the band height.
+ * @param draw         Callback drawing the complete frame on the given canvas.
+ * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+ * @throws std::system_error on error (e.g. an invalid @p frame_height, or a
+ *         failed flush).
+ */
+template<pixel_surface Surface, size_t Extent, typename Dest, typename Tracker, typename DrawFn>
+    requires pipelined_renderable<Surface, Dest, Tracker, DrawFn>
+void render_banded(std::span<Surface, Extent> bands, Dest& dest, Tracker& tracker, size_t frame_height, DrawFn&& draw) {
+    unwrap(try_render_banded(bands, dest, tracker, frame_height, draw));
+}
 #endif
 
 /**
@@ -860,6 +2112,95 @@ template<pixel_surface Surface, typename Dest, typename DrawFn>
     return {};
 }
 
+/**
+ * @brief Renders a frame band by band, drawing each band while the previous ones transfer.
+ *
+ * As the single-band @ref try_render_banded, but rotates through several
+ * band buffers and flushes each asynchronously, so drawing band k+1
+ * overlaps the transfer of band k. Before a buffer is reused, the pass
+ * waits for the transfer of the band it last held. A full redraw then
+ * takes roughly the larger of the drawing and transfer times rather than
+ * their sum.
+ *
+ * Each band flushes with `try_flush_async(dest, tracker, 0, y)`, which for
+ * `idfxx::lcd::rgb565_framebuffer` queues the transfer through an
+ * `idfxx::lcd::transfer_tracker` installed as the panel I/O's
+ * `on_color_transfer_done` callback. The call returns once every band
+ * submitted has finished transferring, even on error, so the buffers may
+ * be redrawn straight away.
+ *
+ * @tparam Surface The band's surface type (satisfies @ref pixel_surface).
+ * @tparam Extent  The band count, or `std::dynamic_extent`.
+ * @tparam Dest    The flush destination type (e.g. a panel).
+ * @tparam Tracker The transfer tracker type passed to `try_flush_async`.
+ * @tparam DrawFn  The draw callback type, invocable with `canvas<Surface>&`.
+ * @param bands        The band buffers to rotate through; all must have the same dimensions.
+ * @param dest         The destination the bands flush to.
+ * @param tracker      The tracker reporting transfer completion.
+ * @param frame_height Height of the frame, in pixels; must be a non-zero
+ *                     multiple of the band height.
+ * @param draw         Callback drawing the complete frame on the given canvas.
+ * @return Success, or an error.
+ * @retval idfxx::errc::invalid_arg if @p bands is empty or its buffers differ
+ *         in size, or @p frame_height is zero or not a multiple of the band
+ *         height.
+ */
+template<pixel_surface Surface, size_t Extent, typename Dest, typename Tracker, typename DrawFn>
+    requires pipelined_renderable<Surface, Dest, Tracker, DrawFn>
+[[nodiscard]] result<void> try_render_banded(
+    std::span<Surface, Extent> bands,
+    Dest& dest,
+    Tracker& tracker,
+    size_t frame_height,
+    DrawFn&& draw
+) {
+    if (bands.empty()) {
+        return error(errc::invalid_arg);
+    }
+    const size_t band_width = bands[0].width();
+    const size_t band_height = bands[0].height();
+    if (band_height == 0 || frame_height == 0 || frame_height % band_height != 0) {
+        return error(errc::invalid_arg);
+    }
+    for (const Surface& band : bands) {
+        if (band.width() != band_width || band.height() != band_height) {
+            return error(errc::invalid_arg);
+        }
+    }
+
+    // The pending transfer of each buffer; a default future is already complete.
+    auto in_flight = [&] {
+        if constexpr (Extent == std::dynamic_extent) {
+            return std::vector<future<void>>(bands.size());
+        } else {
+            return std::array<future<void>, Extent>{};
+        }
+    }();
+
+    result<void> status;
+    size_t i = 0;
+    for (size_t y = 0; y < frame_height; y += band_height, i = (i + 1) % bands.size()) {
+        if (status = in_flight[i].try_wait(); !status) {
+            break;
+        }
+        canvas c(bands[i], 0, y);
+        c.clear();
+        draw(c);
+        auto sent = bands[i].try_flush_async(dest, tracker, size_t{0}, y);
+        if (!sent) {
+            status = error(sent.error());
+            break;
+        }
+        in_flight[i] = std::move(*sent);
+    }
+    for (auto& f : in_flight) {
+        if (auto waited = f.try_wait(); !waited && status) {
+            status = waited;
+        }
+    }
+    return status;
+}
+
 /** @} */ // end of idfxx_gfx
 
 } // namespace idfxx::gfx
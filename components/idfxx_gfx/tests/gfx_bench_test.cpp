@@ -0,0 +1,236 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+// Rendering benchmarks for idfxx::gfx and the idfxx_lcd framebuffers
+// Each case logs cycles per operation and pixels per second; run a single
+// case from the Unity menu, or the whole set with the [bench] tag. The cases
+// run in the default suite, including under QEMU, so their assertions keep
+// the recording paths exercised; but QEMU cycle counts say nothing about real
+// timing, so compare results only against runs on the same hardware target.
+
+#include "../../idfxx_lcd/tests/recording_panel.hpp"
+#include "idfxx/font/spleen"
+#include "idfxx/gfx"
+#include "idfxx/lcd/convert"
+#include "idfxx/lcd/mono_framebuffer"
+#include "idfxx/lcd/rgb565_framebuffer"
+#include "idfxx/log"
+#include "unity.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <esp_cpu.h>
+#include <format>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace idfxx::gfx;
+using idfxx::font::spleen_5x8;
+using idfxx::font::spleen_8x16;
+using idfxx::lcd::mono_framebuffer;
+using idfxx::lcd::rgb565;
+using idfxx::lcd::rgb565_framebuffer;
+using idfxx_lcd_test::recording_panel;
+
+namespace {
+
+constexpr const char* TAG = "gfx_bench";
+
+// Runs op() `iterations` times and logs the cost of one run, and the pixel
+// throughput given that each run writes `pixels` pixels.
+template<typename Op>
+void bench(std::string_view name, size_t iterations, size_t pixels, Op&& op) {
+    op(); // warm caches and lazily allocated buffers
+    uint64_t cycles = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        // Per-run deltas: the 32-bit cycle counter wraps within seconds.
+        const uint32_t before = esp_cpu_get_cycle_count();
+        op();
+        cycles += esp_cpu_get_cycle_count() - before;
+    }
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const double pixels_per_second = elapsed > 0 ? static_cast<double>(pixels * iterations) / elapsed : 0;
+    idfxx::log::info(
+        TAG,
+        "{:<36} {:>10} cycles/op {:>8.2f} cycles/px {:>12.0f} px/s",
+        name,
+        cycles / iterations,
+        pixels != 0 ? static_cast<double>(cycles) / static_cast<double>(pixels * iterations) : 0.0,
+        pixels_per_second
+    );
+}
+
+rgb565_framebuffer make_color_fb(size_t width, size_t height) {
+    return std::move(*rgb565_framebuffer::make(width, height));
+}
+
+mono_framebuffer make_fb(size_t width, size_t height) {
+    return std::move(*mono_framebuffer::make(width, height));
+}
+
+// A w x h dashboard-style frame in screen coordinates: a title bar, panels
+// with outlines, a chart of line segments, and text at several scales.
+template<typename Canvas, typename Pixel>
+void draw_dashboard(Canvas& c, size_t w, size_t h, Pixel ink, Pixel accent) {
+    c.fill_rect(0, 0, w, h / 10, accent);
+    c.draw_text(spleen_8x16, 4, 2, "dashboard", ink, 1);
+    for (size_t y = h / 8; y + h / 4 <= h; y += h / 4) {
+        c.draw_rect(4, y, w / 2 - 8, h / 4 - 6, ink);
+        c.draw_text(spleen_8x16, 8, y + 4, "23.7", ink, 2);
+        c.draw_text(spleen_5x8, w / 2 + 4, y + 4, "humidity 41%", ink);
+    }
+    for (size_t x = w / 2; x + 8 < w; x += 8) {
+        c.draw_line(x, h - 1 - (x * 7) % (h / 3), x + 8, h - 1 - ((x + 8) * 7) % (h / 3), accent);
+    }
+}
+
+} // namespace
+
+// =============================================================================
+// Primitives
+// =============================================================================
+
+TEST_CASE("gfx bench fill_rect", "[idfxx][gfx][bench]") {
+    auto color = make_color_fb(240, 40);
+    constexpr rgb565 red(255, 0, 0);
+    bench("rgb565 fill_rect 240x40", 50, 240 * 40, [&] { fill_rect(color, 0, 0, 240, 40, red); });
+    bench("rgb565 fill_rect 16x16", 500, 16 * 16, [&] { fill_rect(color, 7, 9, 16, 16, red); });
+    bench("rgb565 fill_rect 1x40", 500, 40, [&] { fill_rect(color, 7, 0, 1, 40, red); });
+
+    auto mono = make_fb(128, 64);
+    bench("mono fill_rect 128x64", 100, 128 * 64, [&] { fill_rect(mono, 0, 0, 128, 64, true); });
+    bench("mono fill_rect 16x16", 500, 16 * 16, [&] { fill_rect(mono, 7, 9, 16, 16, true); });
+    TEST_ASSERT_TRUE(mono.get_pixel(7, 9));
+}
+
+TEST_CASE("gfx bench draw_line", "[idfxx][gfx][bench]") {
+    auto color = make_color_fb(240, 40);
+    constexpr rgb565 green(0, 255, 0);
+    bench("rgb565 draw_line diagonal 40px", 500, 40, [&] { draw_line(color, 0, 0, 39, 39, green); });
+    bench("rgb565 draw_line shallow 240px", 200, 240, [&] { draw_line(color, 0, 0, 239, 39, green); });
+    bench("rgb565 draw_line clipped 320px", 200, 40, [&] { draw_line(color, 0, 0, 319, 319, green); });
+
+    auto mono = make_fb(128, 64);
+    bench("mono draw_line diagonal 64px", 500, 64, [&] { draw_line(mono, 0, 0, 63, 63, true); });
+    bench("mono draw_line shallow 128px", 200, 128, [&] { draw_line(mono, 0, 0, 127, 63, true); });
+    TEST_ASSERT_TRUE(mono.get_pixel(0, 0));
+}
+
+TEST_CASE("gfx bench draw_text", "[idfxx][gfx][bench]") {
+    constexpr std::string_view text = "23.7 C";
+    constexpr rgb565 white(255, 255, 255);
+    constexpr rgb565 navy(0, 0, 128);
+    auto color = make_color_fb(240, 96);
+    auto mono = make_fb(128, 64);
+    glyph_cache<rgb565> glyphs(32);
+
+    for (unsigned scale : {1u, 2u, 3u}) {
+        const size_t cells = text.size() * 8 * scale * 16 * scale;
+        bench(std::format("rgb565 draw_text 8x16 scale {}", scale), 100, cells, [&] {
+            draw_text(color, spleen_8x16, 0, 0, text, white, scale);
+        });
+        bench(std::format("rgb565 cached text 8x16 scale {}", scale), 100, cells, [&] {
+            draw_text(color, glyphs, spleen_8x16, 0, 0, text, white, navy, scale);
+        });
+        if (scale < 3) {
+            bench(std::format("mono draw_text 8x16 scale {}", scale), 100, cells, [&] {
+                draw_text(mono, spleen_8x16, 0, 0, text, true, scale);
+            });
+        }
+    }
+    bench("mono draw_text 5x8", 200, text.size() * 5 * 8, [&] { draw_text(mono, spleen_5x8, 0, 0, text); });
+    TEST_ASSERT_TRUE(glyphs.hits() > 0);
+}
+
+// =============================================================================
+// Frames and flushes
+// =============================================================================
+
+TEST_CASE("gfx bench render_banded frame by band height", "[idfxx][gfx][bench]") {
+    constexpr rgb565 white(255, 255, 255);
+    constexpr rgb565 teal(0, 128, 128);
+    recording_panel panel;
+
+    // A 240x320 frame through bands of increasing height: smaller bands
+    // save RAM but redraw the whole scene once per band.
+    for (size_t band_height : {10u, 20u, 40u, 80u, 160u}) {
+        auto band = make_color_fb(240, band_height);
+        bench(std::format("rgb565 240x320 frame, {}-row bands", band_height), 5, 240 * 320, [&] {
+            panel.draws.clear();
+            auto rendered = try_render_banded(band, panel, 320, [&](auto& c) {
+                c.clear();
+                draw_dashboard(c, 240, 320, white, teal);
+            });
+            TEST_ASSERT_TRUE(rendered.has_value());
+        });
+        TEST_ASSERT_EQUAL(320 / band_height, panel.draws.size());
+    }
+
+    // Monochrome panels are small enough to render a full frame at once.
+    auto mono = make_fb(128, 64);
+    bench("mono 128x64 frame", 20, 128 * 64, [&] {
+        panel.draws.clear();
+        canvas c(mono);
+        c.clear();
+        draw_dashboard(c, 128, 64, true, true);
+        TEST_ASSERT_TRUE(mono.try_flush(panel).has_value());
+    });
+}
+
+TEST_CASE("gfx bench flush_region by width", "[idfxx][gfx][bench]") {
+    recording_panel panel;
+
+    // Full-width regions are one transfer; narrower ones one per row.
+    auto color = make_color_fb(240, 320);
+    for (size_t width : {8u, 32u, 120u, 240u}) {
+        bench(std::format("rgb565 flush_region {}x64", width), 50, width * 64, [&] {
+            panel.draws.clear();
+            TEST_ASSERT_TRUE(color.try_flush_region(panel, 0, 100, width, 164).has_value());
+        });
+    }
+
+    auto mono = make_fb(128, 64);
+    for (size_t width : {8u, 32u, 128u}) {
+        bench(std::format("mono flush_region {}x32", width), 100, width * 32, [&] {
+            panel.draws.clear();
+            TEST_ASSERT_TRUE(mono.try_flush_region(panel, 0, 16, width, 48).has_value());
+        });
+    }
+}
+
+// =============================================================================
+// Image conversion
+// =============================================================================
+
+TEST_CASE("gfx bench convert_to_rgb565", "[idfxx][gfx][bench]") {
+    using idfxx::lcd::pixel_format;
+    constexpr size_t pixels = 320 * 10;
+    std::vector<uint8_t> src(pixels * 4);
+    for (size_t i = 0; i < src.size(); ++i) {
+        src[i] = static_cast<uint8_t>(i * 37);
+    }
+    std::vector<rgb565> dst(pixels);
+
+    // The per-pixel loop the word kernels replace.
+    bench("rgb888 per-pixel 320x10", 50, pixels, [&] {
+        for (size_t i = 0; i < pixels; ++i) {
+            dst[i] = rgb565(src[i * 3], src[i * 3 + 1], src[i * 3 + 2]);
+        }
+    });
+    for (auto [name, format] : {
+             std::pair{"rgb888", pixel_format::rgb888},
+             std::pair{"argb8888", pixel_format::argb8888},
+             std::pair{"grey8", pixel_format::grey8},
+         }) {
+        bench(std::format("{} convert_to_rgb565 320x10", name), 50, pixels, [&] {
+            idfxx::lcd::convert_to_rgb565(format, src, dst);
+        });
+    }
+    bench("rgb888 convert_to_rgb565 unaligned", 50, pixels - 1, [&] {
+        idfxx::lcd::convert_to_rgb565(pixel_format::rgb888, std::span(src).subspan(1), std::span(dst).subspan(1));
+    });
+    TEST_ASSERT_EQUAL_HEX16(rgb565(src[1], src[2], src[3]).value(), dst[1].value());
+}
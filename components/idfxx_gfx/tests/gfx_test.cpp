@@ -6,6 +6,7 @@
 
 #include "idfxx/font/spleen"
 #include "idfxx/gfx"
+#include "idfxx/lcd/compact_framebuffer"
 #include "idfxx/lcd/mono_framebuffer"
 #include "idfxx/lcd/rgb565_framebuffer"
 #include "unity.h"
@@ -13,7 +14,12 @@
 #include <array>
 #include <concepts>
 #include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
 #include <utility>
+#include <vector>
 
 using namespace idfxx::gfx;
 using idfxx::font::mono_font;
@@ -61,6 +67,47 @@ static_assert(pixel_surface<counting_surface>);
 
 namespace {
 
+// A surface with only the span hook, recording how it is driven.
+struct span_surface {
+    using pixel_type = int;
+
+    std::array<std::array<int, 8>, 8> pixels{};
+    size_t pixel_writes = 0;
+    size_t span_writes = 0;
+
+    void set_pixel(size_t x, size_t y, int value) noexcept {
+        ++pixel_writes;
+        if (x < 8 && y < 8) {
+            pixels[y][x] = value;
+        }
+    }
+    void fill_span(size_t x, size_t y, size_t length, int value) noexcept {
+        ++span_writes;
+        for (size_t i = 0; i < length; ++i) {
+            pixels[y][x + i] = value;
+        }
+    }
+    [[nodiscard]] size_t width() const noexcept { return 8; }
+    [[nodiscard]] size_t height() const noexcept { return 8; }
+};
+
+} // namespace
+
+// Bulk hooks are detected structurally: the framebuffers provide all three,
+// counting_surface none, span_surface only fill_span.
+static_assert(span_fillable<rgb565_framebuffer> && block_fillable<rgb565_framebuffer> && blittable<rgb565_framebuffer>);
+static_assert(span_fillable<mono_framebuffer> && block_fillable<mono_framebuffer> && blittable<mono_framebuffer>);
+static_assert(block_fillable<idfxx::lcd::rgb332_framebuffer> && blittable<idfxx::lcd::rgb332_framebuffer>);
+static_assert(block_fillable<idfxx::lcd::grey4_framebuffer> && blittable<idfxx::lcd::grey4_framebuffer>);
+static_assert(block_fillable<idfxx::lcd::palette_framebuffer> && blittable<idfxx::lcd::palette_framebuffer>);
+static_assert(!span_fillable<counting_surface> && !block_fillable<counting_surface> && !blittable<counting_surface>);
+static_assert(span_fillable<span_surface> && !block_fillable<span_surface> && !blittable<span_surface>);
+
+// A canvas provides the hooks whatever it wraps.
+static_assert(block_fillable<canvas<counting_surface>> && blittable<canvas<counting_surface>>);
+
+namespace {
+
 // A surface with its own flush, proving the canvas forwarders pass
 // arguments and return values through.
 struct flushable_surface {
@@ -245,6 +292,87 @@ TEST_CASE("gfx primitives work on user-defined surfaces", "[idfxx][gfx]") {
     TEST_ASSERT_EQUAL(0, surface.pixels[0][0]);
 }
 
+TEST_CASE("gfx fill_rect routes through the surface's bulk hooks", "[idfxx][gfx]") {
+    span_surface surface;
+    fill_rect(surface, 1, 2, 6, 3, 5);
+    TEST_ASSERT_EQUAL(0, surface.pixel_writes);
+    TEST_ASSERT_EQUAL(3, surface.span_writes); // one per row
+    TEST_ASSERT_EQUAL(5, surface.pixels[2][1]);
+    TEST_ASSERT_EQUAL(5, surface.pixels[4][6]);
+    TEST_ASSERT_EQUAL(0, surface.pixels[5][1]);
+
+    // Clipped runs stay within the surface.
+    fill_rect(surface, 6, 7, 10, 10, 3);
+    TEST_ASSERT_EQUAL(4, surface.span_writes);
+    TEST_ASSERT_EQUAL(3, surface.pixels[7][7]);
+
+    // Text is drawn a run at a time: "-" is a single horizontal stroke.
+    span_surface text;
+    draw_text(text, spleen_5x8, 0, 0, "-", 1);
+    TEST_ASSERT_EQUAL(0, text.pixel_writes);
+    TEST_ASSERT_EQUAL(1, text.span_writes);
+}
+
+TEST_CASE("gfx bulk fills match per-pixel fills on framebuffers", "[idfxx][gfx]") {
+    // Odd offsets and widths exercise unaligned and partial-page edges.
+    constexpr size_t rects[][4] = {{0, 0, 33, 24}, {3, 5, 7, 1}, {1, 3, 30, 13}, {31, 0, 1, 24}, {0, 9, 33, 6}};
+
+    auto mono = make_fb(33, 24);
+    auto mono_expected = make_fb(33, 24);
+    auto color = make_color_fb(33, 24);
+    auto color_expected = make_color_fb(33, 24);
+    bool on = true;
+    for (const auto& r : rects) {
+        const rgb565 ink(on ? 255 : 0, on ? 0 : 255, 0x40);
+        fill_rect(mono, r[0], r[1], r[2], r[3], on);
+        fill_rect(color, r[0], r[1], r[2], r[3], ink);
+        for (size_t y = r[1]; y < r[1] + r[3]; ++y) {
+            for (size_t x = r[0]; x < r[0] + r[2]; ++x) {
+                mono_expected.set_pixel(x, y, on);
+                color_expected.set_pixel(x, y, ink);
+            }
+        }
+        on = !on;
+    }
+    for (size_t y = 0; y < 24; ++y) {
+        for (size_t x = 0; x < 33; ++x) {
+            TEST_ASSERT_EQUAL(mono_expected.get_pixel(x, y), mono.get_pixel(x, y));
+            TEST_ASSERT_TRUE(color_expected.get_pixel(x, y) == color.get_pixel(x, y));
+        }
+    }
+}
+
+TEST_CASE("gfx blit copies and clips a pixel rectangle", "[idfxx][gfx]") {
+    constexpr rgb565 a(255, 0, 0);
+    constexpr rgb565 b(0, 0, 255);
+    // A 3x2 image inside a source with a stride of 4.
+    const std::array<rgb565, 8> image{a, b, a, rgb565{}, b, a, b, rgb565{}};
+
+    auto fb = make_color_fb(8, 8);
+    blit(fb, 6, 2, 3, 2, image.data(), 4);
+    TEST_ASSERT_TRUE(fb.get_pixel(6, 2) == a);
+    TEST_ASSERT_TRUE(fb.get_pixel(7, 2) == b);
+    TEST_ASSERT_TRUE(fb.get_pixel(6, 3) == b);
+    TEST_ASSERT_TRUE(fb.get_pixel(7, 3) == a);
+
+    // Through a translated canvas, the source skips the clipped-off part.
+    auto band = make_color_fb(8, 4);
+    canvas c(band, 0, 4);
+    c.blit(5, 3, 3, 2, image.data(), 4); // source row 0 lies above the band
+    TEST_ASSERT_TRUE(band.get_pixel(5, 0) == b);
+    TEST_ASSERT_TRUE(band.get_pixel(6, 0) == a);
+    TEST_ASSERT_TRUE(band.get_pixel(7, 0) == b);
+    TEST_ASSERT_TRUE(band.get_pixel(5, 1) == rgb565{});
+
+    // Surfaces without the hook receive per-pixel writes.
+    counting_surface surface;
+    const std::array<int, 4> values{1, 2, 3, 4};
+    blit(surface, 7, 0, 2, 2, values.data(), 2);
+    TEST_ASSERT_EQUAL(2, surface.writes);
+    TEST_ASSERT_EQUAL(1, surface.pixels[0][7]);
+    TEST_ASSERT_EQUAL(3, surface.pixels[1][7]);
+}
+
 // =============================================================================
 // Runtime tests: canvas
 // =============================================================================
@@ -467,6 +595,67 @@ TEST_CASE("gfx canvas window composes and clamps", "[idfxx][gfx]") {
     TEST_ASSERT_EQUAL(1, count_set_pixels(fb)); // only the pixel set above
 }
 
+TEST_CASE("gfx canvas clip keeps coordinates and restricts drawing", "[idfxx][gfx]") {
+    auto fb = make_fb(16, 16);
+    canvas c(fb);
+    auto clipped = c.clip(4, 8, 8, 4);
+
+    // Same coordinate space: the far edges are the clip's.
+    TEST_ASSERT_EQUAL(12, clipped.width());
+    TEST_ASSERT_EQUAL(12, clipped.height());
+    clipped.set_pixel(4, 8, true);
+    clipped.set_pixel(3, 8, true);  // left of the clip: dropped
+    clipped.set_pixel(4, 7, true);  // above the clip: dropped
+    clipped.set_pixel(12, 8, true); // right of the clip: dropped
+    TEST_ASSERT_TRUE(fb.get_pixel(4, 8));
+    TEST_ASSERT_EQUAL(1, count_set_pixels(fb));
+
+    // Every primitive stays inside, and fill covers exactly the clip.
+    clipped.draw_line(0, 0, 15, 15, true);
+    clipped.draw_text(spleen_8x16, 0, 0, "AB");
+    clipped.blit(0, 0, 2, 2, std::array<bool, 4>{true, true, true, true}.data(), 2);
+    for (size_t y = 0; y < 16; ++y) {
+        for (size_t x = 0; x < 16; ++x) {
+            if (fb.get_pixel(x, y)) {
+                TEST_ASSERT_TRUE(x >= 4 && x < 12 && y >= 8 && y < 12);
+            }
+        }
+    }
+    clipped.fill(true);
+    TEST_ASSERT_EQUAL(8 * 4, count_set_pixels(fb));
+    TEST_ASSERT_TRUE(clipped.intersects(11, 11, 1, 1));
+    TEST_ASSERT_FALSE(clipped.intersects(0, 0, 4, 16));
+
+    // Clips and windows compose.
+    auto inner = c.clip(2, 2, 4, 4).window(1, 1, 10, 10);
+    TEST_ASSERT_FALSE(inner.intersects(0, 0, 1, 1)); // (1, 1) lies outside the clip
+    inner.fill_rect(0, 0, 10, 10, true);
+    TEST_ASSERT_EQUAL(8 * 4 + 4 * 4, count_set_pixels(fb));
+    TEST_ASSERT_TRUE(fb.get_pixel(2, 2));
+    TEST_ASSERT_FALSE(fb.get_pixel(1, 1));
+}
+
+TEST_CASE("gfx clipped redraw of a band matches a full-frame render", "[idfxx][gfx]") {
+    auto reference = make_fb(32, 32);
+    canvas ref_canvas(reference);
+    draw_band_test_scene(ref_canvas);
+
+    // Redraw a damaged square straddling the band edge over a band of
+    // stale content: only the square changes.
+    auto band = make_fb(32, 16);
+    canvas c(band, 0, 16);
+    c.fill(true);
+    auto damaged = c.clip(8, 12, 16, 8);
+    damaged.clear();
+    draw_band_test_scene(damaged);
+    for (size_t y = 0; y < band.height(); ++y) {
+        for (size_t x = 0; x < band.width(); ++x) {
+            const bool inside = x >= 8 && x < 24 && y + 16 < 20;
+            TEST_ASSERT_EQUAL(inside ? reference.get_pixel(x, 16 + y) : true, band.get_pixel(x, y));
+        }
+    }
+}
+
 // =============================================================================
 // Runtime tests: render_banded
 // =============================================================================
@@ -562,6 +751,517 @@ TEST_CASE("gfx render_banded stops and reports a failed flush", "[idfxx][gfx]")
     TEST_ASSERT_EQUAL(2, passes); // first band flushed, second failed, no further passes
 }
 
+// =============================================================================
+// Runtime tests: glyph_cache
+// =============================================================================
+
+TEST_CASE("gfx cached opaque text matches background fill plus ink text", "[idfxx][gfx]") {
+    constexpr rgb565 ink(255, 255, 0);
+    constexpr rgb565 background(0, 0, 128);
+
+    for (unsigned scale : {1u, 2u, 3u}) {
+        auto reference = make_color_fb(80, 48);
+        canvas ref_canvas(reference);
+        ref_canvas.fill_rect(3, 5, text_width(spleen_8x16, "Ab\x01z", scale), 16 * scale, background);
+        ref_canvas.draw_text(spleen_8x16, 3, 5, "Ab\x01z", ink, scale);
+
+        auto fb = make_color_fb(80, 48);
+        glyph_cache<rgb565> cache(16);
+        canvas c(fb);
+        c.draw_text(cache, spleen_8x16, 3, 5, "Ab\x01z", ink, background, scale);
+
+        for (size_t y = 0; y < 48; ++y) {
+            for (size_t x = 0; x < 80; ++x) {
+                TEST_ASSERT_TRUE(reference.get_pixel(x, y) == fb.get_pixel(x, y));
+            }
+        }
+    }
+}
+
+TEST_CASE("gfx glyph_cache reuses tiles and keys them by colors and scale", "[idfxx][gfx]") {
+    constexpr rgb565 white(255, 255, 255);
+    constexpr rgb565 black{};
+    glyph_cache<rgb565> cache(64);
+    auto fb = make_color_fb(64, 32);
+
+    draw_text(fb, cache, spleen_8x16, 0, 0, "aab", white, black);
+    TEST_ASSERT_EQUAL(1, cache.hits());
+    TEST_ASSERT_EQUAL(2, cache.misses());
+
+    draw_text(fb, cache, spleen_8x16, 0, 16, "ab", white, black);
+    TEST_ASSERT_EQUAL(3, cache.hits());
+
+    // A different color pair or scale is a different tile.
+    draw_text(fb, cache, spleen_8x16, 32, 0, "a", black, white);
+    draw_text(fb, cache, spleen_8x16, 40, 0, "a", white, black, 2);
+    TEST_ASSERT_EQUAL(4, cache.misses());
+
+    const rgb565* tile = cache.tile(spleen_8x16, 'a', 1, black, white);
+    TEST_ASSERT_EQUAL(4, cache.hits());
+    for (size_t i = 0; i < 8 * 16; ++i) {
+        TEST_ASSERT_TRUE(tile[i] == (fb.get_pixel(i % 8, 16 + i / 8) == white ? black : white));
+    }
+
+    cache.clear();
+    TEST_ASSERT_EQUAL(0, cache.hits());
+    (void)cache.tile(spleen_8x16, 'a', 1, white, black);
+    TEST_ASSERT_EQUAL(1, cache.misses());
+}
+
+TEST_CASE("gfx glyph_cache stays correct when slots collide", "[idfxx][gfx]") {
+    glyph_cache<bool> cache(1); // every key shares the single slot
+    auto reference = make_fb(48, 16);
+    canvas(reference).draw_text(spleen_5x8, 0, 4, "abcabc");
+
+    auto fb = make_fb(48, 16);
+    canvas c(fb);
+    c.draw_text(cache, spleen_5x8, 0, 4, "abcabc", true, false);
+    TEST_ASSERT_EQUAL(6, cache.misses());
+    for (size_t y = 0; y < 16; ++y) {
+        for (size_t x = 0; x < 48; ++x) {
+            TEST_ASSERT_EQUAL(reference.get_pixel(x, y), fb.get_pixel(x, y));
+        }
+    }
+}
+
+// =============================================================================
+// Runtime tests: images
+// =============================================================================
+
+namespace {
+
+constexpr rgb565 img_a(255, 0, 0);
+constexpr rgb565 img_b(0, 255, 0);
+constexpr rgb565 img_c(0, 0, 255);
+
+// A 5x3 test image, row-major.
+constexpr std::array<rgb565, 15> image_pixels{
+    img_a, img_a, img_a, img_b, img_c, // row 0
+    img_c, img_c, img_c, img_c, img_c, // row 1
+    img_a, img_b, img_a, img_b, img_a, // row 2
+};
+
+// Appends the in-memory representation of each pixel.
+void append_pixels(std::vector<uint8_t>& out, std::initializer_list<rgb565> pixels) {
+    for (rgb565 p : pixels) {
+        const auto* bytes = reinterpret_cast<const uint8_t*>(&p);
+        out.insert(out.end(), bytes, bytes + sizeof(p));
+    }
+}
+
+// The test image as PackBits packets: runs crossing row ends, and literals
+// at odd (unaligned) offsets.
+std::vector<uint8_t> image_rle() {
+    std::vector<uint8_t> out;
+    out.push_back(0x82); // 3 x a
+    append_pixels(out, {img_a});
+    out.push_back(0x01); // literal b, c
+    append_pixels(out, {img_b, img_c});
+    out.push_back(0x84); // 5 x c: all of row 1
+    append_pixels(out, {img_c});
+    out.push_back(0x04); // literal row 2
+    append_pixels(out, {img_a, img_b, img_a, img_b, img_a});
+    return out;
+}
+
+std::vector<uint8_t> image_raw(size_t offset = 0) {
+    std::vector<uint8_t> out(offset);
+    for (rgb565 p : image_pixels) {
+        append_pixels(out, {p});
+    }
+    return out;
+}
+
+// Checks the test image drawn at (ox, oy), clipped to the framebuffer, with
+// keyed pixels showing the existing background.
+bool matches_image(
+    const rgb565_framebuffer& fb,
+    size_t ox,
+    size_t oy,
+    std::optional<rgb565> key = std::nullopt,
+    rgb565 background = {}
+) {
+    for (size_t y = 0; y < fb.height(); ++y) {
+        for (size_t x = 0; x < fb.width(); ++x) {
+            rgb565 expected = background;
+            if (x >= ox && x < ox + 5 && y >= oy && y < oy + 3) {
+                const rgb565 p = image_pixels[(y - oy) * 5 + (x - ox)];
+                expected = key && p == *key ? background : p;
+            }
+            if (fb.get_pixel(x, y) != expected) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_CASE("gfx draw_image decodes raw and RLE rgb565 images", "[idfxx][gfx]") {
+    const auto raw = image_raw();
+    const auto unaligned = image_raw(1);
+    const auto rle = image_rle();
+    const std::array images{
+        image<rgb565>(5, 3, image_encoding::raw, raw),
+        image<rgb565>(5, 3, image_encoding::raw, std::span(unaligned).subspan(1)),
+        image<rgb565>(5, 3, image_encoding::rle, rle),
+    };
+    for (const auto& img : images) {
+        auto fb = make_color_fb(8, 6);
+        draw_image(fb, 2, 1, img);
+        TEST_ASSERT_TRUE(matches_image(fb, 2, 1));
+
+        // Clipped at the right and bottom edges.
+        auto clipped = make_color_fb(4, 2);
+        draw_image(clipped, 1, 0, img);
+        TEST_ASSERT_TRUE(matches_image(clipped, 1, 0));
+    }
+}
+
+TEST_CASE("gfx draw_image skips pixels matching the color key", "[idfxx][gfx]") {
+    constexpr rgb565 background(40, 40, 40);
+    const auto raw = image_raw();
+    const auto rle = image_rle();
+    for (rgb565 key : {img_a, img_c}) {
+        for (const auto& img : {image<rgb565>(5, 3, image_encoding::raw, raw, key),
+                                image<rgb565>(5, 3, image_encoding::rle, rle).with_key(key)}) {
+            auto fb = make_color_fb(8, 6);
+            fb.fill(background);
+            canvas(fb).draw_image(1, 2, img);
+            TEST_ASSERT_TRUE(matches_image(fb, 1, 2, key, background));
+        }
+    }
+}
+
+TEST_CASE("gfx draw_image renders bands identical to a full frame", "[idfxx][gfx]") {
+    const auto rle = image_rle();
+    const image<rgb565> img(5, 3, image_encoding::rle, rle);
+
+    auto full = make_color_fb(8, 8);
+    draw_image(full, 2, 3, img);
+
+    auto band = make_color_fb(8, 2);
+    for (size_t y = 0; y < 8; y += 2) {
+        canvas c(band, 0, y);
+        c.clear();
+        c.draw_image(2, 3, img);
+        for (size_t row = 0; row < 2; ++row) {
+            for (size_t x = 0; x < 8; ++x) {
+                TEST_ASSERT_TRUE(band.get_pixel(x, row) == full.get_pixel(x, y + row));
+            }
+        }
+    }
+}
+
+TEST_CASE("gfx draw_image decodes raw and RLE 1-bpp images", "[idfxx][gfx]") {
+    // 10x2: row 0 = 1100000011, row 1 = 0011111100.
+    constexpr std::array<uint8_t, 4> raw{0b11000000, 0b11000000, 0b00111111, 0b00000000};
+    constexpr std::array<uint8_t, 6> rle{0x81, 0x05, 0x81, 0x01, 0x85, 0x01};
+    for (const auto& img : {image<bool>(10, 2, image_encoding::raw, raw),
+                            image<bool>(10, 2, image_encoding::rle, rle)}) {
+        auto fb = make_fb(16, 8);
+        fb.fill(true);
+        draw_image(fb, 3, 4, img);
+        for (size_t x = 0; x < 10; ++x) {
+            TEST_ASSERT_EQUAL(x < 2 || x >= 8, fb.get_pixel(3 + x, 4));
+            TEST_ASSERT_EQUAL(x >= 2 && x < 8, fb.get_pixel(3 + x, 5));
+        }
+        TEST_ASSERT_TRUE(fb.get_pixel(13, 4));
+
+        // Keyed on false, only set pixels draw.
+        auto sprite = make_fb(16, 8);
+        draw_image(sprite, 3, 4, img.with_key(false));
+        TEST_ASSERT_EQUAL(4 + 6, count_set_pixels(sprite));
+
+        // Clipped at the right edge.
+        auto clipped = make_fb(8, 8);
+        draw_image(clipped, 4, 0, img);
+        TEST_ASSERT_EQUAL(2 + 2, count_set_pixels(clipped));
+    }
+}
+
+// =============================================================================
+// Runtime tests: display_list
+// =============================================================================
+
+TEST_CASE("gfx canvas::intersects tests against the drawable region", "[idfxx][gfx]") {
+    auto fb = make_fb(32, 16);
+    canvas band(fb, 0, 16); // rows [16, 32) of a 32x32 frame
+
+    TEST_ASSERT_TRUE(band.intersects(0, 16, 1, 1));
+    TEST_ASSERT_TRUE(band.intersects(10, 0, 4, 17)); // reaches row 16
+    TEST_ASSERT_FALSE(band.intersects(10, 0, 4, 16)); // ends just above
+    TEST_ASSERT_FALSE(band.intersects(32, 20, 4, 4)); // right of the frame
+    TEST_ASSERT_FALSE(band.intersects(0, 20, 0, 4));  // empty
+    TEST_ASSERT_TRUE(band.intersects(5, 5, SIZE_MAX, SIZE_MAX));
+
+    auto win = band.window(8, 20, 4, 4); // local (0, 0) is frame (8, 20)
+    TEST_ASSERT_TRUE(win.intersects(3, 3, 1, 1));
+    TEST_ASSERT_FALSE(win.intersects(4, 0, 4, 4));
+}
+
+TEST_CASE("gfx display_list replays to the same pixels as direct drawing", "[idfxx][gfx]") {
+    auto reference = make_fb(32, 32);
+    canvas ref_canvas(reference);
+    draw_band_test_scene(ref_canvas);
+    ref_canvas.draw_line(31, 31, 0, 20, true); // endpoints given right-to-left, bottom-to-top
+
+    display_list<bool> list(32, 32);
+    draw_band_test_scene(list);
+    list.draw_line(31, 31, 0, 20, true);
+    list.fill_rect(4, 4, 0, 8, true); // empty: not recorded
+    TEST_ASSERT_EQUAL(32, list.width());
+    TEST_ASSERT_EQUAL(5, list.size());
+
+    auto band = make_fb(32, 8);
+    for (size_t band_y = 0; band_y < 32; band_y += 8) {
+        canvas c(band, 0, band_y);
+        c.clear();
+        list.replay(c);
+        for (size_t y = 0; y < 8; ++y) {
+            for (size_t x = 0; x < 32; ++x) {
+                TEST_ASSERT_EQUAL(reference.get_pixel(x, band_y + y), band.get_pixel(x, y));
+            }
+        }
+    }
+
+    list.reset();
+    TEST_ASSERT_TRUE(list.empty());
+}
+
+TEST_CASE("gfx display_list clear records a background fill", "[idfxx][gfx]") {
+    const rgb565 white(255, 255, 255);
+    display_list<rgb565> list(16, 8);
+    list.fill(white);
+    list.clear();
+    TEST_ASSERT_EQUAL(2, list.size());
+
+    auto band = make_color_fb(16, 4);
+    canvas c(band, 0, 4);
+    c.fill(white);
+    list.replay(c);
+    for (size_t y = 0; y < 4; ++y) {
+        for (size_t x = 0; x < 16; ++x) {
+            TEST_ASSERT_TRUE(band.get_pixel(x, y) == rgb565{});
+        }
+    }
+
+    list.reset();
+    TEST_ASSERT_TRUE(list.empty());
+}
+
+TEST_CASE("gfx display_list copies recorded text", "[idfxx][gfx]") {
+    display_list<rgb565> list(64, 16);
+    {
+        std::string label = "Hi";
+        list.draw_text(spleen_8x16, 0, 0, label, rgb565(255, 255, 255));
+        label = "--";
+    }
+    auto reference = make_color_fb(64, 16);
+    canvas(reference).draw_text(spleen_8x16, 0, 0, "Hi", rgb565(255, 255, 255));
+
+    auto fb = make_color_fb(64, 16);
+    canvas c(fb);
+    list.replay(c);
+    for (size_t y = 0; y < 16; ++y) {
+        for (size_t x = 0; x < 64; ++x) {
+            TEST_ASSERT_TRUE(reference.get_pixel(x, y) == fb.get_pixel(x, y));
+        }
+    }
+}
+
+TEST_CASE("gfx display_list records opaque text through a glyph cache", "[idfxx][gfx]") {
+    const rgb565 white(255, 255, 255);
+    const rgb565 navy(0, 0, 128);
+    glyph_cache<rgb565> glyphs(16);
+    auto reference = make_color_fb(64, 32);
+    canvas(reference).draw_text(glyphs, spleen_8x16, 4, 10, "Ok!", white, navy, 1);
+
+    display_list<rgb565> list(64, 32);
+    list.draw_text(glyphs, spleen_8x16, 4, 10, "Ok!", white, navy, 1);
+    TEST_ASSERT_EQUAL(1, list.size());
+
+    auto band = make_color_fb(64, 8);
+    for (size_t band_y = 0; band_y < 32; band_y += 8) {
+        canvas c(band, 0, band_y);
+        c.clear();
+        list.replay(c);
+        for (size_t y = 0; y < 8; ++y) {
+            for (size_t x = 0; x < 64; ++x) {
+                TEST_ASSERT_TRUE(reference.get_pixel(x, band_y + y) == band.get_pixel(x, y));
+            }
+        }
+    }
+}
+
+TEST_CASE("gfx display_list records images by reference", "[idfxx][gfx]") {
+    const auto rle = image_rle();
+    const image<rgb565> img(5, 3, image_encoding::rle, rle);
+
+    auto full = make_color_fb(8, 8);
+    draw_image(full, 2, 3, img);
+
+    display_list<rgb565> list(8, 8);
+    list.draw_image(2, 3, img);
+    list.draw_image(2, 3, image<rgb565>(0, 3, image_encoding::rle, rle)); // empty: not recorded
+    TEST_ASSERT_EQUAL(1, list.size());
+
+    auto band = make_color_fb(8, 2);
+    for (size_t y = 0; y < 8; y += 2) {
+        canvas c(band, 0, y);
+        c.clear();
+        list.replay(c);
+        for (size_t row = 0; row < 2; ++row) {
+            for (size_t x = 0; x < 8; ++x) {
+                TEST_ASSERT_TRUE(band.get_pixel(x, row) == full.get_pixel(x, y + row));
+            }
+        }
+    }
+}
+
+// =============================================================================
+// Runtime tests: pipelined render_banded
+// =============================================================================
+
+namespace {
+
+// Records the order of flushes and completed transfers, standing in for a
+// transfer tracker.
+struct transfer_log {
+    struct event {
+        bool flushed; // false for a completed transfer
+        size_t y;
+    };
+    std::vector<event> events;
+    size_t fail_at = SIZE_MAX; // flush index that reports failure
+};
+
+// A 32x8 band surface whose try_flush_async defers the copy into the
+// band_target until its future is waited on, as a DMA transfer reads the
+// buffer after the flush returns. Reusing the band before waiting would
+// corrupt the assembled frame.
+struct async_band {
+    using pixel_type = bool;
+
+    std::array<std::array<bool, 32>, 8> pixels{};
+
+    void set_pixel(size_t x, size_t y, bool on) noexcept {
+        if (x < 32 && y < 8) {
+            pixels[y][x] = on;
+        }
+    }
+    [[nodiscard]] size_t width() const noexcept { return 32; }
+    [[nodiscard]] size_t height() const noexcept { return 8; }
+
+    [[nodiscard]] idfxx::result<idfxx::future<void>>
+    try_flush_async(band_target& target, transfer_log& log, size_t, size_t y) const {
+        if (target.flushes++ == log.fail_at) {
+            return idfxx::error(idfxx::errc::timeout);
+        }
+        log.events.push_back({true, y});
+        auto done = std::make_shared<bool>(false);
+        return idfxx::future<void>{
+            [this, &target, &log, y, done](std::optional<std::chrono::milliseconds>) -> idfxx::result<void> {
+                if (!*done) {
+                    for (size_t row = 0; row < 8; ++row) {
+                        for (size_t col = 0; col < 32; ++col) {
+                            target.pixels[y + row][col] = pixels[row][col];
+                        }
+                    }
+                    log.events.push_back({false, y});
+                    *done = true;
+                }
+                return {};
+            },
+            [done]() noexcept { return *done; },
+        };
+    }
+};
+
+static_assert(pipelined_renderable<async_band, band_target, transfer_log, void (*)(canvas<async_band>&)>);
+static_assert(!pipelined_renderable<flushing_band, band_target, transfer_log, void (*)(canvas<flushing_band>&)>);
+static_assert(pipelined_renderable<
+              rgb565_framebuffer,
+              idfxx::lcd::panel,
+              idfxx::lcd::transfer_tracker,
+              void (*)(canvas<rgb565_framebuffer>&)>);
+
+} // namespace
+
+TEST_CASE("gfx pipelined render_banded overlaps drawing with transfers", "[idfxx][gfx]") {
+    auto reference = make_fb(32, 32);
+    canvas ref_canvas(reference);
+    draw_band_test_scene(ref_canvas);
+
+    std::array<async_band, 2> bands;
+    band_target target;
+    transfer_log log;
+    size_t passes = 0;
+    auto rendered = try_render_banded(std::span(bands), target, log, 32, [&](canvas<async_band>& c) {
+        ++passes;
+        draw_band_test_scene(c);
+    });
+    TEST_ASSERT_TRUE(rendered.has_value());
+    TEST_ASSERT_EQUAL(4, passes);
+
+    // Two bands go out before the first is waited on; each buffer is reused
+    // only after its previous transfer completed; all complete on return.
+    const std::array<transfer_log::event, 8> expected{{
+        {true, 0},
+        {true, 8},
+        {false, 0},
+        {true, 16},
+        {false, 8},
+        {true, 24},
+        {false, 16},
+        {false, 24},
+    }};
+    TEST_ASSERT_EQUAL(expected.size(), log.events.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        TEST_ASSERT_EQUAL(expected[i].flushed, log.events[i].flushed);
+        TEST_ASSERT_EQUAL(expected[i].y, log.events[i].y);
+    }
+
+    for (size_t y = 0; y < 32; ++y) {
+        for (size_t x = 0; x < 32; ++x) {
+            TEST_ASSERT_EQUAL(reference.get_pixel(x, y), target.pixels[y][x]);
+        }
+    }
+}
+
+TEST_CASE("gfx pipelined render_banded validates its bands", "[idfxx][gfx]") {
+    band_target target;
+    transfer_log log;
+    auto draw = [](canvas<async_band>&) {};
+
+    std::span<async_band> none;
+    auto empty = try_render_banded(none, target, log, 32, draw);
+    TEST_ASSERT_FALSE(empty.has_value());
+    TEST_ASSERT_TRUE(idfxx::errc::invalid_arg == empty.error());
+
+    std::vector<async_band> bands(3);
+    auto not_multiple = try_render_banded(std::span(bands), target, log, 12, draw);
+    TEST_ASSERT_FALSE(not_multiple.has_value());
+    TEST_ASSERT_TRUE(idfxx::errc::invalid_arg == not_multiple.error());
+    TEST_ASSERT_EQUAL(0, target.flushes);
+}
+
+TEST_CASE("gfx pipelined render_banded drains transfers after a failed flush", "[idfxx][gfx]") {
+    std::array<async_band, 2> bands;
+    band_target target;
+    transfer_log log;
+    log.fail_at = 2; // third flush fails
+
+    auto rendered = try_render_banded(std::span(bands), target, log, 32, [](canvas<async_band>&) {});
+    TEST_ASSERT_FALSE(rendered.has_value());
+    TEST_ASSERT_TRUE(idfxx::errc::timeout == rendered.error());
+
+    // Both submitted bands completed before the error was returned.
+    TEST_ASSERT_EQUAL(4, log.events.size());
+    TEST_ASSERT_FALSE(log.events.back().flushed);
+}
+
 #ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
 TEST_CASE("gfx render_banded throws on error", "[idfxx][gfx]") {
     flushing_band band;
@@ -0,0 +1,979 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+#pragma once
+
+/**
+ * @headerfile <idfxx/gfx/widgets>
+ * @file widgets.hpp
+ * @brief Retained-mode widgets that redraw only what changed.
+ *
+ * @defgroup idfxx_gfx_widgets Graphics Widgets Component
+ * @brief Labels, bars, meters, charts, and containers with damage tracking.
+ *
+ * Immediate-mode drawing redraws the whole frame every time anything
+ * changes. The widgets here are retained instead: each one keeps the state
+ * it last drew and, when a setter changes something visible, records the
+ * rectangle that now needs redrawing — a label only the cells after the
+ * first changed character, a bar only the strip between its old and new
+ * fill edges. A @ref idfxx::gfx::scene collects that damage and redraws
+ * just the damaged rectangles, clipped so the pixels around them are left
+ * alone; with band rendering, bands no damage touches are neither drawn
+ * nor transferred.
+ *
+ * @code
+ * using idfxx::lcd::rgb565;
+ * idfxx::gfx::scene<rgb565> ui(240, 320, rgb565{});
+ * idfxx::gfx::label<rgb565> title({8, 8, 232, 40}, idfxx::font::spleen_8x16, "pressure", white, 2);
+ * idfxx::gfx::bar<rgb565> level({8, 60, 232, 84}, 0, 100, green, rgb565{}, white);
+ * ui.add(title);
+ * ui.add(level);
+ *
+ * idfxx::lcd::rgb565_framebuffer band(240, 40);
+ * for (;;) {
+ *     level.set_value(read_pressure());
+ *     ui.render_banded(band, panel); // draws and sends only the changed strip
+ * }
+ * @endcode
+ * @{
+ */
+
+#include <idfxx/error.hpp>
+#include <idfxx/font.hpp>
+#include <idfxx/gfx.hpp>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @headerfile <idfxx/gfx/widgets>
+ * @brief Drawing primitives and the pixel surface concept.
+ */
+namespace idfxx::gfx {
+
+/**
+ * @headerfile <idfxx/gfx/widgets>
+ * @brief A rectangle of pixels, spanning columns `[x_start, x_end)` and rows `[y_start, y_end)`.
+ */
+struct rect {
+    size_t x_start = 0; ///< First column, inclusive.
+    size_t y_start = 0; ///< First row, inclusive.
+    size_t x_end = 0;   ///< End column, exclusive.
+    size_t y_end = 0;   ///< End row, exclusive.
+
+    /** @brief Returns true if the rectangle covers no pixels. */
+    [[nodiscard]] constexpr bool empty() const noexcept { return x_start >= x_end || y_start >= y_end; }
+
+    /** @brief Returns the width in pixels. */
+    [[nodiscard]] constexpr size_t width() const noexcept { return empty() ? 0 : x_end - x_start; }
+
+    /** @brief Returns the height in pixels. */
+    [[nodiscard]] constexpr size_t height() const noexcept { return empty() ? 0 : y_end - y_start; }
+
+    /** @brief Returns true if every pixel of @p other is also covered by this rectangle. */
+    [[nodiscard]] constexpr bool contains(const rect& other) const noexcept {
+        return other.x_start >= x_start && other.x_end <= x_end && other.y_start >= y_start && other.y_end <= y_end;
+    }
+
+    /** @brief Returns true if the two rectangles share at least one pixel. */
+    [[nodiscard]] constexpr bool intersects(const rect& other) const noexcept {
+        return !empty() && !other.empty() && x_start < other.x_end && other.x_start < x_end &&
+            y_start < other.y_end && other.y_start < y_end;
+    }
+
+    /** @brief Returns the pixels covered by both rectangles (empty if they do not intersect). */
+    [[nodiscard]] constexpr rect intersection(const rect& other) const noexcept {
+        if (!intersects(other)) {
+            return {};
+        }
+        return {
+            std::max(x_start, other.x_start),
+            std::max(y_start, other.y_start),
+            std::min(x_end, other.x_end),
+            std::min(y_end, other.y_end),
+        };
+    }
+
+    /**
+     * @brief Returns the smallest rectangle covering both this rectangle and @p other.
+     *
+     * An empty rectangle contributes nothing, so the bounds of an empty
+     * rectangle and @p other are @p other.
+     */
+    [[nodiscard]] constexpr rect bounds(const rect& other) const noexcept {
+        if (empty()) {
+            return other;
+        }
+        if (other.empty()) {
+            return *this;
+        }
+        return {
+            std::min(x_start, other.x_start),
+            std::min(y_start, other.y_start),
+            std::max(x_end, other.x_end),
+            std::max(y_end, other.y_end),
+        };
+    }
+
+    /** @brief Compares two rectangles for equality. */
+    constexpr bool operator==(const rect&) const noexcept = default;
+};
+
+/**
+ * @headerfile <idfxx/gfx/widgets>
+ * @brief Base class for retained-mode widgets.
+ *
+ * A widget occupies a fixed rectangle of the frame (its @ref bounds),
+ * draws itself into a @ref display_list on request, and accumulates the
+ * rectangle that has changed since it was last drawn (its @ref damage).
+ * A new widget is entirely damaged, so it appears on the first render.
+ *
+ * Widgets draw "ink only" over whatever lies beneath them — the scene
+ * background and any containers they sit in — and must not draw outside
+ * their bounds. Siblings should not overlap.
+ *
+ * A widget is registered with a @ref scene or @ref container by
+ * reference, so it is neither copyable nor movable and must outlive
+ * them.
+ *
+ * Derived classes implement the private `do_draw` hook and report changes
+ * through the protected @ref add_damage; containers also implement
+ * `do_children`.
+ *
+ * @tparam Pixel The ink type, matching the surfaces the widget is drawn on.
+ */
+template<typename Pixel>
+class widget {
+public:
+    /** @brief The ink type. */
+    using pixel_type = Pixel;
+
+    virtual ~widget() = default;
+
+    widget(const widget&) = delete;
+    widget& operator=(const widget&) = delete;
+    widget(widget&&) = delete;
+    widget& operator=(widget&&) = delete;
+
+    /** @brief Returns the rectangle the widget occupies, in frame coordinates. */
+    [[nodiscard]] const rect& bounds() const noexcept { return _bounds; }
+
+    /** @brief Returns the rectangle changed since the widget was last drawn (empty if none). */
+    [[nodiscard]] const rect& damage() const noexcept { return _damage; }
+
+    /** @brief Returns true if part of the widget needs redrawing. */
+    [[nodiscard]] bool dirty() const noexcept { return !_damage.empty(); }
+
+    /** @brief Marks the whole widget for redrawing. */
+    void invalidate() noexcept { _damage = _bounds; }
+
+    /** @brief Forgets the accumulated damage, e.g. once a scene has taken it over. */
+    void mark_clean() noexcept { _damage = {}; }
+
+    /**
+     * @brief Records the widget's drawing commands, in frame coordinates.
+     *
+     * Children of a container are not included; the scene visits them
+     * separately.
+     *
+     * @param out The display list to record into.
+     */
+    void draw(display_list<Pixel>& out) const { do_draw(out); }
+
+    /** @brief Returns the widgets drawn on top of this one, in drawing order. */
+    [[nodiscard]] std::span<widget* const> children() const noexcept { return do_children(); }
+
+protected:
+    /**
+     * @brief Creates a widget occupying @p bounds, entirely damaged.
+     *
+     * @param bounds The rectangle the widget occupies, in frame coordinates.
+     */
+    explicit widget(const rect& bounds) noexcept
+        : _bounds(bounds)
+        , _damage(bounds) {}
+
+    /**
+     * @brief Adds a changed rectangle to the widget's damage.
+     *
+     * The rectangle is clipped to the widget's bounds; the damage grows to
+     * the smallest rectangle covering both.
+     *
+     * @param r The changed rectangle, in frame coordinates.
+     */
+    void add_damage(const rect& r) noexcept { _damage = _damage.bounds(r.intersection(_bounds)); }
+
+private:
+    virtual void do_draw(display_list<Pixel>& out) const = 0;
+    [[nodiscard]] virtual std::span<widget* const> do_children() const noexcept { return {}; }
+
+    rect _bounds;
+    rect _damage;
+};
+
+/**
+ * @headerfile <idfxx/gfx/widgets>
+ * @brief A filled panel, optionally outlined, that other widgets sit on.
+ *
+ * Children are drawn on top of the container in the order they were
+ * added, and should lie within its bounds. Changing a child damages only
+ * the child; changing the container's own colors damages everything on
+ * it.
+ *
+ * @tparam Pixel The ink type.
+ */
+template<typename Pixel>
+class container : public widget<Pixel> {
+public:
+    /**
+     * @brief Creates an empty container.
+     *
+     * @param bounds     The rectangle the container occupies.
+     * @param background The fill color.
+     * @param border     The outline color, or `std::nullopt` for no outline.
+     */
+    container(const rect& bounds, Pixel background, std::optional<Pixel> border = std::nullopt) noexcept
+        : widget<Pixel>(bounds)
+        , _background(background)
+        , _border(border) {}
+
+    /**
+     * @brief Adds a widget on top of the container.
+     *
+     * @param child The widget to add; must outlive the container.
+     */
+    void add(widget<Pixel>& child) { _children.push_back(&child); }
+
+    /** @brief Returns the fill color. */
+    [[nodiscard]] Pixel background() const noexcept { return _background; }
+
+    /** @brief Sets the fill color, damaging the container if it changed. */
+    void set_background(Pixel background) noexcept {
+        if (!(background == _background)) {
+            _background = background;
+            this->invalidate();
+        }
+    }
+
+private:
+    void do_draw(display_list<Pixel>& out) const override {
+        const rect& b = this->bounds();
+        out.fill_rect(b.x_start, b.y_start, b.width(), b.height(), _background);
+        if (_border) {
+            out.draw_rect(b.x_start, b.y_start, b.width(), b.height(), *_border);
+        }
+    }
+
+    [[nodiscard]] std::span<widget<Pixel>* const> do_children() const noexcept override { return _children; }
+
+    Pixel _background;
+    std::optional<Pixel> _border;
+    std::vector<widget<Pixel>*> _children;
+};
+
+/**
+ * @headerfile <idfxx/gfx/widgets>
+ * @brief A single line of text.
+ *
+ * The text is drawn from the top-left corner of the bounds; characters
+ * that would not fit entirely within the bounds are not drawn. Changing
+ * the text damages only the character cells from the first difference
+ * onward, so a readout going from "23.7" to "23.8" redraws one cell.
+ *
+ * @tparam Pixel The ink type.
+ */
+template<typename Pixel>
+class label : public widget<Pixel> {
+public:
+    /**
+     * @brief Creates a label.
+     *
+     * @param bounds The rectangle the label occupies.
+     * @param font   Font to render with; must outlive the label.
+     * @param text   The initial text; copied.
+     * @param ink    The text color.
+     * @param scale  Integer magnification factor (>= 1; 0 is treated as 1).
+     */
+    label(const rect& bounds, const font::mono_font& font, std::string_view text, Pixel ink, unsigned scale = 1)
+        : widget<Pixel>(bounds)
+        , _font(&font)
+        , _text(text)
+        , _ink(ink)
+        , _scale(std::max(scale, 1u)) {}
+
+    /** @brief Returns the text. */
+    [[nodiscard]] std::string_view text() const noexcept { return _text; }
+
+    /** @brief Returns the text color. */
+    [[nodiscard]] Pixel ink() const noexcept { return _ink; }
+
+    /**
+     * @brief Replaces the text, damaging the cells from the first changed character on.
+     *
+     * @param text The new text; copied.
+     */
+    void set_text(std::string_view text) {
+        const auto changed = std::ranges::mismatch(_text, text).in1;
+        const auto first = static_cast<size_t>(changed - _text.begin());
+        const size_t last = std::max(_text.size(), text.size());
+        if (first == last) {
+            return;
+        }
+        _damage_cells(first, last);
+        _text.assign(text);
+    }
+
+    /** @brief Sets the text color, damaging the text if it changed. */
+    void set_ink(Pixel ink) noexcept {
+        if (!(ink == _ink)) {
+            _ink = ink;
+            _damage_cells(0, _text.size());
+        }
+    }
+
+private:
+    [[nodiscard]] size_t _cell_width() const noexcept { return size_t{_font->width} * _scale; }
+
+    // The number of characters that fit entirely within the bounds.
+    [[nodiscard]] size_t _visible() const noexcept {
+        const size_t cell = _cell_width();
+        return std::min(_text.size(), cell == 0 ? size_t{0} : this->bounds().width() / cell);
+    }
+
+    void _damage_cells(size_t first, size_t last) noexcept {
+        const rect& b = this->bounds();
+        const size_t cell = _cell_width();
+        this->add_damage({
+            b.x_start + first * cell,
+            b.y_start,
+            b.x_start + last * cell,
+            b.y_start + size_t{_font->height} * _scale,
+        });
+    }
+
+    void do_draw(display_list<Pixel>& out) const override {
+        const rect& b = this->bounds();
+        out.draw_text(*_font, b.x_start, b.y_start, std::string_view(_text).substr(0, _visible()), _ink, _scale);
+    }
+
+    const font::mono_font* _font;
+    std::string _text;
+    Pixel _ink;
+    unsigned _scale;
+};
+
+/**
+ * @headerfile <idfxx/gfx/widgets>
+ * @brief A horizontal bar filled in proportion to a value.
+ *
+ * A one-pixel outline surrounds the track; the track fills from the left
+ * with the ink color in proportion to the value's position between the
+ * minimum and maximum, and shows the track color beyond. Changing the
+ * value damages only the strip between the old and new fill edges — and
+ * nothing at all if the fill edge stays on the same pixel column.
+ *
+ * @tparam Pixel The ink type.
+ */
+template<typename Pixel>
+class bar : public widget<Pixel> {
+public:
+    /**
+     * @brief Creates a bar showing @p min.
+     *
+     * @param bounds The rectangle the bar occupies, including its outline.
+     * @param min    The value shown as an empty bar.
+     * @param max    The value shown as a full bar.
+     * @param ink    The fill color.
+     * @param track  The color of the unfilled part.
+     * @param border The outline color.
+     */
+    bar(const rect& bounds, int min, int max, Pixel ink, Pixel track, Pixel border) noexcept
+        : widget<Pixel>(bounds)
+        , _min(min)
+        , _max(max)
+        , _value(min)
+        , _ink(ink)
+        , _track(track)
+        , _border(border) {}
+
+    /** @brief Returns the value, clamped to `[min, max]`. */
+    [[nodiscard]] int value() const noexcept { return _value; }
+
+    /**
+     * @brief Sets the value, damaging the strip between the old and new fill edges.
+     *
+     * @param value The new value; clamped to `[min, max]`.
+     */
+    void set_value(int value) noexcept {
+        value = std::clamp(value, std::min(_min, _max), std::max(_min, _max));
+        const size_t before = _fill(_value);
+        const size_t after = _fill(value);
+        _value = value;
+        if (before != after) {
+            const rect in = _inner();
+            this->add_damage({in.x_start + std::min(before, after), in.y_start, in.x_start + std::max(before, after), in.y_end});
+        }
+    }
+
+    /** @brief Sets the fill color, damaging the filled part if it changed. */
+    void set_ink(Pixel ink) noexcept {
+        if (!(ink == _ink)) {
+            _ink = ink;
+            const rect in = _inner();
+            this->add_damage({in.x_start, in.y_start, in.x_start + _fill(_value), in.y_end});
+        }
+    }
+
+private:
+    // The track, inside the outline.
+    [[nodiscard]] rect _inner() const noexcept {
+        const rect& b = this->bounds();
+        if (b.width() < 2 || b.height() < 2) {
+            return {};
+        }
+        return {b.x_start + 1, b.y_start + 1, b.x_end - 1, b.y_end - 1};
+    }
+
+    // The filled width of the track for a value, in pixels.
+    [[nodiscard]] size_t _fill(int value) const noexcept {
+        if (_max == _min) {
+            return 0;
+        }
+        const auto span = static_cast<int64_t>(_max) - _min;
+        return static_cast<size_t>((static_cast<int64_t>(value) - _min) * static_cast<int64_t>(_inner().width()) / span);
+    }
+
+    void do_draw(display_list<Pixel>& out) const override {
+        const rect& b = this->bounds();
+        const rect in = _inner();
+        const size_t filled = _fill(_value);
+        out.draw_rect(b.x_start, b.y_start, b.width(), b.height(), _border);
+        out.fill_rect(in.x_start, in.y_start, filled, in.height(), _ink);
+        out.fill_rect(in.x_start + filled, in.y_start, in.width() - filled, in.height(), _track);
+    }
+
+    int _min;
+    int _max;
+    int _value;
+    Pixel _ink;
+    Pixel _track;
+    Pixel _border;
+};
+
+/**
+ * @headerfile <idfxx/gfx/widgets>
+ * @brief A segmented level meter whose segments change color by zone.
+ *
+ * The bounds are divided into equal segments separated by a gap. The
+ * value lights segments from the left, one per `(max - min) / segments`;
+ * each lit segment takes the ink of the highest zone starting at or below
+ * the segment's lower value (or the default lit ink below every zone), so
+ * a meter can run green, then amber, then red. Changing the value damages
+ * only the segments that switch on or off.
+ *
+ * @tparam Pixel The ink type.
+ */
+template<typename Pixel>
+class meter : public widget<Pixel> {
+public:
+    /** @brief A range of values whose segments light in their own color. */
+    struct zone {
+        int from;  ///< Lowest segment value lit in this zone's ink.
+        Pixel ink; ///< The ink for lit segments in the zone.
+    };
+
+    /** @brief Maximum number of zones held; further zones are ignored. */
+    static constexpr size_t max_zones = 4;
+
+    /**
+     * @brief Creates a meter showing @p min (no segments lit).
+     *
+     * @param bounds   The rectangle the meter occupies.
+     * @param segments Number of segments (at least 1).
+     * @param min      The value lighting no segments.
+     * @param max      The value lighting every segment.
+     * @param lit      The ink for lit segments below every zone.
+     * @param unlit    The ink for unlit segments.
+     * @param gap      Pixels between adjacent segments.
+     */
+    meter(const rect& bounds, size_t segments, int min, int max, Pixel lit, Pixel unlit, size_t gap = 1) noexcept
+        : widget<Pixel>(bounds)
+        , _segments(std::max(segments, size_t{1}))
+        , _gap(gap)
+        , _min(min)
+        , _max(max)
+        , _value(min)
+        , _lit(lit)
+        , _unlit(unlit) {}
+
+    /** @brief Returns the value, clamped to `[min, max]`. */
+    [[nodiscard]] int value() const noexcept { return _value; }
+
+    /**
+     * @brief Sets the value, damaging the segments that switch on or off.
+     *
+     * @param value The new value; clamped to `[min, max]`.
+     */
+    void set_value(int value) noexcept {
+        value = std::clamp(value, std::min(_min, _max), std::max(_min, _max));
+        const size_t before = _lit_count(_value);
+        const size_t after = _lit_count(value);
+        _value = value;
+        if (before != after) {
+            const rect first = _segment(std::min(before, after));
+            const rect last = _segment(std::max(before, after) - 1);
+            this->add_damage(first.bounds(last));
+        }
+    }
+
+    /**
+     * @brief Replaces the color zones, damaging the meter.
+     *
+     * @param zones The zones, in increasing order of @ref zone::from; at
+     *              most @ref max_zones are kept.
+     */
+    void set_zones(std::span<const zone> zones) noexcept {
+        _zone_count = std::min(zones.size(), max_zones);
+        std::copy_n(zones.begin(), _zone_count, _zones.begin());
+        this->invalidate();
+    }
+
+private:
+    // The segment's rectangle; segments share out the gaps' rounding.
+    [[nodiscard]] rect _segment(size_t i) const noexcept {
+        const rect& b = this->bounds();
+        const size_t pitch = b.width() + _gap;
+        const size_t left = b.x_start + i * pitch / _segments;
+        const size_t right = b.x_start + (i + 1) * pitch / _segments;
+        return {left, b.y_start, std::max(left, right - std::min(_gap, right)), b.y_end};
+    }
+
+    [[nodiscard]] size_t _lit_count(int value) const noexcept {
+        if (_max == _min) {
+            return 0;
+        }
+        const auto span = static_cast<int64_t>(_max) - _min;
+        return static_cast<size_t>((static_cast<int64_t>(value) - _min) * static_cast<int64_t>(_segments) / span);
+    }
+
+    [[nodiscard]] Pixel _segment_ink(size_t i) const noexcept {
+        const auto span = static_cast<int64_t>(_max) - _min;
+        const auto lower = static_cast<int64_t>(_min) + span * static_cast<int64_t>(i) / static_cast<int64_t>(_segments);
+        Pixel ink = _lit;
+        for (size_t z = 0; z < _zone_count; ++z) {
+            if (_zones[z].from <= lower) {
+                ink = _zones[z].ink;
+            }
+        }
+        return ink;
+    }
+
+    void do_draw(display_list<Pixel>& out) const override {
+        const size_t lit = _lit_count(_value);
+        for (size_t i = 0; i < _segments; ++i) {
+            const rect s = _segment(i);
+            out.fill_rect(s.x_start, s.y_start, s.width(), s.height(), i < lit ? _segment_ink(i) : _unlit);
+        }
+    }
+
+    size_t _segments;
+    size_t _gap;
+    int _min;
+    int _max;
+    int _value;
+    Pixel _lit;
+    Pixel _unlit;
+    std::array<zone, max_zones> _zones{};
+    size_t _zone_count = 0;
+};
+
+/**
+ * @headerfile <idfxx/gfx/widgets>
+ * @brief A sweeping line chart of the most recent samples.
+ *
+ * A one-pixel frame surrounds the plot. Samples are spread evenly across
+ * the plot's width and joined into a polyline; values are clamped to
+ * `[min, max]`, with larger values higher up. Like an oscilloscope trace,
+ * a new sample replaces the oldest one in place rather than scrolling the
+ * plot, with a gap separating the newest sample from the oldest — so
+ * each @ref push damages only the few columns around the new point.
+ *
+ * @tparam Pixel The ink type.
+ */
+template<typename Pixel>
+class chart : public widget<Pixel> {
+public:
+    /**
+     * @brief Creates an empty chart.
+     *
+     * @param bounds   The rectangle the chart occupies, including its frame.
+     * @param capacity Number of samples shown across the plot (at least 2).
+     * @param min      The value plotted on the bottom row.
+     * @param max      The value plotted on the top row.
+     * @param ink      The line color.
+     * @param frame    The frame color.
+     */
+    chart(const rect& bounds, size_t capacity, int min, int max, Pixel ink, Pixel frame)
+        : widget<Pixel>(bounds)
+        , _samples(std::max(capacity, size_t{2}))
+        , _min(min)
+        , _max(max)
+        , _ink(ink)
+        , _frame(frame) {}
+
+    /** @brief Returns the number of samples shown across the plot. */
+    [[nodiscard]] size_t capacity() const noexcept { return _samples.size(); }
+
+    /** @brief Returns the number of samples held (at most @ref capacity). */
+    [[nodiscard]] size_t size() const noexcept { return _count; }
+
+    /**
+     * @brief Adds a sample, replacing the oldest once the chart is full.
+     *
+     * Damages the columns between the previous and next sample positions.
+     *
+     * @param value The sample value.
+     */
+    void push(int value) noexcept {
+        const size_t slot = _next;
+        _samples[slot] = value;
+        _next = (slot + 1) % _samples.size();
+        _count = std::min(_count + 1, _samples.size());
+        const rect plot = _plot();
+        this->add_damage({
+            _column(slot == 0 ? 0 : slot - 1),
+            plot.y_start,
+            _column(std::min(slot + 1, _samples.size() - 1)) + 1,
+            plot.y_end,
+        });
+    }
+
+    /** @brief Removes every sample, damaging the plot. */
+    void clear() noexcept {
+        _count = 0;
+        _next = 0;
+        this->add_damage(_plot());
+    }
+
+private:
+    // The plot area, inside the frame.
+    [[nodiscard]] rect _plot() const noexcept {
+        const rect& b = this->bounds();
+        if (b.width() < 3 || b.height() < 3) {
+            return {};
+        }
+        return {b.x_start + 1, b.y_start + 1, b.x_end - 1, b.y_end - 1};
+    }
+
+    [[nodiscard]] size_t _column(size_t slot) const noexcept {
+        const rect plot = _plot();
+        if (plot.empty()) {
+            return plot.x_start;
+        }
+        return plot.x_start + slot * (plot.width() - 1) / (_samples.size() - 1);
+    }
+
+    [[nodiscard]] size_t _row(int value) const noexcept {
+        const rect plot = _plot();
+        const int lo = std::min(_min, _max);
+        const int hi = std::max(_min, _max);
+        if (lo == hi) {
+            return plot.y_end - 1;
+        }
+        const auto above = static_cast<int64_t>(std::clamp(value, lo, hi)) - lo;
+        return plot.y_end - 1 - static_cast<size_t>(above * static_cast<int64_t>(plot.height() - 1) / (hi - lo));
+    }
+
+    void do_draw(display_list<Pixel>& out) const override {
+        const rect& b = this->bounds();
+        out.draw_rect(b.x_start, b.y_start, b.width(), b.height(), _frame);
+        if (_plot().empty()) {
+            return;
+        }
+        // Segment k joins slots k - 1 and k; the one entering the next
+        // slot to be written is the gap after the newest sample.
+        for (size_t k = 1; k < _count; ++k) {
+            if (k != _next) {
+                out.draw_line(_column(k - 1), _row(_samples[k - 1]), _column(k), _row(_samples[k]), _ink);
+            }
+        }
+    }
+
+    std::vector<int> _samples;
+    size_t _count = 0;
+    size_t _next = 0;
+    int _min;
+    int _max;
+    Pixel _ink;
+    Pixel _frame;
+};
+
+/**
+ * @cond INTERNAL
+ * @brief Constraint for damage-driven banded rendering: the band forgets
+ * its own damage on request and flushes only its damaged rectangles to the
+ * destination at an offset.
+ */
+template<typename Surface, typename Dest>
+concept damage_flushable = pixel_surface<Surface> && requires(Surface& s, Dest& dest) {
+    s.mark_clean();
+    { s.try_flush_dirty(dest, size_t{}, size_t{}) } -> std::same_as<result<void>>;
+};
+/** @endcond */
+
+/**
+ * @headerfile <idfxx/gfx/widgets>
+ * @brief The root of a widget tree, redrawing only damaged regions.
+ *
+ * A scene covers a whole frame filled with a background color, with
+ * widgets added on top in drawing order. Rendering gathers every widget's
+ * damage into a short list of rectangles (overlapping ones merged), then
+ * for each rectangle fills the background and replays the widgets touching
+ * it on a canvas clipped to the rectangle (see @ref canvas::clip). Pixels
+ * outside the damage are never written, so an update costs in proportion
+ * to what changed rather than to the frame.
+ *
+ * Two ways to render:
+ * - @ref render draws into a full-frame surface, e.g. an
+ *   `idfxx::lcd::mono_framebuffer`, whose own damage tracking then lets
+ *   `flush_dirty` send just the changed rectangles.
+ * - @ref render_banded draws through a band buffer, e.g. an
+ *   `idfxx::lcd::rgb565_framebuffer`, visiting only the bands some damage
+ *   touches and sending only the damaged rectangles of each.
+ *
+ * The scene's commands are recorded once per render into an internal
+ * @ref display_list that keeps its capacity, so steady-state updates do
+ * not allocate.
+ *
+ * @tparam Pixel The ink type, matching the surfaces the scene renders to.
+ */
+template<typename Pixel>
+class scene {
+public:
+    /** @brief The ink type. */
+    using pixel_type = Pixel;
+
+    /**
+     * @brief Creates an empty scene, entirely damaged so the first render draws the whole frame.
+     *
+     * @param width      Frame width, in pixels.
+     * @param height     Frame height, in pixels.
+     * @param background The color behind every widget.
+     */
+    scene(size_t width, size_t height, Pixel background)
+        : _width(width)
+        , _height(height)
+        , _background(background)
+        , _list(width, height) {
+        invalidate();
+    }
+
+    /** @brief Returns the frame width, in pixels. */
+    [[nodiscard]] size_t width() const noexcept { return _width; }
+
+    /** @brief Returns the frame height, in pixels. */
+    [[nodiscard]] size_t height() const noexcept { return _height; }
+
+    /**
+     * @brief Adds a widget on top of those already added.
+     *
+     * @param w The widget to add; must outlive the scene.
+     */
+    void add(widget<Pixel>& w) { _widgets.push_back(&w); }
+
+    /** @brief Marks the whole frame for redrawing, e.g. after the panel was reset. */
+    void invalidate() {
+        _damage.clear();
+        _damage.push_back({0, 0, _width, _height});
+    }
+
+    /**
+     * @brief Gathers the widgets' damage and returns the rectangles the next render redraws.
+     *
+     * The widgets are marked clean: their damage now belongs to the scene,
+     * and stays there until a render succeeds.
+     *
+     * @return The damaged rectangles, clipped to the frame; they do not overlap.
+     */
+    [[nodiscard]] std::span<const rect> damage() {
+        for (widget<Pixel>* w : _widgets) {
+            _collect(*w);
+        }
+        return _damage;
+    }
+
+    /**
+     * @brief Redraws the damaged rectangles of the frame on a full-frame surface.
+     *
+     * @tparam Surface The surface type, with a matching pixel type.
+     * @param surface  The surface holding the whole frame.
+     */
+    template<pixel_surface Surface>
+        requires std::same_as<typename Surface::pixel_type, pixel_type>
+    void render(Surface& surface) {
+        const auto regions = damage();
+        if (regions.empty()) {
+            return;
+        }
+        _record();
+        canvas c(surface);
+        for (const rect& r : regions) {
+            _redraw(c, r);
+        }
+        _damage.clear();
+    }
+
+#ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
+    /**
+     * @brief Redraws and sends the damaged rectangles of the frame through a band buffer.
+     *
+     * Steps through the frame in slices of `band.height()` rows, as
+     * @ref gfx::render_banded "render_banded" does, but skips every band no
+     * damage touches. In the others, each damaged rectangle is redrawn on
+     * the band and only those rectangles are sent, with
+     * `band.try_flush_dirty(dest, 0, y)` — so the band's stale content
+     * elsewhere never reaches the panel.
+     *
+     * @tparam Surface The band's surface type, with a matching pixel type.
+     * @tparam Dest    The flush destination type (e.g. a panel).
+     * @param band The framebuffer to render through; its width should be the frame width.
+     * @param dest The destination the band flushes to.
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on error (e.g. a frame height the band does
+     *         not tile, or a failed flush), leaving the damage pending.
+     */
+    template<pixel_surface Surface, typename Dest>
+        requires std::same_as<typename Surface::pixel_type, pixel_type> && damage_flushable<Surface, Dest>
+    void render_banded(Surface& band, Dest& dest) {
+        unwrap(try_render_banded(band, dest));
+    }
+#endif
+
+    /**
+     * @brief Redraws and sends the damaged rectangles of the frame through a band buffer.
+     *
+     * Steps through the frame in slices of `band.height()` rows, as
+     * @ref gfx::try_render_banded "try_render_banded" does, but skips every
+     * band no damage touches. In the others, each damaged rectangle is
+     * redrawn on the band and only those rectangles are sent, with
+     * `band.try_flush_dirty(dest, 0, y)` — so the band's stale content
+     * elsewhere never reaches the panel.
+     *
+     * @tparam Surface The band's surface type, with a matching pixel type.
+     * @tparam Dest    The flush destination type (e.g. a panel).
+     * @param band The framebuffer to render through; its width should be the frame width.
+     * @param dest The destination the band flushes to.
+     * @return Success, or an error. On error the damage stays pending, so a
+     *         later call redraws it.
+     * @retval idfxx::errc::invalid_arg if the band has zero height, or the
+     *         frame height is zero or not a multiple of the band height.
+     */
+    template<pixel_surface Surface, typename Dest>
+        requires std::same_as<typename Surface::pixel_type, pixel_type> && damage_flushable<Surface, Dest>
+    [[nodiscard]] result<void> try_render_banded(Surface& band, Dest& dest) {
+        const size_t band_height = band.height();
+        if (band_height == 0 || _height == 0 || _height % band_height != 0) {
+            return error(errc::invalid_arg);
+        }
+        const auto regions = damage();
+        if (regions.empty()) {
+            return {};
+        }
+        _record();
+        for (size_t y = 0; y < _height; y += band_height) {
+            const rect slice{0, y, _width, y + band_height};
+            if (std::ranges::none_of(regions, [&](const rect& r) { return r.intersects(slice); })) {
+                continue;
+            }
+            band.mark_clean();
+            canvas c(band, 0, y);
+            for (const rect& r : regions) {
+                if (r.intersects(slice)) {
+                    _redraw(c, r);
+                }
+            }
+            if (auto flushed = band.try_flush_dirty(dest, size_t{0}, y); !flushed) {
+                return flushed;
+            }
+        }
+        _damage.clear();
+        return {};
+    }
+
+private:
+    // Moves a widget's damage, and its children's, into the scene's list.
+    void _collect(widget<Pixel>& w) {
+        if (w.dirty()) {
+            _add_damage(w.damage());
+            w.mark_clean();
+        }
+        for (widget<Pixel>* child : w.children()) {
+            _collect(*child);
+        }
+    }
+
+    // Adds a rectangle, merging it with every one it overlaps (and those
+    // the merged rectangle then overlaps) so the list never overlaps.
+    void _add_damage(rect r) {
+        r = r.intersection({0, 0, _width, _height});
+        if (r.empty()) {
+            return;
+        }
+        for (size_t i = 0; i < _damage.size();) {
+            if (_damage[i].contains(r)) {
+                return;
+            }
+            if (_damage[i].intersects(r)) {
+                r = r.bounds(_damage[i]);
+                _damage.erase(_damage.begin() + static_cast<ptrdiff_t>(i));
+                i = 0;
+            } else {
+                ++i;
+            }
+        }
+        _damage.push_back(r);
+    }
+
+    // Records the widgets touching any damage, parents before children.
+    void _record() {
+        _list.reset();
+        for (const widget<Pixel>* w : _widgets) {
+            _record(*w);
+        }
+    }
+
+    void _record(const widget<Pixel>& w) {
+        if (std::ranges::any_of(_damage, [&](const rect& r) { return r.intersects(w.bounds()); })) {
+            w.draw(_list);
+        }
+        for (const widget<Pixel>* child : w.children()) {
+            _record(*child);
+        }
+    }
+
+    template<pixel_surface Surface>
+    void _redraw(const canvas<Surface>& c, const rect& r) const noexcept {
+        auto clipped = c.clip(r.x_start, r.y_start, r.width(), r.height());
+        clipped.fill_rect(r.x_start, r.y_start, r.width(), r.height(), _background);
+        _list.replay(clipped);
+    }
+
+    size_t _width;
+    size_t _height;
+    Pixel _background;
+    std::vector<widget<Pixel>*> _widgets;
+    std::vector<rect> _damage;
+    display_list<Pixel> _list;
+};
+
+/** @} */ // end of idfxx_gfx_widgets
+
+} // namespace idfxx::gfx
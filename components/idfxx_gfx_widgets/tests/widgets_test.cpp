@@ -0,0 +1,331 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+// Unit tests for idfxx_gfx_widgets
+// Pure pixel rendering — runs everywhere, including QEMU.
+
+#include "idfxx/font/spleen"
+#include "idfxx/gfx/widgets"
+#include "idfxx/lcd/mono_framebuffer"
+#include "idfxx/lcd/rgb565_framebuffer"
+#include "unity.h"
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace idfxx::gfx;
+using idfxx::font::spleen_5x8;
+using idfxx::lcd::mono_framebuffer;
+using idfxx::lcd::rgb565;
+using idfxx::lcd::rgb565_framebuffer;
+
+// =============================================================================
+// Compile-time tests (static_assert)
+// These verify correctness at compile time - if this file compiles, they pass.
+// =============================================================================
+
+static_assert(rect{0, 0, 4, 4}.intersects({3, 3, 8, 8}));
+static_assert(!rect{0, 0, 4, 4}.intersects({4, 0, 8, 4})); // edges touch, no pixel shared
+static_assert(rect{0, 0, 4, 4}.intersection({2, 1, 8, 3}) == rect{2, 1, 4, 3});
+static_assert(rect{}.bounds({2, 2, 3, 3}) == rect{2, 2, 3, 3});
+static_assert(rect{0, 0, 1, 1}.bounds({2, 2, 3, 3}) == rect{0, 0, 3, 3});
+
+// Widgets are registered by reference, so they stay put.
+static_assert(!std::is_copy_constructible_v<label<bool>>);
+static_assert(!std::is_move_constructible_v<bar<rgb565>>);
+
+// Banded rendering needs a band that flushes its damage at an offset.
+static_assert(damage_flushable<rgb565_framebuffer, idfxx::lcd::panel>);
+static_assert(!damage_flushable<mono_framebuffer, idfxx::lcd::panel>);
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+namespace {
+
+mono_framebuffer make_fb(size_t width, size_t height) {
+    return std::move(*mono_framebuffer::make(width, height));
+}
+
+rgb565_framebuffer make_color_fb(size_t width, size_t height) {
+    return std::move(*rgb565_framebuffer::make(width, height));
+}
+
+// Panel assembling every draw into a frame-sized pixel store, and recording
+// the rectangles drawn.
+class frame_panel : public idfxx::lcd::panel {
+public:
+    frame_panel(size_t width, size_t height)
+        : width(width)
+        , frame(width * height) {}
+
+    size_t width;
+    std::vector<rgb565> frame;
+    std::vector<rect> draws;
+
+private:
+    [[nodiscard]] esp_lcd_panel_handle_t do_idf_handle() const override { return nullptr; }
+
+    [[nodiscard]] idfxx::result<void>
+    do_draw_bitmap(int x_start, int y_start, int x_end, int y_end, const void* color_data) override {
+        const auto* pixels = static_cast<const rgb565*>(color_data);
+        for (int y = y_start; y < y_end; ++y) {
+            for (int x = x_start; x < x_end; ++x) {
+                frame[y * width + x] = *pixels++;
+            }
+        }
+        draws.push_back({
+            static_cast<size_t>(x_start),
+            static_cast<size_t>(y_start),
+            static_cast<size_t>(x_end),
+            static_cast<size_t>(y_end),
+        });
+        return {};
+    }
+};
+
+constexpr rgb565 black{};
+constexpr rgb565 white(255, 255, 255);
+constexpr rgb565 green(0, 200, 0);
+constexpr rgb565 red(255, 40, 40);
+constexpr rgb565 navy(0, 0, 96);
+
+} // namespace
+
+// =============================================================================
+// Runtime tests: widget damage
+// =============================================================================
+
+TEST_CASE("gfx widgets start out entirely damaged", "[idfxx][gfx][widgets]") {
+    label<bool> text({2, 3, 40, 11}, spleen_5x8, "hi", true);
+    TEST_ASSERT_TRUE(text.dirty());
+    TEST_ASSERT_TRUE(text.damage() == text.bounds());
+    text.mark_clean();
+    TEST_ASSERT_FALSE(text.dirty());
+    text.invalidate();
+    TEST_ASSERT_TRUE(text.damage() == text.bounds());
+}
+
+TEST_CASE("gfx label damages only the cells from the first change", "[idfxx][gfx][widgets]") {
+    label<bool> readout({10, 4, 60, 12}, spleen_5x8, "23.7", true);
+    readout.mark_clean();
+
+    readout.set_text("23.7");
+    TEST_ASSERT_FALSE(readout.dirty());
+
+    readout.set_text("23.8");
+    TEST_ASSERT_TRUE(readout.damage() == (rect{10 + 3 * 5, 4, 10 + 4 * 5, 12}));
+
+    // Shorter text damages the cells it vacates; the damage accumulates.
+    readout.mark_clean();
+    readout.set_text("2");
+    TEST_ASSERT_TRUE(readout.damage() == (rect{10 + 5, 4, 10 + 4 * 5, 12}));
+
+    // Text running past the bounds damages only up to them.
+    readout.mark_clean();
+    readout.set_text("0123456789012");
+    TEST_ASSERT_TRUE(readout.damage() == (rect{10, 4, 60, 12}));
+}
+
+TEST_CASE("gfx bar damages only the strip between fill edges", "[idfxx][gfx][widgets]") {
+    // A 100-pixel track inside the outline.
+    bar<rgb565> level({0, 0, 102, 10}, 0, 1000, green, black, white);
+    level.mark_clean();
+
+    level.set_value(400);
+    TEST_ASSERT_TRUE(level.damage() == (rect{1, 1, 41, 9}));
+
+    // A change within one pixel column draws nothing.
+    level.mark_clean();
+    level.set_value(405);
+    TEST_ASSERT_FALSE(level.dirty());
+    TEST_ASSERT_EQUAL(405, level.value());
+
+    level.set_value(5000); // clamped
+    TEST_ASSERT_EQUAL(1000, level.value());
+    TEST_ASSERT_TRUE(level.damage() == (rect{41, 1, 101, 9}));
+
+    level.mark_clean();
+    level.set_ink(red);
+    TEST_ASSERT_TRUE(level.damage() == (rect{1, 1, 101, 9}));
+}
+
+TEST_CASE("gfx meter lights segments in zone colors", "[idfxx][gfx][widgets]") {
+    // Ten 9-pixel segments one pixel apart.
+    scene<rgb565> ui(99, 4, black);
+    meter<rgb565> vu({0, 0, 99, 4}, 10, 0, 100, green, navy);
+    const std::array<meter<rgb565>::zone, 2> zones{{{60, rgb565(255, 180, 0)}, {90, red}}};
+    vu.set_zones(zones);
+    ui.add(vu);
+
+    vu.set_value(95);
+    auto fb = make_color_fb(99, 4);
+    ui.render(fb);
+    TEST_ASSERT_TRUE(fb.get_pixel(0, 0) == green);
+    TEST_ASSERT_TRUE(fb.get_pixel(9, 0) == black); // gap
+    TEST_ASSERT_TRUE(fb.get_pixel(60, 0) == rgb565(255, 180, 0));
+    TEST_ASSERT_TRUE(fb.get_pixel(80, 3) == rgb565(255, 180, 0));
+    TEST_ASSERT_TRUE(fb.get_pixel(90, 0) == navy); // 95 does not fill the last segment
+
+    // Dropping to 35 switches off segments 3 through 8 only.
+    vu.set_value(35);
+    TEST_ASSERT_TRUE(vu.damage() == (rect{30, 0, 89, 4}));
+}
+
+TEST_CASE("gfx chart push damages the columns around the new sample", "[idfxx][gfx][widgets]") {
+    // Five samples across a 9-pixel plot: columns 1, 3, 5, 7, 9.
+    chart<bool> trend({0, 0, 11, 10}, 5, 0, 100, true, true);
+    trend.mark_clean();
+
+    trend.push(50);
+    TEST_ASSERT_TRUE(trend.damage() == (rect{1, 1, 4, 9}));
+    trend.mark_clean();
+    trend.push(60);
+    TEST_ASSERT_TRUE(trend.damage() == (rect{1, 1, 6, 9}));
+    TEST_ASSERT_EQUAL(2, trend.size());
+
+    for (int v : {70, 80, 90, 10}) {
+        trend.push(v);
+    }
+    TEST_ASSERT_EQUAL(5, trend.size()); // wrapped: the 10 replaced the 50
+    trend.mark_clean();
+    trend.push(20);
+    TEST_ASSERT_TRUE(trend.damage() == (rect{1, 1, 6, 9}));
+}
+
+// =============================================================================
+// Runtime tests: scene rendering
+// =============================================================================
+
+namespace {
+
+// A small dashboard: a titled panel holding a readout, a bar and a chart.
+struct dashboard {
+    scene<bool> ui{64, 32, false};
+    container<bool> panel{{0, 0, 64, 32}, false, true};
+    label<bool> title{{2, 2, 30, 10}, spleen_5x8, "temp", true};
+    label<bool> readout{{30, 2, 62, 10}, spleen_5x8, "23.7", true};
+    bar<bool> level{{2, 12, 62, 18}, 0, 100, true, false, true};
+    chart<bool> trend{{2, 19, 62, 31}, 8, 0, 100, true, true};
+
+    dashboard() {
+        panel.add(title);
+        panel.add(readout);
+        panel.add(level);
+        panel.add(trend);
+        ui.add(panel);
+    }
+};
+
+bool same_pixels(const mono_framebuffer& a, const mono_framebuffer& b) {
+    for (size_t y = 0; y < a.height(); ++y) {
+        for (size_t x = 0; x < a.width(); ++x) {
+            if (a.get_pixel(x, y) != b.get_pixel(x, y)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_CASE("gfx scene redraws only the damage, matching a full redraw", "[idfxx][gfx][widgets]") {
+    dashboard d;
+    auto fb = make_fb(64, 32);
+    d.ui.render(fb);
+    TEST_ASSERT_TRUE(d.ui.damage().empty());
+
+    // Nothing changed: nothing is written.
+    fb.mark_clean();
+    d.ui.render(fb);
+    TEST_ASSERT_TRUE(fb.dirty_regions().empty());
+
+    d.readout.set_text("24.1");
+    d.level.set_value(40);
+    d.trend.push(30);
+    d.trend.push(70);
+
+    // A pixel outside the damage survives the update.
+    fb.set_pixel(63, 0, false);
+    d.ui.render(fb);
+    TEST_ASSERT_FALSE(fb.get_pixel(63, 0));
+    fb.set_pixel(63, 0, true);
+
+    // The result matches drawing every widget afresh.
+    auto reference = make_fb(64, 32);
+    d.ui.invalidate();
+    d.ui.render(reference);
+    TEST_ASSERT_TRUE(same_pixels(reference, fb));
+}
+
+TEST_CASE("gfx scene merges overlapping damage", "[idfxx][gfx][widgets]") {
+    dashboard d;
+    auto fb = make_fb(64, 32);
+    d.ui.render(fb);
+
+    // Separate changes stay separate rectangles.
+    d.readout.set_text("99.9");
+    d.level.set_value(50);
+    auto regions = d.ui.damage();
+    TEST_ASSERT_EQUAL(2, regions.size());
+    TEST_ASSERT_FALSE(d.readout.dirty()); // the scene holds the damage now
+
+    // Recoloring the panel damages everything on it, absorbing the rest.
+    d.panel.set_background(true);
+    d.title.set_text("hot");
+    regions = d.ui.damage();
+    TEST_ASSERT_EQUAL(1, regions.size());
+    TEST_ASSERT_TRUE(regions[0] == (rect{0, 0, 64, 32}));
+}
+
+TEST_CASE("gfx scene render_banded skips clean bands and sends only damage", "[idfxx][gfx][widgets]") {
+    scene<rgb565> ui(32, 32, navy);
+    label<rgb565> caption({0, 0, 32, 8}, spleen_5x8, "ok", white);
+    bar<rgb565> level({0, 17, 32, 23}, 0, 30, green, black, white);
+    ui.add(caption);
+    ui.add(level);
+
+    auto band = make_color_fb(32, 8);
+    frame_panel panel(32, 32);
+    TEST_ASSERT_TRUE(ui.try_render_banded(band, panel).has_value());
+    TEST_ASSERT_EQUAL(4, panel.draws.size()); // the whole frame, band by band
+
+    // The bar's fill edge moves within the third band: one draw of just the strip.
+    panel.draws.clear();
+    level.set_value(10);
+    TEST_ASSERT_TRUE(ui.try_render_banded(band, panel).has_value());
+    TEST_ASSERT_EQUAL(1, panel.draws.size());
+    TEST_ASSERT_TRUE(panel.draws[0] == (rect{1, 18, 11, 22}));
+
+    // Nothing changed: nothing is sent.
+    panel.draws.clear();
+    TEST_ASSERT_TRUE(ui.try_render_banded(band, panel).has_value());
+    TEST_ASSERT_TRUE(panel.draws.empty());
+
+    // The assembled frame matches a full-frame render.
+    auto reference = make_color_fb(32, 32);
+    ui.invalidate();
+    ui.render(reference);
+    for (size_t y = 0; y < 32; ++y) {
+        for (size_t x = 0; x < 32; ++x) {
+            TEST_ASSERT_TRUE(panel.frame[y * 32 + x] == reference.get_pixel(x, y));
+        }
+    }
+}
+
+TEST_CASE("gfx scene render_banded rejects a band that does not tile the frame", "[idfxx][gfx][widgets]") {
+    scene<rgb565> ui(32, 30, black);
+    auto band = make_color_fb(32, 8);
+    frame_panel panel(32, 32);
+
+    auto rendered = ui.try_render_banded(band, panel);
+    TEST_ASSERT_FALSE(rendered.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(idfxx::errc::invalid_arg), rendered.error().value());
+    TEST_ASSERT_EQUAL(1, ui.damage().size()); // still pending
+    TEST_ASSERT_TRUE(panel.draws.empty());
+}
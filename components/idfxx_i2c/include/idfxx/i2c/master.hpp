@@ -19,6 +19,7 @@
  */
 
 #include <idfxx/error>
+#include <idfxx/future>
 #include <idfxx/gpio>
 #include <idfxx/intr_alloc>
 
@@ -287,6 +288,14 @@ public:
     /** @brief Returns the bus clock frequency in Hz. */
     [[nodiscard]] freq::hertz frequency() const { return _frequency; }
 
+    /**
+     * @brief Returns the depth of the bus's transaction queue.
+     *
+     * Zero for a synchronous bus. Otherwise transactions are queued, and at
+     * most this many may be in flight on each device at once.
+     */
+    [[nodiscard]] size_t trans_queue_depth() const { return _trans_queue_depth; }
+
     /**
      * @brief Scans for devices on the bus.
      *
@@ -392,7 +401,12 @@ public:
     }
 
 private:
-    explicit master_bus(i2c_master_bus_handle_t handle, enum port port, freq::hertz frequency);
+    explicit master_bus(
+        i2c_master_bus_handle_t handle,
+        enum port port,
+        freq::hertz frequency,
+        size_t trans_queue_depth
+    );
 
     void _delete() noexcept;
 
@@ -404,6 +418,7 @@ private:
     i2c_master_bus_handle_t _handle = nullptr;
     enum port _port;
     freq::hertz _frequency;
+    size_t _trans_queue_depth = 0;
 };
 
 /**
@@ -413,6 +428,15 @@ private:
  * Represents a specific device on an I2C bus. Provides methods for
  * raw data transfer and register-based read/write operations.
  *
+ * On a bus created with a non-zero trans_queue_depth, the `*_async`
+ * methods queue a transaction and return an @ref idfxx::future "future"
+ * for it, so transactions to several devices can be queued back-to-back.
+ * The blocking methods queue their transaction too, and wait for it: their
+ * timeout covers both waiting for room in the queue and the transaction
+ * itself. The queued transaction transfers through buffers it owns, copying
+ * the caller's data in and received data out, so a method that fails with
+ * `errc::timeout` leaves the driver with nothing of the caller's to access.
+ *
  * This type is non-copyable and move-only. A moved-from
  * object must not be used: any operation other than destruction or
  * assignment is undefined behavior.
@@ -851,7 +875,9 @@ public:
      * @brief Registers a callback for transaction-done events.
      *
      * The callback runs in ISR context when an asynchronous transaction
-     * completes. It should return true if a higher-priority task was woken.
+     * completes, after the transaction's future has been completed. It
+     * should return true if a higher-priority task was woken. Waits for the
+     * device's in-flight transactions before replacing a previous callback.
      * Only useful when the bus was created with a non-zero trans_queue_depth.
      *
      * @param on_trans_done Transaction-done callback.
@@ -868,7 +894,9 @@ public:
      * @brief Registers a callback for transaction-done events.
      *
      * The callback runs in ISR context when an asynchronous transaction
-     * completes. It should return true if a higher-priority task was woken.
+     * completes, after the transaction's future has been completed. It
+     * should return true if a higher-priority task was woken. Waits for the
+     * device's in-flight transactions before replacing a previous callback.
      * Only useful when the bus was created with a non-zero trans_queue_depth.
      *
      * @param on_trans_done Transaction-done callback.
@@ -1980,7 +2008,313 @@ public:
         return _try_read_register(high, low, buf, size, std::chrono::ceil<std::chrono::milliseconds>(timeout));
     }
 
+    // =========================================================================
+    // Asynchronous transactions
+    // =========================================================================
+
+#ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
+    /**
+     * @brief Queues a transmission to the device.
+     *
+     * On a bus created with a non-zero trans_queue_depth, the transaction
+     * is queued and this returns at once with a future that completes when
+     * the transaction does, so several transactions — to this device or
+     * others on the bus — can be in flight back-to-back. On a synchronous
+     * bus the transaction completes before this returns.
+     *
+     * @param data Data to transmit. Must remain valid until the returned future completes.
+     *
+     * @return A future that completes with the transaction's outcome.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error if the transaction could not be queued.
+     */
+    [[nodiscard]] idfxx::future<void> transmit_async(std::span<const uint8_t> data) {
+        return unwrap(try_transmit_async(data));
+    }
+
+    /**
+     * @brief Queues a transmission to the device.
+     *
+     * @param data    Data to transmit. Must remain valid until the returned future completes.
+     * @param timeout Maximum time to wait for room in the transaction queue.
+     *
+     * @return A future that completes with the transaction's outcome.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error if the transaction could not be queued.
+     */
+    template<typename Rep, typename Period>
+    [[nodiscard]] idfxx::future<void>
+    transmit_async(std::span<const uint8_t> data, const std::chrono::duration<Rep, Period>& timeout) {
+        return unwrap(try_transmit_async(data, timeout));
+    }
+
+    /**
+     * @brief Queues a reception from the device.
+     *
+     * @param buf Buffer for received data. Must remain valid, and is only
+     *            filled, once the returned future completes.
+     *
+     * @return A future that completes with the transaction's outcome.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error if the transaction could not be queued.
+     */
+    [[nodiscard]] idfxx::future<void> receive_async(std::span<uint8_t> buf) { return unwrap(try_receive_async(buf)); }
+
+    /**
+     * @brief Queues a reception from the device.
+     *
+     * @param buf     Buffer for received data. Must remain valid, and is only
+     *                filled, once the returned future completes.
+     * @param timeout Maximum time to wait for room in the transaction queue.
+     *
+     * @return A future that completes with the transaction's outcome.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error if the transaction could not be queued.
+     */
+    template<typename Rep, typename Period>
+    [[nodiscard]] idfxx::future<void>
+    receive_async(std::span<uint8_t> buf, const std::chrono::duration<Rep, Period>& timeout) {
+        return unwrap(try_receive_async(buf, timeout));
+    }
+
+    /**
+     * @brief Queues a write to a register.
+     *
+     * The register address and data are copied, so @p buf may be reused as
+     * soon as this returns.
+     *
+     * @param reg Register address (16-bit, MSB first).
+     * @param buf Data to write.
+     *
+     * @return A future that completes with the transaction's outcome.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error if the transaction could not be queued.
+     */
+    [[nodiscard]] idfxx::future<void> write_register_async(uint16_t reg, std::span<const uint8_t> buf) {
+        return unwrap(try_write_register_async(reg, buf));
+    }
+
+    /**
+     * @brief Queues a write to a register.
+     *
+     * @param reg     Register address (16-bit, MSB first).
+     * @param buf     Data to write; copied, so it may be reused as soon as this returns.
+     * @param timeout Maximum time to wait for room in the transaction queue.
+     *
+     * @return A future that completes with the transaction's outcome.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error if the transaction could not be queued.
+     */
+    template<typename Rep, typename Period>
+    [[nodiscard]] idfxx::future<void> write_register_async(
+        uint16_t reg,
+        std::span<const uint8_t> buf,
+        const std::chrono::duration<Rep, Period>& timeout
+    ) {
+        return unwrap(try_write_register_async(reg, buf, timeout));
+    }
+
+    /**
+     * @brief Queues a read from a register.
+     *
+     * Writes the register address and reads the data in one transaction,
+     * with a repeated start between them. Unlike read_register(), there is
+     * no stop or processing delay after the address, so use this with
+     * devices that support combined write-read transfers.
+     *
+     * @param reg Register address (16-bit, MSB first).
+     * @param buf Buffer for received data. Must remain valid, and is only
+     *            filled, once the returned future completes.
+     *
+     * @return A future that completes with the transaction's outcome.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error if the transaction could not be queued.
+     */
+    [[nodiscard]] idfxx::future<void> read_register_async(uint16_t reg, std::span<uint8_t> buf) {
+        return unwrap(try_read_register_async(reg, buf));
+    }
+
+    /**
+     * @brief Queues a read from a register.
+     *
+     * @param reg     Register address (16-bit, MSB first).
+     * @param buf     Buffer for received data. Must remain valid, and is only
+     *                filled, once the returned future completes.
+     * @param timeout Maximum time to wait for room in the transaction queue.
+     *
+     * @return A future that completes with the transaction's outcome.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error if the transaction could not be queued.
+     */
+    template<typename Rep, typename Period>
+    [[nodiscard]] idfxx::future<void>
+    read_register_async(uint16_t reg, std::span<uint8_t> buf, const std::chrono::duration<Rep, Period>& timeout) {
+        return unwrap(try_read_register_async(reg, buf, timeout));
+    }
+#endif
+
+    /**
+     * @brief Queues a transmission to the device.
+     *
+     * On a bus created with a non-zero trans_queue_depth, the transaction
+     * is queued and this returns at once with a future that completes when
+     * the transaction does, so several transactions — to this device or
+     * others on the bus — can be in flight back-to-back. On a synchronous
+     * bus the transaction completes before this returns.
+     *
+     * @param data Data to transmit. Must remain valid until the returned future completes.
+     *
+     * @return A future that completes with the transaction's outcome, or an
+     *         error if the transaction could not be queued.
+     */
+    [[nodiscard]] result<idfxx::future<void>> try_transmit_async(std::span<const uint8_t> data) {
+        return try_transmit_async(data, DEFAULT_TIMEOUT);
+    }
+
+    /**
+     * @brief Queues a transmission to the device.
+     *
+     * @param data    Data to transmit. Must remain valid until the returned future completes.
+     * @param timeout Maximum time to wait for room in the transaction queue.
+     *
+     * @return A future that completes with the transaction's outcome, or an
+     *         error if the transaction could not be queued.
+     */
+    template<typename Rep, typename Period>
+    [[nodiscard]] result<idfxx::future<void>>
+    try_transmit_async(std::span<const uint8_t> data, const std::chrono::duration<Rep, Period>& timeout) {
+        return _try_transmit_async(data, std::chrono::ceil<std::chrono::milliseconds>(timeout));
+    }
+
+    /**
+     * @brief Queues a reception from the device.
+     *
+     * @param buf Buffer for received data. Must remain valid, and is only
+     *            filled, once the returned future completes.
+     *
+     * @return A future that completes with the transaction's outcome, or an
+     *         error if the transaction could not be queued.
+     */
+    [[nodiscard]] result<idfxx::future<void>> try_receive_async(std::span<uint8_t> buf) {
+        return try_receive_async(buf, DEFAULT_TIMEOUT);
+    }
+
+    /**
+     * @brief Queues a reception from the device.
+     *
+     * @param buf     Buffer for received data. Must remain valid, and is only
+     *                filled, once the returned future completes.
+     * @param timeout Maximum time to wait for room in the transaction queue.
+     *
+     * @return A future that completes with the transaction's outcome, or an
+     *         error if the transaction could not be queued.
+     */
+    template<typename Rep, typename Period>
+    [[nodiscard]] result<idfxx::future<void>>
+    try_receive_async(std::span<uint8_t> buf, const std::chrono::duration<Rep, Period>& timeout) {
+        return _try_receive_async(buf, std::chrono::ceil<std::chrono::milliseconds>(timeout));
+    }
+
+    /**
+     * @brief Queues a write to a register.
+     *
+     * The register address and data are copied, so @p buf may be reused as
+     * soon as this returns.
+     *
+     * @param reg Register address (16-bit, MSB first).
+     * @param buf Data to write.
+     *
+     * @return A future that completes with the transaction's outcome, or an
+     *         error if the transaction could not be queued.
+     */
+    [[nodiscard]] result<idfxx::future<void>> try_write_register_async(uint16_t reg, std::span<const uint8_t> buf) {
+        return try_write_register_async(reg, buf, DEFAULT_TIMEOUT);
+    }
+
+    /**
+     * @brief Queues a write to a register.
+     *
+     * @param reg     Register address (16-bit, MSB first).
+     * @param buf     Data to write; copied, so it may be reused as soon as this returns.
+     * @param timeout Maximum time to wait for room in the transaction queue.
+     *
+     * @return A future that completes with the transaction's outcome, or an
+     *         error if the transaction could not be queued.
+     */
+    template<typename Rep, typename Period>
+    [[nodiscard]] result<idfxx::future<void>> try_write_register_async(
+        uint16_t reg,
+        std::span<const uint8_t> buf,
+        const std::chrono::duration<Rep, Period>& timeout
+    ) {
+        return _try_write_register_async(reg, buf, std::chrono::ceil<std::chrono::milliseconds>(timeout));
+    }
+
+    /**
+     * @brief Queues a read from a register.
+     *
+     * Writes the register address and reads the data in one transaction,
+     * with a repeated start between them. Unlike try_read_register(), there
+     * is no stop or processing delay after the address, so use this with
+     * devices that support combined write-read transfers.
+     *
+     * @param reg Register address (16-bit, MSB first).
+     * @param buf Buffer for received data. Must remain valid, and is only
+     *            filled, once the returned future completes.
+     *
+     * @return A future that completes with the transaction's outcome, or an
+     *         error if the transaction could not be queued.
+     *
+     * @code
+     * // Start a measurement read on every sensor, then collect the results.
+     * std::array<std::array<uint8_t, 6>, 6> samples;
+     * std::array<idfxx::future<void>, 6> reads;
+     * for (size_t i = 0; i < sensors.size(); ++i) {
+     *     if (auto queued = sensors[i].try_read_register_async(0x00FD, samples[i])) {
+     *         reads[i] = *queued;
+     *     }
+     * }
+     * for (auto& r : reads) {
+     *     auto done = r.try_wait(); // samples[i] is filled once done
+     * }
+     * @endcode
+     */
+    [[nodiscard]] result<idfxx::future<void>> try_read_register_async(uint16_t reg, std::span<uint8_t> buf) {
+        return try_read_register_async(reg, buf, DEFAULT_TIMEOUT);
+    }
+
+    /**
+     * @brief Queues a read from a register.
+     *
+     * @param reg     Register address (16-bit, MSB first).
+     * @param buf     Buffer for received data. Must remain valid, and is only
+     *                filled, once the returned future completes.
+     * @param timeout Maximum time to wait for room in the transaction queue.
+     *
+     * @return A future that completes with the transaction's outcome, or an
+     *         error if the transaction could not be queued.
+     */
+    template<typename Rep, typename Period>
+    [[nodiscard]] result<idfxx::future<void>>
+    try_read_register_async(uint16_t reg, std::span<uint8_t> buf, const std::chrono::duration<Rep, Period>& timeout) {
+        return _try_read_register_async(reg, buf, std::chrono::ceil<std::chrono::milliseconds>(timeout));
+    }
+
 private:
+    // Completion tracking for a bus with a transaction queue, held in the
+    // .cpp and shared with the futures it hands out and the driver's
+    // transaction-done callback, so it keeps a stable address and outlives
+    // the device while futures remain.
+    struct async_state;
+
     explicit master_device(master_bus* bus, i2c_master_dev_handle_t handle, uint16_t address);
 
     void _delete() noexcept;
@@ -2008,10 +2342,19 @@ private:
     [[nodiscard]] result<void>
     _try_read_register(uint8_t high, uint8_t low, uint8_t* buf, size_t size, std::chrono::milliseconds timeout);
 
+    [[nodiscard]] result<idfxx::future<void>>
+    _try_transmit_async(std::span<const uint8_t> data, std::chrono::milliseconds timeout);
+    [[nodiscard]] result<idfxx::future<void>>
+    _try_receive_async(std::span<uint8_t> buf, std::chrono::milliseconds timeout);
+    [[nodiscard]] result<idfxx::future<void>>
+    _try_write_register_async(uint16_t reg, std::span<const uint8_t> buf, std::chrono::milliseconds timeout);
+    [[nodiscard]] result<idfxx::future<void>>
+    _try_read_register_async(uint16_t reg, std::span<uint8_t> buf, std::chrono::milliseconds timeout);
+
     master_bus* _bus = nullptr;
     i2c_master_dev_handle_t _handle = nullptr;
     uint16_t _address = 0;
-    std::unique_ptr<std::move_only_function<bool() const>> _on_trans_done;
+    std::shared_ptr<async_state> _async;
 };
 
 /** @} */ // end of idfxx_i2c
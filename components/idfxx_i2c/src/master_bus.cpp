@@ -122,31 +122,35 @@ static result<i2c_master_bus_handle_t> make_bus(enum port port, const master_bus
 
 #ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
 master_bus::master_bus(enum port port, const struct config& config)
-    : master_bus(unwrap(make_bus(port, config)), port, config.frequency) {}
+    : master_bus(unwrap(make_bus(port, config)), port, config.frequency, config.trans_queue_depth) {}
 
 master_bus::master_bus(enum port port, gpio sda, gpio scl, freq::hertz frequency)
     : master_bus(port, config{.sda = sda, .scl = scl, .frequency = frequency}) {}
 #endif
 
 result<master_bus> master_bus::make(enum port port, const struct config& config) {
-    return make_bus(port, config).transform([&](auto handle) { return master_bus{handle, port, config.frequency}; });
+    return make_bus(port, config).transform([&](auto handle) {
+        return master_bus{handle, port, config.frequency, config.trans_queue_depth};
+    });
 }
 
 result<master_bus> master_bus::make(enum port port, gpio sda, gpio scl, freq::hertz frequency) {
     return make(port, config{.sda = sda, .scl = scl, .frequency = frequency});
 }
 
-master_bus::master_bus(i2c_master_bus_handle_t handle, enum port port, freq::hertz frequency)
+master_bus::master_bus(i2c_master_bus_handle_t handle, enum port port, freq::hertz frequency, size_t trans_queue_depth)
     : _mux(std::make_unique<std::recursive_mutex>())
     , _handle(handle)
     , _port(port)
-    , _frequency(frequency) {}
+    , _frequency(frequency)
+    , _trans_queue_depth(trans_queue_depth) {}
 
 master_bus::master_bus(master_bus&& other) noexcept
     : _mux(std::move(other._mux))
     , _handle(std::exchange(other._handle, nullptr))
     , _port(other._port)
-    , _frequency(other._frequency) {}
+    , _frequency(other._frequency)
+    , _trans_queue_depth(other._trans_queue_depth) {}
 
 master_bus& master_bus::operator=(master_bus&& other) noexcept {
     if (this != &other) {
@@ -155,6 +159,7 @@ master_bus& master_bus::operator=(master_bus&& other) noexcept {
         _handle = std::exchange(other._handle, nullptr);
         _port = other._port;
         _frequency = other._frequency;
+        _trans_queue_depth = other._trans_queue_depth;
     }
     return *this;
 }
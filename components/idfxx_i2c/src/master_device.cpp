@@ -1,13 +1,22 @@
 // SPDX-License-Identifier: Apache-2.0
 // Copyright 2026 Chris Leishman
 
+#include <idfxx/chrono>
 #include <idfxx/i2c/master>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <driver/i2c_master.h>
 #include <esp_idf_version.h>
 #include <esp_log.h>
 #include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -48,6 +57,226 @@ static result<void> map_xfer_error(esp_err_t err, const char* op, uint16_t addre
     return error(errc::invalid_arg);
 }
 
+namespace {
+
+// Status of a queued transaction the driver has not yet reported.
+constexpr esp_err_t pending_status = std::numeric_limits<esp_err_t>::min();
+
+// A transaction queued on a bus with a transaction queue. The device's
+// in-flight ring holds it, and the buffers it owns, until the driver reports
+// it, so the driver never refers to memory the caller may since have freed.
+struct queued_transaction {
+    std::atomic<esp_err_t> status{pending_status};
+    // Data the driver reads and writes in place of the caller's buffers, for
+    // the blocking calls and the register calls.
+    std::vector<uint8_t> bytes;
+    std::vector<i2c_operation_job_t> jobs; // for execute_operations
+};
+
+esp_err_t IRAM_ATTR to_esp_err(const i2c_master_event_data_t* edata) {
+    switch (edata != nullptr ? edata->event : I2C_EVENT_DONE) {
+    case I2C_EVENT_DONE:
+        return ESP_OK;
+    case I2C_EVENT_TIMEOUT:
+        return ESP_ERR_TIMEOUT;
+    default:
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+}
+
+idfxx::future<void> completed_future() {
+    return idfxx::future<void>{
+        [](std::optional<std::chrono::milliseconds>) -> result<void> { return {}; },
+        []() noexcept { return true; },
+    };
+}
+
+} // namespace
+
+// Tracks the device's transactions on a bus with a transaction queue. The
+// driver reports each device's transactions in the order they were queued,
+// through the transaction-done callback, so a ring of in-flight transactions
+// indexed by free-running submitted/completed counters matches each report to
+// its transaction. On a synchronous bus it only holds the user's callback.
+struct master_device::async_state {
+    // The bus's trans_queue_depth, and the ring's capacity; 0 on a synchronous bus.
+    size_t depth;
+    // Entry n % depth holds the nth transaction until it is reclaimed.
+    std::unique_ptr<std::shared_ptr<queued_transaction>[]> ring;
+    // Written by submitting tasks, under the bus lock.
+    std::atomic<uint32_t> submitted{0};
+    // Written only by the transaction-done callback.
+    std::atomic<uint32_t> completed{0};
+    // Ring entries before this one have been released; guarded by the bus lock.
+    uint32_t reclaimed = 0;
+    // Given on every completion. Waiters re-check the counters after each
+    // take, so a stale token only costs an extra loop.
+    SemaphoreHandle_t done = nullptr;
+    // Serializes waiters: each give wakes only one task.
+    std::timed_mutex wait_mtx;
+    // The callback from register_event_callbacks(), run after each completion.
+    std::move_only_function<bool() const> on_trans_done;
+
+    explicit async_state(size_t depth)
+        : depth(depth) {
+        if (depth == 0) {
+            return;
+        }
+        ring = std::make_unique<std::shared_ptr<queued_transaction>[]>(depth);
+        done = xSemaphoreCreateBinary();
+        if (done == nullptr) {
+            raise_no_mem();
+        }
+    }
+
+    ~async_state() {
+        if (done != nullptr) {
+            vSemaphoreDelete(done);
+        }
+    }
+
+    async_state(const async_state&) = delete;
+    async_state& operator=(const async_state&) = delete;
+
+    static bool IRAM_ATTR
+    trans_done(i2c_master_dev_handle_t, const i2c_master_event_data_t* edata, void* user_arg) {
+        auto* self = static_cast<async_state*>(user_arg);
+        bool woken = false;
+        uint32_t c = self->completed.load(std::memory_order_relaxed);
+        if (c != self->submitted.load(std::memory_order_acquire)) {
+            self->ring[c % self->depth]->status.store(to_esp_err(edata), std::memory_order_release);
+            self->completed.store(c + 1, std::memory_order_release);
+            BaseType_t task_woken = pdFALSE;
+            xSemaphoreGiveFromISR(self->done, &task_woken);
+            woken = task_woken == pdTRUE;
+        }
+        if (self->on_trans_done) {
+            woken = self->on_trans_done() || woken;
+        }
+        return woken;
+    }
+
+    // Wrap-safe comparison of the free-running completion counter.
+    [[nodiscard]] bool reached(uint32_t target) const noexcept {
+        return static_cast<int32_t>(completed.load(std::memory_order_acquire) - target) >= 0;
+    }
+
+    result<void> wait(uint32_t target, std::optional<std::chrono::milliseconds> timeout) {
+        if (reached(target)) {
+            return {};
+        }
+        using clock = std::chrono::steady_clock;
+        std::optional<clock::time_point> deadline = timeout.transform([](auto t) { return clock::now() + t; });
+
+        std::unique_lock lk(wait_mtx, std::defer_lock);
+        if (!deadline) {
+            lk.lock();
+        } else if (!lk.try_lock_until(*deadline)) {
+            return reached(target) ? result<void>{} : error(errc::timeout);
+        }
+
+        while (!reached(target)) {
+            TickType_t ticks = portMAX_DELAY;
+            if (deadline) {
+                auto now = clock::now();
+                if (now >= *deadline) {
+                    return error(errc::timeout);
+                }
+                ticks = idfxx::chrono::ticks(*deadline - now);
+            }
+            if (xSemaphoreTake(done, ticks) != pdTRUE && !reached(target)) {
+                return error(errc::timeout);
+            }
+        }
+        return {};
+    }
+
+    // Waits for every submitted transaction to be reported.
+    void drain() { (void)wait(submitted.load(std::memory_order_acquire), std::nullopt); }
+
+    // Releases the ring's hold on reported transactions. Called under the bus lock.
+    void reclaim() noexcept {
+        for (uint32_t c = completed.load(std::memory_order_acquire); reclaimed != c; ++reclaimed) {
+            ring[reclaimed % depth].reset();
+        }
+    }
+
+    // Starts one transaction through start(timeout_ms), the driver call, under
+    // the bus lock. On a bus with a transaction queue the returned future
+    // completes when the driver reports the transaction; on a synchronous bus
+    // start() has already run it to completion.
+    template<typename Start>
+    static result<idfxx::future<void>> queue(
+        const std::shared_ptr<async_state>& self,
+        std::shared_ptr<queued_transaction> t,
+        const char* op,
+        uint16_t address,
+        enum port port,
+        std::chrono::milliseconds timeout,
+        Start&& start
+    ) {
+        const int timeout_ms = static_cast<int>(timeout.count());
+        if (self->depth == 0) {
+            return map_xfer_error(start(timeout_ms), op, address, port).transform(completed_future);
+        }
+
+        self->reclaim();
+        uint32_t seq = self->submitted.load(std::memory_order_relaxed);
+        if (seq - self->reclaimed == self->depth) {
+            if (auto r = self->wait(seq - static_cast<uint32_t>(self->depth) + 1, timeout); !r) {
+                return error(r.error());
+            }
+            self->reclaim();
+        }
+        self->ring[seq % self->depth] = t;
+        // Count the transaction before starting it: the driver may report it
+        // before start() returns.
+        self->submitted.store(seq + 1, std::memory_order_release);
+        if (auto err = start(timeout_ms); err != ESP_OK) {
+            self->submitted.store(seq, std::memory_order_release);
+            self->ring[seq % self->depth].reset();
+            return error(map_xfer_error(err, op, address, port).error());
+        }
+
+        return idfxx::future<void>{
+            [self, t, target = seq + 1, op, address, port](std::optional<std::chrono::milliseconds> timeout) {
+                return self->wait(target, timeout).and_then([&] {
+                    return map_xfer_error(t->status.load(std::memory_order_acquire), op, address, port);
+                });
+            },
+            [t]() noexcept { return t->status.load(std::memory_order_acquire) != pending_status; },
+        };
+    }
+
+    // Runs one transaction to completion under the bus lock. On a queued bus,
+    // start() must only refer to buffers owned by `t`: if the timeout expires
+    // first, this returns while the driver still holds the transaction. `t`
+    // is unused on a synchronous bus.
+    template<typename Start>
+    static result<void> run(
+        const std::shared_ptr<async_state>& self,
+        std::shared_ptr<queued_transaction> t,
+        const char* op,
+        uint16_t address,
+        enum port port,
+        std::chrono::milliseconds timeout,
+        Start&& start
+    ) {
+        if (self->depth == 0) {
+            return map_xfer_error(start(static_cast<int>(timeout.count())), op, address, port);
+        }
+        // The timeout covers both waiting for room in the queue and waiting
+        // for the transaction itself.
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        return queue(self, std::move(t), op, address, port, timeout, start)
+            .and_then([&](idfxx::future<void> f) -> result<void> {
+                using std::chrono::milliseconds;
+                auto remaining = std::chrono::ceil<milliseconds>(deadline - std::chrono::steady_clock::now());
+                return f.try_wait_for(std::max(remaining, milliseconds{0}));
+            });
+    }
+};
+
 static result<i2c_master_dev_handle_t>
 make_device(master_bus& bus, uint16_t address, const master_device::config& config) {
     auto scl_speed = config.scl_speed.count() > 0 ? config.scl_speed : bus.frequency();
@@ -91,17 +320,24 @@ make_device(master_bus& bus, uint16_t address, const master_device::config& conf
 
 #ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
 master_device::master_device(master_bus& bus, uint16_t address, const struct config& config)
-    : _bus(&bus)
-    , _handle(unwrap(make_device(bus, address, config)))
-    , _address(address) {}
+    : master_device(unwrap(make(bus, address, config))) {}
 
 master_device::master_device(master_bus& bus, uint16_t address)
     : master_device(bus, address, config{}) {}
 #endif
 
 result<master_device> master_device::make(master_bus& bus, uint16_t address, const struct config& config) {
-    return make_device(bus, address, config).transform([&](auto handle) {
-        return master_device(&bus, handle, address);
+    return make_device(bus, address, config).and_then([&](auto handle) -> result<master_device> {
+        master_device device(&bus, handle, address);
+        if (bus.trans_queue_depth() > 0) {
+            // Every transaction on a queued bus is reported through this callback.
+            i2c_master_event_callbacks_t cbs{.on_trans_done = async_state::trans_done};
+            if (auto err = i2c_master_register_event_callbacks(handle, &cbs, device._async.get()); err != ESP_OK) {
+                ESP_LOGD(TAG, "Failed to register I2C transaction callback: %s", esp_err_to_name(err));
+                return error(err);
+            }
+        }
+        return device;
     });
 }
 
@@ -112,13 +348,14 @@ result<master_device> master_device::make(master_bus& bus, uint16_t address) {
 master_device::master_device(master_bus* bus, i2c_master_dev_handle_t handle, uint16_t address)
     : _bus(bus)
     , _handle(handle)
-    , _address(address) {}
+    , _address(address)
+    , _async(std::make_shared<async_state>(bus->trans_queue_depth())) {}
 
 master_device::master_device(master_device&& other) noexcept
     : _bus(std::exchange(other._bus, nullptr))
     , _handle(std::exchange(other._handle, nullptr))
     , _address(other._address)
-    , _on_trans_done(std::move(other._on_trans_done)) {}
+    , _async(std::move(other._async)) {}
 
 master_device& master_device::operator=(master_device&& other) noexcept {
     if (this != &other) {
@@ -126,7 +363,7 @@ master_device& master_device::operator=(master_device&& other) noexcept {
         _bus = std::exchange(other._bus, nullptr);
         _handle = std::exchange(other._handle, nullptr);
         _address = other._address;
-        _on_trans_done = std::move(other._on_trans_done);
+        _async = std::move(other._async);
     }
     return *this;
 }
@@ -137,26 +374,34 @@ master_device::~master_device() {
 
 void master_device::_delete() noexcept {
     if (_handle != nullptr) {
-        if (_on_trans_done) {
+        if (_async->depth > 0 || _async->on_trans_done) {
+            // Let the driver finish the device's queued transactions first.
+            if (_async->depth > 0) {
+                _async->drain();
+            }
             i2c_master_event_callbacks_t cbs{.on_trans_done = nullptr};
             (void)i2c_master_register_event_callbacks(_handle, &cbs, nullptr);
         }
         i2c_master_bus_rm_device(_handle);
         _handle = nullptr;
     }
-    _on_trans_done.reset();
+    _async.reset();
 }
 
 result<void> master_device::_try_transmit(const uint8_t* buf, size_t size, std::chrono::milliseconds timeout) {
     if (_handle == nullptr) {
         return error(errc::invalid_state);
     }
-    esp_err_t err;
-    {
-        std::scoped_lock lock(*_bus);
-        err = i2c_master_transmit(_handle, buf, size, timeout.count());
+    std::scoped_lock lock(*_bus);
+    std::shared_ptr<queued_transaction> t;
+    if (_async->depth > 0) {
+        t = std::make_shared<queued_transaction>();
+        t->bytes.assign(buf, buf + size);
+        buf = t->bytes.data();
     }
-    return map_xfer_error(err, "transmit", _address, _bus->port());
+    return async_state::run(_async, t, "transmit", _address, _bus->port(), timeout, [&](int timeout_ms) {
+        return i2c_master_transmit(_handle, buf, size, timeout_ms);
+    });
 }
 
 result<void> master_device::_try_multi_buffer_transmit(
@@ -168,6 +413,20 @@ result<void> master_device::_try_multi_buffer_transmit(
     }
     std::scoped_lock lock(*_bus);
 
+    if (_async->depth > 0) {
+        // Gather the buffers into one the transaction owns. A single transmit
+        // of the concatenation is the same transaction on the wire.
+        auto t = std::make_shared<queued_transaction>();
+        for (const auto& b : buffers) {
+            t->bytes.insert(t->bytes.end(), b.begin(), b.end());
+        }
+        return async_state::run(
+            _async, t, "multi_buffer_transmit", _address, _bus->port(), timeout, [&](int timeout_ms) {
+                return i2c_master_transmit(_handle, t->bytes.data(), t->bytes.size(), timeout_ms);
+            }
+        );
+    }
+
     constexpr size_t SBO_SIZE = 8;
     std::array<i2c_master_transmit_multi_buffer_info_t, SBO_SIZE> stack_info;
     std::vector<i2c_master_transmit_multi_buffer_info_t> heap_info;
@@ -187,11 +446,14 @@ result<void> master_device::_try_multi_buffer_transmit(
         info[i].buffer_size = buffers[i].size();
     }
 
-    return map_xfer_error(
-        i2c_master_multi_buffer_transmit(_handle, info, buffers.size(), timeout.count()),
+    return async_state::run(
+        _async,
+        nullptr,
         "multi_buffer_transmit",
         _address,
-        _bus->port()
+        _bus->port(),
+        timeout,
+        [&](int timeout_ms) { return i2c_master_multi_buffer_transmit(_handle, info, buffers.size(), timeout_ms); }
     );
 }
 
@@ -251,33 +513,68 @@ result<void> master_device::_try_execute_operations(std::span<const operation> o
         }
     }
 
-    return map_xfer_error(
-        i2c_master_execute_defined_operations(_handle, jobs, ops.size(), timeout.count()),
-        "execute_operations",
-        _address,
-        _bus->port()
-    );
-}
-
-namespace {
+    std::shared_ptr<queued_transaction> t;
+    if (_async->depth > 0) {
+        t = std::make_shared<queued_transaction>();
+        // Point the jobs at data the transaction owns: writes are copied in,
+        // reads are copied out once the transaction succeeds.
+        size_t total = 0;
+        for (const auto& o : ops) {
+            if (o.command == operation_command::write) {
+                total += o.write_data.size();
+            } else if (o.command == operation_command::read) {
+                total += o.read_data.size();
+            }
+        }
+        t->bytes.resize(total);
+        t->jobs.assign(jobs, jobs + ops.size());
+        size_t pos = 0;
+        for (size_t i = 0; i < ops.size(); ++i) {
+            if (ops[i].command == operation_command::write) {
+                std::ranges::copy(ops[i].write_data, t->bytes.begin() + pos);
+                t->jobs[i].write.data = t->bytes.data() + pos;
+                pos += ops[i].write_data.size();
+            } else if (ops[i].command == operation_command::read) {
+                t->jobs[i].read.data = t->bytes.data() + pos;
+                pos += ops[i].read_data.size();
+            }
+        }
+        jobs = t->jobs.data();
+    }
 
-bool IRAM_ATTR trans_done_trampoline(i2c_master_dev_handle_t, const i2c_master_event_data_t*, void* user_arg) {
-    auto* cb = static_cast<const std::move_only_function<bool() const>*>(user_arg);
-    return (*cb)();
+    return async_state::run(_async, t, "execute_operations", _address, _bus->port(), timeout, [&](int timeout_ms) {
+        return i2c_master_execute_defined_operations(_handle, jobs, ops.size(), timeout_ms);
+    }).transform([&] {
+        if (!t) {
+            return;
+        }
+        for (size_t i = 0; i < ops.size(); ++i) {
+            if (ops[i].command == operation_command::read) {
+                std::copy_n(t->jobs[i].read.data, ops[i].read_data.size(), ops[i].read_data.data());
+            }
+        }
+    });
 }
 
-} // namespace
-
 result<void> master_device::try_register_event_callbacks(std::move_only_function<bool() const> on_trans_done) {
     if (_handle == nullptr) {
         return error(errc::invalid_state);
     }
-    auto new_cb = std::make_unique<std::move_only_function<bool() const>>(std::move(on_trans_done));
-    i2c_master_event_callbacks_t cbs{.on_trans_done = trans_done_trampoline};
-    if (auto err = i2c_master_register_event_callbacks(_handle, &cbs, new_cb.get()); err != ESP_OK) {
+    std::scoped_lock lock(*_bus);
+    if (_async->depth > 0) {
+        // The driver callback is already installed and reads the user
+        // callback on each completion: swap it once none are outstanding.
+        _async->drain();
+        _async->on_trans_done = std::move(on_trans_done);
+        return {};
+    }
+    // Set the callback before the trampoline that reads it is installed.
+    auto previous = std::exchange(_async->on_trans_done, std::move(on_trans_done));
+    i2c_master_event_callbacks_t cbs{.on_trans_done = async_state::trans_done};
+    if (auto err = i2c_master_register_event_callbacks(_handle, &cbs, _async.get()); err != ESP_OK) {
+        _async->on_trans_done = std::move(previous);
         return error(err);
     }
-    _on_trans_done = std::move(new_cb);
     return {};
 }
 
@@ -285,12 +582,23 @@ result<void> master_device::_try_receive(uint8_t* buf, size_t size, std::chrono:
     if (_handle == nullptr) {
         return error(errc::invalid_state);
     }
-    esp_err_t err;
-    {
-        std::scoped_lock lock(*_bus);
-        err = i2c_master_receive(_handle, buf, size, timeout.count());
+    std::scoped_lock lock(*_bus);
+    // On a queued bus the driver receives into a buffer the transaction owns,
+    // copied out once the transaction succeeds.
+    std::shared_ptr<queued_transaction> t;
+    uint8_t* dst = buf;
+    if (_async->depth > 0) {
+        t = std::make_shared<queued_transaction>();
+        t->bytes.resize(size);
+        dst = t->bytes.data();
     }
-    return map_xfer_error(err, "receive", _address, _bus->port());
+    return async_state::run(_async, t, "receive", _address, _bus->port(), timeout, [&](int timeout_ms) {
+        return i2c_master_receive(_handle, dst, size, timeout_ms);
+    }).transform([&] {
+        if (t) {
+            std::copy_n(dst, size, buf);
+        }
+    });
 }
 
 result<void>
@@ -369,4 +677,80 @@ result<void> master_device::_try_read_register(
     });
 }
 
+// =============================================================================
+// Asynchronous transactions
+// =============================================================================
+
+result<idfxx::future<void>>
+master_device::_try_transmit_async(std::span<const uint8_t> data, std::chrono::milliseconds timeout) {
+    if (_handle == nullptr) {
+        return error(errc::invalid_state);
+    }
+    std::scoped_lock lock(*_bus);
+    return async_state::queue(
+        _async,
+        std::make_shared<queued_transaction>(),
+        "transmit",
+        _address,
+        _bus->port(),
+        timeout,
+        [&](int timeout_ms) { return i2c_master_transmit(_handle, data.data(), data.size(), timeout_ms); }
+    );
+}
+
+result<idfxx::future<void>>
+master_device::_try_receive_async(std::span<uint8_t> buf, std::chrono::milliseconds timeout) {
+    if (_handle == nullptr) {
+        return error(errc::invalid_state);
+    }
+    std::scoped_lock lock(*_bus);
+    return async_state::queue(
+        _async,
+        std::make_shared<queued_transaction>(),
+        "receive",
+        _address,
+        _bus->port(),
+        timeout,
+        [&](int timeout_ms) { return i2c_master_receive(_handle, buf.data(), buf.size(), timeout_ms); }
+    );
+}
+
+result<idfxx::future<void>> master_device::_try_write_register_async(
+    uint16_t reg,
+    std::span<const uint8_t> buf,
+    std::chrono::milliseconds timeout
+) {
+    if (_handle == nullptr) {
+        return error(errc::invalid_state);
+    }
+    // The transaction owns a copy of the address and data, so the caller's
+    // buffer is free as soon as this returns.
+    auto t = std::make_shared<queued_transaction>();
+    t->bytes.reserve(2 + buf.size());
+    t->bytes.push_back(static_cast<uint8_t>((reg >> 8) & 0xFF));
+    t->bytes.push_back(static_cast<uint8_t>(reg & 0xFF));
+    t->bytes.insert(t->bytes.end(), buf.begin(), buf.end());
+
+    std::scoped_lock lock(*_bus);
+    return async_state::queue(_async, t, "write_register", _address, _bus->port(), timeout, [&](int timeout_ms) {
+        return i2c_master_transmit(_handle, t->bytes.data(), t->bytes.size(), timeout_ms);
+    });
+}
+
+result<idfxx::future<void>>
+master_device::_try_read_register_async(uint16_t reg, std::span<uint8_t> buf, std::chrono::milliseconds timeout) {
+    if (_handle == nullptr) {
+        return error(errc::invalid_state);
+    }
+    auto t = std::make_shared<queued_transaction>();
+    t->bytes = {static_cast<uint8_t>((reg >> 8) & 0xFF), static_cast<uint8_t>(reg & 0xFF)};
+
+    std::scoped_lock lock(*_bus);
+    return async_state::queue(_async, t, "read_register", _address, _bus->port(), timeout, [&](int timeout_ms) {
+        return i2c_master_transmit_receive(
+            _handle, t->bytes.data(), t->bytes.size(), buf.data(), buf.size(), timeout_ms
+        );
+    });
+}
+
 } // namespace idfxx::i2c
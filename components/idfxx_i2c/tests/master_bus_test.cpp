@@ -184,6 +184,27 @@ TEST_CASE("master_bus port accessor works", "[idfxx][i2c][master_bus]") {
     TEST_ASSERT_EQUAL(std::to_underlying(port::i2c0), std::to_underlying(bus.port()));
 }
 
+TEST_CASE("master_bus trans_queue_depth accessor works", "[idfxx][i2c][master_bus]") {
+    {
+        auto bus_result = master_bus::make(port::i2c0, TEST_SDA, TEST_SCL, 100_kHz);
+        if (!bus_result.has_value()) {
+            TEST_FAIL_MESSAGE("Failed to create I2C bus");
+        }
+        TEST_ASSERT_EQUAL(0, bus_result->trans_queue_depth());
+    }
+
+    auto bus_result = master_bus::make(port::i2c0, {
+        .sda = TEST_SDA,
+        .scl = TEST_SCL,
+        .frequency = 100_kHz,
+        .trans_queue_depth = 4,
+    });
+    if (!bus_result.has_value()) {
+        TEST_FAIL_MESSAGE("Failed to create I2C bus with a transaction queue");
+    }
+    TEST_ASSERT_EQUAL(4, bus_result->trans_queue_depth());
+}
+
 // =============================================================================
 // to_string tests
 // =============================================================================
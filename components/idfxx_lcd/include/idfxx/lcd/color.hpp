@@ -109,4 +109,107 @@ private:
 
 static_assert(sizeof(rgb565) == 2);
 
+/**
+ * @headerfile <idfxx/lcd/color>
+ * @brief An 8-bit RGB332 color: 3 bits of red, 3 of green, 2 of blue.
+ *
+ * The pixel type of @ref rgb332_framebuffer. Panels do not accept RGB332
+ * directly; @ref to_rgb565 expands it, replicating each component's high
+ * bits into the low ones so full intensity stays full intensity.
+ *
+ * @code
+ * constexpr idfxx::lcd::rgb332 amber(255, 191, 0);
+ * @endcode
+ */
+class rgb332 {
+public:
+    /** @brief Creates black. */
+    constexpr rgb332() noexcept = default;
+
+    /**
+     * @brief Creates a color from 8-bit red, green, and blue components.
+     *
+     * Components are truncated to the 3-3-2 bit layout.
+     *
+     * @param r Red component, 0-255.
+     * @param g Green component, 0-255.
+     * @param b Blue component, 0-255.
+     */
+    constexpr rgb332(uint8_t r, uint8_t g, uint8_t b) noexcept
+        : _value(static_cast<uint8_t>((r & 0xE0u) | ((g & 0xE0u) >> 3) | (b >> 6))) {}
+
+    /**
+     * @brief Creates a color from a packed RGB332 value.
+     *
+     * @param value Packed color: red in bits 7-5, green in bits 4-2, blue in
+     *              bits 1-0.
+     * @return The color.
+     */
+    [[nodiscard]] static constexpr rgb332 from_value(uint8_t value) noexcept {
+        rgb332 c;
+        c._value = value;
+        return c;
+    }
+
+    /** @brief Returns the packed RGB332 value. */
+    [[nodiscard]] constexpr uint8_t value() const noexcept { return _value; }
+
+    /** @brief Returns the same color in RGB565. */
+    [[nodiscard]] constexpr rgb565 to_rgb565() const noexcept {
+        const unsigned r = _value >> 5;
+        const unsigned g = (_value >> 2) & 0x07u;
+        const unsigned b = _value & 0x03u;
+        return rgb565::from_value(
+            static_cast<uint16_t>(
+                (((r << 2) | (r >> 1)) << 11) | (((g << 3) | g) << 5) | ((b << 3) | (b << 1) | (b >> 1))
+            )
+        );
+    }
+
+    /** @brief Compares two colors for equality. */
+    friend constexpr bool operator==(rgb332, rgb332) noexcept = default;
+
+private:
+    uint8_t _value = 0;
+};
+
+static_assert(sizeof(rgb332) == 1);
+
+/**
+ * @headerfile <idfxx/lcd/color>
+ * @brief A 4-bit grey level, from 0 (black) to 15 (white).
+ *
+ * The pixel type of @ref grey4_framebuffer. @ref to_rgb565 expands it to
+ * the matching grey in RGB565.
+ */
+class grey4 {
+public:
+    /** @brief Creates black. */
+    constexpr grey4() noexcept = default;
+
+    /**
+     * @brief Creates a grey level.
+     *
+     * @param level Level from 0 (black) to 15 (white); higher bits are ignored.
+     */
+    constexpr explicit grey4(uint8_t level) noexcept
+        : _level(level & 0x0Fu) {}
+
+    /** @brief Returns the level, from 0 (black) to 15 (white). */
+    [[nodiscard]] constexpr uint8_t level() const noexcept { return _level; }
+
+    /** @brief Returns the same grey in RGB565. */
+    [[nodiscard]] constexpr rgb565 to_rgb565() const noexcept {
+        const unsigned rb = (_level << 1) | (_level >> 3);
+        const unsigned g = (_level << 2) | (_level >> 2);
+        return rgb565::from_value(static_cast<uint16_t>((rb << 11) | (g << 5) | rb));
+    }
+
+    /** @brief Compares two levels for equality. */
+    friend constexpr bool operator==(grey4, grey4) noexcept = default;
+
+private:
+    uint8_t _level = 0;
+};
+
 } // namespace idfxx::lcd
@@ -0,0 +1,578 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+#pragma once
+
+/**
+ * @headerfile <idfxx/lcd/compact_framebuffer>
+ * @file compact_framebuffer.hpp
+ * @brief Compact framebuffers (RGB332, 4-bit grey, palette) with a converting flush.
+ * @ingroup idfxx_lcd
+ */
+
+#include <idfxx/error>
+#include <idfxx/flags>
+#include <idfxx/future>
+#include <idfxx/lcd/color>
+#include <idfxx/lcd/detail/caps_allocator.hpp>
+#include <idfxx/lcd/panel>
+#include <idfxx/lcd/transfer_tracker>
+#include <idfxx/memory>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <utility>
+#include <vector>
+
+/**
+ * @headerfile <idfxx/lcd/compact_framebuffer>
+ * @brief LCD driver classes.
+ */
+namespace idfxx::lcd {
+
+/**
+ * @headerfile <idfxx/lcd/compact_framebuffer>
+ * @brief Pixel format of @ref rgb332_framebuffer: one @ref rgb332 per byte.
+ */
+struct rgb332_format {
+    /** @brief The value type written by the framebuffer's `set_pixel`. */
+    using pixel_type = rgb332;
+    /** @brief Bits of storage per pixel. */
+    static constexpr unsigned bits_per_pixel = 8;
+
+    /** @brief Returns the stored code for a pixel. */
+    static constexpr uint8_t encode(rgb332 c) noexcept { return c.value(); }
+    /** @brief Returns the pixel for a stored code. */
+    static constexpr rgb332 decode(uint8_t code) noexcept { return rgb332::from_value(code); }
+    /** @brief Returns the RGB565 color a stored code is sent to the panel as. */
+    static constexpr rgb565 expand(uint8_t code) noexcept { return decode(code).to_rgb565(); }
+};
+
+/**
+ * @headerfile <idfxx/lcd/compact_framebuffer>
+ * @brief Pixel format of @ref grey4_framebuffer: two @ref grey4 levels per byte.
+ */
+struct grey4_format {
+    /** @brief The value type written by the framebuffer's `set_pixel`. */
+    using pixel_type = grey4;
+    /** @brief Bits of storage per pixel. */
+    static constexpr unsigned bits_per_pixel = 4;
+
+    /** @brief Returns the stored code for a pixel. */
+    static constexpr uint8_t encode(grey4 g) noexcept { return g.level(); }
+    /** @brief Returns the pixel for a stored code. */
+    static constexpr grey4 decode(uint8_t code) noexcept { return grey4(code); }
+    /** @brief Returns the RGB565 color a stored code is sent to the panel as. */
+    static constexpr rgb565 expand(uint8_t code) noexcept { return decode(code).to_rgb565(); }
+};
+
+/**
+ * @headerfile <idfxx/lcd/compact_framebuffer>
+ * @brief Pixel format of @ref palette_framebuffer: one 8-bit palette index per byte.
+ *
+ * Has no fixed expansion; the framebuffer's palette maps each index to its
+ * RGB565 color.
+ */
+struct palette8_format {
+    /** @brief The value type written by the framebuffer's `set_pixel`: a palette index. */
+    using pixel_type = uint8_t;
+    /** @brief Bits of storage per pixel. */
+    static constexpr unsigned bits_per_pixel = 8;
+
+    /** @brief Returns the stored code for a pixel. */
+    static constexpr uint8_t encode(uint8_t index) noexcept { return index; }
+    /** @brief Returns the pixel for a stored code. */
+    static constexpr uint8_t decode(uint8_t code) noexcept { return code; }
+};
+
+/**
+ * @headerfile <idfxx/lcd/compact_framebuffer>
+ * @brief In-memory framebuffer storing fewer than 16 bits per pixel, expanded to RGB565 on flush.
+ *
+ * A full frame at 16 bpp is often too large for internal RAM (a 320x240
+ * panel needs 150 KB). A compact framebuffer holds the same frame in half
+ * (@ref rgb332_framebuffer, @ref palette_framebuffer) or a quarter
+ * (@ref grey4_framebuffer) of the memory, so simple UIs can keep a whole
+ * frame without banded rendering.
+ *
+ * Pixels are stored row-major. In 4-bit formats each row starts on a byte
+ * boundary and the left pixel of each pair is in the high nibble.
+ *
+ * Panels take RGB565, so @ref flush expands the frame a few rows at a time
+ * (@ref bounce_rows) into a small DMA-capable bounce buffer using a lookup
+ * table, one entry per stored code. The bounce buffer has two halves: while
+ * the panel transfers one, the next rows are expanded into the other, so
+ * conversion overlaps the transfer. Transfers go through a
+ * @ref transfer_tracker, which reports when a half may be reused.
+ *
+ * @code
+ * idfxx::lcd::transfer_tracker tracker; // installed as the panel I/O's on_color_transfer_done
+ * idfxx::lcd::rgb332_framebuffer fb(320, 240); // 75 KB instead of 150 KB
+ * idfxx::gfx::canvas canvas(fb);
+ * canvas.fill_rect(10, 10, 100, 40, idfxx::lcd::rgb332(255, 0, 0));
+ * fb.flush(display, tracker);
+ * @endcode
+ *
+ * The framebuffer satisfies `idfxx::gfx::pixel_surface`, including its bulk
+ * `fill_span`, `fill_block`, and `blit` hooks.
+ *
+ * This is a plain value type: copyable, movable, and independent of any
+ * panel. Copies keep the original's memory placement.
+ *
+ * @tparam Format The pixel format: @ref rgb332_format, @ref grey4_format, or
+ *                @ref palette8_format.
+ */
+template<typename Format>
+class compact_framebuffer {
+public:
+    /** @brief The value type written by @ref set_pixel. */
+    using pixel_type = typename Format::pixel_type;
+
+    /** @brief Rows expanded into each half of the bounce buffer per transfer. */
+    static constexpr size_t bounce_rows = 4;
+
+#ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
+    /**
+     * @brief Creates a framebuffer of the given dimensions, with every pixel stored as code 0.
+     *
+     * Code 0 is black in the RGB332 and grey formats, and palette index 0
+     * in the palette format.
+     *
+     * @param width  Width in pixels; must be non-zero.
+     * @param height Height in pixels; must be non-zero.
+     * @param caps   Capabilities of the memory holding the pixels. The pixels
+     *               are never transferred directly, so they need not be
+     *               DMA-capable.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on error (e.g. invalid dimensions).
+     */
+    [[nodiscard]] compact_framebuffer(
+        size_t width,
+        size_t height,
+        flags<memory::capabilities> caps = memory::capabilities::default_heap
+    )
+        : compact_framebuffer(unwrap(make(width, height, caps))) {}
+#endif
+
+    /**
+     * @brief Creates a framebuffer of the given dimensions, with every pixel stored as code 0.
+     *
+     * Code 0 is black in the RGB332 and grey formats, and palette index 0
+     * in the palette format, whose palette starts out all black.
+     *
+     * @param width  Width in pixels; must be non-zero.
+     * @param height Height in pixels; must be non-zero.
+     * @param caps   Capabilities of the memory holding the pixels. The pixels
+     *               are never transferred directly, so they need not be
+     *               DMA-capable; the bounce buffer always is.
+     *
+     * @return The new framebuffer, or an error.
+     * @retval idfxx::errc::invalid_arg if @p width or @p height is zero.
+     *
+     * @note Allocation failure is handled like any other allocation:
+     *       std::bad_alloc when exceptions are enabled, abort() otherwise.
+     */
+    [[nodiscard]] static result<compact_framebuffer>
+    make(size_t width, size_t height, flags<memory::capabilities> caps = memory::capabilities::default_heap) {
+        if (width == 0 || height == 0) {
+            return error(errc::invalid_arg);
+        }
+        return compact_framebuffer{
+            width,
+            height,
+            storage(_stride(width) * height, detail::caps_allocator<uint8_t>{caps}),
+            bounce_storage(2 * bounce_rows * width, detail::caps_allocator<rgb565>{memory::capabilities::dma}),
+        };
+    }
+
+    /** @brief Returns the width in pixels. */
+    [[nodiscard]] size_t width() const noexcept { return _width; }
+
+    /** @brief Returns the height in pixels. */
+    [[nodiscard]] size_t height() const noexcept { return _height; }
+
+    /**
+     * @brief Sets a single pixel.
+     *
+     * Out-of-range coordinates are ignored.
+     *
+     * @param x     Column, in `[0, width())`.
+     * @param y     Row, in `[0, height())`.
+     * @param pixel The value to write.
+     */
+    void set_pixel(size_t x, size_t y, pixel_type pixel) noexcept {
+        if (x >= _width || y >= _height) {
+            return;
+        }
+        _put(y * _stride(_width), x, Format::encode(pixel));
+    }
+
+    /**
+     * @brief Returns a single pixel.
+     *
+     * @param x Column, in `[0, width())`.
+     * @param y Row, in `[0, height())`.
+     * @return The pixel, or the value stored as code 0 if the coordinates are out of range.
+     */
+    [[nodiscard]] pixel_type get_pixel(size_t x, size_t y) const noexcept {
+        if (x >= _width || y >= _height) {
+            return Format::decode(0);
+        }
+        return Format::decode(_get(_data.data() + y * _stride(_width), x));
+    }
+
+    /**
+     * @brief Sets every pixel to the given value.
+     * @param pixel The value to fill with.
+     */
+    void fill(pixel_type pixel) noexcept { std::fill(_data.begin(), _data.end(), _fill_byte(Format::encode(pixel))); }
+
+    /** @brief Sets every pixel to code 0 (black, or palette index 0). */
+    void clear() noexcept { std::fill(_data.begin(), _data.end(), uint8_t{0}); }
+
+    /**
+     * @brief Sets a horizontal run of pixels to the given value.
+     *
+     * The run starts at (@p x, @p y) and extends @p length pixels to the
+     * right; any part outside the framebuffer is ignored.
+     *
+     * @param x      Column of the run's left end.
+     * @param y      Row of the run.
+     * @param length Number of pixels.
+     * @param pixel  The value to write.
+     */
+    void fill_span(size_t x, size_t y, size_t length, pixel_type pixel) noexcept { fill_block(x, y, length, 1, pixel); }
+
+    /**
+     * @brief Sets a rectangle of pixels to the given value.
+     *
+     * The rectangle's top-left corner is at (@p x, @p y); any part outside
+     * the framebuffer is ignored. Each row is filled with `memset`, apart
+     * from a lone pixel at either end sharing a byte with its neighbour in
+     * 4-bit formats.
+     *
+     * @param x      Left edge of the rectangle.
+     * @param y      Top edge of the rectangle.
+     * @param width  Width in pixels.
+     * @param height Height in pixels.
+     * @param pixel  The value to write.
+     */
+    void fill_block(size_t x, size_t y, size_t width, size_t height, pixel_type pixel) noexcept {
+        if (!_clip(x, y, width, height)) {
+            return;
+        }
+        const uint8_t code = Format::encode(pixel);
+        const size_t stride = _stride(_width);
+        for (size_t row = y; row < y + height; ++row) {
+            const size_t offset = row * stride;
+            size_t first = x;
+            size_t last = x + width; // exclusive
+            if constexpr (Format::bits_per_pixel == 4) {
+                if (first % 2 != 0) {
+                    _put(offset, first++, code);
+                }
+                if (last % 2 != 0 && last > first) {
+                    _put(offset, --last, code);
+                }
+                std::memset(_data.data() + offset + first / 2, _fill_byte(code), (last - first) / 2);
+            } else {
+                std::memset(_data.data() + offset + first, code, last - first);
+            }
+        }
+    }
+
+    /**
+     * @brief Copies a rectangle of pixels into the framebuffer.
+     *
+     * The rectangle's top-left corner lands at (@p x, @p y); any part
+     * outside the framebuffer is ignored. Source row `r` starts at
+     * `pixels + r * stride`.
+     *
+     * @param x      Left edge of the destination.
+     * @param y      Top edge of the destination.
+     * @param width  Width in pixels.
+     * @param height Height in pixels.
+     * @param pixels The source pixels, row-major.
+     * @param stride Distance between the starts of successive source rows, in pixels.
+     */
+    void blit(size_t x, size_t y, size_t width, size_t height, const pixel_type* pixels, size_t stride) noexcept {
+        if (!_clip(x, y, width, height)) {
+            return;
+        }
+        for (size_t row = y; row < y + height; ++row, pixels += stride) {
+            const size_t offset = row * _stride(_width);
+            for (size_t col = 0; col < width; ++col) {
+                _put(offset, x + col, Format::encode(pixels[col]));
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the raw pixel codes.
+     *
+     * The span holds the row-major layout described in the class
+     * documentation.
+     *
+     * @return A read-only view of the stored codes.
+     */
+    [[nodiscard]] std::span<const uint8_t> data() const noexcept { return _data; }
+
+    /**
+     * @brief Returns the RGB565 color each stored code is sent to the panel as.
+     *
+     * @return The lookup table, indexed by code.
+     */
+    [[nodiscard]] std::span<const rgb565, (size_t{1} << Format::bits_per_pixel)> palette() const noexcept {
+        return _lut;
+    }
+
+    /**
+     * @brief Replaces palette entries.
+     *
+     * Entry `i` of @p colors becomes the color of palette index
+     * `first + i`; entries past index 255 are ignored. The stored indices
+     * are unchanged, so the next @ref flush shows every pixel in its new
+     * color — e.g. for palette animation.
+     *
+     * @param colors The new colors.
+     * @param first  Palette index of the first color.
+     */
+    void set_palette(std::span<const rgb565> colors, size_t first = 0) noexcept
+        requires std::same_as<Format, palette8_format>
+    {
+        if (first < _lut.size()) {
+            std::copy_n(colors.begin(), std::min(colors.size(), _lut.size() - first), _lut.begin() + first);
+        }
+    }
+
+#ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
+    /**
+     * @brief Draws the full framebuffer to a panel, expanding it to RGB565.
+     *
+     * The framebuffer's top-left corner lands at (@p x, @p y) on the panel.
+     * The panel must use the RGB565 format. Returns once the last transfer
+     * has completed.
+     *
+     * @param panel   The panel to draw to.
+     * @param tracker The tracker installed as the panel I/O's `on_color_transfer_done`.
+     * @param x       Destination column of the framebuffer's left edge.
+     * @param y       Destination row of the framebuffer's top edge.
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on error.
+     */
+    void flush(panel& panel, transfer_tracker& tracker, size_t x = 0, size_t y = 0) {
+        unwrap(try_flush(panel, tracker, x, y));
+    }
+
+    /**
+     * @brief Draws a horizontal band of the framebuffer to a panel, expanding it to RGB565.
+     *
+     * The band spans rows `[y_start, y_end)` across the full width, and is
+     * drawn to the same rows on the panel. Returns once the last transfer
+     * has completed.
+     *
+     * @param panel   The panel to draw to.
+     * @param tracker The tracker installed as the panel I/O's `on_color_transfer_done`.
+     * @param y_start First row of the band, inclusive.
+     * @param y_end   End row of the band, exclusive; must satisfy `y_start < y_end <= height()`.
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on error (e.g. an invalid row range).
+     */
+    void flush_rows(panel& panel, transfer_tracker& tracker, size_t y_start, size_t y_end) {
+        unwrap(try_flush_rows(panel, tracker, y_start, y_end));
+    }
+#endif
+
+    /**
+     * @brief Draws the full framebuffer to a panel, expanding it to RGB565.
+     *
+     * The framebuffer's top-left corner lands at (@p x, @p y) on the panel.
+     * The panel must use the RGB565 format. Rows are expanded into alternate
+     * halves of the bounce buffer, each reused only once its previous
+     * transfer has completed. Returns once the last transfer has completed,
+     * even on error, so the bounce buffer is idle afterwards.
+     *
+     * @param panel   The panel to draw to.
+     * @param tracker The tracker installed as the panel I/O's `on_color_transfer_done`.
+     * @param x       Destination column of the framebuffer's left edge.
+     * @param y       Destination row of the framebuffer's top edge.
+     * @return Success, or an error.
+     */
+    [[nodiscard]] result<void> try_flush(panel& panel, transfer_tracker& tracker, size_t x = 0, size_t y = 0) {
+        return _send(panel, tracker, 0, _height, x, y);
+    }
+
+    /**
+     * @brief Draws a horizontal band of the framebuffer to a panel, expanding it to RGB565.
+     *
+     * The band spans rows `[y_start, y_end)` across the full width, and is
+     * drawn to the same rows on the panel. Returns once the last transfer
+     * has completed, even on error.
+     *
+     * @param panel   The panel to draw to.
+     * @param tracker The tracker installed as the panel I/O's `on_color_transfer_done`.
+     * @param y_start First row of the band, inclusive.
+     * @param y_end   End row of the band, exclusive; must satisfy `y_start < y_end <= height()`.
+     * @return Success, or an error.
+     * @retval idfxx::errc::invalid_arg if the row range is invalid.
+     */
+    [[nodiscard]] result<void> try_flush_rows(panel& panel, transfer_tracker& tracker, size_t y_start, size_t y_end) {
+        if (y_start >= y_end || y_end > _height) {
+            return error(errc::invalid_arg);
+        }
+        return _send(panel, tracker, y_start, y_end, 0, 0);
+    }
+
+private:
+    using storage = std::vector<uint8_t, detail::caps_allocator<uint8_t>>;
+    using bounce_storage = std::vector<rgb565, detail::caps_allocator<rgb565>>;
+    using lut_type = std::array<rgb565, (size_t{1} << Format::bits_per_pixel)>;
+
+    compact_framebuffer(size_t width, size_t height, storage data, bounce_storage bounce)
+        : _width(width)
+        , _height(height)
+        , _data(std::move(data))
+        , _bounce(std::move(bounce))
+        , _lut(_default_lut()) {}
+
+    static constexpr lut_type _default_lut() noexcept {
+        lut_type lut{};
+        if constexpr (requires { Format::expand(uint8_t{}); }) {
+            for (size_t code = 0; code < lut.size(); ++code) {
+                lut[code] = Format::expand(static_cast<uint8_t>(code));
+            }
+        }
+        return lut;
+    }
+
+    // Bytes per row; 4-bit rows start on a byte boundary.
+    static constexpr size_t _stride(size_t width) noexcept {
+        return Format::bits_per_pixel == 4 ? (width + 1) / 2 : width;
+    }
+
+    // The byte holding code in every pixel it covers.
+    static constexpr uint8_t _fill_byte(uint8_t code) noexcept {
+        return Format::bits_per_pixel == 4 ? static_cast<uint8_t>(code * 0x11u) : code;
+    }
+
+    void _put(size_t row_offset, size_t x, uint8_t code) noexcept {
+        if constexpr (Format::bits_per_pixel == 4) {
+            uint8_t& byte = _data[row_offset + x / 2];
+            byte = x % 2 == 0 ? static_cast<uint8_t>((byte & 0x0Fu) | (code << 4))
+                              : static_cast<uint8_t>((byte & 0xF0u) | code);
+        } else {
+            _data[row_offset + x] = code;
+        }
+    }
+
+    static uint8_t _get(const uint8_t* row, size_t x) noexcept {
+        if constexpr (Format::bits_per_pixel == 4) {
+            return x % 2 == 0 ? row[x / 2] >> 4 : row[x / 2] & 0x0Fu;
+        } else {
+            return row[x];
+        }
+    }
+
+    // Trims a rectangle to the framebuffer, returning false if nothing is left.
+    [[nodiscard]] bool _clip(size_t x, size_t y, size_t& width, size_t& height) const noexcept {
+        if (x >= _width || y >= _height) {
+            return false;
+        }
+        width = std::min(width, _width - x);
+        height = std::min(height, _height - y);
+        return width != 0 && height != 0;
+    }
+
+    // Expands rows [y, y + rows) into dst through the lookup table.
+    void _expand(size_t y, size_t rows, rgb565* dst) const noexcept {
+        const size_t stride = _stride(_width);
+        for (size_t row = y; row < y + rows; ++row) {
+            const uint8_t* src = _data.data() + row * stride;
+            if constexpr (Format::bits_per_pixel == 4) {
+                size_t col = 0;
+                for (; col + 1 < _width; col += 2, ++src) {
+                    *dst++ = _lut[*src >> 4];
+                    *dst++ = _lut[*src & 0x0Fu];
+                }
+                if (col < _width) {
+                    *dst++ = _lut[*src >> 4];
+                }
+            } else {
+                for (size_t col = 0; col < _width; ++col) {
+                    *dst++ = _lut[src[col]];
+                }
+            }
+        }
+    }
+
+    // Sends rows [y_start, y_end) to the panel with the framebuffer's origin
+    // at (x, y), alternating between the two halves of the bounce buffer.
+    result<void> _send(panel& panel, transfer_tracker& tracker, size_t y_start, size_t y_end, size_t x, size_t y) {
+        std::array<future<void>, 2> in_flight;
+        result<void> status;
+        for (size_t row = y_start, n = 0; row < y_end; row += bounce_rows, ++n) {
+            // A half is rewritten only once the panel has finished with it.
+            auto idle = in_flight[n % 2].try_wait();
+            if (!idle) {
+                status = idle;
+                break;
+            }
+            const size_t rows = std::min(bounce_rows, y_end - row);
+            rgb565* half = _bounce.data() + (n % 2) * bounce_rows * _width;
+            _expand(row, rows, half);
+            auto sent = panel.try_draw_bitmap_async(
+                tracker,
+                static_cast<int>(x),
+                static_cast<int>(y + row),
+                static_cast<int>(x + _width),
+                static_cast<int>(y + row + rows),
+                half
+            );
+            if (!sent) {
+                status = error(sent.error());
+                break;
+            }
+            in_flight[n % 2] = std::move(*sent);
+        }
+        // Leave nothing in flight reading the bounce buffer.
+        for (const future<void>& f : in_flight) {
+            auto idle = f.try_wait();
+            if (status && !idle) {
+                status = idle;
+            }
+        }
+        return status;
+    }
+
+    size_t _width;
+    size_t _height;
+    storage _data;
+    bounce_storage _bounce;
+    lut_type _lut;
+};
+
+/**
+ * @headerfile <idfxx/lcd/compact_framebuffer>
+ * @brief Framebuffer of @ref rgb332 colors, 8 bits per pixel (half of @ref rgb565_framebuffer).
+ */
+using rgb332_framebuffer = compact_framebuffer<rgb332_format>;
+
+/**
+ * @headerfile <idfxx/lcd/compact_framebuffer>
+ * @brief Framebuffer of @ref grey4 levels, 4 bits per pixel (a quarter of @ref rgb565_framebuffer).
+ */
+using grey4_framebuffer = compact_framebuffer<grey4_format>;
+
+/**
+ * @headerfile <idfxx/lcd/compact_framebuffer>
+ * @brief Framebuffer of 8-bit palette indices, mapped to RGB565 by a 256-entry palette.
+ */
+using palette_framebuffer = compact_framebuffer<palette8_format>;
+
+} // namespace idfxx::lcd
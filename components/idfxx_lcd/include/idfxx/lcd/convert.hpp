@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+#pragma once
+
+/**
+ * @headerfile <idfxx/lcd/convert>
+ * @file convert.hpp
+ * @brief Batched pixel format conversion into RGB565.
+ * @ingroup idfxx_lcd
+ */
+
+#include <idfxx/lcd/color>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+/**
+ * @headerfile <idfxx/lcd/convert>
+ * @brief LCD driver classes.
+ */
+namespace idfxx::lcd {
+
+/**
+ * @headerfile <idfxx/lcd/convert>
+ * @brief Source pixel formats accepted by @ref convert_to_rgb565.
+ */
+enum class pixel_format : uint8_t {
+    rgb888,   ///< 3 bytes per pixel: red, green, blue
+    bgr888,   ///< 3 bytes per pixel: blue, green, red
+    argb8888, ///< 32-bit words 0xAARRGGBB in native byte order (bytes B, G, R, A on ESP32); alpha is ignored
+    grey8,    ///< 1 byte per pixel: grey level, 0 (black) to 255 (white)
+};
+
+/**
+ * @brief Returns the number of bytes one pixel of @p format occupies.
+ * @param format The pixel format.
+ * @return The size of one pixel in bytes.
+ */
+[[nodiscard]] constexpr size_t bytes_per_pixel(pixel_format format) noexcept {
+    switch (format) {
+    case pixel_format::rgb888:
+    case pixel_format::bgr888:
+        return 3;
+    case pixel_format::argb8888:
+        return 4;
+    case pixel_format::grey8:
+        return 1;
+    }
+    return 1;
+}
+
+/**
+ * @brief Converts a run of pixels to RGB565.
+ *
+ * Produces the same colors as constructing each @ref rgb565 from its 8-bit
+ * components, but works a 32-bit word at a time: it loads up to four source
+ * pixels per word and stores two RGB565 pixels per word, which makes
+ * converting a camera frame or decoded image cheaper than sending it to the
+ * panel. The work is split into a word-aligned body and byte-wise head and
+ * tail, so any source and destination alignment is accepted.
+ *
+ * By default the output is in the panel byte order @ref rgb565 uses, ready
+ * for @ref panel::draw_bitmap or a framebuffer @c blit. Panels configured
+ * with @ref rgb_data_endian::little take the opposite byte order; pass
+ * `rgb_data_endian::little` to write that instead. (Such values are
+ * byte-swapped with respect to @ref rgb565::value, so compare or modify
+ * them only after converting with the default order.)
+ *
+ * @code
+ * // A 96x96 RGB888 camera thumbnail into a framebuffer, a row at a time.
+ * std::array<idfxx::lcd::rgb565, 96> row;
+ * for (size_t y = 0; y < 96; ++y) {
+ *     idfxx::lcd::convert_to_rgb565(
+ *         idfxx::lcd::pixel_format::rgb888, frame.subspan(y * 96 * 3, 96 * 3), row);
+ *     fb.blit(x, top + y, 96, 1, row.data(), 96);
+ * }
+ * @endcode
+ *
+ * @param format Pixel format of @p src.
+ * @param src    Source pixels, `bytes_per_pixel(format)` bytes each.
+ * @param dst    Destination pixels.
+ * @param endian Byte order to write; the default matches @ref rgb565.
+ *
+ * @return The number of pixels converted: the smaller of the whole pixels in
+ *         @p src and the size of @p dst.
+ */
+size_t convert_to_rgb565(
+    pixel_format format,
+    std::span<const uint8_t> src,
+    std::span<rgb565> dst,
+    rgb_data_endian endian = rgb_data_endian::big
+) noexcept;
+
+} // namespace idfxx::lcd
@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+#pragma once
+
+/**
+ * @headerfile <idfxx/lcd/damage>
+ * @file damage.hpp
+ * @brief Damaged-region tracking for LCD framebuffers.
+ * @ingroup idfxx_lcd
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+
+/**
+ * @headerfile <idfxx/lcd/damage>
+ * @brief LCD driver classes.
+ */
+namespace idfxx::lcd {
+
+/**
+ * @headerfile <idfxx/lcd/damage>
+ * @brief A rectangle of pixels, spanning columns `[x_start, x_end)` and rows `[y_start, y_end)`.
+ */
+struct rect {
+    size_t x_start = 0; ///< First column, inclusive.
+    size_t y_start = 0; ///< First row, inclusive.
+    size_t x_end = 0;   ///< End column, exclusive.
+    size_t y_end = 0;   ///< End row, exclusive.
+
+    /** @brief Returns true if the rectangle covers no pixels. */
+    [[nodiscard]] constexpr bool empty() const noexcept { return x_start >= x_end || y_start >= y_end; }
+
+    /** @brief Returns the width in pixels. */
+    [[nodiscard]] constexpr size_t width() const noexcept { return empty() ? 0 : x_end - x_start; }
+
+    /** @brief Returns the height in pixels. */
+    [[nodiscard]] constexpr size_t height() const noexcept { return empty() ? 0 : y_end - y_start; }
+
+    /** @brief Returns the number of pixels covered. */
+    [[nodiscard]] constexpr size_t area() const noexcept { return width() * height(); }
+
+    /** @brief Returns true if every pixel of @p other is also covered by this rectangle. */
+    [[nodiscard]] constexpr bool contains(const rect& other) const noexcept {
+        return other.x_start >= x_start && other.x_end <= x_end && other.y_start >= y_start && other.y_end <= y_end;
+    }
+
+    /** @brief Returns the smallest rectangle covering both this rectangle and @p other. */
+    [[nodiscard]] constexpr rect bounds(const rect& other) const noexcept {
+        return {
+            std::min(x_start, other.x_start),
+            std::min(y_start, other.y_start),
+            std::max(x_end, other.x_end),
+            std::max(y_end, other.y_end),
+        };
+    }
+
+    /** @brief Compares two rectangles for equality. */
+    constexpr bool operator==(const rect&) const noexcept = default;
+};
+
+/**
+ * @headerfile <idfxx/lcd/damage>
+ * @brief A small, fixed-capacity set of damaged rectangles.
+ *
+ * Framebuffers record every write here so that only the changed parts of a
+ * frame need to be transferred. Each transfer to a panel carries a fixed
+ * setup cost (the column and row window commands), so the set trades a
+ * little overdraw for fewer rectangles:
+ *
+ * - a rectangle already covered by the set is dropped,
+ * - a rectangle is merged with any existing one whose combined bounding box
+ *   is no more than twice their total area (so runs of adjacent pixels grow
+ *   one rectangle, while distant widgets stay separate), and merges cascade,
+ * - when the set is full, the rectangle is merged with the existing one
+ *   whose bounding box grows least.
+ *
+ * The set never holds more than @ref capacity rectangles and never
+ * allocates, so it is cheap enough to update on every pixel write.
+ */
+class damage_set {
+public:
+    /** @brief Maximum number of rectangles held. */
+    static constexpr size_t capacity = 8;
+
+    /**
+     * @brief Adds a damaged rectangle.
+     *
+     * Empty rectangles are ignored.
+     *
+     * @param r The rectangle to add.
+     */
+    constexpr void add(const rect& r) noexcept {
+        if (r.empty()) {
+            return;
+        }
+        // Most recent first: successive writes usually land near each other.
+        for (size_t i = _count; i-- > 0;) {
+            if (_rects[i].contains(r)) {
+                return;
+            }
+        }
+        rect merged = _absorb(r);
+        if (_count == capacity) {
+            size_t best = 0;
+            size_t best_growth = static_cast<size_t>(-1);
+            for (size_t i = 0; i < _count; ++i) {
+                size_t growth = _rects[i].bounds(merged).area() - _rects[i].area();
+                if (growth < best_growth) {
+                    best = i;
+                    best_growth = growth;
+                }
+            }
+            merged = merged.bounds(_rects[best]);
+            _remove(best);
+            merged = _absorb(merged);
+        }
+        _rects[_count++] = merged;
+    }
+
+    /** @brief Removes every rectangle. */
+    constexpr void clear() noexcept { _count = 0; }
+
+    /** @brief Returns true if no rectangles are held. */
+    [[nodiscard]] constexpr bool empty() const noexcept { return _count == 0; }
+
+    /** @brief Returns the number of rectangles held. */
+    [[nodiscard]] constexpr size_t size() const noexcept { return _count; }
+
+    /** @brief Returns the held rectangles, in no particular order. Rectangles may overlap. */
+    [[nodiscard]] constexpr std::span<const rect> regions() const noexcept { return {_rects.data(), _count}; }
+
+private:
+    // Merges r with every held rectangle cheap enough to combine, removing
+    // those from the set, and returns the combined rectangle.
+    constexpr rect _absorb(rect r) noexcept {
+        for (size_t i = 0; i < _count;) {
+            rect combined = _rects[i].bounds(r);
+            if (combined.area() <= 2 * (_rects[i].area() + r.area())) {
+                r = combined;
+                _remove(i);
+                i = 0; // the grown rectangle may now reach earlier ones
+            } else {
+                ++i;
+            }
+        }
+        return r;
+    }
+
+    constexpr void _remove(size_t i) noexcept { _rects[i] = _rects[--_count]; }
+
+    std::array<rect, capacity> _rects{};
+    size_t _count = 0;
+};
+
+} // namespace idfxx::lcd
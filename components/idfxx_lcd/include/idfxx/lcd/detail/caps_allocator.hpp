@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+#pragma once
+
+/**
+ * @headerfile <idfxx/lcd/detail/caps_allocator.hpp>
+ * @file caps_allocator.hpp
+ * @brief Allocator with memory capabilities chosen at run time.
+ * @ingroup idfxx_lcd
+ */
+
+#include <idfxx/error>
+#include <idfxx/flags>
+#include <idfxx/memory>
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+/// @cond INTERNAL
+
+namespace idfxx::lcd::detail {
+
+/**
+ * @brief STL-compatible allocator whose memory capabilities are chosen at run time.
+ *
+ * Like @ref idfxx::allocator, but the capabilities are carried by the
+ * allocator instance, so a framebuffer can be placed in DMA-capable memory
+ * or in SPIRAM depending on how it was created. Containers propagate the
+ * allocator on copy, move, and swap, so storage keeps its placement.
+ *
+ * @tparam T The type of object to allocate.
+ */
+template<typename T>
+struct caps_allocator {
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    /** @brief Creates an allocator drawing from heap regions matching @p c. */
+    constexpr explicit caps_allocator(flags<memory::capabilities> c) noexcept
+        : caps(c) {}
+
+    /** @brief Rebinding copy constructor. */
+    template<typename U>
+    constexpr caps_allocator(const caps_allocator<U>& other) noexcept
+        : caps(other.caps) {}
+
+    /**
+     * @brief Allocates memory for n objects of type T.
+     *
+     * @note Throws std::bad_alloc only when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     *       When exceptions are disabled, calls abort() on failure.
+     */
+    [[nodiscard]] T* allocate(size_t n) {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            raise_no_mem();
+        }
+        void* p = heap_caps_malloc(n * sizeof(T), to_underlying(caps));
+        if (!p) {
+            raise_no_mem();
+        }
+        return static_cast<T*>(p);
+    }
+
+    /** @brief Deallocates memory previously allocated by this allocator. */
+    void deallocate(T* p, size_t) noexcept { heap_caps_free(p); }
+
+    /** @brief Allocators are interchangeable when they draw from the same regions. */
+    template<typename U>
+    constexpr bool operator==(const caps_allocator<U>& other) const noexcept {
+        return caps == other.caps;
+    }
+
+    flags<memory::capabilities> caps; ///< Capabilities of the heap regions allocated from.
+};
+
+} // namespace idfxx::lcd::detail
+
+/// @endcond
@@ -11,6 +11,7 @@
  */
 
 #include <idfxx/error>
+#include <idfxx/lcd/damage>
 #include <idfxx/lcd/panel>
 
 #include <algorithm>
@@ -37,8 +38,10 @@ namespace idfxx::lcd {
  *
  * Draw into the framebuffer with @ref set_pixel and friends, then push it to
  * a panel with @ref flush (full frame) or @ref flush_rows (a horizontal
- * band). This is a plain value type: copyable, movable, and independent of
- * any panel.
+ * band). Every write is also recorded, rounded out to whole pages, in a
+ * small @ref damage_set, so @ref flush_dirty can transfer only what changed
+ * since the previous call. This is a plain value type: copyable, movable,
+ * and independent of any panel.
  *
  * @code
  * idfxx::lcd::mono_framebuffer fb(display.width(), display.height());
@@ -68,6 +71,9 @@ public:
     /**
      * @brief Creates a framebuffer of the given dimensions, with all pixels off.
      *
+     * The whole framebuffer starts out dirty, since the panel's contents are
+     * unknown.
+     *
      * @param width  Width in pixels; must be non-zero.
      * @param height Height in pixels; must be non-zero and a multiple of 8.
      *
@@ -90,7 +96,8 @@ public:
     /**
      * @brief Sets or clears a single pixel.
      *
-     * Out-of-range coordinates are ignored.
+     * Out-of-range coordinates are ignored. The pixel's page column is
+     * marked dirty.
      *
      * @param x  Column, in `[0, width())`.
      * @param y  Row, in `[0, height())`.
@@ -107,6 +114,8 @@ public:
         } else {
             byte &= static_cast<uint8_t>(~mask);
         }
+        size_t page_y = y & ~size_t{7};
+        _damage.add({x, page_y, x + 1, page_y + 8});
     }
 
     /**
@@ -124,14 +133,99 @@ public:
     }
 
     /**
-     * @brief Sets every pixel to the given state.
+     * @brief Sets every pixel to the given state, marking the whole framebuffer dirty.
      * @param on true to set all pixels, false to clear them.
      */
-    void fill(bool on) noexcept { std::ranges::fill(_data, on ? uint8_t{0xFF} : uint8_t{0x00}); }
+    void fill(bool on) noexcept {
+        std::ranges::fill(_data, on ? uint8_t{0xFF} : uint8_t{0x00});
+        _damage.add({0, 0, _width, _height});
+    }
 
     /** @brief Clears every pixel (equivalent to `fill(false)`). */
     void clear() noexcept { fill(false); }
 
+    /**
+     * @brief Sets or clears a horizontal run of pixels.
+     *
+     * The run starts at (@p x, @p y) and extends @p length pixels to the
+     * right; any part outside the framebuffer is ignored. The run's page
+     * columns are marked dirty.
+     *
+     * @param x      Column of the run's left end.
+     * @param y      Row of the run.
+     * @param length Number of pixels.
+     * @param on     true to set the pixels, false to clear them.
+     */
+    void fill_span(size_t x, size_t y, size_t length, bool on) noexcept { fill_block(x, y, length, 1, on); }
+
+    /**
+     * @brief Sets or clears a rectangle of pixels.
+     *
+     * The rectangle's top-left corner is at (@p x, @p y); any part outside
+     * the framebuffer is ignored. Each page the rectangle touches is
+     * updated a byte (eight rows) at a time: pages it covers completely are
+     * overwritten, and partly covered pages are masked. The rectangle's
+     * pages are marked dirty.
+     *
+     * @param x      Left edge of the rectangle.
+     * @param y      Top edge of the rectangle.
+     * @param width  Width in pixels.
+     * @param height Height in pixels.
+     * @param on     true to set the pixels, false to clear them.
+     */
+    void fill_block(size_t x, size_t y, size_t width, size_t height, bool on) noexcept {
+        if (!_clip(x, y, width, height)) {
+            return;
+        }
+        const size_t y_end = y + height;
+        for (size_t page = y / 8; page * 8 < y_end; ++page) {
+            const size_t top = std::max(y, page * 8) - page * 8;
+            const size_t bottom = std::min(y_end, page * 8 + 8) - page * 8;
+            const auto mask = static_cast<uint8_t>((0xFFu << top) & (0xFFu >> (8 - bottom)));
+            uint8_t* bytes = _data.data() + page * _width + x;
+            if (mask == 0xFF) {
+                std::fill_n(bytes, width, on ? uint8_t{0xFF} : uint8_t{0x00});
+            } else if (on) {
+                for (size_t i = 0; i < width; ++i) {
+                    bytes[i] |= mask;
+                }
+            } else {
+                for (size_t i = 0; i < width; ++i) {
+                    bytes[i] &= static_cast<uint8_t>(~mask);
+                }
+            }
+        }
+        _damage.add({x, y & ~size_t{7}, x + width, (y_end + 7) & ~size_t{7}});
+    }
+
+    /**
+     * @brief Copies a rectangle of pixel states into the framebuffer.
+     *
+     * The rectangle's top-left corner lands at (@p x, @p y); any part
+     * outside the framebuffer is ignored. Source row `r` starts at
+     * `pixels + r * stride`. The rectangle's pages are marked dirty.
+     *
+     * @param x      Left edge of the destination.
+     * @param y      Top edge of the destination.
+     * @param width  Width in pixels.
+     * @param height Height in pixels.
+     * @param pixels The source pixel states, row-major.
+     * @param stride Distance between the starts of successive source rows, in pixels.
+     */
+    void blit(size_t x, size_t y, size_t width, size_t height, const bool* pixels, size_t stride) noexcept {
+        if (!_clip(x, y, width, height)) {
+            return;
+        }
+        for (size_t row = y; row < y + height; ++row, pixels += stride) {
+            uint8_t* bytes = _data.data() + (row / 8) * _width + x;
+            const auto mask = static_cast<uint8_t>(1u << (row % 8));
+            for (size_t i = 0; i < width; ++i) {
+                bytes[i] = pixels[i] ? static_cast<uint8_t>(bytes[i] | mask) : static_cast<uint8_t>(bytes[i] & ~mask);
+            }
+        }
+        _damage.add({x, y & ~size_t{7}, x + width, (y + height + 7) & ~size_t{7}});
+    }
+
     /**
      * @brief Returns the raw page-packed pixel data.
      *
@@ -143,6 +237,34 @@ public:
      */
     [[nodiscard]] std::span<const uint8_t> data() const noexcept { return _data; }
 
+    /**
+     * @brief Returns the rectangles changed since the last @ref flush_dirty or @ref mark_clean.
+     *
+     * The rectangles are clipped to the framebuffer, aligned to page
+     * boundaries, and may overlap.
+     *
+     * @return A read-only view of the dirty rectangles.
+     */
+    [[nodiscard]] std::span<const rect> dirty_regions() const noexcept { return _damage.regions(); }
+
+    /**
+     * @brief Marks a rectangle dirty, so the next @ref flush_dirty transfers it.
+     *
+     * @param r The rectangle to mark, expanded outward to page boundaries and
+     *          clipped to the framebuffer.
+     */
+    void mark_dirty(const rect& r) noexcept {
+        _damage.add({
+            r.x_start,
+            r.y_start & ~size_t{7},
+            std::min(r.x_end, _width),
+            std::min((r.y_end + 7) & ~size_t{7}, _height),
+        });
+    }
+
+    /** @brief Forgets all damage, e.g. after the frame was pushed with @ref flush. */
+    void mark_clean() noexcept { _damage.clear(); }
+
 #ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
     /**
      * @brief Draws the full framebuffer to a panel.
@@ -193,6 +315,21 @@ public:
     void flush_region(panel& panel, size_t x_start, size_t y_start, size_t x_end, size_t y_end) const {
         unwrap(try_flush_region(panel, x_start, y_start, x_end, y_end));
     }
+
+    /**
+     * @brief Draws the dirty rectangles to a panel and marks the framebuffer clean.
+     *
+     * Each dirty rectangle costs exactly one draw. Full-width and single-page
+     * rectangles are contiguous in the framebuffer and transfer in place;
+     * other rectangles are first copied, page by page, into a contiguous
+     * staging buffer owned by the framebuffer. The panel must use the
+     * page-packed 1-bpp format (e.g. an SSD1306).
+     *
+     * @param panel The panel to draw to.
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on error, leaving the framebuffer dirty.
+     */
+    void flush_dirty(panel& panel) { unwrap(try_flush_dirty(panel)); }
 #endif
 
     /**
@@ -277,15 +414,88 @@ public:
         return {};
     }
 
+    /**
+     * @brief Draws the dirty rectangles to a panel and marks the framebuffer clean.
+     *
+     * Each dirty rectangle costs exactly one draw. Full-width and single-page
+     * rectangles are contiguous in the framebuffer and transfer in place;
+     * other rectangles are first copied, page by page, into a contiguous
+     * staging buffer owned by the framebuffer. The panel must use the
+     * page-packed 1-bpp format (e.g. an SSD1306).
+     *
+     * As with the pixel data itself, the staging buffer must not change
+     * while a panel is still transferring from it, so the next call should
+     * not be made until the previous transfers have completed.
+     *
+     * @param panel The panel to draw to.
+     * @return Success, or an error. On error the framebuffer stays dirty, so a
+     *         later call retries every rectangle.
+     */
+    [[nodiscard]] result<void> try_flush_dirty(panel& panel) {
+        auto regions = _damage.regions();
+        size_t staged = 0;
+        for (const rect& r : regions) {
+            if (_needs_staging(r)) {
+                staged += r.area() / 8;
+            }
+        }
+        if (_staging.size() < staged) {
+            _staging.resize(staged);
+        }
+        // Each staged rectangle gets its own slice, so earlier transfers
+        // still in flight are never overwritten by later copies.
+        uint8_t* slot = _staging.data();
+        for (const rect& r : regions) {
+            const uint8_t* bytes = _data.data() + (r.y_start / 8) * _width + r.x_start;
+            if (_needs_staging(r)) {
+                const uint8_t* staged_bytes = slot;
+                for (size_t page = 0; page < r.height() / 8; ++page, bytes += _width) {
+                    slot = std::copy_n(bytes, r.width(), slot);
+                }
+                bytes = staged_bytes;
+            }
+            auto drawn = panel.try_draw_bitmap(
+                static_cast<int>(r.x_start),
+                static_cast<int>(r.y_start),
+                static_cast<int>(r.x_end),
+                static_cast<int>(r.y_end),
+                bytes
+            );
+            if (!drawn) {
+                return drawn;
+            }
+        }
+        _damage.clear();
+        return {};
+    }
+
 private:
     mono_framebuffer(size_t width, size_t height, std::vector<uint8_t> data)
         : _width(width)
         , _height(height)
-        , _data(std::move(data)) {}
+        , _data(std::move(data)) {
+        _damage.add({0, 0, width, height});
+    }
+
+    // Trims a rectangle to the framebuffer, returning false if nothing is left.
+    [[nodiscard]] bool _clip(size_t x, size_t y, size_t& width, size_t& height) const noexcept {
+        if (x >= _width || y >= _height) {
+            return false;
+        }
+        width = std::min(width, _width - x);
+        height = std::min(height, _height - y);
+        return width != 0 && height != 0;
+    }
+
+    // Damage is page-aligned; rectangles narrower than the framebuffer and
+    // taller than one page are not contiguous in the page-major layout.
+    [[nodiscard]] bool _needs_staging(const rect& r) const noexcept { return r.width() != _width && r.height() > 8; }
 
     size_t _width;
     size_t _height;
     std::vector<uint8_t> _data;
+    damage_set _damage;
+    std::vector<uint8_t> _staging;
 };
 
 } // namespace idfxx::lcd
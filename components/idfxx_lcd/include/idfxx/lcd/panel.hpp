@@ -11,6 +11,7 @@
  */
 
 #include <idfxx/error>
+#include <idfxx/future>
 #include <idfxx/gpio>
 #include <idfxx/lcd/color>
 
@@ -25,6 +26,8 @@ typedef struct esp_lcd_panel_t* esp_lcd_panel_handle_t;
  */
 namespace idfxx::lcd {
 
+class transfer_tracker;
+
 /**
  * @headerfile <idfxx/lcd/panel>
  * @brief Abstract base class for LCD panels.
@@ -101,6 +104,27 @@ public:
         unwrap(try_draw_bitmap(x_start, y_start, x_end, y_end, color_data));
     }
 
+    /**
+     * @brief Queues bitmap data for a region of the display, returning a future for the transfer.
+     *
+     * See @ref try_draw_bitmap_async.
+     *
+     * @param tracker    The transfer tracker installed as the panel I/O's `on_color_transfer_done`.
+     * @param x_start    Start column, inclusive.
+     * @param y_start    Start row, inclusive.
+     * @param x_end      End column, exclusive.
+     * @param y_end      End row, exclusive.
+     * @param color_data Pixel data in the panel's native format; must stay unchanged until the
+     *                   returned future completes.
+     * @return A future that completes once this transfer has finished.
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on error.
+     */
+    [[nodiscard]] future<void>
+    draw_bitmap_async(transfer_tracker& tracker, int x_start, int y_start, int x_end, int y_end, const void* color_data) {
+        return unwrap(try_draw_bitmap_async(tracker, x_start, y_start, x_end, y_end, color_data));
+    }
+
     /**
      * @brief Inverts the color of the display.
      * @param invert true to invert colors, false for normal.
@@ -154,6 +178,43 @@ public:
         return do_draw_bitmap(x_start, y_start, x_end, y_end, color_data);
     }
 
+    /**
+     * @brief Queues bitmap data for a region of the display, returning a future for the transfer.
+     *
+     * Like @ref try_draw_bitmap, this returns as soon as the transfer is
+     * queued; the returned future completes once the panel I/O reports it
+     * finished, after which @p color_data may be reused. Transfers to one
+     * panel I/O complete in the order they were queued, so the future also
+     * implies that every earlier transfer through @p tracker has finished.
+     * When the panel I/O's transaction queue (`trans_queue_depth`) is full,
+     * the call blocks until the oldest queued transfer completes.
+     *
+     * @code
+     * idfxx::lcd::transfer_tracker tracker; // installed as the panel I/O's on_color_transfer_done
+     * auto sent = panel.draw_bitmap_async(tracker, 0, 0, 240, 40, band.data());
+     * // ... prepare the next band in a second buffer ...
+     * sent.wait(); // band may now be overwritten
+     * @endcode
+     *
+     * @param tracker    The transfer tracker installed as the panel I/O's `on_color_transfer_done`.
+     * @param x_start    Start column, inclusive.
+     * @param y_start    Start row, inclusive.
+     * @param x_end      End column, exclusive.
+     * @param y_end      End row, exclusive.
+     * @param color_data Pixel data in the panel's native format; must stay unchanged until the
+     *                   returned future completes.
+     * @return A future that completes once this transfer has finished, or an error if it could
+     *         not be queued.
+     */
+    [[nodiscard]] result<future<void>> try_draw_bitmap_async(
+        transfer_tracker& tracker,
+        int x_start,
+        int y_start,
+        int x_end,
+        int y_end,
+        const void* color_data
+    );
+
     /**
      * @brief Inverts the color of the display.
      * @param invert true to invert colors, false for normal.
@@ -11,11 +11,20 @@
  */
 
 #include <idfxx/error>
+#include <idfxx/flags>
+#include <idfxx/future>
 #include <idfxx/lcd/color>
+#include <idfxx/lcd/damage>
+#include <idfxx/lcd/detail/caps_allocator.hpp>
 #include <idfxx/lcd/panel>
+#include <idfxx/lcd/transfer_tracker>
+#include <idfxx/memory>
 
 #include <algorithm>
+#include <bit>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <span>
 #include <vector>
 
@@ -47,8 +56,43 @@ namespace idfxx::lcd {
  * }
  * @endcode
  *
+ * Every write is also recorded in a small @ref damage_set, so a full-frame
+ * framebuffer can be kept on screen with @ref flush_dirty, which transfers
+ * only the rectangles changed since the previous call:
+ *
+ * @code
+ * idfxx::lcd::rgb565_framebuffer fb(display.width(), display.height());
+ * fb.flush_dirty(display); // a new framebuffer is entirely dirty
+ * for (;;) {
+ *     // ... update a few widgets ...
+ *     fb.flush_dirty(display);
+ * }
+ * @endcode
+ *
+ * Pixel storage is allocated from DMA-capable memory by default, so SPI
+ * panels transfer straight from the framebuffer without a bounce copy.
+ * Frames too large for internal RAM can be placed in SPIRAM instead, in
+ * which case the SPI driver bounce-copies each transfer through internal
+ * memory.
+ *
+ * @ref flush_async returns as soon as the transfer is queued, with a future
+ * that completes when the panel has consumed the pixels. Alternating
+ * between two framebuffers renders the next frame while the previous one
+ * is still being sent:
+ *
+ * @code
+ * idfxx::lcd::transfer_tracker tracker; // installed as the panel I/O's on_color_transfer_done
+ * std::array<idfxx::lcd::rgb565_framebuffer, 2> fbs{{{240, 320}, {240, 320}}};
+ * std::array<idfxx::future<void>, 2> sent;
+ * for (size_t n = 0;; n ^= 1) {
+ *     sent[n].wait(); // the panel is done with this buffer
+ *     // ... draw the next frame into fbs[n] ...
+ *     sent[n] = fbs[n].flush_async(display, tracker);
+ * }
+ * @endcode
+ *
  * This is a plain value type: copyable, movable, and independent of any
- * panel.
+ * panel. Copies keep the original's memory placement.
  */
 class rgb565_framebuffer {
 public:
@@ -61,28 +105,43 @@ public:
      *
      * @param width  Width in pixels; must be non-zero.
      * @param height Height in pixels; must be non-zero.
+     * @param caps   Capabilities of the memory holding the pixels, e.g.
+     *               `memory::capabilities::spiram` for frames too large for internal RAM.
      *
      * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
      * @throws std::system_error on error (e.g. invalid dimensions).
      */
-    [[nodiscard]] rgb565_framebuffer(size_t width, size_t height)
-        : rgb565_framebuffer(unwrap(make(width, height))) {}
+    [[nodiscard]] rgb565_framebuffer(
+        size_t width,
+        size_t height,
+        flags<memory::capabilities> caps = memory::capabilities::dma
+    )
+        : rgb565_framebuffer(unwrap(make(width, height, caps))) {}
 #endif
 
     /**
      * @brief Creates a framebuffer of the given dimensions, with all pixels black.
      *
+     * The whole framebuffer starts out dirty, since the panel's contents are
+     * unknown.
+     *
      * @param width  Width in pixels; must be non-zero.
      * @param height Height in pixels; must be non-zero.
+     * @param caps   Capabilities of the memory holding the pixels, e.g.
+     *               `memory::capabilities::spiram` for frames too large for internal RAM.
      *
      * @return The new rgb565_framebuffer, or an error.
      * @retval idfxx::errc::invalid_arg if @p width or @p height is zero.
+     *
+     * @note Allocation failure is handled like any other allocation:
+     *       std::bad_alloc when exceptions are enabled, abort() otherwise.
      */
-    [[nodiscard]] static result<rgb565_framebuffer> make(size_t width, size_t height) {
+    [[nodiscard]] static result<rgb565_framebuffer>
+    make(size_t width, size_t height, flags<memory::capabilities> caps = memory::capabilities::dma) {
         if (width == 0 || height == 0) {
             return error(errc::invalid_arg);
         }
-        return rgb565_framebuffer{width, height, std::vector<rgb565>(width * height)};
+        return rgb565_framebuffer{width, height, storage(width * height, allocator_type{caps})};
     }
 
     /** @brief Returns the width in pixels. */
@@ -94,7 +153,7 @@ public:
     /**
      * @brief Sets a single pixel to the given color.
      *
-     * Out-of-range coordinates are ignored.
+     * Out-of-range coordinates are ignored. The pixel is marked dirty.
      *
      * @param x     Column, in `[0, width())`.
      * @param y     Row, in `[0, height())`.
@@ -105,6 +164,7 @@ public:
             return;
         }
         _data[y * _width + x] = color;
+        _damage.add({x, y, x + 1, y + 1});
     }
 
     /**
@@ -122,14 +182,85 @@ public:
     }
 
     /**
-     * @brief Sets every pixel to the given color.
+     * @brief Sets every pixel to the given color, marking the whole framebuffer dirty.
      * @param color The color to fill with.
      */
-    void fill(rgb565 color) noexcept { std::ranges::fill(_data, color); }
+    void fill(rgb565 color) noexcept {
+        _fill_pixels(_data.data(), _data.size(), color);
+        _damage.add({0, 0, _width, _height});
+    }
 
     /** @brief Sets every pixel to black (equivalent to `fill({})`). */
     void clear() noexcept { fill({}); }
 
+    /**
+     * @brief Sets a horizontal run of pixels to the given color.
+     *
+     * The run starts at (@p x, @p y) and extends @p length pixels to the
+     * right; any part outside the framebuffer is ignored. The run is marked
+     * dirty.
+     *
+     * @param x      Column of the run's left end.
+     * @param y      Row of the run.
+     * @param length Number of pixels.
+     * @param color  The color to write.
+     */
+    void fill_span(size_t x, size_t y, size_t length, rgb565 color) noexcept { fill_block(x, y, length, 1, color); }
+
+    /**
+     * @brief Sets a rectangle of pixels to the given color.
+     *
+     * The rectangle's top-left corner is at (@p x, @p y); any part outside
+     * the framebuffer is ignored. Rows are filled two pixels per 32-bit
+     * store, and a full-width rectangle is filled as one contiguous run. The
+     * rectangle is marked dirty.
+     *
+     * @param x      Left edge of the rectangle.
+     * @param y      Top edge of the rectangle.
+     * @param width  Width in pixels.
+     * @param height Height in pixels.
+     * @param color  The color to write.
+     */
+    void fill_block(size_t x, size_t y, size_t width, size_t height, rgb565 color) noexcept {
+        if (!_clip(x, y, width, height)) {
+            return;
+        }
+        rgb565* row = _data.data() + y * _width + x;
+        if (width == _width) {
+            _fill_pixels(row, width * height, color);
+        } else {
+            for (size_t i = 0; i < height; ++i, row += _width) {
+                _fill_pixels(row, width, color);
+            }
+        }
+        _damage.add({x, y, x + width, y + height});
+    }
+
+    /**
+     * @brief Copies a rectangle of pixels into the framebuffer.
+     *
+     * The rectangle's top-left corner lands at (@p x, @p y); any part
+     * outside the framebuffer is ignored. Source row `r` starts at
+     * `pixels + r * stride`. The rectangle is marked dirty.
+     *
+     * @param x      Left edge of the destination.
+     * @param y      Top edge of the destination.
+     * @param width  Width in pixels.
+     * @param height Height in pixels.
+     * @param pixels The source pixels, row-major, in panel byte order.
+     * @param stride Distance between the starts of successive source rows, in pixels.
+     */
+    void blit(size_t x, size_t y, size_t width, size_t height, const rgb565* pixels, size_t stride) noexcept {
+        if (!_clip(x, y, width, height)) {
+            return;
+        }
+        rgb565* row = _data.data() + y * _width + x;
+        for (size_t i = 0; i < height; ++i, row += _width, pixels += stride) {
+            std::memcpy(row, pixels, width * sizeof(rgb565));
+        }
+        _damage.add({x, y, x + width, y + height});
+    }
+
     /**
      * @brief Returns the raw pixel data.
      *
@@ -141,6 +272,27 @@ public:
      */
     [[nodiscard]] std::span<const rgb565> data() const noexcept { return _data; }
 
+    /**
+     * @brief Returns the rectangles changed since the last @ref flush_dirty or @ref mark_clean.
+     *
+     * The rectangles are clipped to the framebuffer and may overlap.
+     *
+     * @return A read-only view of the dirty rectangles.
+     */
+    [[nodiscard]] std::span<const rect> dirty_regions() const noexcept { return _damage.regions(); }
+
+    /**
+     * @brief Marks a rectangle dirty, so the next @ref flush_dirty transfers it.
+     *
+     * @param r The rectangle to mark, clipped to the framebuffer.
+     */
+    void mark_dirty(const rect& r) noexcept {
+        _damage.add({r.x_start, r.y_start, std::min(r.x_end, _width), std::min(r.y_end, _height)});
+    }
+
+    /** @brief Forgets all damage, e.g. after the frame was pushed with @ref flush. */
+    void mark_clean() noexcept { _damage.clear(); }
+
 #ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
     /**
      * @brief Draws the full framebuffer to a panel.
@@ -157,6 +309,25 @@ public:
      */
     void flush(panel& panel, size_t x = 0, size_t y = 0) const { unwrap(try_flush(panel, x, y)); }
 
+    /**
+     * @brief Starts drawing the full framebuffer to a panel.
+     *
+     * As @ref flush, but the transfer is submitted through @p tracker and
+     * the returned future completes once the panel has consumed the pixels.
+     * The framebuffer must not be modified or destroyed until then.
+     *
+     * @param panel   The panel to draw to.
+     * @param tracker The tracker installed as the panel I/O's `on_color_transfer_done`.
+     * @param x       Destination column of the framebuffer's left edge.
+     * @param y       Destination row of the framebuffer's top edge.
+     * @return A future completing when the transfer has finished.
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on error.
+     */
+    [[nodiscard]] future<void> flush_async(panel& panel, transfer_tracker& tracker, size_t x = 0, size_t y = 0) const {
+        return unwrap(try_flush_async(panel, tracker, x, y));
+    }
+
     /**
      * @brief Draws a horizontal band of the framebuffer to a panel.
      *
@@ -192,6 +363,22 @@ public:
     void flush_region(panel& panel, size_t x_start, size_t y_start, size_t x_end, size_t y_end) const {
         unwrap(try_flush_region(panel, x_start, y_start, x_end, y_end));
     }
+
+    /**
+     * @brief Draws the dirty rectangles to a panel and marks the framebuffer clean.
+     *
+     * Each dirty rectangle costs exactly one draw. Full-width and single-row
+     * rectangles are contiguous in the framebuffer and transfer in place;
+     * other rectangles are first copied into a contiguous staging buffer
+     * owned by the framebuffer. The panel must use the RGB565 format.
+     *
+     * @param panel The panel to draw to.
+     * @param x     Destination column of the framebuffer's left edge.
+     * @param y     Destination row of the framebuffer's top edge.
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on error, leaving the framebuffer dirty.
+     */
+    void flush_dirty(panel& panel, size_t x = 0, size_t y = 0) { unwrap(try_flush_dirty(panel, x, y)); }
 #endif
 
     /**
@@ -216,6 +403,32 @@ public:
         );
     }
 
+    /**
+     * @brief Starts drawing the full framebuffer to a panel.
+     *
+     * As @ref try_flush, but the transfer is submitted through @p tracker
+     * and the returned future completes once the panel has consumed the
+     * pixels. The framebuffer must not be modified or destroyed
+     * until then.
+     *
+     * @param panel   The panel to draw to.
+     * @param tracker The tracker installed as the panel I/O's `on_color_transfer_done`.
+     * @param x       Destination column of the framebuffer's left edge.
+     * @param y       Destination row of the framebuffer's top edge.
+     * @return A future completing when the transfer has finished, or an error.
+     */
+    [[nodiscard]] result<future<void>>
+    try_flush_async(panel& panel, transfer_tracker& tracker, size_t x = 0, size_t y = 0) const {
+        return panel.try_draw_bitmap_async(
+            tracker,
+            static_cast<int>(x),
+            static_cast<int>(y),
+            static_cast<int>(x + _width),
+            static_cast<int>(y + _height),
+            _data.data()
+        );
+    }
+
     /**
      * @brief Draws a horizontal band of the framebuffer to a panel.
      *
@@ -281,15 +494,112 @@ public:
         return {};
     }
 
+    /**
+     * @brief Draws the dirty rectangles to a panel and marks the framebuffer clean.
+     *
+     * Each dirty rectangle costs exactly one draw. Full-width and single-row
+     * rectangles are contiguous in the framebuffer and transfer in place;
+     * other rectangles are first copied into a contiguous staging buffer
+     * owned by the framebuffer. The panel must use the RGB565 format.
+     *
+     * As with the pixel data itself, the staging buffer must not change
+     * while a panel is still transferring from it, so the next call should
+     * not be made until the previous transfers have completed.
+     *
+     * @param panel The panel to draw to.
+     * @param x     Destination column of the framebuffer's left edge.
+     * @param y     Destination row of the framebuffer's top edge.
+     * @return Success, or an error. On error the framebuffer stays dirty, so a
+     *         later call retries every rectangle.
+     */
+    [[nodiscard]] result<void> try_flush_dirty(panel& panel, size_t x = 0, size_t y = 0) {
+        auto regions = _damage.regions();
+        size_t staged = 0;
+        for (const rect& r : regions) {
+            if (_needs_staging(r)) {
+                staged += r.area();
+            }
+        }
+        if (_staging.size() < staged) {
+            // The staging buffer is transferred from too, so it shares the
+            // pixel storage's placement.
+            _staging = storage(staged, _data.get_allocator());
+        }
+        // Each staged rectangle gets its own slice, so earlier transfers
+        // still in flight are never overwritten by later copies.
+        rgb565* slot = _staging.data();
+        for (const rect& r : regions) {
+            const rgb565* pixels = _data.data() + r.y_start * _width + r.x_start;
+            if (_needs_staging(r)) {
+                const rgb565* staged_pixels = slot;
+                for (size_t row = 0; row < r.height(); ++row, pixels += _width) {
+                    slot = std::copy_n(pixels, r.width(), slot);
+                }
+                pixels = staged_pixels;
+            }
+            auto drawn = panel.try_draw_bitmap(
+                static_cast<int>(x + r.x_start),
+                static_cast<int>(y + r.y_start),
+                static_cast<int>(x + r.x_end),
+                static_cast<int>(y + r.y_end),
+                pixels
+            );
+            if (!drawn) {
+                return drawn;
+            }
+        }
+        _damage.clear();
+        return {};
+    }
+
 private:
-    rgb565_framebuffer(size_t width, size_t height, std::vector<rgb565> data)
+    using allocator_type = detail::caps_allocator<rgb565>;
+    using storage = std::vector<rgb565, allocator_type>;
+
+    rgb565_framebuffer(size_t width, size_t height, storage data)
         : _width(width)
         , _height(height)
-        , _data(std::move(data)) {}
+        , _data(std::move(data))
+        , _staging(_data.get_allocator()) {
+        _damage.add({0, 0, width, height});
+    }
+
+    // Trims a rectangle to the framebuffer, returning false if nothing is left.
+    [[nodiscard]] bool _clip(size_t x, size_t y, size_t& width, size_t& height) const noexcept {
+        if (x >= _width || y >= _height) {
+            return false;
+        }
+        width = std::min(width, _width - x);
+        height = std::min(height, _height - y);
+        return width != 0 && height != 0;
+    }
+
+    // Fills count pixels two at a time with 32-bit stores once the
+    // destination is word-aligned. Both halves of the word hold the same
+    // stored bytes, so the result is independent of host endianness.
+    static void _fill_pixels(rgb565* dst, size_t count, rgb565 color) noexcept {
+        if (count > 0 && reinterpret_cast<uintptr_t>(dst) % sizeof(uint32_t) != 0) {
+            *dst++ = color;
+            --count;
+        }
+        const uint32_t pair = uint32_t{std::bit_cast<uint16_t>(color)} * 0x00010001u;
+        for (; count >= 2; count -= 2, dst += 2) {
+            std::memcpy(static_cast<void*>(dst), &pair, sizeof(pair));
+        }
+        if (count > 0) {
+            *dst = color;
+        }
+    }
+
+    // Rectangles narrower than the framebuffer and taller than one row are
+    // not contiguous in the row-major layout.
+    [[nodiscard]] bool _needs_staging(const rect& r) const noexcept { return r.width() != _width && r.height() > 1; }
 
     size_t _width;
     size_t _height;
-    std::vector<rgb565> _data;
+    storage _data;
+    damage_set _damage;
+    storage _staging;
 };
 
 } // namespace idfxx::lcd
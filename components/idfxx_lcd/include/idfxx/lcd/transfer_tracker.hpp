@@ -0,0 +1,168 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+#pragma once
+
+/**
+ * @headerfile <idfxx/lcd/transfer_tracker>
+ * @file transfer_tracker.hpp
+ * @brief Completion tracking for asynchronous panel transfers.
+ * @ingroup idfxx_lcd
+ */
+
+#include <idfxx/error>
+#include <idfxx/future>
+#include <idfxx/lcd/panel>
+
+#include <cstddef>
+#include <cstdint>
+#include <esp_lcd_panel_io.h>
+#include <functional>
+#include <memory>
+
+/**
+ * @headerfile <idfxx/lcd/transfer_tracker>
+ * @brief LCD driver classes.
+ */
+namespace idfxx::lcd {
+
+/**
+ * @headerfile <idfxx/lcd/transfer_tracker>
+ * @brief Turns panel I/O color-transfer completions into futures.
+ *
+ * SPI panels queue each draw_bitmap transfer and return before the pixels
+ * have been sent, so the source buffer must not be modified until the
+ * transfer completes. A transfer_tracker counts the transfers submitted
+ * through it and the completions reported by the panel I/O's
+ * `on_color_transfer_done` callback, and hands out futures that complete
+ * once every transfer submitted before them has finished.
+ *
+ * Install @ref callback() as the panel I/O's `on_color_transfer_done`, then
+ * draw through @ref panel::try_draw_bitmap_async, @ref try_draw_bitmap, or a
+ * framebuffer's `flush_async`.
+ * Each draw_bitmap produces exactly one completion, so every transfer to
+ * the panel should go through the tracker while it is installed;
+ * completions without a matching submission are ignored. Several tasks may
+ * draw through one tracker: submissions are serialized, so each transfer's
+ * number matches its place in the panel I/O's queue.
+ *
+ * @code
+ * idfxx::lcd::transfer_tracker tracker;
+ * idfxx::lcd::panel_io io(bus, {
+ *     // ...
+ *     .on_color_transfer_done = tracker.callback(),
+ * });
+ * @endcode
+ *
+ * The tracker's state is shared with its callback and futures, so either
+ * may outlive the tracker itself. This type is non-copyable and move-only.
+ * A moved-from object must not be used: any operation other than
+ * destruction or assignment is undefined behavior.
+ */
+class transfer_tracker {
+public:
+    /**
+     * @brief Callback type accepted by the panel I/O's `on_color_transfer_done`.
+     *
+     * Same as @ref panel_io::color_transfer_done_callback.
+     */
+    using callback_type = std::move_only_function<bool(esp_lcd_panel_io_event_data_t* edata)>;
+
+#ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
+    /**
+     * @brief Creates a transfer tracker with no transfers outstanding.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on error.
+     */
+    [[nodiscard]] transfer_tracker();
+#endif
+
+    /**
+     * @brief Creates a transfer tracker with no transfers outstanding.
+     *
+     * @return The new transfer_tracker, or an error.
+     */
+    [[nodiscard]] static result<transfer_tracker> make();
+
+    transfer_tracker(const transfer_tracker&) = delete;
+    transfer_tracker& operator=(const transfer_tracker&) = delete;
+    transfer_tracker(transfer_tracker&&) noexcept = default;
+    transfer_tracker& operator=(transfer_tracker&&) noexcept = default;
+
+    /**
+     * @brief Returns a callback recording transfer completions.
+     *
+     * Pass the result as `on_color_transfer_done` in the panel I/O
+     * configuration. The callback is safe to run in interrupt context.
+     *
+     * @return The completion callback.
+     */
+    [[nodiscard]] callback_type callback() const;
+
+#ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
+    /**
+     * @brief Draws bitmap data to a panel, counting the transfer.
+     *
+     * @param panel      The panel to draw to.
+     * @param x_start    Start column, inclusive.
+     * @param y_start    Start row, inclusive.
+     * @param x_end      End column, exclusive.
+     * @param y_end      End row, exclusive.
+     * @param color_data The pixel data; must stay unchanged until the transfer completes.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on error.
+     */
+    void draw_bitmap(panel& panel, int x_start, int y_start, int x_end, int y_end, const void* color_data) {
+        unwrap(try_draw_bitmap(panel, x_start, y_start, x_end, y_end, color_data));
+    }
+#endif
+
+    /**
+     * @brief Draws bitmap data to a panel, counting the transfer.
+     *
+     * @param panel      The panel to draw to.
+     * @param x_start    Start column, inclusive.
+     * @param y_start    Start row, inclusive.
+     * @param x_end      End column, exclusive.
+     * @param y_end      End row, exclusive.
+     * @param color_data The pixel data; must stay unchanged until the transfer completes.
+     *
+     * @return Success, or an error. A failed draw is not counted.
+     */
+    [[nodiscard]] result<void>
+    try_draw_bitmap(panel& panel, int x_start, int y_start, int x_end, int y_end, const void* color_data);
+
+    /**
+     * @brief Returns a future for the transfers submitted so far.
+     *
+     * The future completes once every transfer submitted through this
+     * tracker before the call has finished; later submissions do not delay
+     * it. With nothing outstanding the future is already complete.
+     *
+     * @return The completion future.
+     */
+    [[nodiscard]] future<void> fence() const;
+
+    /** @brief Returns the number of submitted transfers that have not yet completed. */
+    [[nodiscard]] size_t pending() const noexcept;
+
+private:
+    /// @cond INTERNAL
+    friend class panel;
+
+    struct state;
+    explicit transfer_tracker(std::shared_ptr<state> s) noexcept;
+
+    // Submits one counted transfer, returning its sequence number.
+    [[nodiscard]] result<uint32_t>
+    _submit(panel& panel, int x_start, int y_start, int x_end, int y_end, const void* color_data);
+    // Future completing once the transfer with the given sequence number has finished.
+    [[nodiscard]] future<void> _until(uint32_t target) const;
+    /// @endcond
+
+    std::shared_ptr<state> _state;
+};
+
+} // namespace idfxx::lcd
@@ -0,0 +1,177 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+#include <idfxx/lcd/convert>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <memory>
+
+namespace idfxx::lcd {
+
+namespace {
+
+// Packs 8-bit components into an RGB565 value, truncating as rgb565's
+// constructor does.
+constexpr uint32_t pack(uint32_t r, uint32_t g, uint32_t b) noexcept {
+    return ((r & 0xF8u) << 8) | ((g & 0xFCu) << 3) | (b >> 3);
+}
+
+constexpr uint32_t byte(uint32_t word, int n) noexcept {
+    return (word >> (8 * n)) & 0xFFu;
+}
+
+[[nodiscard]] bool word_aligned(const void* p) noexcept {
+    return (reinterpret_cast<uintptr_t>(p) & 3u) == 0;
+}
+
+// Loads one source pixel and packs it.
+template<pixel_format F>
+uint32_t load_one(const uint8_t* src) noexcept {
+    if constexpr (F == pixel_format::rgb888) {
+        return pack(src[0], src[1], src[2]);
+    } else if constexpr (F == pixel_format::bgr888) {
+        return pack(src[2], src[1], src[0]);
+    } else if constexpr (F == pixel_format::argb8888) {
+        uint32_t w;
+        std::memcpy(&w, src, 4);
+        return pack(byte(w, 2), byte(w, 1), byte(w, 0));
+    } else {
+        return pack(src[0], src[0], src[0]);
+    }
+}
+
+template<bool Big>
+void store_one(uint8_t* dst, uint32_t p) noexcept {
+    uint16_t v = static_cast<uint16_t>(p);
+    if constexpr (Big) {
+        v = std::byteswap(v);
+    }
+    std::memcpy(dst, &v, 2);
+}
+
+// Stores two packed pixels, p0 first. Only used on little-endian targets.
+template<bool Big, bool WordDst>
+void store_two(uint8_t* dst, uint32_t p0, uint32_t p1) noexcept {
+    uint32_t w = p0 | (p1 << 16);
+    if constexpr (Big) {
+        w = ((w & 0x00FF00FFu) << 8) | ((w >> 8) & 0x00FF00FFu);
+    }
+    if constexpr (WordDst) {
+        std::memcpy(std::assume_aligned<4>(dst), &w, 4);
+    } else {
+        std::memcpy(std::assume_aligned<2>(dst), &w, 2);
+        const uint16_t hi = static_cast<uint16_t>(w >> 16);
+        std::memcpy(std::assume_aligned<2>(dst + 2), &hi, 2);
+    }
+}
+
+[[nodiscard]] uint32_t load_word(const uint8_t* src) noexcept {
+    uint32_t w;
+    std::memcpy(&w, std::assume_aligned<4>(src), 4);
+    return w;
+}
+
+// Converts whole groups from a word-aligned source, advancing the pointers
+// and leaving the remainder in n. RGB888 and grey8 take four pixels from
+// three words and one word respectively; ARGB8888 takes two pixels from two
+// words.
+template<pixel_format F, bool Big, bool WordDst>
+void convert_words(const uint8_t*& src, uint8_t*& dst, size_t& n) noexcept {
+    if constexpr (F == pixel_format::rgb888 || F == pixel_format::bgr888) {
+        for (; n >= 4; n -= 4, src += 12, dst += 8) {
+            const uint32_t w0 = load_word(src);
+            const uint32_t w1 = load_word(src + 4);
+            const uint32_t w2 = load_word(src + 8);
+            // Bytes: c0 c1 c2 | c0 c1 c2 | c0 c1 c2 | c0 c1 c2 across w0 w1 w2.
+            uint32_t p[4];
+            if constexpr (F == pixel_format::rgb888) {
+                p[0] = pack(byte(w0, 0), byte(w0, 1), byte(w0, 2));
+                p[1] = pack(byte(w0, 3), byte(w1, 0), byte(w1, 1));
+                p[2] = pack(byte(w1, 2), byte(w1, 3), byte(w2, 0));
+                p[3] = pack(byte(w2, 1), byte(w2, 2), byte(w2, 3));
+            } else {
+                p[0] = pack(byte(w0, 2), byte(w0, 1), byte(w0, 0));
+                p[1] = pack(byte(w1, 1), byte(w1, 0), byte(w0, 3));
+                p[2] = pack(byte(w2, 0), byte(w1, 3), byte(w1, 2));
+                p[3] = pack(byte(w2, 3), byte(w2, 2), byte(w2, 1));
+            }
+            store_two<Big, WordDst>(dst, p[0], p[1]);
+            store_two<Big, WordDst>(dst + 4, p[2], p[3]);
+        }
+    } else if constexpr (F == pixel_format::argb8888) {
+        for (; n >= 2; n -= 2, src += 8, dst += 4) {
+            const uint32_t w0 = load_word(src);
+            const uint32_t w1 = load_word(src + 4);
+            store_two<Big, WordDst>(
+                dst, pack(byte(w0, 2), byte(w0, 1), byte(w0, 0)), pack(byte(w1, 2), byte(w1, 1), byte(w1, 0))
+            );
+        }
+    } else {
+        for (; n >= 4; n -= 4, src += 4, dst += 8) {
+            const uint32_t w = load_word(src);
+            const uint32_t g0 = byte(w, 0), g1 = byte(w, 1), g2 = byte(w, 2), g3 = byte(w, 3);
+            store_two<Big, WordDst>(dst, pack(g0, g0, g0), pack(g1, g1, g1));
+            store_two<Big, WordDst>(dst + 4, pack(g2, g2, g2), pack(g3, g3, g3));
+        }
+    }
+}
+
+template<pixel_format F, bool Big>
+void convert(const uint8_t* src, uint8_t* dst, size_t n) noexcept {
+    constexpr size_t bpp = bytes_per_pixel(F);
+    if constexpr (std::endian::native == std::endian::little) {
+        // Single pixels until the source is word aligned (never, for a
+        // misaligned ARGB8888 source, which is then converted pixel by pixel).
+        for (; n > 0 && !word_aligned(src); --n, src += bpp, dst += 2) {
+            store_one<Big>(dst, load_one<F>(src));
+        }
+        if (word_aligned(dst)) {
+            convert_words<F, Big, true>(src, dst, n);
+        } else {
+            convert_words<F, Big, false>(src, dst, n);
+        }
+    }
+    for (; n > 0; --n, src += bpp, dst += 2) {
+        store_one<Big>(dst, load_one<F>(src));
+    }
+}
+
+template<pixel_format F>
+void convert(const uint8_t* src, uint8_t* dst, size_t n, rgb_data_endian endian) noexcept {
+    if (endian == rgb_data_endian::big) {
+        convert<F, true>(src, dst, n);
+    } else {
+        convert<F, false>(src, dst, n);
+    }
+}
+
+} // namespace
+
+size_t convert_to_rgb565(
+    pixel_format format,
+    std::span<const uint8_t> src,
+    std::span<rgb565> dst,
+    rgb_data_endian endian
+) noexcept {
+    const size_t n = std::min(src.size() / bytes_per_pixel(format), dst.size());
+    auto* out = reinterpret_cast<uint8_t*>(dst.data());
+    switch (format) {
+    case pixel_format::rgb888:
+        convert<pixel_format::rgb888>(src.data(), out, n, endian);
+        break;
+    case pixel_format::bgr888:
+        convert<pixel_format::bgr888>(src.data(), out, n, endian);
+        break;
+    case pixel_format::argb8888:
+        convert<pixel_format::argb8888>(src.data(), out, n, endian);
+        break;
+    case pixel_format::grey8:
+        convert<pixel_format::grey8>(src.data(), out, n, endian);
+        break;
+    }
+    return n;
+}
+
+} // namespace idfxx::lcd
@@ -2,11 +2,25 @@
 // Copyright 2026 Chris Leishman
 
 #include <idfxx/lcd/panel>
+#include <idfxx/lcd/transfer_tracker>
 
 #include <esp_lcd_panel_ops.h>
 
 namespace idfxx::lcd {
 
+result<future<void>> panel::try_draw_bitmap_async(
+    transfer_tracker& tracker,
+    int x_start,
+    int y_start,
+    int x_end,
+    int y_end,
+    const void* color_data
+) {
+    return tracker._submit(*this, x_start, y_start, x_end, y_end, color_data).transform([&](uint32_t seq) {
+        return tracker._until(seq);
+    });
+}
+
 result<void> panel::do_draw_bitmap(int x_start, int y_start, int x_end, int y_end, const void* color_data) {
     auto handle = do_idf_handle();
     if (handle == nullptr) {
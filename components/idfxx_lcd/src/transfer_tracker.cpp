@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+#include <idfxx/chrono>
+#include <idfxx/lcd/transfer_tracker>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace idfxx::lcd {
+
+struct transfer_tracker::state {
+    // Given on every counted completion. Waiters re-check the counters after
+    // each take, so a stale token only costs an extra loop.
+    SemaphoreHandle_t done = nullptr;
+    std::atomic<uint32_t> submitted{0};
+    std::atomic<uint32_t> completed{0};
+    // Serializes waiters: each give wakes only one task.
+    std::timed_mutex wait_mtx;
+    // Serializes submitters, so sequence numbers follow the order in which
+    // transfers reach the panel I/O and a rollback only ever undoes the
+    // newest count.
+    std::mutex submit_mtx;
+
+    ~state() {
+        if (done != nullptr) {
+            vSemaphoreDelete(done);
+        }
+    }
+
+    // Wrap-safe comparison of the free-running completion counter.
+    [[nodiscard]] bool reached(uint32_t target) const noexcept {
+        return static_cast<int32_t>(completed.load(std::memory_order_acquire) - target) >= 0;
+    }
+
+    bool complete() noexcept {
+        // Completions are reported one at a time by the panel I/O driver, so
+        // there is only ever a single writer of the completed counter.
+        uint32_t c = completed.load(std::memory_order_relaxed);
+        if (c == submitted.load(std::memory_order_acquire)) {
+            return false; // a transfer the tracker did not submit
+        }
+        completed.store(c + 1, std::memory_order_release);
+        if (!xPortInIsrContext()) {
+            // I2C panel I/O reports completions from the submitting task.
+            xSemaphoreGive(done);
+            return false;
+        }
+        BaseType_t woken = pdFALSE;
+        xSemaphoreGiveFromISR(done, &woken);
+        return woken == pdTRUE;
+    }
+
+    result<void> wait(uint32_t target, std::optional<std::chrono::milliseconds> timeout) {
+        if (reached(target)) {
+            return {};
+        }
+        using clock = std::chrono::steady_clock;
+        std::optional<clock::time_point> deadline = timeout.transform([](auto t) { return clock::now() + t; });
+
+        std::unique_lock lk(wait_mtx, std::defer_lock);
+        if (!deadline) {
+            lk.lock();
+        } else if (!lk.try_lock_until(*deadline)) {
+            return reached(target) ? result<void>{} : error(errc::timeout);
+        }
+
+        while (!reached(target)) {
+            TickType_t ticks = portMAX_DELAY;
+            if (deadline) {
+                auto now = clock::now();
+                if (now >= *deadline) {
+                    return error(errc::timeout);
+                }
+                ticks = idfxx::chrono::ticks(*deadline - now);
+            }
+            if (xSemaphoreTake(done, ticks) != pdTRUE && !reached(target)) {
+                return error(errc::timeout);
+            }
+        }
+        return {};
+    }
+};
+
+#ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
+transfer_tracker::transfer_tracker()
+    : transfer_tracker(unwrap(make())) {}
+#endif
+
+transfer_tracker::transfer_tracker(std::shared_ptr<state> s) noexcept
+    : _state(std::move(s)) {}
+
+result<transfer_tracker> transfer_tracker::make() {
+    auto s = std::make_shared<state>();
+    s->done = xSemaphoreCreateBinary();
+    if (s->done == nullptr) {
+        raise_no_mem();
+    }
+    return transfer_tracker{std::move(s)};
+}
+
+transfer_tracker::callback_type transfer_tracker::callback() const {
+    return [s = _state](esp_lcd_panel_io_event_data_t*) { return s->complete(); };
+}
+
+result<uint32_t> transfer_tracker::_submit(
+    panel& panel,
+    int x_start,
+    int y_start,
+    int x_end,
+    int y_end,
+    const void* color_data
+) {
+    std::scoped_lock lock(_state->submit_mtx);
+    // Count the transfer before submitting it: the completion may be
+    // reported before try_draw_bitmap returns.
+    uint32_t seq = _state->submitted.load(std::memory_order_relaxed) + 1;
+    _state->submitted.store(seq, std::memory_order_release);
+    auto drawn = panel.try_draw_bitmap(x_start, y_start, x_end, y_end, color_data);
+    if (!drawn) {
+        _state->submitted.store(seq - 1, std::memory_order_release);
+        return error(drawn.error());
+    }
+    return seq;
+}
+
+future<void> transfer_tracker::_until(uint32_t target) const {
+    return future<void>{
+        [s = _state, target](std::optional<std::chrono::milliseconds> timeout) { return s->wait(target, timeout); },
+        [s = _state, target]() noexcept { return s->reached(target); },
+    };
+}
+
+result<void> transfer_tracker::try_draw_bitmap(
+    panel& panel,
+    int x_start,
+    int y_start,
+    int x_end,
+    int y_end,
+    const void* color_data
+) {
+    return _submit(panel, x_start, y_start, x_end, y_end, color_data).transform([](uint32_t) {});
+}
+
+future<void> transfer_tracker::fence() const {
+    return _until(_state->submitted.load(std::memory_order_acquire));
+}
+
+size_t transfer_tracker::pending() const noexcept {
+    return _state->submitted.load(std::memory_order_acquire) - _state->completed.load(std::memory_order_acquire);
+}
+
+} // namespace idfxx::lcd
@@ -0,0 +1,236 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+// Unit tests for idfxx::lcd::rgb332, idfxx::lcd::grey4, and idfxx::lcd::compact_framebuffer
+// Uses ESP-IDF Unity test framework with compile-time static_asserts
+
+#include "idfxx/lcd/compact_framebuffer"
+#include "recording_panel.hpp"
+#include "unity.h"
+
+#include <array>
+#include <cstring>
+#include <esp_memory_utils.h>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace idfxx::lcd;
+using idfxx_lcd_test::recording_panel;
+
+// =============================================================================
+// Compile-time tests (static_assert)
+// These verify correctness at compile time - if this file compiles, they pass.
+// =============================================================================
+
+// Component packing truncates to the 3-3-2 layout.
+static_assert(rgb332{}.value() == 0x00);
+static_assert(rgb332(255, 255, 255).value() == 0xFF);
+static_assert(rgb332(255, 0, 0).value() == 0xE0);
+static_assert(rgb332(0, 255, 0).value() == 0x1C);
+static_assert(rgb332(0, 0, 255).value() == 0x03);
+static_assert(rgb332::from_value(0x5A).value() == 0x5A);
+
+// Expansion keeps black black and full intensity full.
+static_assert(rgb332{}.to_rgb565() == rgb565{});
+static_assert(rgb332(255, 255, 255).to_rgb565() == rgb565(255, 255, 255));
+static_assert(rgb332(255, 0, 0).to_rgb565() == rgb565(255, 0, 0));
+static_assert(rgb332(0, 255, 0).to_rgb565() == rgb565(0, 255, 0));
+static_assert(rgb332(0, 0, 255).to_rgb565() == rgb565(0, 0, 255));
+
+static_assert(grey4(15).to_rgb565() == rgb565(255, 255, 255));
+static_assert(grey4(0).to_rgb565() == rgb565{});
+static_assert(grey4(0x1F).level() == 0x0F);
+
+// Compact framebuffers are regular value types, usable as gfx surfaces.
+static_assert(std::is_copy_constructible_v<rgb332_framebuffer>);
+static_assert(std::is_move_assignable_v<grey4_framebuffer>);
+static_assert(std::is_same_v<palette_framebuffer::pixel_type, uint8_t>);
+
+// =============================================================================
+// Runtime tests (Unity TEST_CASE)
+// =============================================================================
+
+namespace {
+
+// Panel that reports each transfer complete as soon as it is submitted (as
+// I2C panel I/O does) and keeps a copy of the pixels, since the bounce
+// buffer is reused once a transfer completes.
+class converting_panel : public idfxx::lcd::panel {
+public:
+    explicit converting_panel(transfer_tracker& tracker, size_t width, size_t height)
+        : complete(tracker.callback())
+        , width(width)
+        , frame(width * height) {}
+
+    transfer_tracker::callback_type complete;
+    size_t width;
+    std::vector<rgb565> frame;
+    std::vector<const void*> sources;
+
+private:
+    [[nodiscard]] esp_lcd_panel_handle_t do_idf_handle() const override { return nullptr; }
+
+    [[nodiscard]] idfxx::result<void>
+    do_draw_bitmap(int x_start, int y_start, int x_end, int y_end, const void* color_data) override {
+        const auto* pixels = static_cast<const rgb565*>(color_data);
+        for (int y = y_start; y < y_end; ++y) {
+            for (int x = x_start; x < x_end; ++x) {
+                frame[y * width + x] = *pixels++;
+            }
+        }
+        sources.push_back(color_data);
+        (void)complete(nullptr);
+        return {};
+    }
+};
+
+} // namespace
+
+TEST_CASE("compact_framebuffer::make rejects invalid dimensions", "[idfxx][lcd]") {
+    auto zero_width = rgb332_framebuffer::make(0, 240);
+    TEST_ASSERT_FALSE(zero_width.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(idfxx::errc::invalid_arg), zero_width.error().value());
+
+    auto zero_height = grey4_framebuffer::make(320, 0);
+    TEST_ASSERT_FALSE(zero_height.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(idfxx::errc::invalid_arg), zero_height.error().value());
+}
+
+TEST_CASE("compact_framebuffer stores 8 or 4 bits per pixel", "[idfxx][lcd]") {
+    auto rgb = rgb332_framebuffer::make(320, 240);
+    TEST_ASSERT_TRUE(rgb.has_value());
+    TEST_ASSERT_EQUAL(320 * 240, rgb->data().size());
+
+    auto grey = grey4_framebuffer::make(7, 3);
+    TEST_ASSERT_TRUE(grey.has_value());
+    TEST_ASSERT_EQUAL(4 * 3, grey->data().size()); // rows start on a byte boundary
+
+    grey->set_pixel(0, 1, grey4(0xA));
+    grey->set_pixel(1, 1, grey4(0x5));
+    grey->set_pixel(6, 1, grey4(0xF));
+    TEST_ASSERT_EQUAL_HEX8(0xA5, grey->data()[4]);
+    TEST_ASSERT_EQUAL_HEX8(0xF0, grey->data()[7]);
+    TEST_ASSERT_TRUE(grey->get_pixel(1, 1) == grey4(0x5));
+    TEST_ASSERT_TRUE(grey->get_pixel(7, 1) == grey4{}); // out of range
+}
+
+TEST_CASE("compact_framebuffer fill_block matches per-pixel writes", "[idfxx][lcd]") {
+    auto bulk = grey4_framebuffer::make(9, 5);
+    auto pixels = grey4_framebuffer::make(9, 5);
+    TEST_ASSERT_TRUE(bulk.has_value() && pixels.has_value());
+    bulk->fill(grey4(3));
+    pixels->fill(grey4(3));
+
+    // Odd and even edges, single columns, and clipping.
+    const std::array<std::array<size_t, 4>, 5> rects{{{1, 0, 4, 2}, {2, 1, 5, 3}, {3, 2, 1, 3}, {6, 4, 10, 10}, {0, 3, 9, 1}}};
+    for (size_t i = 0; i < rects.size(); ++i) {
+        const auto [x, y, w, h] = rects[i];
+        const grey4 level(static_cast<uint8_t>(8 + i));
+        bulk->fill_block(x, y, w, h, level);
+        for (size_t py = y; py < y + h; ++py) {
+            for (size_t px = x; px < x + w; ++px) {
+                pixels->set_pixel(px, py, level);
+            }
+        }
+    }
+    TEST_ASSERT_EQUAL_MEMORY(pixels->data().data(), bulk->data().data(), bulk->data().size());
+}
+
+TEST_CASE("compact_framebuffer blit copies and clips", "[idfxx][lcd]") {
+    auto fb = rgb332_framebuffer::make(4, 3);
+    TEST_ASSERT_TRUE(fb.has_value());
+    const std::array<rgb332, 6> src{
+        rgb332::from_value(1),
+        rgb332::from_value(2),
+        rgb332::from_value(3),
+        rgb332::from_value(4),
+        rgb332::from_value(5),
+        rgb332::from_value(6),
+    };
+    fb->blit(2, 1, 3, 2, src.data(), 3);
+    TEST_ASSERT_TRUE(fb->get_pixel(2, 1) == rgb332::from_value(1));
+    TEST_ASSERT_TRUE(fb->get_pixel(3, 1) == rgb332::from_value(2));
+    TEST_ASSERT_TRUE(fb->get_pixel(2, 2) == rgb332::from_value(4));
+    TEST_ASSERT_TRUE(fb->get_pixel(3, 2) == rgb332::from_value(5));
+    TEST_ASSERT_TRUE(fb->get_pixel(1, 1) == rgb332{});
+}
+
+TEST_CASE("compact_framebuffer flush expands every pixel to RGB565", "[idfxx][lcd]") {
+    auto tracker = transfer_tracker::make();
+    TEST_ASSERT_TRUE(tracker.has_value());
+
+    // An odd width exercises the trailing nibble of 4-bit rows, and a height
+    // that is not a multiple of bounce_rows a short final transfer.
+    constexpr size_t width = 5;
+    constexpr size_t height = 2 * grey4_framebuffer::bounce_rows + 1;
+    auto fb = grey4_framebuffer::make(width, height);
+    TEST_ASSERT_TRUE(fb.has_value());
+    for (size_t y = 0; y < height; ++y) {
+        for (size_t x = 0; x < width; ++x) {
+            fb->set_pixel(x, y, grey4(static_cast<uint8_t>(x + y)));
+        }
+    }
+
+    converting_panel panel(*tracker, width, height);
+    TEST_ASSERT_TRUE(fb->try_flush(panel, *tracker).has_value());
+    TEST_ASSERT_EQUAL(3, panel.sources.size());
+    for (size_t y = 0; y < height; ++y) {
+        for (size_t x = 0; x < width; ++x) {
+            TEST_ASSERT_TRUE(panel.frame[y * width + x] == grey4(static_cast<uint8_t>(x + y)).to_rgb565());
+        }
+    }
+
+    // Successive transfers alternate between the two DMA-capable halves of
+    // the bounce buffer, never the framebuffer itself.
+    TEST_ASSERT_TRUE(panel.sources[0] != panel.sources[1]);
+    TEST_ASSERT_EQUAL_PTR(panel.sources[0], panel.sources[2]);
+    TEST_ASSERT_TRUE(esp_ptr_dma_capable(panel.sources[0]));
+    TEST_ASSERT_EQUAL(0, tracker->pending());
+}
+
+TEST_CASE("compact_framebuffer flush_rows draws only the band", "[idfxx][lcd]") {
+    auto tracker = transfer_tracker::make();
+    TEST_ASSERT_TRUE(tracker.has_value());
+    auto fb = rgb332_framebuffer::make(4, 8);
+    TEST_ASSERT_TRUE(fb.has_value());
+
+    recording_panel recorder;
+    auto invalid = fb->try_flush_rows(recorder, *tracker, 5, 9);
+    TEST_ASSERT_FALSE(invalid.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(idfxx::errc::invalid_arg), invalid.error().value());
+
+    fb->fill(rgb332(255, 0, 0));
+    converting_panel panel(*tracker, 4, 8);
+    TEST_ASSERT_TRUE(fb->try_flush_rows(panel, *tracker, 2, 5).has_value());
+    TEST_ASSERT_TRUE(panel.frame[1 * 4] == rgb565{});
+    TEST_ASSERT_TRUE(panel.frame[2 * 4] == rgb565(255, 0, 0));
+    TEST_ASSERT_TRUE(panel.frame[4 * 4 + 3] == rgb565(255, 0, 0));
+    TEST_ASSERT_TRUE(panel.frame[5 * 4] == rgb565{});
+}
+
+TEST_CASE("palette_framebuffer maps indices through its palette", "[idfxx][lcd]") {
+    auto tracker = transfer_tracker::make();
+    TEST_ASSERT_TRUE(tracker.has_value());
+    auto fb = palette_framebuffer::make(3, 1);
+    TEST_ASSERT_TRUE(fb.has_value());
+    TEST_ASSERT_TRUE(fb->palette()[200] == rgb565{}); // starts out all black
+
+    const std::array<rgb565, 2> colors{rgb565(255, 0, 0), rgb565(0, 0, 255)};
+    fb->set_palette(colors, 7);
+    fb->set_palette(colors, 255); // only the first fits
+    fb->set_pixel(0, 0, 7);
+    fb->set_pixel(1, 0, 8);
+    fb->set_pixel(2, 0, 255);
+
+    converting_panel panel(*tracker, 3, 1);
+    TEST_ASSERT_TRUE(fb->try_flush(panel, *tracker).has_value());
+    TEST_ASSERT_TRUE(panel.frame[0] == rgb565(255, 0, 0));
+    TEST_ASSERT_TRUE(panel.frame[1] == rgb565(0, 0, 255));
+    TEST_ASSERT_TRUE(panel.frame[2] == rgb565(255, 0, 0));
+
+    // Changing the palette recolors without touching the pixels.
+    fb->set_palette(std::array{rgb565(0, 255, 0)}, 8);
+    TEST_ASSERT_TRUE(fb->try_flush(panel, *tracker).has_value());
+    TEST_ASSERT_TRUE(panel.frame[1] == rgb565(0, 255, 0));
+}
@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+// Unit tests for idfxx::lcd::convert_to_rgb565
+// Uses ESP-IDF Unity test framework with compile-time static_asserts
+
+#include "idfxx/lcd/convert"
+#include "unity.h"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+using namespace idfxx::lcd;
+
+// =============================================================================
+// Compile-time tests (static_assert)
+// These verify correctness at compile time - if this file compiles, they pass.
+// =============================================================================
+
+static_assert(bytes_per_pixel(pixel_format::rgb888) == 3);
+static_assert(bytes_per_pixel(pixel_format::bgr888) == 3);
+static_assert(bytes_per_pixel(pixel_format::argb8888) == 4);
+static_assert(bytes_per_pixel(pixel_format::grey8) == 1);
+
+// =============================================================================
+// Runtime tests (Unity TEST_CASE)
+// =============================================================================
+
+namespace {
+
+// Deterministic, non-repeating source bytes.
+std::array<uint8_t, 64> source_bytes() {
+    std::array<uint8_t, 64> bytes{};
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+    return bytes;
+}
+
+// The per-pixel reference the word kernels must match.
+rgb565 reference(pixel_format format, const uint8_t* p) {
+    switch (format) {
+    case pixel_format::rgb888:
+        return rgb565(p[0], p[1], p[2]);
+    case pixel_format::bgr888:
+        return rgb565(p[2], p[1], p[0]);
+    case pixel_format::argb8888: {
+        uint32_t w;
+        std::memcpy(&w, p, 4);
+        return rgb565((w >> 16) & 0xFF, (w >> 8) & 0xFF, w & 0xFF);
+    }
+    case pixel_format::grey8:
+        return rgb565(p[0], p[0], p[0]);
+    }
+    return {};
+}
+
+// Converts every length from 0 to 9 at every source and destination
+// alignment, checking each pixel and that nothing past the run is written.
+void check_against_reference(pixel_format format) {
+    const auto bytes = source_bytes();
+    const size_t bpp = bytes_per_pixel(format);
+    for (size_t src_offset = 0; src_offset < 4; ++src_offset) {
+        for (size_t dst_offset = 0; dst_offset < 2; ++dst_offset) {
+            for (size_t n = 0; n <= 9; ++n) {
+                alignas(4) std::array<rgb565, 12> out;
+                out.fill(rgb565::from_value(0xDEAD));
+                const std::span<const uint8_t> src(bytes.data() + src_offset, n * bpp);
+                const size_t converted = convert_to_rgb565(format, src, std::span(out).subspan(dst_offset, n));
+                TEST_ASSERT_EQUAL(n, converted);
+                for (size_t i = 0; i < out.size(); ++i) {
+                    const bool inside = i >= dst_offset && i < dst_offset + n;
+                    const uint16_t expected =
+                        inside ? reference(format, src.data() + (i - dst_offset) * bpp).value() : 0xDEAD;
+                    TEST_ASSERT_EQUAL_HEX16(expected, out[i].value());
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("convert_to_rgb565 matches rgb565 for RGB888 at any alignment", "[idfxx][lcd]") {
+    check_against_reference(pixel_format::rgb888);
+}
+
+TEST_CASE("convert_to_rgb565 matches rgb565 for BGR888 at any alignment", "[idfxx][lcd]") {
+    check_against_reference(pixel_format::bgr888);
+}
+
+TEST_CASE("convert_to_rgb565 matches rgb565 for ARGB8888 at any alignment", "[idfxx][lcd]") {
+    check_against_reference(pixel_format::argb8888);
+}
+
+TEST_CASE("convert_to_rgb565 matches rgb565 for grey8 at any alignment", "[idfxx][lcd]") {
+    check_against_reference(pixel_format::grey8);
+}
+
+TEST_CASE("convert_to_rgb565 ignores ARGB8888 alpha", "[idfxx][lcd]") {
+    const std::array<uint32_t, 2> words{0x00FF8000, 0xFFFF8000};
+    alignas(4) std::array<uint8_t, 8> src;
+    std::memcpy(src.data(), words.data(), src.size());
+    std::array<rgb565, 2> out;
+    convert_to_rgb565(pixel_format::argb8888, src, out);
+    TEST_ASSERT_EQUAL_HEX16(rgb565(255, 128, 0).value(), out[0].value());
+    TEST_ASSERT_EQUAL_HEX16(rgb565(255, 128, 0).value(), out[1].value());
+}
+
+TEST_CASE("convert_to_rgb565 writes little-endian output on request", "[idfxx][lcd]") {
+    const auto bytes = source_bytes();
+    alignas(4) std::array<rgb565, 7> big;
+    alignas(4) std::array<rgb565, 7> little;
+    convert_to_rgb565(pixel_format::rgb888, bytes, big);
+    convert_to_rgb565(pixel_format::rgb888, bytes, little, rgb_data_endian::little);
+    for (size_t i = 0; i < big.size(); ++i) {
+        TEST_ASSERT_EQUAL_HEX16(std::byteswap(big[i].value()), little[i].value());
+    }
+}
+
+TEST_CASE("convert_to_rgb565 stops at the shorter of source and destination", "[idfxx][lcd]") {
+    const auto bytes = source_bytes();
+    std::array<rgb565, 4> out;
+    out.fill(rgb565::from_value(0xBEEF));
+
+    // Seven bytes hold two whole RGB888 pixels.
+    TEST_ASSERT_EQUAL(2, convert_to_rgb565(pixel_format::rgb888, std::span(bytes).first(7), out));
+    TEST_ASSERT_EQUAL_HEX16(0xBEEF, out[2].value());
+
+    // Sixty-four grey pixels into four.
+    TEST_ASSERT_EQUAL(4, convert_to_rgb565(pixel_format::grey8, bytes, out));
+    TEST_ASSERT_EQUAL_HEX16(rgb565(bytes[3], bytes[3], bytes[3]).value(), out[3].value());
+}
@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+// Unit tests for idfxx::lcd::rect and idfxx::lcd::damage_set
+// Uses ESP-IDF Unity test framework with compile-time static_asserts
+
+#include "idfxx/lcd/damage"
+#include "unity.h"
+
+#include <type_traits>
+
+using namespace idfxx::lcd;
+
+// =============================================================================
+// Compile-time tests (static_assert)
+// These verify correctness at compile time - if this file compiles, they pass.
+// =============================================================================
+
+// rect geometry
+static_assert(rect{}.empty());
+static_assert(rect{2, 3, 2, 9}.empty());
+static_assert(rect{2, 3, 6, 9}.area() == 24);
+static_assert(rect{0, 0, 10, 10}.contains(rect{2, 2, 4, 4}));
+static_assert(!rect{0, 0, 10, 10}.contains(rect{8, 8, 12, 12}));
+static_assert(rect{0, 0, 2, 2}.bounds(rect{5, 1, 6, 8}) == rect{0, 0, 6, 8});
+
+// damage_set is a trivially copyable value, cheap enough to embed in a framebuffer.
+static_assert(std::is_trivially_copyable_v<damage_set>);
+
+// Adjacent pixels grow one rectangle.
+static_assert([] {
+    damage_set d;
+    for (size_t x = 0; x < 10; ++x) {
+        d.add({x, 4, x + 1, 5});
+    }
+    return d.size() == 1 && d.regions()[0] == rect{0, 4, 10, 5};
+}());
+
+// Covered and empty rectangles are dropped.
+static_assert([] {
+    damage_set d;
+    d.add({0, 0, 8, 8});
+    d.add({2, 2, 3, 3});
+    d.add({5, 5, 5, 9});
+    return d.size() == 1 && d.regions()[0] == rect{0, 0, 8, 8};
+}());
+
+// Distant rectangles stay separate.
+static_assert([] {
+    damage_set d;
+    d.add({0, 0, 10, 10});
+    d.add({200, 200, 210, 210});
+    return d.size() == 2;
+}());
+
+// A rectangle bridging two others merges all three.
+static_assert([] {
+    damage_set d;
+    d.add({0, 0, 10, 10});
+    d.add({20, 0, 30, 10});
+    d.add({5, 0, 25, 10});
+    return d.size() == 1 && d.regions()[0] == rect{0, 0, 30, 10};
+}());
+
+// =============================================================================
+// Runtime tests (Unity TEST_CASE)
+// =============================================================================
+
+TEST_CASE("damage_set stays within capacity", "[idfxx][lcd]") {
+    damage_set d;
+
+    // Widely separated pixels along a diagonal never merge on their own.
+    for (size_t i = 0; i < 4 * damage_set::capacity; ++i) {
+        size_t p = i * 50;
+        d.add({p, p, p + 1, p + 1});
+        TEST_ASSERT_TRUE(d.size() <= damage_set::capacity);
+    }
+
+    // Every pixel is still covered by some rectangle.
+    for (size_t i = 0; i < 4 * damage_set::capacity; ++i) {
+        size_t p = i * 50;
+        bool covered = false;
+        for (const rect& r : d.regions()) {
+            covered = covered || r.contains({p, p, p + 1, p + 1});
+        }
+        TEST_ASSERT_TRUE(covered);
+    }
+
+    d.clear();
+    TEST_ASSERT_TRUE(d.empty());
+    TEST_ASSERT_EQUAL(0, d.regions().size());
+}
@@ -8,6 +8,7 @@
 #include "recording_panel.hpp"
 #include "unity.h"
 
+#include <array>
 #include <type_traits>
 #include <utility>
 
@@ -209,3 +210,79 @@ TEST_CASE("panel reports native dimensions", "[idfxx][lcd]") {
     TEST_ASSERT_EQUAL(0, display.width());
     TEST_ASSERT_EQUAL(0, display.height());
 }
+
+TEST_CASE("mono_framebuffer flush_dirty sends page-aligned rectangles", "[idfxx][lcd]") {
+    constexpr size_t width = 128;
+    auto fb = mono_framebuffer::make(width, 64);
+    TEST_ASSERT_TRUE(fb.has_value());
+
+    recording_panel display;
+
+    // A new framebuffer is entirely dirty and flushes in place.
+    TEST_ASSERT_TRUE(fb->try_flush_dirty(display).has_value());
+    TEST_ASSERT_EQUAL(1, display.draws.size());
+    TEST_ASSERT_EQUAL_PTR(fb->data().data(), display.draws[0].data);
+    TEST_ASSERT_EQUAL(0, fb->dirty_regions().size());
+
+    // A vertical line spanning pages 1-2 is rounded out to whole pages.
+    for (size_t y = 10; y < 20; ++y) {
+        fb->set_pixel(5, y, true);
+        fb->set_pixel(6, y, true);
+    }
+    TEST_ASSERT_EQUAL(1, fb->dirty_regions().size());
+    TEST_ASSERT_TRUE(fb->dirty_regions()[0] == (rect{5, 8, 7, 24}));
+
+    // Multi-page narrow rectangles are staged: one draw, pages back to back.
+    display.draws.clear();
+    TEST_ASSERT_TRUE(fb->try_flush_dirty(display).has_value());
+    TEST_ASSERT_EQUAL(1, display.draws.size());
+    TEST_ASSERT_EQUAL(5, display.draws[0].x_start);
+    TEST_ASSERT_EQUAL(8, display.draws[0].y_start);
+    TEST_ASSERT_EQUAL(7, display.draws[0].x_end);
+    TEST_ASSERT_EQUAL(24, display.draws[0].y_end);
+    auto* bytes = static_cast<const uint8_t*>(display.draws[0].data);
+    TEST_ASSERT_EQUAL_HEX8(fb->data()[1 * width + 5], bytes[0]);
+    TEST_ASSERT_EQUAL_HEX8(fb->data()[1 * width + 6], bytes[1]);
+    TEST_ASSERT_EQUAL_HEX8(fb->data()[2 * width + 5], bytes[2]);
+    TEST_ASSERT_EQUAL_HEX8(fb->data()[2 * width + 6], bytes[3]);
+
+    // Single-page rectangles transfer in place.
+    fb->set_pixel(40, 33, true);
+    display.draws.clear();
+    TEST_ASSERT_TRUE(fb->try_flush_dirty(display).has_value());
+    TEST_ASSERT_EQUAL(1, display.draws.size());
+    TEST_ASSERT_EQUAL(32, display.draws[0].y_start);
+    TEST_ASSERT_EQUAL(40, display.draws[0].y_end);
+    TEST_ASSERT_EQUAL_PTR(fb->data().data() + 4 * width + 40, display.draws[0].data);
+}
+
+TEST_CASE("mono_framebuffer fill_block masks partial pages", "[idfxx][lcd]") {
+    auto fb = mono_framebuffer::make(16, 32);
+    TEST_ASSERT_TRUE(fb.has_value());
+    fb->mark_clean();
+
+    // Rows [5, 19): the tail of page 0, all of page 1, the head of page 2.
+    fb->fill_block(2, 5, 3, 14, true);
+    for (size_t y = 0; y < 32; ++y) {
+        for (size_t x = 0; x < 16; ++x) {
+            TEST_ASSERT_EQUAL(x >= 2 && x < 5 && y >= 5 && y < 19, fb->get_pixel(x, y));
+        }
+    }
+    TEST_ASSERT_EQUAL_HEX8(0xE0, fb->data()[2]);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, fb->data()[16 + 2]);
+    TEST_ASSERT_EQUAL_HEX8(0x07, fb->data()[32 + 2]);
+    TEST_ASSERT_EQUAL(1, fb->dirty_regions().size());
+    TEST_ASSERT_TRUE(fb->dirty_regions()[0] == (rect{2, 0, 5, 24}));
+
+    // Clearing inside a page leaves its other rows alone.
+    fb->fill_span(2, 16, 3, false);
+    TEST_ASSERT_FALSE(fb->get_pixel(2, 16));
+    TEST_ASSERT_TRUE(fb->get_pixel(2, 17));
+
+    const std::array<bool, 4> image{true, false, false, true};
+    fb->blit(14, 30, 2, 2, image.data(), 2);
+    TEST_ASSERT_TRUE(fb->get_pixel(14, 30));
+    TEST_ASSERT_FALSE(fb->get_pixel(15, 30));
+    TEST_ASSERT_FALSE(fb->get_pixel(14, 31));
+    TEST_ASSERT_TRUE(fb->get_pixel(15, 31));
+}
@@ -10,6 +10,7 @@
 
 #include <array>
 #include <bit>
+#include <esp_memory_utils.h>
 #include <type_traits>
 #include <utility>
 
@@ -77,6 +78,22 @@ TEST_CASE("rgb565_framebuffer::make creates a black framebuffer", "[idfxx][lcd]"
     }
 }
 
+TEST_CASE("rgb565_framebuffer storage is DMA-capable by default", "[idfxx][lcd]") {
+    auto fb = rgb565_framebuffer::make(8, 4);
+    TEST_ASSERT_TRUE(fb.has_value());
+    TEST_ASSERT_TRUE(esp_ptr_dma_capable(fb->data().data()));
+
+    auto dram = rgb565_framebuffer::make(8, 4, idfxx::memory::capabilities::dram);
+    TEST_ASSERT_TRUE(dram.has_value());
+    dram->set_pixel(7, 3, rgb565(255, 0, 0));
+
+    // Copies keep both the pixels and the placement.
+    auto copy = *fb;
+    TEST_ASSERT_TRUE(esp_ptr_dma_capable(copy.data().data()));
+    copy = *dram;
+    TEST_ASSERT_TRUE(copy.get_pixel(7, 3) == rgb565(255, 0, 0));
+}
+
 TEST_CASE("rgb565_framebuffer set_pixel uses row-major layout", "[idfxx][lcd]") {
     constexpr size_t width = 32;
     auto fb = rgb565_framebuffer::make(width, 16);
@@ -231,3 +248,172 @@ TEST_CASE("rgb565_framebuffer flush_region sends one transfer per row", "[idfxx]
     TEST_ASSERT_FALSE(overflow.has_value());
     TEST_ASSERT_EQUAL(std::to_underlying(idfxx::errc::invalid_arg), overflow.error().value());
 }
+
+TEST_CASE("rgb565_framebuffer tracks damage", "[idfxx][lcd]") {
+    auto fb = rgb565_framebuffer::make(64, 48);
+    TEST_ASSERT_TRUE(fb.has_value());
+
+    // A new framebuffer is entirely dirty.
+    TEST_ASSERT_EQUAL(1, fb->dirty_regions().size());
+    TEST_ASSERT_TRUE(fb->dirty_regions()[0] == (rect{0, 0, 64, 48}));
+
+    fb->mark_clean();
+    TEST_ASSERT_EQUAL(0, fb->dirty_regions().size());
+
+    constexpr rgb565 red(255, 0, 0);
+    for (size_t x = 4; x < 12; ++x) {
+        fb->set_pixel(x, 7, red);
+    }
+    fb->set_pixel(100, 7, red); // out of range: no damage
+    TEST_ASSERT_EQUAL(1, fb->dirty_regions().size());
+    TEST_ASSERT_TRUE(fb->dirty_regions()[0] == (rect{4, 7, 12, 8}));
+
+    // mark_dirty clips to the framebuffer.
+    fb->mark_clean();
+    fb->mark_dirty({60, 40, 100, 100});
+    TEST_ASSERT_EQUAL(1, fb->dirty_regions().size());
+    TEST_ASSERT_TRUE(fb->dirty_regions()[0] == (rect{60, 40, 64, 48}));
+
+    fb->fill(red);
+    TEST_ASSERT_EQUAL(1, fb->dirty_regions().size());
+    TEST_ASSERT_TRUE(fb->dirty_regions()[0] == (rect{0, 0, 64, 48}));
+}
+
+TEST_CASE("rgb565_framebuffer flush_dirty sends one transfer per rectangle", "[idfxx][lcd]") {
+    constexpr size_t width = 64;
+    auto fb = rgb565_framebuffer::make(width, 48);
+    TEST_ASSERT_TRUE(fb.has_value());
+
+    recording_panel display;
+
+    // The initial flush sends the whole frame in place.
+    TEST_ASSERT_TRUE(fb->try_flush_dirty(display).has_value());
+    TEST_ASSERT_EQUAL(1, display.draws.size());
+    TEST_ASSERT_EQUAL_PTR(fb->data().data(), display.draws[0].data);
+    TEST_ASSERT_EQUAL(0, fb->dirty_regions().size());
+
+    // Nothing dirty: nothing sent.
+    display.draws.clear();
+    TEST_ASSERT_TRUE(fb->try_flush_dirty(display).has_value());
+    TEST_ASSERT_EQUAL(0, display.draws.size());
+
+    // Two separate 3x4 blocks and a single-row run.
+    constexpr rgb565 a(255, 0, 0);
+    constexpr rgb565 b(0, 0, 255);
+    for (size_t y = 10; y < 14; ++y) {
+        for (size_t x = 3; x < 6; ++x) {
+            fb->set_pixel(x, y, a);
+            fb->set_pixel(x + 40, y + 20, b);
+        }
+    }
+    for (size_t x = 20; x < 30; ++x) {
+        fb->set_pixel(x, 45, a);
+    }
+    TEST_ASSERT_EQUAL(3, fb->dirty_regions().size());
+
+    TEST_ASSERT_TRUE(fb->try_flush_dirty(display, 0, 100).has_value());
+    TEST_ASSERT_EQUAL(3, display.draws.size());
+    TEST_ASSERT_EQUAL(0, fb->dirty_regions().size());
+
+    for (const auto& draw : display.draws) {
+        auto* pixels = static_cast<const rgb565*>(draw.data);
+        const size_t w = draw.x_end - draw.x_start;
+        const size_t h = draw.y_end - draw.y_start;
+        if (h == 1) {
+            // Single-row rectangles transfer in place.
+            TEST_ASSERT_EQUAL(145, draw.y_start);
+            TEST_ASSERT_EQUAL_PTR(fb->data().data() + 45 * width + 20, pixels);
+            continue;
+        }
+        // Narrow blocks are staged contiguously, row by row.
+        TEST_ASSERT_EQUAL(3, w);
+        TEST_ASSERT_EQUAL(4, h);
+        TEST_ASSERT_TRUE(pixels < fb->data().data() || pixels >= fb->data().data() + fb->data().size());
+        for (size_t i = 0; i < w * h; ++i) {
+            size_t x = draw.x_start + i % w;
+            size_t y = draw.y_start - 100 + i / w;
+            TEST_ASSERT_TRUE(pixels[i] == fb->get_pixel(x, y));
+        }
+    }
+}
+
+TEST_CASE("rgb565_framebuffer fill_block, fill_span and blit", "[idfxx][lcd]") {
+    auto fb = rgb565_framebuffer::make(17, 9);
+    TEST_ASSERT_TRUE(fb.has_value());
+    fb->mark_clean();
+
+    constexpr rgb565 red(255, 0, 0);
+    constexpr rgb565 blue(0, 0, 255);
+
+    // An odd start column exercises the unaligned head and tail stores.
+    fb->fill_block(3, 2, 5, 3, red);
+    for (size_t y = 0; y < 9; ++y) {
+        for (size_t x = 0; x < 17; ++x) {
+            bool inside = x >= 3 && x < 8 && y >= 2 && y < 5;
+            TEST_ASSERT_TRUE(fb->get_pixel(x, y) == (inside ? red : rgb565{}));
+        }
+    }
+    TEST_ASSERT_EQUAL(1, fb->dirty_regions().size());
+    TEST_ASSERT_TRUE(fb->dirty_regions()[0] == (rect{3, 2, 8, 5}));
+
+    // Runs are clipped at the right edge.
+    fb->fill_span(15, 7, 10, blue);
+    TEST_ASSERT_TRUE(fb->get_pixel(14, 7) == rgb565{});
+    TEST_ASSERT_TRUE(fb->get_pixel(15, 7) == blue);
+    TEST_ASSERT_TRUE(fb->get_pixel(16, 7) == blue);
+    fb->fill_span(17, 0, 4, blue); // entirely outside: ignored
+
+    const std::array<rgb565, 6> image{red, blue, red, blue, red, blue};
+    fb->blit(0, 7, 3, 2, image.data(), 3);
+    TEST_ASSERT_TRUE(fb->get_pixel(0, 7) == red);
+    TEST_ASSERT_TRUE(fb->get_pixel(1, 7) == blue);
+    TEST_ASSERT_TRUE(fb->get_pixel(0, 8) == blue);
+    TEST_ASSERT_TRUE(fb->get_pixel(2, 8) == blue);
+}
+
+TEST_CASE("rgb565_framebuffer flush_async completes with the transfer", "[idfxx][lcd]") {
+    auto fb = rgb565_framebuffer::make(8, 4);
+    TEST_ASSERT_TRUE(fb.has_value());
+    auto tracker = transfer_tracker::make();
+    TEST_ASSERT_TRUE(tracker.has_value());
+    auto done = tracker->callback();
+    recording_panel panel;
+
+    auto sent = fb->try_flush_async(panel, *tracker, 0, 16);
+    TEST_ASSERT_TRUE(sent.has_value());
+    TEST_ASSERT_EQUAL(1, panel.draws.size());
+    TEST_ASSERT_EQUAL(16, panel.draws[0].y_start);
+    TEST_ASSERT_EQUAL(20, panel.draws[0].y_end);
+    TEST_ASSERT_EQUAL_PTR(fb->data().data(), panel.draws[0].data);
+    TEST_ASSERT_FALSE(sent->done());
+
+    // The panel I/O reports the transfer complete.
+    (void)done(nullptr);
+    TEST_ASSERT_TRUE(sent->done());
+    TEST_ASSERT_TRUE(sent->try_wait().has_value());
+}
+
+TEST_CASE("rgb565_framebuffer flush_async waits only for its own transfer", "[idfxx][lcd]") {
+    auto front = rgb565_framebuffer::make(8, 4);
+    auto back = rgb565_framebuffer::make(8, 4);
+    TEST_ASSERT_TRUE(front.has_value());
+    TEST_ASSERT_TRUE(back.has_value());
+    auto tracker = transfer_tracker::make();
+    TEST_ASSERT_TRUE(tracker.has_value());
+    auto done = tracker->callback();
+    recording_panel panel;
+
+    auto first = front->try_flush_async(panel, *tracker);
+    auto second = back->try_flush_async(panel, *tracker);
+    TEST_ASSERT_TRUE(first.has_value());
+    TEST_ASSERT_TRUE(second.has_value());
+
+    // Once the first transfer finishes, its framebuffer is free even though
+    // the second is still being sent.
+    (void)done(nullptr);
+    TEST_ASSERT_TRUE(first->done());
+    TEST_ASSERT_FALSE(second->done());
+
+    (void)done(nullptr);
+    TEST_ASSERT_TRUE(second->done());
+}
@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+// Unit tests for idfxx::lcd::transfer_tracker
+// Uses ESP-IDF Unity test framework with compile-time static_asserts
+
+#include "idfxx/lcd/transfer_tracker"
+#include "recording_panel.hpp"
+#include "unity.h"
+
+#include <chrono>
+#include <type_traits>
+#include <utility>
+
+using namespace idfxx::lcd;
+using namespace std::chrono_literals;
+using idfxx_lcd_test::recording_panel;
+
+// =============================================================================
+// Compile-time tests (static_assert)
+// =============================================================================
+
+static_assert(!std::is_copy_constructible_v<transfer_tracker>);
+static_assert(!std::is_copy_assignable_v<transfer_tracker>);
+static_assert(std::is_move_constructible_v<transfer_tracker>);
+static_assert(std::is_move_assignable_v<transfer_tracker>);
+
+// =============================================================================
+// Runtime tests (Unity TEST_CASE)
+// =============================================================================
+
+namespace {
+
+// Panel whose draws always fail, as when the transfer queue is full.
+class failing_panel : public idfxx::lcd::panel {
+    [[nodiscard]] esp_lcd_panel_handle_t do_idf_handle() const override { return nullptr; }
+
+    [[nodiscard]] idfxx::result<void> do_draw_bitmap(int, int, int, int, const void*) override {
+        return idfxx::error(idfxx::errc::fail);
+    }
+};
+
+} // namespace
+
+TEST_CASE("transfer_tracker fence with nothing outstanding is complete", "[idfxx][lcd]") {
+    auto tracker = transfer_tracker::make();
+    TEST_ASSERT_TRUE(tracker.has_value());
+    TEST_ASSERT_EQUAL(0, tracker->pending());
+
+    auto f = tracker->fence();
+    TEST_ASSERT_TRUE(f.valid());
+    TEST_ASSERT_TRUE(f.done());
+    TEST_ASSERT_TRUE(f.try_wait().has_value());
+}
+
+TEST_CASE("transfer_tracker fence covers earlier transfers only", "[idfxx][lcd]") {
+    auto tracker = transfer_tracker::make();
+    TEST_ASSERT_TRUE(tracker.has_value());
+    auto done = tracker->callback();
+    recording_panel panel;
+    const uint16_t pixel = 0;
+
+    TEST_ASSERT_TRUE(tracker->try_draw_bitmap(panel, 0, 0, 1, 1, &pixel).has_value());
+    TEST_ASSERT_TRUE(tracker->try_draw_bitmap(panel, 1, 0, 2, 1, &pixel).has_value());
+    auto first = tracker->fence();
+    TEST_ASSERT_TRUE(tracker->try_draw_bitmap(panel, 2, 0, 3, 1, &pixel).has_value());
+    auto second = tracker->fence();
+    TEST_ASSERT_EQUAL(3, panel.draws.size());
+    TEST_ASSERT_EQUAL(3, tracker->pending());
+
+    (void)done(nullptr);
+    TEST_ASSERT_FALSE(first.done());
+    auto timed_out = first.try_wait_for(10ms);
+    TEST_ASSERT_FALSE(timed_out.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(idfxx::errc::timeout), timed_out.error().value());
+
+    (void)done(nullptr);
+    TEST_ASSERT_TRUE(first.done());
+    TEST_ASSERT_TRUE(first.try_wait_for(10ms).has_value());
+    TEST_ASSERT_FALSE(second.done());
+
+    (void)done(nullptr);
+    TEST_ASSERT_TRUE(second.try_wait().has_value());
+    TEST_ASSERT_EQUAL(0, tracker->pending());
+}
+
+TEST_CASE("transfer_tracker ignores untracked completions and failed draws", "[idfxx][lcd]") {
+    auto tracker = transfer_tracker::make();
+    TEST_ASSERT_TRUE(tracker.has_value());
+    auto done = tracker->callback();
+    const uint16_t pixel = 0;
+
+    // A completion for a transfer the tracker did not submit.
+    (void)done(nullptr);
+    TEST_ASSERT_EQUAL(0, tracker->pending());
+
+    failing_panel broken;
+    TEST_ASSERT_FALSE(tracker->try_draw_bitmap(broken, 0, 0, 1, 1, &pixel).has_value());
+    TEST_ASSERT_EQUAL(0, tracker->pending());
+
+    recording_panel panel;
+    TEST_ASSERT_TRUE(tracker->try_draw_bitmap(panel, 0, 0, 1, 1, &pixel).has_value());
+    auto f = tracker->fence();
+    TEST_ASSERT_FALSE(f.done());
+    (void)done(nullptr);
+    TEST_ASSERT_TRUE(f.done());
+}
+
+TEST_CASE("transfer_tracker futures outlive the tracker", "[idfxx][lcd]") {
+    auto done = transfer_tracker::callback_type{};
+    idfxx::future<void> f;
+    {
+        auto tracker = transfer_tracker::make();
+        TEST_ASSERT_TRUE(tracker.has_value());
+        done = tracker->callback();
+        recording_panel panel;
+        const uint16_t pixel = 0;
+        TEST_ASSERT_TRUE(tracker->try_draw_bitmap(panel, 0, 0, 1, 1, &pixel).has_value());
+        f = tracker->fence();
+    }
+    (void)done(nullptr);
+    TEST_ASSERT_TRUE(f.try_wait().has_value());
+}
+
+TEST_CASE("panel draw_bitmap_async futures complete in submission order", "[idfxx][lcd]") {
+    auto tracker = transfer_tracker::make();
+    TEST_ASSERT_TRUE(tracker.has_value());
+    auto done = tracker->callback();
+    recording_panel panel;
+    const uint16_t pixel = 0;
+
+    auto first = panel.try_draw_bitmap_async(*tracker, 0, 0, 1, 1, &pixel);
+    auto second = panel.try_draw_bitmap_async(*tracker, 1, 0, 2, 1, &pixel);
+    TEST_ASSERT_TRUE(first.has_value());
+    TEST_ASSERT_TRUE(second.has_value());
+    TEST_ASSERT_EQUAL(2, panel.draws.size());
+    TEST_ASSERT_FALSE(first->done());
+
+    // A transfer queued later does not hold back an earlier future.
+    auto third = panel.try_draw_bitmap_async(*tracker, 2, 0, 3, 1, &pixel);
+    TEST_ASSERT_TRUE(third.has_value());
+
+    (void)done(nullptr);
+    TEST_ASSERT_TRUE(first->try_wait_for(10ms).has_value());
+    TEST_ASSERT_FALSE(second->done());
+
+    (void)done(nullptr);
+    TEST_ASSERT_TRUE(second->done());
+    TEST_ASSERT_FALSE(third->done());
+
+    (void)done(nullptr);
+    TEST_ASSERT_TRUE(third->try_wait().has_value());
+    TEST_ASSERT_EQUAL(0, tracker->pending());
+}
+
+TEST_CASE("panel draw_bitmap_async reports a failed draw without counting it", "[idfxx][lcd]") {
+    auto tracker = transfer_tracker::make();
+    TEST_ASSERT_TRUE(tracker.has_value());
+    failing_panel broken;
+    const uint16_t pixel = 0;
+
+    auto sent = broken.try_draw_bitmap_async(*tracker, 0, 0, 1, 1, &pixel);
+    TEST_ASSERT_FALSE(sent.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(idfxx::errc::fail), sent.error().value());
+    TEST_ASSERT_EQUAL(0, tracker->pending());
+}
@@ -0,0 +1,310 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+#pragma once
+
+/**
+ * @headerfile <idfxx/lcd/touch_filter>
+ * @file touch_filter.hpp
+ * @brief Touch calibration, de-jitter filtering, and press/move/release events.
+ * @ingroup idfxx_lcd_touch
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+/**
+ * @headerfile <idfxx/lcd/touch_filter>
+ * @brief LCD driver classes.
+ */
+namespace idfxx::lcd {
+
+/**
+ * @headerfile <idfxx/lcd/touch_filter>
+ * @brief A touch position.
+ */
+struct touch_point {
+    uint16_t x = 0; ///< X coordinate
+    uint16_t y = 0; ///< Y coordinate
+
+    /** @brief Compares two points for equality. */
+    friend constexpr bool operator==(const touch_point&, const touch_point&) noexcept = default;
+};
+
+/**
+ * @headerfile <idfxx/lcd/touch_filter>
+ * @brief A press, move, or release of the touch screen.
+ */
+struct touch_event {
+    /** @brief What happened. */
+    enum class kind : uint8_t {
+        press,   ///< Contact started
+        move,    ///< Contact moved
+        release, ///< Contact ended; the position is the last one reported
+    };
+
+    kind type = kind::press; ///< Event type
+    uint16_t x = 0;          ///< X coordinate
+    uint16_t y = 0;          ///< Y coordinate
+    uint16_t strength = 0;   ///< Contact strength as reported by the controller (0 if unsupported)
+};
+
+/**
+ * @headerfile <idfxx/lcd/touch_filter>
+ * @brief Three-point affine calibration from controller to screen coordinates.
+ *
+ * Resistive panels are rarely aligned with the display beneath them: the
+ * touch axes are offset, scaled, and slightly rotated. Touching three targets
+ * at known screen positions gives enough information to correct all three,
+ * using the mapping
+ *
+ *     x' = (a·x + b·y + c) / d
+ *     y' = (e·x + f·y + g) / d
+ *
+ * computed in integer arithmetic. A default-constructed calibration is the
+ * identity.
+ *
+ * @code
+ * // Targets drawn at (20,20), (220,160) and (120,300); raw readings taken while touching each.
+ * auto cal = idfxx::lcd::touch_calibration::from_points(
+ *     {{{312, 3580}, {3710, 2105}, {2040, 420}}},
+ *     {{{20, 20}, {220, 160}, {120, 300}}});
+ * @endcode
+ */
+class touch_calibration {
+public:
+    /** @brief Constructs the identity calibration. */
+    constexpr touch_calibration() noexcept = default;
+
+    /**
+     * @brief Computes the calibration that maps three raw readings onto three screen positions.
+     *
+     * @param raw    Controller coordinates read while touching each target.
+     * @param screen Screen positions of the targets.
+     *
+     * @return The calibration, or `std::nullopt` if the raw readings are collinear.
+     */
+    [[nodiscard]] static constexpr std::optional<touch_calibration>
+    from_points(const std::array<touch_point, 3>& raw, const std::array<touch_point, 3>& screen) noexcept {
+        const int64_t x0 = raw[0].x, x1 = raw[1].x, x2 = raw[2].x;
+        const int64_t y0 = raw[0].y, y1 = raw[1].y, y2 = raw[2].y;
+        const int64_t u0 = screen[0].x, u1 = screen[1].x, u2 = screen[2].x;
+        const int64_t v0 = screen[0].y, v1 = screen[1].y, v2 = screen[2].y;
+
+        touch_calibration cal;
+        cal._d = (x0 - x2) * (y1 - y2) - (x1 - x2) * (y0 - y2);
+        if (cal._d == 0) {
+            return std::nullopt;
+        }
+        cal._a = (u0 - u2) * (y1 - y2) - (u1 - u2) * (y0 - y2);
+        cal._b = (x0 - x2) * (u1 - u2) - (u0 - u2) * (x1 - x2);
+        cal._c = y0 * (x2 * u1 - x1 * u2) + y1 * (x0 * u2 - x2 * u0) + y2 * (x1 * u0 - x0 * u1);
+        cal._e = (v0 - v2) * (y1 - y2) - (v1 - v2) * (y0 - y2);
+        cal._f = (x0 - x2) * (v1 - v2) - (v0 - v2) * (x1 - x2);
+        cal._g = y0 * (x2 * v1 - x1 * v2) + y1 * (x0 * v2 - x2 * v0) + y2 * (x1 * v0 - x0 * v1);
+        if (cal._d < 0) {
+            cal._a = -cal._a;
+            cal._b = -cal._b;
+            cal._c = -cal._c;
+            cal._e = -cal._e;
+            cal._f = -cal._f;
+            cal._g = -cal._g;
+            cal._d = -cal._d;
+        }
+        return cal;
+    }
+
+    /**
+     * @brief Maps a raw reading to screen coordinates.
+     *
+     * @param raw   Controller coordinates.
+     * @param x_max Largest X coordinate to return; results are clamped to `[0, x_max]`.
+     * @param y_max Largest Y coordinate to return; results are clamped to `[0, y_max]`.
+     *
+     * @return The screen position, rounded to the nearest pixel.
+     */
+    [[nodiscard]] constexpr touch_point apply(touch_point raw, uint16_t x_max, uint16_t y_max) const noexcept {
+        const int64_t x = raw.x, y = raw.y;
+        return {
+            _map(_a * x + _b * y + _c, x_max),
+            _map(_e * x + _f * y + _g, y_max),
+        };
+    }
+
+    /** @brief Compares two calibrations for equality of their coefficients. */
+    friend constexpr bool operator==(const touch_calibration&, const touch_calibration&) noexcept = default;
+
+private:
+    [[nodiscard]] constexpr uint16_t _map(int64_t numerator, uint16_t max) const noexcept {
+        // Round to nearest; _d is always positive.
+        const int64_t v = numerator >= 0 ? (numerator + _d / 2) / _d : -((-numerator + _d / 2) / _d);
+        return static_cast<uint16_t>(std::clamp<int64_t>(v, 0, max));
+    }
+
+    int64_t _a = 1, _b = 0, _c = 0;
+    int64_t _e = 0, _f = 1, _g = 0;
+    int64_t _d = 1;
+};
+
+/**
+ * @headerfile <idfxx/lcd/touch_filter>
+ * @brief De-jitter filter turning a stream of touch samples into press/move/release events.
+ *
+ * Each axis passes through a median over the last few samples, which rejects
+ * the isolated spikes resistive panels produce, and then a first-order IIR
+ * low-pass that smooths the remaining noise. A press is reported only once
+ * the median window has filled, so contact bounce shorter than the window
+ * produces no events at all; a move is reported once the filtered position
+ * has drifted at least `move_threshold` from the last reported one, so a
+ * resting finger is quiet.
+ *
+ * The filter is plain data with no synchronization; `touch_input` runs one
+ * on its worker task, and it can equally be driven by hand from a polling
+ * loop.
+ *
+ * @code
+ * idfxx::lcd::touch_filter filter({.median_window = 5, .smoothing = 2});
+ * if (auto ev = count > 0 ? filter.sample(x, y, strength) : filter.release()) {
+ *     handle(*ev);
+ * }
+ * @endcode
+ */
+class touch_filter {
+public:
+    /** @brief Largest supported median window. */
+    static constexpr size_t max_median_window = 5;
+
+    /**
+     * @headerfile <idfxx/lcd/touch_filter>
+     * @brief Filter configuration.
+     */
+    struct config {
+        /** @brief Samples per median (1, 3, or 5); also the samples needed before a press is reported. */
+        uint8_t median_window = 3;
+        /** @brief IIR strength: each sample moves the output 1/2^smoothing of the way. 0 disables. */
+        uint8_t smoothing = 1;
+        /** @brief Distance, in either axis, the position must move before a move is reported. */
+        uint16_t move_threshold = 2;
+    };
+
+    /**
+     * @brief Checks whether a configuration is usable.
+     * @param cfg The configuration.
+     * @return True if the median window is 1, 3, or 5 and smoothing is at most 8.
+     */
+    [[nodiscard]] static constexpr bool valid(const config& cfg) noexcept {
+        return cfg.median_window % 2 == 1 && cfg.median_window <= max_median_window && cfg.smoothing <= 8;
+    }
+
+    /** @brief Constructs a filter with the default configuration, in the released state. */
+    constexpr touch_filter() noexcept
+        : _cfg(config{}) {}
+
+    /**
+     * @brief Constructs a filter in the released state.
+     * @param cfg Filter configuration. Must satisfy @ref valid.
+     */
+    constexpr explicit touch_filter(const config& cfg) noexcept
+        : _cfg(cfg) {}
+
+    /**
+     * @brief Feeds one sample taken while the screen is touched.
+     *
+     * @param x        X coordinate.
+     * @param y        Y coordinate.
+     * @param strength Contact strength (0 if unsupported).
+     *
+     * @return A press when the median window first fills, a move when the
+     *         filtered position has moved far enough, or `std::nullopt`.
+     */
+    [[nodiscard]] constexpr std::optional<touch_event> sample(uint16_t x, uint16_t y, uint16_t strength) noexcept {
+        _xs[_next] = x;
+        _ys[_next] = y;
+        _next = (_next + 1) % _cfg.median_window;
+        _strength = strength;
+        if (_count < _cfg.median_window) {
+            ++_count;
+            if (_count < _cfg.median_window) {
+                return std::nullopt;
+            }
+            _fx = static_cast<int32_t>(_median(_xs)) << frac_bits;
+            _fy = static_cast<int32_t>(_median(_ys)) << frac_bits;
+            _last = _position();
+            return touch_event{touch_event::kind::press, _last.x, _last.y, strength};
+        }
+
+        _fx += ((static_cast<int32_t>(_median(_xs)) << frac_bits) - _fx) >> _cfg.smoothing;
+        _fy += ((static_cast<int32_t>(_median(_ys)) << frac_bits) - _fy) >> _cfg.smoothing;
+        const touch_point p = _position();
+        const int dx = p.x > _last.x ? p.x - _last.x : _last.x - p.x;
+        const int dy = p.y > _last.y ? p.y - _last.y : _last.y - p.y;
+        if (std::max(dx, dy) < std::max<int>(_cfg.move_threshold, 1)) {
+            return std::nullopt;
+        }
+        _last = p;
+        return touch_event{touch_event::kind::move, p.x, p.y, strength};
+    }
+
+    /**
+     * @brief Reports that the screen is no longer touched.
+     *
+     * @return A release at the last reported position if a press was
+     *         reported, otherwise `std::nullopt` (the contact was too short
+     *         to count).
+     */
+    [[nodiscard]] constexpr std::optional<touch_event> release() noexcept {
+        const bool was_pressed = pressed();
+        _count = 0;
+        _next = 0;
+        if (!was_pressed) {
+            return std::nullopt;
+        }
+        return touch_event{touch_event::kind::release, _last.x, _last.y, _strength};
+    }
+
+    /**
+     * @brief Returns whether a press has been reported and not yet released.
+     * @return True while pressed.
+     */
+    [[nodiscard]] constexpr bool pressed() const noexcept { return _count != 0 && _count == _cfg.median_window; }
+
+    /**
+     * @brief Returns the filter configuration.
+     * @return The configuration.
+     */
+    [[nodiscard]] constexpr const config& get_config() const noexcept { return _cfg; }
+
+private:
+    // Fractional bits kept by the IIR so small steps are not lost to truncation.
+    static constexpr int frac_bits = 4;
+
+    [[nodiscard]] constexpr uint16_t _median(const std::array<uint16_t, max_median_window>& values) const noexcept {
+        std::array<uint16_t, max_median_window> sorted = values;
+        const auto n = _cfg.median_window;
+        std::nth_element(sorted.begin(), sorted.begin() + n / 2, sorted.begin() + n);
+        return sorted[n / 2];
+    }
+
+    [[nodiscard]] constexpr touch_point _position() const noexcept {
+        constexpr int32_t half = 1 << (frac_bits - 1);
+        return {
+            static_cast<uint16_t>((_fx + half) >> frac_bits),
+            static_cast<uint16_t>((_fy + half) >> frac_bits),
+        };
+    }
+
+    config _cfg;
+    std::array<uint16_t, max_median_window> _xs{};
+    std::array<uint16_t, max_median_window> _ys{};
+    uint8_t _next = 0;
+    uint8_t _count = 0;
+    int32_t _fx = 0;
+    int32_t _fy = 0;
+    touch_point _last{};
+    uint16_t _strength = 0;
+};
+
+} // namespace idfxx::lcd
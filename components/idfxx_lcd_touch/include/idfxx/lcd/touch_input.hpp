@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+#pragma once
+
+/**
+ * @headerfile <idfxx/lcd/touch_input>
+ * @file touch_input.hpp
+ * @brief Interrupt-driven touch input service.
+ * @ingroup idfxx_lcd_touch
+ */
+
+#include <idfxx/cpu>
+#include <idfxx/error>
+#include <idfxx/lcd/touch>
+#include <idfxx/lcd/touch_filter>
+#include <idfxx/queue>
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+
+/**
+ * @headerfile <idfxx/lcd/touch_input>
+ * @brief LCD driver classes.
+ */
+namespace idfxx::lcd {
+
+/**
+ * @headerfile <idfxx/lcd/touch_input>
+ * @brief Interrupt-driven touch input service.
+ *
+ * Replaces a polling loop around `esp_lcd_touch_read_data()`. A worker task
+ * sleeps until the controller asserts its interrupt pin (the touch
+ * controller's `config::int_gpio`), then reads the controller once per wake
+ * — one bus transaction drains whatever the controller has buffered — and
+ * keeps sampling every `sample_interval` only while the screen stays
+ * touched. Each reading is calibrated, passed through a @ref touch_filter,
+ * and the resulting press, move, and release events are delivered to a
+ * callback, a queue, or both. While nothing touches the screen the service
+ * uses no CPU and no bus time.
+ *
+ * Only the first contact point is tracked; multi-touch controllers report
+ * their primary contact.
+ *
+ * This type is non-copyable and move-only. The touch controller must outlive it.
+ *
+ * @code
+ * idfxx::gpio::install_isr_service();
+ * idfxx::lcd::stmpe610 touch(touch_io, {.x_max = 240, .y_max = 320, .int_gpio = idfxx::gpio_7});
+ * idfxx::lcd::touch_input input(touch, {
+ *     .callback = [](const idfxx::lcd::touch_event& ev) {
+ *         // runs on the touch_input task
+ *     },
+ * });
+ * @endcode
+ */
+class touch_input {
+public:
+    /**
+     * @headerfile <idfxx/lcd/touch_input>
+     * @brief Touch input service configuration.
+     *
+     * At least one of `callback` and `queue` must be set.
+     */
+    struct config {
+        /** @brief De-jitter filter settings. */
+        touch_filter::config filter = {};
+        /** @brief Calibration applied to each reading, before filtering. */
+        touch_calibration calibration = {};
+        /** @brief Interval between readings while the screen is touched. */
+        std::chrono::milliseconds sample_interval{10};
+        /** @brief Called on the worker task for each event. */
+        std::move_only_function<void(const touch_event&)> callback = nullptr;
+        /** @brief Queue each event is sent to, without waiting. Must outlive the service. */
+        idfxx::queue<touch_event>* queue = nullptr;
+        /** @brief Worker task priority. */
+        task_priority priority = 5;
+        /** @brief Worker task stack size in bytes; the callback runs on this stack. */
+        size_t stack_size = 3072;
+        /** @brief Core to pin the worker task to (nullopt = any core). */
+        std::optional<core_id> core_affinity = std::nullopt;
+    };
+
+#ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
+    /**
+     * @brief Starts delivering events from a touch controller.
+     *
+     * Does not take ownership of @p touch. It is the caller's responsibility to ensure that
+     * this service does not outlive the touch controller.
+     *
+     * @pre gpio::install_isr_service() must have been called.
+     *
+     * @param touch The touch controller, created with an interrupt pin.
+     * @param cfg   Service configuration.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on error.
+     */
+    [[nodiscard]] explicit touch_input(touch& touch, config cfg);
+#endif
+
+    /**
+     * @brief Starts delivering events from a touch controller.
+     *
+     * Does not take ownership of @p touch. It is the caller's responsibility to ensure that
+     * this service does not outlive the touch controller.
+     *
+     * @pre gpio::install_isr_service() must have been called.
+     *
+     * @param touch The touch controller, created with an interrupt pin.
+     * @param cfg   Service configuration.
+     *
+     * @return The running service, or an error.
+     * @retval invalid_arg The controller has no interrupt pin, neither a callback nor a queue
+     *         is set, the filter configuration is not @ref touch_filter::valid, or the
+     *         sample interval is not positive.
+     * @retval invalid_state The controller has no ESP-IDF handle (e.g. it was moved from).
+     */
+    [[nodiscard]] static result<touch_input> make(touch& touch, config cfg);
+
+    /**
+     * @brief Stops the service.
+     *
+     * Detaches the interrupt handler and joins the worker task. A press in
+     * progress is not released.
+     */
+    ~touch_input();
+
+    touch_input(const touch_input&) = delete;
+    touch_input& operator=(const touch_input&) = delete;
+    touch_input(touch_input&&) noexcept;
+    touch_input& operator=(touch_input&&) noexcept;
+
+    /**
+     * @brief Replaces the calibration applied to subsequent readings.
+     *
+     * Has no effect on a moved-from service.
+     *
+     * @param calibration The new calibration.
+     */
+    void set_calibration(const touch_calibration& calibration) noexcept;
+
+    /**
+     * @brief Returns whether the screen is currently pressed.
+     * @return True between a press and its release; false for a moved-from service.
+     */
+    [[nodiscard]] bool pressed() const noexcept;
+
+    /**
+     * @brief Returns the number of events that could not be sent because the queue was full.
+     * @return The number of dropped events; 0 for a moved-from service.
+     */
+    [[nodiscard]] size_t dropped() const noexcept;
+
+private:
+    struct context;
+
+    explicit touch_input(std::unique_ptr<context> ctx) noexcept;
+
+    std::unique_ptr<context> _context;
+};
+
+} // namespace idfxx::lcd
@@ -0,0 +1,189 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+#include <idfxx/gpio>
+#include <idfxx/lcd/touch_input>
+#include <idfxx/sched>
+#include <idfxx/task>
+
+#include <atomic>
+#include <esp_lcd_touch.h>
+#include <esp_log.h>
+#include <mutex>
+#include <utility>
+
+namespace {
+const char* TAG = "idfxx::lcd::touch_input";
+}
+
+namespace idfxx::lcd {
+
+struct touch_input::context {
+    esp_lcd_touch_handle_t handle;
+    touch_filter filter;
+    std::chrono::milliseconds sample_interval;
+    std::move_only_function<void(const touch_event&)> callback;
+    idfxx::queue<touch_event>* queue;
+
+    std::mutex calibration_mu;
+    touch_calibration calibration;
+
+    std::atomic<bool> pressed{false};
+    std::atomic<size_t> dropped{0};
+
+    // The handler is removed before the worker is joined, so the ISR never
+    // sees a task that is being torn down.
+    std::optional<task> worker;
+    gpio::unique_isr_handle isr;
+
+    context(esp_lcd_touch_handle_t handle, config& cfg)
+        : handle(handle)
+        , filter(cfg.filter)
+        , sample_interval(cfg.sample_interval)
+        , callback(std::move(cfg.callback))
+        , queue(cfg.queue)
+        , calibration(cfg.calibration) {}
+
+    ~context() {
+        isr = gpio::unique_isr_handle{};
+        if (worker) {
+            worker->request_stop();
+            // Wake the worker if it is waiting for an interrupt.
+            (void)worker->try_notify();
+        }
+    }
+
+    static void on_interrupt(void* arg) {
+        auto* ctx = static_cast<context*>(arg);
+        idfxx::yield_from_isr(ctx->worker->notify_from_isr());
+    }
+
+    void deliver(const std::optional<touch_event>& ev) {
+        if (!ev) {
+            return;
+        }
+        pressed.store(ev->type != touch_event::kind::release, std::memory_order_relaxed);
+        if (callback) {
+            callback(*ev);
+        }
+        if (queue != nullptr && !queue->try_send(*ev, std::chrono::milliseconds{0})) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Reads the controller once. Returns true while the screen is touched.
+    bool read_once() {
+        auto err = esp_lcd_touch_read_data(handle);
+        if (err != ESP_OK) {
+            ESP_LOGD(TAG, "Failed to read touch data: %s", esp_err_to_name(err));
+            return filter.pressed();
+        }
+        esp_lcd_touch_point_data_t point{};
+        uint8_t count = 0;
+        if (esp_lcd_touch_get_data(handle, &point, &count, 1) != ESP_OK || count == 0) {
+            deliver(filter.release());
+            return false;
+        }
+        touch_calibration cal;
+        {
+            std::lock_guard lock(calibration_mu);
+            cal = calibration;
+        }
+        auto p = cal.apply({point.x, point.y}, handle->config.x_max, handle->config.y_max);
+        deliver(filter.sample(p.x, p.y, point.strength));
+        return true;
+    }
+
+    void run(task::self& self) {
+        while (!self.stop_requested()) {
+            // Idle: nothing is read until the controller raises its interrupt.
+            self.wait();
+            // Touched: sample at the configured rate until the contact ends.
+            // Interrupts that arrive meanwhile only cut the wait short.
+            while (!self.stop_requested() && read_once()) {
+                self.wait_for(sample_interval);
+            }
+        }
+    }
+};
+
+touch_input::touch_input(std::unique_ptr<context> ctx) noexcept
+    : _context(std::move(ctx)) {}
+
+result<touch_input> touch_input::make(touch& touch, config cfg) {
+    if (!cfg.callback && cfg.queue == nullptr) {
+        ESP_LOGD(TAG, "Neither 'callback' nor 'queue' is set");
+        return error(errc::invalid_arg);
+    }
+    if (!touch_filter::valid(cfg.filter)) {
+        ESP_LOGD(TAG, "Field 'filter' has an invalid value");
+        return error(errc::invalid_arg);
+    }
+    if (cfg.sample_interval.count() <= 0) {
+        ESP_LOGD(TAG, "Field 'sample_interval' has an invalid value");
+        return error(errc::invalid_arg);
+    }
+    esp_lcd_touch_handle_t handle = touch.idf_handle();
+    if (handle == nullptr) {
+        return error(errc::invalid_state);
+    }
+    auto int_gpio = gpio::make(handle->config.int_gpio_num);
+    if (!int_gpio || !int_gpio->is_connected()) {
+        ESP_LOGD(TAG, "Touch controller has no interrupt pin");
+        return error(errc::invalid_arg);
+    }
+
+    auto ctx = std::make_unique<context>(handle, cfg);
+    auto* raw = ctx.get();
+    ctx->worker.emplace(
+        task::config{
+            .name = "touch_input",
+            .stack_size = cfg.stack_size,
+            .priority = cfg.priority,
+            .core_affinity = cfg.core_affinity,
+        },
+        [raw](task::self& self) { raw->run(self); }
+    );
+
+    int_gpio->set_intr_type(
+        handle->config.levels.interrupt != 0 ? gpio::intr_type::posedge : gpio::intr_type::negedge
+    );
+    auto isr = int_gpio->try_isr_handler_add(context::on_interrupt, raw);
+    if (!isr) {
+        ESP_LOGD(TAG, "Failed to add interrupt handler: %s", isr.error().message().c_str());
+        return error(isr.error());
+    }
+    ctx->isr = gpio::unique_isr_handle{*isr};
+    int_gpio->intr_enable();
+
+    // A contact that began before the handler was attached raised its edge
+    // already; read once so it is not missed.
+    (void)ctx->worker->try_notify();
+    return touch_input{std::move(ctx)};
+}
+
+#ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
+touch_input::touch_input(touch& touch, config cfg)
+    : touch_input(unwrap(make(touch, std::move(cfg)))) {}
+#endif
+
+touch_input::touch_input(touch_input&&) noexcept = default;
+touch_input& touch_input::operator=(touch_input&&) noexcept = default;
+touch_input::~touch_input() = default;
+
+void touch_input::set_calibration(const touch_calibration& calibration) noexcept {
+    if (_context) {
+        std::lock_guard lock(_context->calibration_mu);
+        _context->calibration = calibration;
+    }
+}
+
+bool touch_input::pressed() const noexcept {
+    return _context && _context->pressed.load(std::memory_order_relaxed);
+}
+
+size_t touch_input::dropped() const noexcept {
+    return _context ? _context->dropped.load(std::memory_order_relaxed) : 0;
+}
+
+} // namespace idfxx::lcd
@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+// Unit tests for idfxx lcd touch calibration and filtering
+// Uses ESP-IDF Unity test framework with compile-time static_asserts
+
+#include "idfxx/lcd/touch_filter"
+#include "unity.h"
+
+#include <array>
+#include <optional>
+#include <type_traits>
+
+using namespace idfxx::lcd;
+
+// =============================================================================
+// Compile-time tests (static_assert)
+// These verify correctness at compile time - if this file compiles, they pass.
+// =============================================================================
+
+// Events are plain data, so they can travel through a FreeRTOS queue
+static_assert(std::is_trivially_copyable_v<touch_event>);
+
+// The default calibration is the identity, clamped to the range
+static_assert(touch_calibration{}.apply({17, 42}, 100, 100) == touch_point{17, 42});
+static_assert(touch_calibration{}.apply({170, 42}, 100, 100) == touch_point{100, 42});
+
+// Three collinear readings cannot define a calibration
+static_assert(!touch_calibration::from_points({{{0, 0}, {10, 10}, {20, 20}}}, {{{0, 0}, {1, 0}, {0, 1}}}));
+
+// Median windows must be odd and at most max_median_window
+static_assert(touch_filter::valid({}));
+static_assert(touch_filter::valid({.median_window = 1}));
+static_assert(touch_filter::valid({.median_window = 5}));
+static_assert(!touch_filter::valid({.median_window = 0}));
+static_assert(!touch_filter::valid({.median_window = 4}));
+static_assert(!touch_filter::valid({.median_window = 7}));
+static_assert(!touch_filter::valid({.smoothing = 9}));
+
+// =============================================================================
+// Runtime tests (Unity TEST_CASE)
+// =============================================================================
+
+TEST_CASE("touch_calibration maps the reference points onto their targets", "[idfxx][lcd][touch]") {
+    // A panel rotated a little, offset, and scaled to a 12-bit range.
+    const std::array<touch_point, 3> raw{{{312, 3580}, {3710, 2105}, {2040, 420}}};
+    const std::array<touch_point, 3> screen{{{20, 20}, {220, 160}, {120, 300}}};
+
+    auto cal = touch_calibration::from_points(raw, screen);
+    TEST_ASSERT_TRUE(cal.has_value());
+    for (size_t i = 0; i < raw.size(); ++i) {
+        auto p = cal->apply(raw[i], 239, 319);
+        TEST_ASSERT_EQUAL(screen[i].x, p.x);
+        TEST_ASSERT_EQUAL(screen[i].y, p.y);
+    }
+
+    // Results beyond the screen clamp to its edges.
+    auto clamped = cal->apply(raw[1], 199, 149);
+    TEST_ASSERT_EQUAL(199, clamped.x);
+    TEST_ASSERT_EQUAL(149, clamped.y);
+}
+
+TEST_CASE("touch_calibration interpolates between the reference points", "[idfxx][lcd][touch]") {
+    // Raw coordinates are screen coordinates doubled, with X and Y swapped.
+    auto cal = touch_calibration::from_points({{{0, 0}, {0, 400}, {200, 0}}}, {{{0, 0}, {200, 0}, {0, 100}}});
+    TEST_ASSERT_TRUE(cal.has_value());
+
+    auto p = cal->apply({60, 150}, 239, 319);
+    TEST_ASSERT_EQUAL(75, p.x);
+    TEST_ASSERT_EQUAL(30, p.y);
+}
+
+TEST_CASE("touch_filter reports a press only once the median window fills", "[idfxx][lcd][touch]") {
+    touch_filter filter({.median_window = 3, .smoothing = 0, .move_threshold = 1});
+
+    TEST_ASSERT_FALSE(filter.sample(100, 50, 7).has_value());
+    TEST_ASSERT_FALSE(filter.sample(102, 52, 7).has_value());
+    TEST_ASSERT_FALSE(filter.pressed());
+
+    auto press = filter.sample(101, 51, 9);
+    TEST_ASSERT_TRUE(press.has_value());
+    TEST_ASSERT_TRUE(press->type == touch_event::kind::press);
+    TEST_ASSERT_EQUAL(101, press->x);
+    TEST_ASSERT_EQUAL(51, press->y);
+    TEST_ASSERT_EQUAL(9, press->strength);
+    TEST_ASSERT_TRUE(filter.pressed());
+}
+
+TEST_CASE("touch_filter ignores contact bounce shorter than the window", "[idfxx][lcd][touch]") {
+    touch_filter filter({.median_window = 5});
+
+    TEST_ASSERT_FALSE(filter.sample(10, 10, 0).has_value());
+    TEST_ASSERT_FALSE(filter.sample(11, 10, 0).has_value());
+    TEST_ASSERT_FALSE(filter.release().has_value());
+    TEST_ASSERT_FALSE(filter.pressed());
+
+    // The next contact starts from an empty window.
+    for (int i = 0; i < 4; ++i) {
+        TEST_ASSERT_FALSE(filter.sample(200, 100, 0).has_value());
+    }
+    auto press = filter.sample(200, 100, 0);
+    TEST_ASSERT_TRUE(press.has_value());
+    TEST_ASSERT_EQUAL(200, press->x);
+}
+
+TEST_CASE("touch_filter median rejects single-sample spikes", "[idfxx][lcd][touch]") {
+    touch_filter filter({.median_window = 3, .smoothing = 0, .move_threshold = 1});
+    for (int i = 0; i < 3; ++i) {
+        (void)filter.sample(120, 80, 0);
+    }
+
+    TEST_ASSERT_FALSE(filter.sample(4000, 80, 0).has_value());
+    TEST_ASSERT_FALSE(filter.sample(120, 3, 0).has_value());
+    TEST_ASSERT_FALSE(filter.sample(120, 80, 0).has_value());
+}
+
+TEST_CASE("touch_filter smooths a step and reports moves past the threshold", "[idfxx][lcd][touch]") {
+    touch_filter filter({.median_window = 1, .smoothing = 1, .move_threshold = 4});
+    auto press = filter.sample(100, 100, 0);
+    TEST_ASSERT_TRUE(press.has_value());
+
+    // Each sample moves halfway to the target: 150, 175, 188, 194, 197, 199, 200.
+    int moves = 0;
+    uint16_t last_x = press->x;
+    for (int i = 0; i < 20; ++i) {
+        if (auto ev = filter.sample(200, 100, 0)) {
+            TEST_ASSERT_TRUE(ev->type == touch_event::kind::move);
+            TEST_ASSERT_TRUE(ev->x > last_x);
+            TEST_ASSERT_TRUE(ev->x - last_x >= 4);
+            TEST_ASSERT_EQUAL(100, ev->y);
+            last_x = ev->x;
+            ++moves;
+        }
+    }
+    TEST_ASSERT_EQUAL(5, moves);
+    TEST_ASSERT_TRUE(last_x >= 196);
+
+    // A resting finger produces no further events.
+    TEST_ASSERT_FALSE(filter.sample(200, 100, 0).has_value());
+}
+
+TEST_CASE("touch_filter releases at the last reported position", "[idfxx][lcd][touch]") {
+    touch_filter filter({.median_window = 1, .smoothing = 0, .move_threshold = 10});
+    (void)filter.sample(30, 40, 5);
+    TEST_ASSERT_FALSE(filter.sample(33, 42, 6).has_value());
+
+    auto release = filter.release();
+    TEST_ASSERT_TRUE(release.has_value());
+    TEST_ASSERT_TRUE(release->type == touch_event::kind::release);
+    TEST_ASSERT_EQUAL(30, release->x);
+    TEST_ASSERT_EQUAL(40, release->y);
+    TEST_ASSERT_FALSE(filter.pressed());
+    TEST_ASSERT_FALSE(filter.release().has_value());
+}
@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+// Unit tests for idfxx lcd touch_input
+// Uses ESP-IDF Unity test framework with compile-time static_asserts
+
+#include "idfxx/lcd/touch_input"
+#include "unity.h"
+
+#include <type_traits>
+#include <utility>
+
+using namespace idfxx::lcd;
+
+namespace {
+
+// A controller with no ESP-IDF handle, as after a move.
+class detached_touch : public touch {
+private:
+    esp_lcd_touch_handle_t do_idf_handle() const override { return nullptr; }
+};
+
+} // namespace
+
+// =============================================================================
+// Compile-time tests (static_assert)
+// These verify correctness at compile time - if this file compiles, they pass.
+// =============================================================================
+
+// touch_input is non-copyable
+static_assert(!std::is_copy_constructible_v<touch_input>);
+static_assert(!std::is_copy_assignable_v<touch_input>);
+
+// touch_input is move-only
+static_assert(std::is_move_constructible_v<touch_input>);
+static_assert(std::is_move_assignable_v<touch_input>);
+
+// touch_input::config is default-constructible
+static_assert(std::is_default_constructible_v<touch_input::config>);
+
+// =============================================================================
+// Runtime tests (Unity TEST_CASE)
+// =============================================================================
+
+TEST_CASE("touch_input::config defaults", "[idfxx][lcd][touch]") {
+    touch_input::config config{};
+
+    TEST_ASSERT_EQUAL(10, config.sample_interval.count());
+    TEST_ASSERT_EQUAL(3, config.filter.median_window);
+    TEST_ASSERT_NULL(config.callback);
+    TEST_ASSERT_NULL(config.queue);
+    TEST_ASSERT_FALSE(config.core_affinity.has_value());
+}
+
+TEST_CASE("touch_input::make requires a callback or a queue", "[idfxx][lcd][touch]") {
+    detached_touch touch;
+
+    auto result = touch_input::make(touch, {});
+    TEST_ASSERT_FALSE(result.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(idfxx::errc::invalid_arg), result.error().value());
+}
+
+TEST_CASE("touch_input::make rejects an invalid filter", "[idfxx][lcd][touch]") {
+    detached_touch touch;
+
+    auto result = touch_input::make(
+        touch,
+        {
+            .filter = {.median_window = 4},
+            .callback = [](const touch_event&) {},
+        }
+    );
+    TEST_ASSERT_FALSE(result.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(idfxx::errc::invalid_arg), result.error().value());
+}
+
+TEST_CASE("touch_input::make rejects a controller without a handle", "[idfxx][lcd][touch]") {
+    detached_touch touch;
+
+    auto result = touch_input::make(touch, {.callback = [](const touch_event&) {}});
+    TEST_ASSERT_FALSE(result.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(idfxx::errc::invalid_state), result.error().value());
+}
@@ -4,7 +4,9 @@
 #include <idfxx/lcd/ili9341>
 #include <idfxx/lcd/panel_io>
 #include <idfxx/lcd/stmpe610>
+#include <idfxx/lcd/touch_input>
 #include <idfxx/log>
+#include <idfxx/queue>
 #include <idfxx/sched>
 #include <idfxx/spi/master>
 
@@ -13,7 +15,6 @@
 #include <chrono>
 #include <cstdint>
 #include <esp_lcd_panel_ops.h>
-#include <esp_lcd_touch.h>
 #include <vector>
 
 using namespace std::chrono_literals;
@@ -30,6 +31,7 @@ static constexpr auto PIN_LCD_DC = idfxx::gpio_9;
 static constexpr auto PIN_LCD_RST = idfxx::gpio_14;
 static constexpr auto PIN_BL = idfxx::gpio_15;
 static constexpr auto PIN_TOUCH_CS = idfxx::gpio_16;
+static constexpr auto PIN_TOUCH_INT = idfxx::gpio_7;
 
 static constexpr int DISPLAY_W = 240;
 static constexpr int DISPLAY_H = 320;
@@ -116,34 +118,26 @@ extern "C" void app_main() {
             {
                 .x_max = DISPLAY_W,
                 .y_max = DISPLAY_H,
+                .int_gpio = PIN_TOUCH_INT,
             }
         );
 
+        // --- Touch events: read only after the controller raises INT ---
+        idfxx::gpio::install_isr_service();
+        idfxx::queue<idfxx::lcd::touch_event> events(16);
+        idfxx::lcd::touch_input input(touch, {.queue = &events});
+
         auto* lcd_handle = panel.idf_handle();
-        auto* touch_handle = touch.idf_handle();
 
         clear_screen(lcd_handle);
         logger.info("Touch the display to paint");
 
-        // --- Poll loop (skip redraws when the reported point hasn't moved) ---
-        uint16_t last_x = 0, last_y = 0;
-        bool have_last = false;
+        // --- Event loop (moves are reported only once the filtered point has moved) ---
         while (true) {
-            if (esp_lcd_touch_read_data(touch_handle) == ESP_OK) {
-                std::array<esp_lcd_touch_point_data_t, 1> data{};
-                uint8_t count = 0;
-                if (esp_lcd_touch_get_data(touch_handle, data.data(), &count, 1) == ESP_OK && count > 0) {
-                    if (!have_last || data[0].x != last_x || data[0].y != last_y) {
-                        draw_dot(lcd_handle, data[0].x, data[0].y, COLOR_FG);
-                        last_x = data[0].x;
-                        last_y = data[0].y;
-                        have_last = true;
-                    }
-                } else {
-                    have_last = false;
-                }
+            auto ev = events.receive();
+            if (ev.type != idfxx::lcd::touch_event::kind::release) {
+                draw_dot(lcd_handle, ev.x, ev.y, COLOR_FG);
             }
-            idfxx::delay(20ms);
         }
 
     } catch (const std::system_error& e) {
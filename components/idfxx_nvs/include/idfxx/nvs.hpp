@@ -13,20 +13,25 @@
  *
  * Provides NVS namespace lifecycle management with type-safe storage
  * for integers (8-64 bits), strings, and binary blobs. Features an
- * explicit commit model for atomic updates.
+ * explicit commit model for atomic updates, and a write-back cache that
+ * coalesces frequent updates into batched commits.
  *
- * Depends on @ref idfxx_core for error handling.
+ * Depends on @ref idfxx_core for error handling and @ref idfxx_timer for
+ * timed cache flushes.
  * @{
  */
 
 #include <idfxx/error>
 #include <idfxx/partition>
 
+#include <cstddef>
+#include <iterator>
 #include <span>
 #include <string_view>
 #include <vector>
 
 typedef uint32_t nvs_handle_t;
+struct nvs_opaque_iterator_t;
 typedef int esp_err_t;
 
 namespace idfxx {
@@ -102,6 +107,38 @@ public:
 
     class flash;
 
+    /**
+     * @brief Type of a stored value.
+     */
+    enum class entry_type : uint8_t {
+        // clang-format off
+        u8   = 0x01, /*!< uint8_t */
+        i8   = 0x11, /*!< int8_t */
+        u16  = 0x02, /*!< uint16_t */
+        i16  = 0x12, /*!< int16_t */
+        u32  = 0x04, /*!< uint32_t */
+        i32  = 0x14, /*!< int32_t */
+        u64  = 0x08, /*!< uint64_t */
+        i64  = 0x18, /*!< int64_t */
+        str  = 0x21, /*!< String */
+        blob = 0x42, /*!< Binary blob */
+        any  = 0xff, /*!< Any type; only meaningful as an iteration filter */
+        // clang-format on
+    };
+
+    /**
+     * @brief An entry visited by an entry_range.
+     *
+     * The key view is only valid until the iterator is advanced.
+     */
+    struct entry_info {
+        std::string_view key; ///< Key name.
+        entry_type type;      ///< Value type.
+        size_t size;          ///< Value size in bytes. For strings, includes the terminating NUL.
+    };
+
+    class entry_range;
+
 #ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
     /**
      * @brief Opens a NVS namespace.
@@ -234,6 +271,39 @@ public:
      */
     [[nodiscard]] std::vector<uint8_t> get_blob(std::string_view key) { return unwrap(try_get_blob(key)); }
 
+    /**
+     * @brief Retrieves a string into a caller-provided buffer, without allocating.
+     * @param key    Key name.
+     * @param buffer Destination, which must have room for the terminating NUL.
+     * @return A view of the string within @p buffer, excluding the NUL.
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on error.
+     */
+    [[nodiscard]] std::string_view get_string(std::string_view key, std::span<char> buffer) {
+        return unwrap(try_get_string(key, buffer));
+    }
+
+    /**
+     * @brief Retrieves binary data into a caller-provided buffer, without allocating.
+     * @param key    Key name.
+     * @param buffer Destination.
+     * @return The prefix of @p buffer holding the data.
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on error.
+     */
+    [[nodiscard]] std::span<uint8_t> get_blob(std::string_view key, std::span<uint8_t> buffer) {
+        return unwrap(try_get_blob(key, buffer));
+    }
+
+    /**
+     * @brief Returns a range over the entries in this namespace.
+     * @param type Only visit entries of this type.
+     * @return The entry range.
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on error.
+     */
+    [[nodiscard]] entry_range entries(entry_type type = entry_type::any) const;
+
     /**
      * @brief Stores an integer value.
      * @tparam T Integer type (8 to 64 bits, signed or unsigned).
@@ -321,6 +391,55 @@ public:
      */
     [[nodiscard]] result<std::vector<uint8_t>> try_get_blob(std::string_view key);
 
+    /**
+     * @brief Retrieves a string into a caller-provided buffer, without allocating.
+     *
+     * Reads the value with a single lookup, unlike try_get_string(std::string_view),
+     * which first queries the length.
+     *
+     * @param key    Key name.
+     * @param buffer Destination, which must have room for the terminating NUL.
+     * @return A view of the string within @p buffer, excluding the NUL, or an error.
+     * @retval idfxx::nvs::errc::invalid_length if @p buffer is too small.
+     */
+    [[nodiscard]] result<std::string_view> try_get_string(std::string_view key, std::span<char> buffer);
+
+    /**
+     * @brief Retrieves binary data into a caller-provided buffer, without allocating.
+     *
+     * Reads the value with a single lookup, unlike try_get_blob(std::string_view),
+     * which first queries the length.
+     *
+     * @param key    Key name.
+     * @param buffer Destination.
+     * @return The prefix of @p buffer holding the data, or an error.
+     * @retval idfxx::nvs::errc::invalid_length if @p buffer is too small.
+     */
+    [[nodiscard]] result<std::span<uint8_t>> try_get_blob(std::string_view key, std::span<uint8_t> buffer);
+
+    /**
+     * @brief Returns a range over the entries in this namespace.
+     *
+     * Visiting entries performs no heap allocation beyond the single iterator
+     * ESP-IDF allocates when the walk starts.
+     *
+     * @code
+     * char buf[64];
+     * auto entries = ns.try_entries(idfxx::nvs::entry_type::str);
+     * if (entries) {
+     *     for (auto e : *entries) {
+     *         if (e.size <= sizeof(buf)) {
+     *             apply(e.key, ns.try_get_string(e.key, buf).value());
+     *         }
+     *     }
+     * }
+     * @endcode
+     *
+     * @param type Only visit entries of this type.
+     * @return The entry range, or an error.
+     */
+    [[nodiscard]] result<entry_range> try_entries(entry_type type = entry_type::any) const;
+
     /**
      * @brief Stores an integer value.
      * @tparam T Integer type (8 to 64 bits, signed or unsigned).
@@ -376,6 +495,81 @@ private:
  */
 [[nodiscard]] std::unexpected<std::error_code> nvs_error(esp_err_t e);
 
+/**
+ * @headerfile <idfxx/nvs>
+ * @brief Single-pass range over the entries of an NVS namespace.
+ *
+ * Obtained from nvs::try_entries(). Iterators are input iterators; the
+ * range may only be traversed once, and must outlive its iterators.
+ * Entries must not be added or erased during the walk.
+ *
+ * This type is non-copyable and move-only.
+ */
+class nvs::entry_range {
+public:
+    /**
+     * @brief Input iterator over the entries of a range.
+     */
+    class iterator {
+    public:
+        using value_type = entry_info;
+        using difference_type = std::ptrdiff_t;
+        using iterator_concept = std::input_iterator_tag;
+
+        iterator() = default;
+
+        /** @brief Returns the current entry. */
+        [[nodiscard]] entry_info operator*() const { return _range->_current; }
+
+        /** @brief Advances to the next entry. */
+        iterator& operator++() {
+            _range->advance();
+            return *this;
+        }
+
+        /** @brief Advances to the next entry. */
+        void operator++(int) { _range->advance(); }
+
+        /** @brief Returns true once the walk is complete. */
+        [[nodiscard]] bool operator==(std::default_sentinel_t) const noexcept { return _range->_it == nullptr; }
+
+    private:
+        friend class entry_range;
+        explicit iterator(entry_range* range) noexcept
+            : _range(range) {}
+
+        entry_range* _range = nullptr;
+    };
+
+    ~entry_range();
+
+    entry_range(const entry_range&) = delete;
+    entry_range& operator=(const entry_range&) = delete;
+
+    /** @brief Move constructor. */
+    entry_range(entry_range&& other) noexcept;
+
+    /** @brief Move assignment. */
+    entry_range& operator=(entry_range&& other) noexcept;
+
+    /** @brief Returns an iterator to the current entry. */
+    [[nodiscard]] iterator begin() noexcept { return iterator{this}; }
+
+    /** @brief Returns the end sentinel. */
+    [[nodiscard]] std::default_sentinel_t end() const noexcept { return {}; }
+
+private:
+    friend class nvs;
+    entry_range(nvs_handle_t handle, nvs_opaque_iterator_t* it);
+    void load();
+    void advance();
+
+    nvs_handle_t _handle;
+    nvs_opaque_iterator_t* _it;
+    char _key[16] = {};
+    entry_info _current{};
+};
+
 class nvs::flash {
 public:
     constexpr static size_t key_size = 32; /*!< Size of each NVS encryption key in bytes */
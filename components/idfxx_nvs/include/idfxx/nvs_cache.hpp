@@ -0,0 +1,350 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+#pragma once
+
+/**
+ * @headerfile <idfxx/nvs_cache>
+ * @file nvs_cache.hpp
+ * @brief Write-back cache over an NVS namespace.
+ *
+ * @addtogroup idfxx_nvs
+ * @{
+ */
+
+#include <idfxx/error>
+#include <idfxx/nvs>
+#include <idfxx/partition>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace idfxx {
+
+/**
+ * @headerfile <idfxx/nvs_cache>
+ * @brief Write-back cache over an NVS namespace.
+ *
+ * Reads are served from RAM once a key has been loaded, including reads of
+ * keys known to be absent. Writes and erases update the cache and mark the
+ * key dirty; dirty keys are written to flash together, with a single commit,
+ * when any of the following happens:
+ *
+ * - the flush delay elapses with no further writes (the delay restarts on
+ *   every write, so bursts of updates coalesce into one flush),
+ * - the number of dirty keys reaches config::max_dirty, in which case the
+ *   write that reached the bound flushes before returning,
+ * - sync() is called,
+ * - the chip restarts via esp_restart() (a shutdown handler flushes every
+ *   live cache), or
+ * - the cache is destroyed.
+ *
+ * If a flush fails, the keys it could not write stay dirty and are retried
+ * by the next flush. While config::max_dirty keys remain dirty, a write that
+ * would add another dirty key retries the flush first and, if that still
+ * leaves the bound reached, returns its error without changing the cache;
+ * rewriting a key that is already dirty is always accepted.
+ *
+ * Timed flushes run on the esp_timer task. A write lost to power failure
+ * before a flush is simply absent after reboot; each flushed batch is
+ * applied key by key, as with direct nvs writes.
+ *
+ * The cache assumes it is the only writer to its namespace: changes made
+ * through another handle after a key has been cached are not observed.
+ * All member functions are thread-safe.
+ *
+ * This type is non-copyable and move-only. A moved-from
+ * object must not be used: any operation other than destruction or
+ * assignment is undefined behavior.
+ *
+ * @code
+ * idfxx::nvs_cache settings("settings", {.flush_delay = 2s});
+ *
+ * // Called on every slider change; coalesced into one flash commit.
+ * settings.set_value<uint8_t>("brightness", level);
+ * @endcode
+ */
+class nvs_cache {
+public:
+    /**
+     * @brief Cache configuration.
+     */
+    struct config {
+        /** @brief Quiet period after the last write before dirty keys are flushed. Zero disables timed flushes. */
+        std::chrono::milliseconds flush_delay{1000};
+        /** @brief Number of dirty keys at which a write flushes immediately. Must be at least 1. */
+        size_t max_dirty = 16;
+        /** @brief Flush this cache from a shutdown handler when the chip restarts. */
+        bool flush_on_shutdown = true;
+    };
+
+#ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
+    /**
+     * @brief Opens a cached NVS namespace.
+     *
+     * @param namespace_name Namespace name (max 15 characters).
+     * @param cfg            Cache configuration; `{}` for the defaults.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on failure.
+     */
+    [[nodiscard]] explicit nvs_cache(std::string_view namespace_name, config cfg);
+
+    /**
+     * @brief Opens a cached NVS namespace on a specific partition.
+     *
+     * @param part           The partition to open NVS storage from.
+     * @param namespace_name Namespace name (max 15 characters).
+     * @param cfg            Cache configuration; `{}` for the defaults.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on failure.
+     */
+    [[nodiscard]] explicit nvs_cache(const partition& part, std::string_view namespace_name, config cfg);
+#endif
+
+    /**
+     * @brief Opens a cached NVS namespace.
+     *
+     * @param namespace_name Namespace name (max 15 characters).
+     * @param cfg            Cache configuration; `{}` for the defaults.
+     *
+     * @return The new cache, or an error.
+     * @retval idfxx::errc::invalid_arg if `cfg.max_dirty` is zero.
+     */
+    [[nodiscard]] static result<nvs_cache> make(std::string_view namespace_name, config cfg);
+
+    /**
+     * @brief Opens a cached NVS namespace on a specific partition.
+     *
+     * @param part           The partition to open NVS storage from.
+     * @param namespace_name Namespace name (max 15 characters).
+     * @param cfg            Cache configuration; `{}` for the defaults.
+     *
+     * @return The new cache, or an error.
+     * @retval idfxx::errc::invalid_arg if `cfg.max_dirty` is zero.
+     */
+    [[nodiscard]] static result<nvs_cache>
+    make(const partition& part, std::string_view namespace_name, config cfg);
+
+    /**
+     * @brief Flushes dirty keys and closes the namespace.
+     *
+     * Flush errors are logged and otherwise ignored; call sync() first to
+     * observe them.
+     */
+    ~nvs_cache();
+
+    nvs_cache(const nvs_cache&) = delete;
+    nvs_cache& operator=(const nvs_cache&) = delete;
+
+    /** @brief Move constructor. */
+    nvs_cache(nvs_cache&& other) noexcept;
+
+    /** @brief Move assignment. Flushes and closes the current namespace first. */
+    nvs_cache& operator=(nvs_cache&& other) noexcept;
+
+    /** @brief Returns the number of keys written or erased since the last flush. */
+    [[nodiscard]] size_t dirty_count() const;
+
+#ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
+    /**
+     * @brief Writes all dirty keys to flash and commits.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on failure.
+     */
+    void sync() { unwrap(try_sync()); }
+
+    /**
+     * @brief Erases a key.
+     *
+     * @param key Key name (max 15 characters).
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on failure.
+     */
+    void erase(std::string_view key) { unwrap(try_erase(key)); }
+
+    /**
+     * @brief Sets a string value.
+     *
+     * @param key   Key name (max 15 characters).
+     * @param value String value.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on failure.
+     */
+    void set_string(std::string_view key, std::string_view value) { unwrap(try_set_string(key, value)); }
+
+    /**
+     * @brief Gets a string value.
+     *
+     * @param key Key name.
+     * @return The string value.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on failure.
+     */
+    [[nodiscard]] std::string get_string(std::string_view key) { return unwrap(try_get_string(key)); }
+
+    /**
+     * @brief Sets a blob value.
+     *
+     * @param key  Key name (max 15 characters).
+     * @param data Blob data.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on failure.
+     */
+    void set_blob(std::string_view key, std::span<const uint8_t> data) { unwrap(try_set_blob(key, data)); }
+
+    /**
+     * @brief Gets a blob value.
+     *
+     * @param key Key name.
+     * @return The blob data.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on failure.
+     */
+    [[nodiscard]] std::vector<uint8_t> get_blob(std::string_view key) { return unwrap(try_get_blob(key)); }
+
+    /**
+     * @brief Sets an integer value.
+     *
+     * @tparam T Integer type (8 to 64 bits).
+     * @param key   Key name (max 15 characters).
+     * @param value Value to store.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on failure.
+     */
+    template<typename T>
+        requires sized_integral<T>
+    void set_value(std::string_view key, T value) {
+        unwrap(try_set_value(key, value));
+    }
+
+    /**
+     * @brief Gets an integer value.
+     *
+     * @tparam T Integer type (8 to 64 bits).
+     * @param key Key name.
+     * @return The stored value.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on failure.
+     */
+    template<typename T>
+        requires sized_integral<T>
+    [[nodiscard]] T get_value(std::string_view key) {
+        return unwrap(try_get_value<T>(key));
+    }
+#endif
+
+    /**
+     * @brief Writes all dirty keys to flash and commits.
+     *
+     * Keys that fail to write stay dirty, so a later flush retries them.
+     *
+     * @return Success, or an error.
+     */
+    [[nodiscard]] result<void> try_sync();
+
+    /**
+     * @brief Erases a key.
+     *
+     * Unlike nvs::try_erase(), erasing a key that does not exist is not an error.
+     *
+     * @param key Key name (max 15 characters).
+     * @return Success, or an error.
+     * @retval idfxx::nvs::errc::key_too_long if the key name is too long.
+     */
+    [[nodiscard]] result<void> try_erase(std::string_view key);
+
+    /**
+     * @brief Sets a string value.
+     *
+     * @param key   Key name (max 15 characters).
+     * @param value String value.
+     * @return Success, or an error.
+     * @retval idfxx::nvs::errc::key_too_long if the key name is too long.
+     */
+    [[nodiscard]] result<void> try_set_string(std::string_view key, std::string_view value);
+
+    /**
+     * @brief Gets a string value.
+     *
+     * @param key Key name.
+     * @return The string value, or an error.
+     * @retval idfxx::nvs::errc::not_found if the key does not exist.
+     * @retval idfxx::nvs::errc::type_mismatch if the key holds a different type.
+     */
+    [[nodiscard]] result<std::string> try_get_string(std::string_view key);
+
+    /**
+     * @brief Sets a blob value.
+     *
+     * @param key  Key name (max 15 characters).
+     * @param data Blob data.
+     * @return Success, or an error.
+     * @retval idfxx::nvs::errc::key_too_long if the key name is too long.
+     */
+    [[nodiscard]] result<void> try_set_blob(std::string_view key, std::span<const uint8_t> data);
+
+    /**
+     * @brief Gets a blob value.
+     *
+     * @param key Key name.
+     * @return The blob data, or an error.
+     * @retval idfxx::nvs::errc::not_found if the key does not exist.
+     * @retval idfxx::nvs::errc::type_mismatch if the key holds a different type.
+     */
+    [[nodiscard]] result<std::vector<uint8_t>> try_get_blob(std::string_view key);
+
+    /**
+     * @brief Sets an integer value.
+     *
+     * @tparam T Integer type (8 to 64 bits).
+     * @param key   Key name (max 15 characters).
+     * @param value Value to store.
+     * @return Success, or an error.
+     * @retval idfxx::nvs::errc::key_too_long if the key name is too long.
+     */
+    template<typename T>
+        requires sized_integral<T>
+    [[nodiscard]] result<void> try_set_value(std::string_view key, T value);
+
+    /**
+     * @brief Gets an integer value.
+     *
+     * @tparam T Integer type (8 to 64 bits).
+     * @param key Key name.
+     * @return The stored value, or an error.
+     * @retval idfxx::nvs::errc::not_found if the key does not exist.
+     * @retval idfxx::nvs::errc::type_mismatch if the key holds a different type.
+     */
+    template<typename T>
+        requires sized_integral<T>
+    [[nodiscard]] result<T> try_get_value(std::string_view key);
+
+private:
+    /// @cond INTERNAL
+    struct state;
+    static result<nvs_cache> open(result<nvs> handle, config cfg);
+    explicit nvs_cache(std::unique_ptr<state> s) noexcept;
+    /// @endcond
+
+    std::unique_ptr<state> _state;
+};
+
+} // namespace idfxx
+
+/** @} */ // end of idfxx_nvs
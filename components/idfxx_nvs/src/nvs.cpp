@@ -9,6 +9,7 @@
 #include <esp_system.h>
 #include <nvs.h>
 #include <nvs_flash.h>
+#include <cstring>
 #include <utility>
 
 // Verify error codes match ESP-IDF constants
@@ -39,6 +40,19 @@ static_assert(std::to_underlying(idfxx::nvs::errc::wrong_encryption) == ESP_ERR_
 // Verify key size matches ESP-IDF constant
 static_assert(idfxx::nvs::flash::key_size == NVS_KEY_SIZE);
 
+// Verify entry types match ESP-IDF constants
+static_assert(std::to_underlying(idfxx::nvs::entry_type::u8) == NVS_TYPE_U8);
+static_assert(std::to_underlying(idfxx::nvs::entry_type::i8) == NVS_TYPE_I8);
+static_assert(std::to_underlying(idfxx::nvs::entry_type::u16) == NVS_TYPE_U16);
+static_assert(std::to_underlying(idfxx::nvs::entry_type::i16) == NVS_TYPE_I16);
+static_assert(std::to_underlying(idfxx::nvs::entry_type::u32) == NVS_TYPE_U32);
+static_assert(std::to_underlying(idfxx::nvs::entry_type::i32) == NVS_TYPE_I32);
+static_assert(std::to_underlying(idfxx::nvs::entry_type::u64) == NVS_TYPE_U64);
+static_assert(std::to_underlying(idfxx::nvs::entry_type::i64) == NVS_TYPE_I64);
+static_assert(std::to_underlying(idfxx::nvs::entry_type::str) == NVS_TYPE_STR);
+static_assert(std::to_underlying(idfxx::nvs::entry_type::blob) == NVS_TYPE_BLOB);
+static_assert(std::to_underlying(idfxx::nvs::entry_type::any) == NVS_TYPE_ANY);
+
 namespace {
 const char* TAG = "idfxx::nvs";
 }
@@ -121,6 +135,24 @@ std::unexpected<std::error_code> nvs_error(esp_err_t e) {
     return error(e);
 }
 
+// NVS keys are short, so they are NUL-terminated in a stack buffer rather
+// than copied into a std::string on every call.
+struct key_buffer {
+    char str[NVS_KEY_NAME_MAX_SIZE];
+
+    [[nodiscard]] const char* c_str() const noexcept { return str; }
+};
+
+static result<key_buffer> make_key(std::string_view key) {
+    if (key.size() >= NVS_KEY_NAME_MAX_SIZE) {
+        return error(nvs::errc::key_too_long);
+    }
+    key_buffer k;
+    std::memcpy(k.str, key.data(), key.size());
+    k.str[key.size()] = '\0';
+    return k;
+}
+
 static result<void> guard_write(nvs_handle_t handle, bool read_only) {
     if (handle == 0) {
         return error(nvs::errc::invalid_handle);
@@ -231,11 +263,14 @@ result<void> nvs::try_erase(std::string_view key) {
     if (auto r = guard_write(_handle, _read_only); !r) {
         return r;
     }
-    std::string key_str{key};
-    esp_err_t err = nvs_erase_key(_handle, key_str.c_str());
+    auto key_str = make_key(key);
+    if (!key_str) {
+        return error(key_str.error());
+    }
+    esp_err_t err = nvs_erase_key(_handle, key_str->c_str());
     if (err != ESP_OK) {
         if (err != ESP_ERR_NVS_NOT_FOUND) {
-            ESP_LOGD(TAG, "Failed to erase key '%s': %s", key_str.c_str(), esp_err_to_name(err));
+            ESP_LOGD(TAG, "Failed to erase key '%s': %s", key_str->c_str(), esp_err_to_name(err));
         }
         return nvs_error(err);
     }
@@ -258,11 +293,14 @@ result<void> nvs::try_set_string(std::string_view key, std::string_view value) {
     if (auto r = guard_write(_handle, _read_only); !r) {
         return r;
     }
-    std::string key_str{key};
+    auto key_str = make_key(key);
+    if (!key_str) {
+        return error(key_str.error());
+    }
     std::string value_str{value};
-    esp_err_t err = nvs_set_str(_handle, key_str.c_str(), value_str.c_str());
+    esp_err_t err = nvs_set_str(_handle, key_str->c_str(), value_str.c_str());
     if (err != ESP_OK) {
-        ESP_LOGD(TAG, "Failed to set string key '%s': %s", key_str.c_str(), esp_err_to_name(err));
+        ESP_LOGD(TAG, "Failed to set string key '%s': %s", key_str->c_str(), esp_err_to_name(err));
         return nvs_error(err);
     }
     return {};
@@ -272,23 +310,26 @@ result<std::string> nvs::try_get_string(std::string_view key) {
     if (_handle == 0) {
         return error(nvs::errc::invalid_handle);
     }
-    std::string key_str{key};
+    auto key_str = make_key(key);
+    if (!key_str) {
+        return error(key_str.error());
+    }
 
     // First, get the required size
     size_t required_size = 0;
-    esp_err_t err = nvs_get_str(_handle, key_str.c_str(), nullptr, &required_size);
+    esp_err_t err = nvs_get_str(_handle, key_str->c_str(), nullptr, &required_size);
     if (err != ESP_OK) {
         if (err != ESP_ERR_NVS_NOT_FOUND) {
-            ESP_LOGD(TAG, "Failed to get string key '%s': %s", key_str.c_str(), esp_err_to_name(err));
+            ESP_LOGD(TAG, "Failed to get string key '%s': %s", key_str->c_str(), esp_err_to_name(err));
         }
         return nvs_error(err);
     }
 
     // Allocate buffer and get the string
     std::string value(required_size - 1, '\0'); // -1 for null terminator
-    err = nvs_get_str(_handle, key_str.c_str(), value.data(), &required_size);
+    err = nvs_get_str(_handle, key_str->c_str(), value.data(), &required_size);
     if (err != ESP_OK) {
-        ESP_LOGD(TAG, "Failed to get string key '%s': %s", key_str.c_str(), esp_err_to_name(err));
+        ESP_LOGD(TAG, "Failed to get string key '%s': %s", key_str->c_str(), esp_err_to_name(err));
         return nvs_error(err);
     }
 
@@ -299,10 +340,13 @@ result<void> nvs::try_set_blob(std::string_view key, const void* data, size_t le
     if (auto r = guard_write(_handle, _read_only); !r) {
         return r;
     }
-    std::string key_str{key};
-    esp_err_t err = nvs_set_blob(_handle, key_str.c_str(), data, length);
+    auto key_str = make_key(key);
+    if (!key_str) {
+        return error(key_str.error());
+    }
+    esp_err_t err = nvs_set_blob(_handle, key_str->c_str(), data, length);
     if (err != ESP_OK) {
-        ESP_LOGD(TAG, "Failed to set blob key '%s': %s", key_str.c_str(), esp_err_to_name(err));
+        ESP_LOGD(TAG, "Failed to set blob key '%s': %s", key_str->c_str(), esp_err_to_name(err));
         return nvs_error(err);
     }
     return {};
@@ -316,28 +360,171 @@ result<std::vector<uint8_t>> nvs::try_get_blob(std::string_view key) {
     if (_handle == 0) {
         return error(nvs::errc::invalid_handle);
     }
-    std::string key_str{key};
+    auto key_str = make_key(key);
+    if (!key_str) {
+        return error(key_str.error());
+    }
 
     // First, get the required size
     size_t required_size = 0;
-    esp_err_t err = nvs_get_blob(_handle, key_str.c_str(), nullptr, &required_size);
+    esp_err_t err = nvs_get_blob(_handle, key_str->c_str(), nullptr, &required_size);
     if (err != ESP_OK) {
         if (err != ESP_ERR_NVS_NOT_FOUND) {
-            ESP_LOGD(TAG, "Failed to get blob key '%s': %s", key_str.c_str(), esp_err_to_name(err));
+            ESP_LOGD(TAG, "Failed to get blob key '%s': %s", key_str->c_str(), esp_err_to_name(err));
         }
         return nvs_error(err);
     }
 
     // Allocate buffer and get the blob
     std::vector<uint8_t> value(required_size);
-    err = nvs_get_blob(_handle, key_str.c_str(), value.data(), &required_size);
+    err = nvs_get_blob(_handle, key_str->c_str(), value.data(), &required_size);
     if (err != ESP_OK) {
-        ESP_LOGD(TAG, "Failed to get blob key '%s': %s", key_str.c_str(), esp_err_to_name(err));
+        ESP_LOGD(TAG, "Failed to get blob key '%s': %s", key_str->c_str(), esp_err_to_name(err));
         return nvs_error(err);
     }
     return value;
 }
 
+result<std::string_view> nvs::try_get_string(std::string_view key, std::span<char> buffer) {
+    if (_handle == 0) {
+        return error(nvs::errc::invalid_handle);
+    }
+    auto key_str = make_key(key);
+    if (!key_str) {
+        return error(key_str.error());
+    }
+    // A null destination would turn the read into a length query
+    if (buffer.empty()) {
+        return error(nvs::errc::invalid_length);
+    }
+    size_t length = buffer.size();
+    esp_err_t err = nvs_get_str(_handle, key_str->c_str(), buffer.data(), &length);
+    if (err != ESP_OK) {
+        if (err != ESP_ERR_NVS_NOT_FOUND) {
+            ESP_LOGD(TAG, "Failed to get string key '%s': %s", key_str->c_str(), esp_err_to_name(err));
+        }
+        return nvs_error(err);
+    }
+    return std::string_view{buffer.data(), length - 1}; // -1 for null terminator
+}
+
+result<std::span<uint8_t>> nvs::try_get_blob(std::string_view key, std::span<uint8_t> buffer) {
+    if (_handle == 0) {
+        return error(nvs::errc::invalid_handle);
+    }
+    auto key_str = make_key(key);
+    if (!key_str) {
+        return error(key_str.error());
+    }
+    size_t length = buffer.size();
+    esp_err_t err = nvs_get_blob(_handle, key_str->c_str(), buffer.data(), &length);
+    // With an empty buffer the destination may be null, which makes the call a length query
+    if (err == ESP_OK && length > buffer.size()) {
+        err = ESP_ERR_NVS_INVALID_LENGTH;
+    }
+    if (err != ESP_OK) {
+        if (err != ESP_ERR_NVS_NOT_FOUND) {
+            ESP_LOGD(TAG, "Failed to get blob key '%s': %s", key_str->c_str(), esp_err_to_name(err));
+        }
+        return nvs_error(err);
+    }
+    return buffer.first(length);
+}
+
+result<nvs::entry_range> nvs::try_entries(entry_type type) const {
+    if (_handle == 0) {
+        return error(nvs::errc::invalid_handle);
+    }
+    nvs_iterator_t it = nullptr;
+    esp_err_t err = nvs_entry_find_in_handle(_handle, static_cast<nvs_type_t>(type), &it);
+    if (err == ESP_ERR_NVS_NOT_FOUND) {
+        return entry_range{_handle, nullptr};
+    }
+    if (err != ESP_OK) {
+        ESP_LOGD(TAG, "Failed to iterate entries: %s", esp_err_to_name(err));
+        return nvs_error(err);
+    }
+    return entry_range{_handle, it};
+}
+
+#ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
+nvs::entry_range nvs::entries(entry_type type) const {
+    return unwrap(try_entries(type));
+}
+#endif
+
+nvs::entry_range::entry_range(nvs_handle_t handle, nvs_opaque_iterator_t* it)
+    : _handle(handle)
+    , _it(it) {
+    load();
+}
+
+nvs::entry_range::entry_range(entry_range&& other) noexcept
+    : _handle(other._handle)
+    , _it(std::exchange(other._it, nullptr))
+    , _current(other._current) {
+    std::memcpy(_key, other._key, sizeof(_key));
+    _current.key = {_key, _current.key.size()};
+}
+
+nvs::entry_range& nvs::entry_range::operator=(entry_range&& other) noexcept {
+    if (this != &other) {
+        nvs_release_iterator(_it);
+        _handle = other._handle;
+        _it = std::exchange(other._it, nullptr);
+        std::memcpy(_key, other._key, sizeof(_key));
+        _current = other._current;
+        _current.key = {_key, _current.key.size()};
+    }
+    return *this;
+}
+
+nvs::entry_range::~entry_range() {
+    nvs_release_iterator(_it);
+}
+
+void nvs::entry_range::load() {
+    if (_it == nullptr) {
+        return;
+    }
+    nvs_entry_info_t info;
+    nvs_entry_info(_it, &info);
+    static_assert(sizeof(_key) == sizeof(info.key));
+    std::memcpy(_key, info.key, sizeof(_key));
+    _key[sizeof(_key) - 1] = '\0';
+
+    size_t size = 0;
+    switch (info.type) {
+    case NVS_TYPE_STR:
+        nvs_get_str(_handle, _key, nullptr, &size);
+        break;
+    case NVS_TYPE_BLOB:
+        nvs_get_blob(_handle, _key, nullptr, &size);
+        break;
+    default:
+        // Integer type codes carry their width in bytes in the low nibble
+        size = info.type & 0x0f;
+        break;
+    }
+    _current = {std::string_view{_key}, static_cast<entry_type>(info.type), size};
+}
+
+void nvs::entry_range::advance() {
+    esp_err_t err = nvs_entry_next(&_it);
+    if (err != ESP_OK) {
+        if (err != ESP_ERR_NVS_NOT_FOUND) {
+            ESP_LOGD(TAG, "Failed to advance entry iterator: %s", esp_err_to_name(err));
+        }
+        // nvs_entry_next releases the iterator when the walk ends
+        if (_it != nullptr) {
+            nvs_release_iterator(_it);
+            _it = nullptr;
+        }
+        return;
+    }
+    load();
+}
+
 // Traits mapping each integer type to its NVS get/set functions
 template<typename T>
 struct nvs_ops;
@@ -358,10 +545,13 @@ result<void> nvs::try_set_value(std::string_view key, T value) {
     if (auto r = guard_write(_handle, _read_only); !r) {
         return r;
     }
-    std::string key_str{key};
-    esp_err_t err = nvs_ops<T>::set(_handle, key_str.c_str(), value);
+    auto key_str = make_key(key);
+    if (!key_str) {
+        return error(key_str.error());
+    }
+    esp_err_t err = nvs_ops<T>::set(_handle, key_str->c_str(), value);
     if (err != ESP_OK) {
-        ESP_LOGD(TAG, "Failed to set key '%s': %s", key_str.c_str(), esp_err_to_name(err));
+        ESP_LOGD(TAG, "Failed to set key '%s': %s", key_str->c_str(), esp_err_to_name(err));
         return nvs_error(err);
     }
     return {};
@@ -373,12 +563,15 @@ result<T> nvs::try_get_value(std::string_view key) {
     if (_handle == 0) {
         return error(nvs::errc::invalid_handle);
     }
-    std::string key_str{key};
+    auto key_str = make_key(key);
+    if (!key_str) {
+        return error(key_str.error());
+    }
     T value;
-    esp_err_t err = nvs_ops<T>::get(_handle, key_str.c_str(), &value);
+    esp_err_t err = nvs_ops<T>::get(_handle, key_str->c_str(), &value);
     if (err != ESP_OK) {
         if (err != ESP_ERR_NVS_NOT_FOUND) {
-            ESP_LOGD(TAG, "Failed to get key '%s': %s", key_str.c_str(), esp_err_to_name(err));
+            ESP_LOGD(TAG, "Failed to get key '%s': %s", key_str->c_str(), esp_err_to_name(err));
         }
         return nvs_error(err);
     }
@@ -0,0 +1,421 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+#include <idfxx/error>
+#include <idfxx/nvs_cache>
+#include <idfxx/system>
+#include <idfxx/timer>
+
+#include <algorithm>
+#include <cstring>
+#include <esp_log.h>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace {
+const char* TAG = "idfxx::nvs_cache";
+}
+
+namespace idfxx {
+
+namespace {
+
+// Maximum key length accepted by NVS, excluding the terminator.
+constexpr size_t max_key_length = 15;
+
+enum class kind : uint8_t { u8, i8, u16, i16, u32, i32, u64, i64, string, blob };
+
+template<typename T>
+constexpr kind kind_of() {
+    // clang-format off
+    if constexpr (std::same_as<T, uint8_t>)  return kind::u8;
+    if constexpr (std::same_as<T, int8_t>)   return kind::i8;
+    if constexpr (std::same_as<T, uint16_t>) return kind::u16;
+    if constexpr (std::same_as<T, int16_t>)  return kind::i16;
+    if constexpr (std::same_as<T, uint32_t>) return kind::u32;
+    if constexpr (std::same_as<T, int32_t>)  return kind::i32;
+    if constexpr (std::same_as<T, uint64_t>) return kind::u64;
+    if constexpr (std::same_as<T, int64_t>)  return kind::i64;
+    // clang-format on
+}
+
+// A cached key. A clean entry that is not present records a lookup of type
+// `type` that found nothing; a dirty one that is not present is a pending erase.
+struct entry {
+    kind type;
+    bool present = false;
+    bool dirty = false;
+    bool retyped = false; // flash holds the key as another type; erase it before writing
+    std::vector<uint8_t> data;
+};
+
+template<typename T>
+std::vector<uint8_t> to_bytes(T value) {
+    std::vector<uint8_t> bytes(sizeof(T));
+    std::memcpy(bytes.data(), &value, sizeof(T));
+    return bytes;
+}
+
+template<typename T>
+T from_bytes(const std::vector<uint8_t>& bytes) {
+    T value;
+    std::memcpy(&value, bytes.data(), sizeof(T));
+    return value;
+}
+
+result<void> write_entry(nvs& handle, std::string_view key, const entry& e) {
+    if (!e.present || e.retyped) {
+        if (auto r = handle.try_erase(key); !r && r.error() != nvs::errc::not_found) {
+            return r;
+        }
+        if (!e.present) {
+            return {};
+        }
+    }
+    switch (e.type) {
+    case kind::u8:
+        return handle.try_set_value(key, from_bytes<uint8_t>(e.data));
+    case kind::i8:
+        return handle.try_set_value(key, from_bytes<int8_t>(e.data));
+    case kind::u16:
+        return handle.try_set_value(key, from_bytes<uint16_t>(e.data));
+    case kind::i16:
+        return handle.try_set_value(key, from_bytes<int16_t>(e.data));
+    case kind::u32:
+        return handle.try_set_value(key, from_bytes<uint32_t>(e.data));
+    case kind::i32:
+        return handle.try_set_value(key, from_bytes<int32_t>(e.data));
+    case kind::u64:
+        return handle.try_set_value(key, from_bytes<uint64_t>(e.data));
+    case kind::i64:
+        return handle.try_set_value(key, from_bytes<int64_t>(e.data));
+    case kind::string:
+        return handle.try_set_string(key, {reinterpret_cast<const char*>(e.data.data()), e.data.size()});
+    case kind::blob:
+        return handle.try_set_blob(key, std::span<const uint8_t>{e.data});
+    }
+    return error(errc::invalid_state);
+}
+
+} // namespace
+
+struct nvs_cache::state {
+    state(nvs h, config c)
+        : handle(std::move(h))
+        , cfg(c) {}
+
+    nvs handle;
+    config cfg;
+    std::mutex mutex;
+    std::map<std::string, entry, std::less<>> entries;
+    size_t dirty = 0;
+    // Declared last so it is destroyed first: the timer's destructor waits for
+    // an in-flight flush, which still needs the members above.
+    std::optional<timer> flush_timer;
+
+    // Live caches, walked by the shutdown handler. Lock order is registry, then state.
+    static std::mutex& registry_mutex() {
+        static std::mutex m;
+        return m;
+    }
+    static std::vector<state*>& registry() {
+        static std::vector<state*> r;
+        return r;
+    }
+
+    static void on_shutdown() {
+        std::lock_guard registry_lock{registry_mutex()};
+        for (auto* s : registry()) {
+            if (!s->cfg.flush_on_shutdown) {
+                continue;
+            }
+            std::lock_guard lock{s->mutex};
+            if (auto r = s->flush(); !r) {
+                ESP_LOGW(TAG, "Flush on shutdown failed: %s", r.error().message().c_str());
+            }
+        }
+    }
+
+    void attach() {
+        std::lock_guard registry_lock{registry_mutex()};
+        static bool handler_registered = false;
+        if (!handler_registered) {
+            if (auto r = try_register_shutdown_handler(&on_shutdown); r) {
+                handler_registered = true;
+            } else {
+                ESP_LOGW(TAG, "Failed to register shutdown handler: %s", r.error().message().c_str());
+            }
+        }
+        registry().push_back(this);
+    }
+
+    // Detaches from the shutdown handler and timer, then flushes what is left.
+    void close() {
+        {
+            std::lock_guard registry_lock{registry_mutex()};
+            std::erase(registry(), this);
+        }
+        flush_timer.reset();
+        std::lock_guard lock{mutex};
+        if (auto r = flush(); !r) {
+            ESP_LOGW(TAG, "Flush on close failed: %s", r.error().message().c_str());
+        }
+    }
+
+    // Requires `mutex` to be held.
+    result<void> flush() {
+        if (dirty == 0) {
+            return {};
+        }
+        result<void> status{};
+        size_t written = 0;
+        for (auto& [key, e] : entries) {
+            if (!e.dirty) {
+                continue;
+            }
+            if (auto r = write_entry(handle, key, e); !r) {
+                ESP_LOGD(TAG, "Failed to flush key '%s': %s", key.c_str(), r.error().message().c_str());
+                if (status) {
+                    status = r;
+                }
+                continue;
+            }
+            e.dirty = false;
+            e.retyped = false;
+            --dirty;
+            ++written;
+        }
+        if (written > 0) {
+            if (auto r = handle.try_commit(); !r && status) {
+                status = r;
+            }
+        }
+        ESP_LOGD(TAG, "Flushed %zu keys, %zu still dirty", written, dirty);
+        return status;
+    }
+
+    // Requires `mutex` to be held.
+    result<void> store(std::string_view key, kind type, bool present, std::vector<uint8_t> data) {
+        if (key.size() > max_key_length) {
+            return error(nvs::errc::key_too_long);
+        }
+        auto it = entries.find(key);
+        if ((it == entries.end() || !it->second.dirty) && dirty >= cfg.max_dirty) {
+            // An earlier flush failed and left the bound reached. Retry it, and
+            // refuse to grow the dirty set past the bound while it keeps failing.
+            if (auto r = flush(); !r && dirty >= cfg.max_dirty) {
+                return r;
+            }
+        }
+        if (it == entries.end()) {
+            it = entries.emplace(std::string{key}, entry{.type = type, .data = {}}).first;
+        }
+        auto& e = it->second;
+        if (e.type != type && (e.present || e.dirty)) {
+            e.retyped = true;
+        }
+        e.type = type;
+        e.present = present;
+        e.data = std::move(data);
+        if (!e.dirty) {
+            e.dirty = true;
+            ++dirty;
+        }
+
+        if (dirty >= cfg.max_dirty) {
+            return flush();
+        }
+        if (flush_timer) {
+            if (auto r = flush_timer->try_restart(cfg.flush_delay); !r) {
+                ESP_LOGW(TAG, "Failed to restart flush timer: %s", r.error().message().c_str());
+            }
+        }
+        return {};
+    }
+
+    // Requires `mutex` to be held. Loads the key with `load` on a miss, or when
+    // the only thing known is that a lookup of another type found nothing.
+    template<typename Load>
+    result<const entry*> lookup(std::string_view key, kind type, Load&& load) {
+        auto it = entries.find(key);
+        if (it != entries.end()) {
+            const auto& e = it->second;
+            if (e.type == type || e.present || e.dirty) {
+                if (!e.present) {
+                    return error(nvs::errc::not_found);
+                }
+                if (e.type != type) {
+                    return error(nvs::errc::type_mismatch);
+                }
+                return &e;
+            }
+        }
+
+        auto loaded = load();
+        if (!loaded && loaded.error() != nvs::errc::not_found) {
+            return error(loaded.error());
+        }
+        entry e{.type = type, .present = loaded.has_value(), .data = {}};
+        if (loaded) {
+            e.data = std::move(*loaded);
+        }
+        if (it == entries.end()) {
+            it = entries.emplace(std::string{key}, std::move(e)).first;
+        } else {
+            it->second = std::move(e);
+        }
+        if (!it->second.present) {
+            return error(nvs::errc::not_found);
+        }
+        return &it->second;
+    }
+};
+
+result<nvs_cache> nvs_cache::make(std::string_view namespace_name, config cfg) {
+    return open(nvs::make(namespace_name), cfg);
+}
+
+result<nvs_cache> nvs_cache::make(const partition& part, std::string_view namespace_name, config cfg) {
+    return open(nvs::make(part, namespace_name), cfg);
+}
+
+#ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
+nvs_cache::nvs_cache(std::string_view namespace_name, config cfg)
+    : nvs_cache(unwrap(make(namespace_name, cfg))) {}
+
+nvs_cache::nvs_cache(const partition& part, std::string_view namespace_name, config cfg)
+    : nvs_cache(unwrap(make(part, namespace_name, cfg))) {}
+#endif
+
+result<nvs_cache> nvs_cache::open(result<nvs> handle, config cfg) {
+    if (!handle) {
+        return error(handle.error());
+    }
+    if (cfg.max_dirty == 0) {
+        return error(errc::invalid_arg);
+    }
+    auto s = std::make_unique<state>(std::move(*handle), cfg);
+    if (cfg.flush_delay.count() > 0) {
+        auto t = timer::make({.name = "nvs_cache"}, [s = s.get()] {
+            std::lock_guard lock{s->mutex};
+            if (auto r = s->flush(); !r) {
+                ESP_LOGW(TAG, "Timed flush failed: %s", r.error().message().c_str());
+            }
+        });
+        if (!t) {
+            ESP_LOGD(TAG, "Failed to create flush timer: %s", t.error().message().c_str());
+            return error(t.error());
+        }
+        s->flush_timer.emplace(std::move(*t));
+    }
+    s->attach();
+    return nvs_cache{std::move(s)};
+}
+
+nvs_cache::nvs_cache(std::unique_ptr<state> s) noexcept
+    : _state(std::move(s)) {}
+
+nvs_cache::nvs_cache(nvs_cache&& other) noexcept = default;
+
+nvs_cache& nvs_cache::operator=(nvs_cache&& other) noexcept {
+    if (this != &other) {
+        if (_state) {
+            _state->close();
+        }
+        _state = std::move(other._state);
+    }
+    return *this;
+}
+
+nvs_cache::~nvs_cache() {
+    if (_state) {
+        _state->close();
+    }
+}
+
+size_t nvs_cache::dirty_count() const {
+    std::lock_guard lock{_state->mutex};
+    return _state->dirty;
+}
+
+result<void> nvs_cache::try_sync() {
+    std::lock_guard lock{_state->mutex};
+    return _state->flush();
+}
+
+result<void> nvs_cache::try_erase(std::string_view key) {
+    std::lock_guard lock{_state->mutex};
+    auto it = _state->entries.find(key);
+    kind type = it != _state->entries.end() ? it->second.type : kind::blob;
+    return _state->store(key, type, false, {});
+}
+
+result<void> nvs_cache::try_set_string(std::string_view key, std::string_view value) {
+    std::lock_guard lock{_state->mutex};
+    return _state->store(key, kind::string, true, {value.begin(), value.end()});
+}
+
+result<std::string> nvs_cache::try_get_string(std::string_view key) {
+    std::lock_guard lock{_state->mutex};
+    return _state
+        ->lookup(
+            key,
+            kind::string,
+            [&] {
+                return _state->handle.try_get_string(key).transform([](const std::string& s) {
+                    return std::vector<uint8_t>{s.begin(), s.end()};
+                });
+            }
+        )
+        .transform([](const entry* e) { return std::string{e->data.begin(), e->data.end()}; });
+}
+
+result<void> nvs_cache::try_set_blob(std::string_view key, std::span<const uint8_t> data) {
+    std::lock_guard lock{_state->mutex};
+    return _state->store(key, kind::blob, true, {data.begin(), data.end()});
+}
+
+result<std::vector<uint8_t>> nvs_cache::try_get_blob(std::string_view key) {
+    std::lock_guard lock{_state->mutex};
+    return _state->lookup(key, kind::blob, [&] { return _state->handle.try_get_blob(key); }).transform([](const entry* e) {
+        return e->data;
+    });
+}
+
+template<typename T>
+    requires sized_integral<T>
+result<void> nvs_cache::try_set_value(std::string_view key, T value) {
+    std::lock_guard lock{_state->mutex};
+    return _state->store(key, kind_of<T>(), true, to_bytes(value));
+}
+
+template<typename T>
+    requires sized_integral<T>
+result<T> nvs_cache::try_get_value(std::string_view key) {
+    std::lock_guard lock{_state->mutex};
+    return _state
+        ->lookup(key, kind_of<T>(), [&] { return _state->handle.try_get_value<T>(key).transform(to_bytes<T>); })
+        .transform([](const entry* e) { return from_bytes<T>(e->data); });
+}
+
+// Explicit template instantiations
+template result<void> nvs_cache::try_set_value<uint8_t>(std::string_view, uint8_t);
+template result<void> nvs_cache::try_set_value<int8_t>(std::string_view, int8_t);
+template result<void> nvs_cache::try_set_value<uint16_t>(std::string_view, uint16_t);
+template result<void> nvs_cache::try_set_value<int16_t>(std::string_view, int16_t);
+template result<void> nvs_cache::try_set_value<uint32_t>(std::string_view, uint32_t);
+template result<void> nvs_cache::try_set_value<int32_t>(std::string_view, int32_t);
+template result<void> nvs_cache::try_set_value<uint64_t>(std::string_view, uint64_t);
+template result<void> nvs_cache::try_set_value<int64_t>(std::string_view, int64_t);
+template result<uint8_t> nvs_cache::try_get_value<uint8_t>(std::string_view);
+template result<int8_t> nvs_cache::try_get_value<int8_t>(std::string_view);
+template result<uint16_t> nvs_cache::try_get_value<uint16_t>(std::string_view);
+template result<int16_t> nvs_cache::try_get_value<int16_t>(std::string_view);
+template result<uint32_t> nvs_cache::try_get_value<uint32_t>(std::string_view);
+template result<int32_t> nvs_cache::try_get_value<int32_t>(std::string_view);
+template result<uint64_t> nvs_cache::try_get_value<uint64_t>(std::string_view);
+template result<int64_t> nvs_cache::try_get_value<int64_t>(std::string_view);
+
+} // namespace idfxx
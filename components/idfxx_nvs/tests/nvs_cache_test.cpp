@@ -0,0 +1,242 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+// Unit tests for idfxx nvs_cache
+// Uses ESP-IDF Unity test framework with compile-time static_asserts
+
+#include "idfxx/nvs"
+#include "idfxx/nvs_cache"
+#include "idfxx/sched"
+#include "unity.h"
+
+#include <chrono>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+using namespace idfxx;
+using namespace std::chrono_literals;
+
+// =============================================================================
+// Compile-time tests (static_assert)
+// =============================================================================
+
+static_assert(!std::is_default_constructible_v<nvs_cache>);
+static_assert(!std::is_copy_constructible_v<nvs_cache>);
+static_assert(!std::is_copy_assignable_v<nvs_cache>);
+static_assert(std::is_move_constructible_v<nvs_cache>);
+static_assert(std::is_move_assignable_v<nvs_cache>);
+
+// =============================================================================
+// Runtime tests (Unity TEST_CASE)
+// =============================================================================
+
+static void ensure_nvs_init() {
+    auto result = nvs::flash::try_init();
+    if (!result && (result.error() == nvs::errc::no_free_pages ||
+                    result.error() == nvs::errc::new_version_found)) {
+        TEST_ASSERT_TRUE(nvs::flash::try_erase().has_value());
+        result = nvs::flash::try_init();
+    }
+    TEST_ASSERT_TRUE(result.has_value());
+}
+
+// Clears a namespace so each test starts from an empty one.
+static void reset_namespace(std::string_view name) {
+    auto ns = nvs::make(name);
+    TEST_ASSERT_TRUE(ns.has_value());
+    TEST_ASSERT_TRUE(ns->try_erase_all().has_value());
+    TEST_ASSERT_TRUE(ns->try_commit().has_value());
+}
+
+TEST_CASE("nvs_cache::make rejects a zero dirty bound", "[idfxx][nvs][nvs_cache]") {
+    ensure_nvs_init();
+
+    auto cache = nvs_cache::make("test_cache", {.max_dirty = 0});
+    TEST_ASSERT_FALSE(cache.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(errc::invalid_arg), cache.error().value());
+}
+
+TEST_CASE("nvs_cache serves writes before they are flushed", "[idfxx][nvs][nvs_cache]") {
+    ensure_nvs_init();
+    reset_namespace("test_cache");
+
+    auto cache = nvs_cache::make("test_cache", {.flush_delay = 10s});
+    TEST_ASSERT_TRUE(cache.has_value());
+
+    TEST_ASSERT_TRUE(cache->try_set_value<uint32_t>("count", 1).has_value());
+    TEST_ASSERT_TRUE(cache->try_set_value<uint32_t>("count", 2).has_value());
+    TEST_ASSERT_TRUE(cache->try_set_string("name", "cached").has_value());
+    TEST_ASSERT_EQUAL(2, cache->dirty_count());
+
+    auto count = cache->try_get_value<uint32_t>("count");
+    TEST_ASSERT_TRUE(count.has_value());
+    TEST_ASSERT_EQUAL(2, *count);
+
+    auto name = cache->try_get_string("name");
+    TEST_ASSERT_TRUE(name.has_value());
+    TEST_ASSERT_EQUAL_STRING("cached", name->c_str());
+
+    // Not yet in flash
+    auto ns = nvs::make("test_cache", true);
+    TEST_ASSERT_TRUE(ns.has_value());
+    auto raw = ns->try_get_value<uint32_t>("count");
+    TEST_ASSERT_FALSE(raw.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(nvs::errc::not_found), raw.error().value());
+}
+
+TEST_CASE("nvs_cache::try_sync writes dirty keys", "[idfxx][nvs][nvs_cache]") {
+    ensure_nvs_init();
+    reset_namespace("test_cache");
+
+    auto cache = nvs_cache::make("test_cache", {.flush_delay = 10s});
+    TEST_ASSERT_TRUE(cache.has_value());
+
+    uint8_t blob[]{0xDE, 0xAD, 0xBE, 0xEF};
+    TEST_ASSERT_TRUE(cache->try_set_value<int16_t>("temp", -40).has_value());
+    TEST_ASSERT_TRUE(cache->try_set_blob("blob", blob).has_value());
+    TEST_ASSERT_TRUE(cache->try_sync().has_value());
+    TEST_ASSERT_EQUAL(0, cache->dirty_count());
+
+    auto ns = nvs::make("test_cache", true);
+    TEST_ASSERT_TRUE(ns.has_value());
+    auto temp = ns->try_get_value<int16_t>("temp");
+    TEST_ASSERT_TRUE(temp.has_value());
+    TEST_ASSERT_EQUAL(-40, *temp);
+    auto data = ns->try_get_blob("blob");
+    TEST_ASSERT_TRUE(data.has_value());
+    TEST_ASSERT_EQUAL(4, data->size());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(blob, data->data(), 4);
+}
+
+TEST_CASE("nvs_cache flushes when the dirty bound is reached", "[idfxx][nvs][nvs_cache]") {
+    ensure_nvs_init();
+    reset_namespace("test_cache");
+
+    auto cache = nvs_cache::make("test_cache", {.flush_delay = 10s, .max_dirty = 2});
+    TEST_ASSERT_TRUE(cache.has_value());
+
+    TEST_ASSERT_TRUE(cache->try_set_value<uint8_t>("a", 1).has_value());
+    TEST_ASSERT_EQUAL(1, cache->dirty_count());
+    TEST_ASSERT_TRUE(cache->try_set_value<uint8_t>("b", 2).has_value());
+    TEST_ASSERT_EQUAL(0, cache->dirty_count());
+
+    auto ns = nvs::make("test_cache", true);
+    TEST_ASSERT_TRUE(ns.has_value());
+    TEST_ASSERT_TRUE(ns->try_get_value<uint8_t>("a").has_value());
+    TEST_ASSERT_TRUE(ns->try_get_value<uint8_t>("b").has_value());
+}
+
+TEST_CASE("nvs_cache refuses new dirty keys while flushes keep failing", "[idfxx][nvs][nvs_cache]") {
+    ensure_nvs_init();
+    reset_namespace("test_cache");
+
+    auto cache = nvs_cache::make("test_cache", {.flush_delay = 10s, .max_dirty = 2});
+    TEST_ASSERT_TRUE(cache.has_value());
+
+    // NVS strings are limited to 4000 bytes, so these keys never flush
+    const std::string too_long(4000, 'x');
+    TEST_ASSERT_TRUE(cache->try_set_string("big1", too_long).has_value());
+    TEST_ASSERT_FALSE(cache->try_set_string("big2", too_long).has_value());
+    TEST_ASSERT_EQUAL(2, cache->dirty_count());
+
+    // A new key is refused rather than growing the dirty set
+    TEST_ASSERT_FALSE(cache->try_set_value<uint8_t>("c", 3).has_value());
+    TEST_ASSERT_EQUAL(2, cache->dirty_count());
+    TEST_ASSERT_FALSE(cache->try_get_value<uint8_t>("c").has_value());
+
+    // Rewriting a dirty key is always accepted; once the values fit, the
+    // next flush drains them and new keys are cached again
+    TEST_ASSERT_FALSE(cache->try_set_string("big1", "short").has_value());
+    TEST_ASSERT_EQUAL(1, cache->dirty_count());
+    TEST_ASSERT_TRUE(cache->try_set_string("big2", "short").has_value());
+    TEST_ASSERT_TRUE(cache->try_set_value<uint8_t>("c", 3).has_value());
+    TEST_ASSERT_EQUAL(0, cache->dirty_count());
+}
+
+TEST_CASE("nvs_cache flushes after the flush delay", "[idfxx][nvs][nvs_cache]") {
+    ensure_nvs_init();
+    reset_namespace("test_cache");
+
+    auto cache = nvs_cache::make("test_cache", {.flush_delay = 20ms});
+    TEST_ASSERT_TRUE(cache.has_value());
+
+    TEST_ASSERT_TRUE(cache->try_set_value<uint32_t>("delayed", 7).has_value());
+    TEST_ASSERT_EQUAL(1, cache->dirty_count());
+    idfxx::delay(200ms);
+    TEST_ASSERT_EQUAL(0, cache->dirty_count());
+
+    auto ns = nvs::make("test_cache", true);
+    TEST_ASSERT_TRUE(ns.has_value());
+    auto value = ns->try_get_value<uint32_t>("delayed");
+    TEST_ASSERT_TRUE(value.has_value());
+    TEST_ASSERT_EQUAL(7, *value);
+}
+
+TEST_CASE("nvs_cache flushes on destruction", "[idfxx][nvs][nvs_cache]") {
+    ensure_nvs_init();
+    reset_namespace("test_cache");
+
+    {
+        auto cache = nvs_cache::make("test_cache", {.flush_delay = 10s});
+        TEST_ASSERT_TRUE(cache.has_value());
+        TEST_ASSERT_TRUE(cache->try_set_string("bye", "flushed").has_value());
+    }
+
+    auto ns = nvs::make("test_cache", true);
+    TEST_ASSERT_TRUE(ns.has_value());
+    auto value = ns->try_get_string("bye");
+    TEST_ASSERT_TRUE(value.has_value());
+    TEST_ASSERT_EQUAL_STRING("flushed", value->c_str());
+}
+
+TEST_CASE("nvs_cache erase and lookup errors", "[idfxx][nvs][nvs_cache]") {
+    ensure_nvs_init();
+    reset_namespace("test_cache");
+
+    auto cache = nvs_cache::make("test_cache", {.flush_delay = 10s});
+    TEST_ASSERT_TRUE(cache.has_value());
+
+    auto missing = cache->try_get_string("missing");
+    TEST_ASSERT_FALSE(missing.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(nvs::errc::not_found), missing.error().value());
+
+    TEST_ASSERT_TRUE(cache->try_set_value<int32_t>("num", 5).has_value());
+    auto mismatch = cache->try_get_string("num");
+    TEST_ASSERT_FALSE(mismatch.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(nvs::errc::type_mismatch), mismatch.error().value());
+
+    TEST_ASSERT_TRUE(cache->try_erase("num").has_value());
+    auto erased = cache->try_get_value<int32_t>("num");
+    TEST_ASSERT_FALSE(erased.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(nvs::errc::not_found), erased.error().value());
+
+    // Erasing a key that never existed is not an error
+    TEST_ASSERT_TRUE(cache->try_erase("never").has_value());
+
+    auto too_long = cache->try_set_string("this_key_is_too_long", "x");
+    TEST_ASSERT_FALSE(too_long.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(nvs::errc::key_too_long), too_long.error().value());
+}
+
+#ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
+
+TEST_CASE("nvs_cache constructor and throwing accessors", "[idfxx][nvs][nvs_cache]") {
+    ensure_nvs_init();
+    reset_namespace("test_cache");
+
+    nvs_cache cache("test_cache", {});
+    cache.set_value<uint16_t>("port", 8080);
+    TEST_ASSERT_EQUAL(8080, cache.get_value<uint16_t>("port"));
+    cache.sync();
+
+    bool threw = false;
+    try {
+        (void)cache.get_string("absent");
+    } catch (const std::system_error&) {
+        threw = true;
+    }
+    TEST_ASSERT_TRUE(threw);
+}
+
+#endif // CONFIG_COMPILER_CXX_EXCEPTIONS
@@ -49,6 +49,12 @@ static_assert(!sized_integral<void*>);
 // nvs::errc is an error_code_enum
 static_assert(std::is_error_code_enum_v<nvs::errc>);
 
+// entry_range is a move-only, single-pass range
+static_assert(std::input_iterator<nvs::entry_range::iterator>);
+static_assert(std::sentinel_for<std::default_sentinel_t, nvs::entry_range::iterator>);
+static_assert(!std::is_copy_constructible_v<nvs::entry_range>);
+static_assert(std::is_move_constructible_v<nvs::entry_range>);
+
 // =============================================================================
 // Runtime tests (Unity TEST_CASE)
 // =============================================================================
@@ -629,6 +635,88 @@ TEST_CASE("nvs move assignment cleans up target", "[idfxx][nvs]") {
     TEST_ASSERT_EQUAL(std::to_underlying(nvs::errc::invalid_handle), set_result.error().value());
 }
 
+TEST_CASE("nvs get string and blob into caller buffers", "[idfxx][nvs]") {
+    ensure_nvs_init();
+
+    auto nvs_handle = nvs::make("test_span");
+    TEST_ASSERT_TRUE(nvs_handle.has_value());
+    auto& nvs = *nvs_handle;
+
+    uint8_t blob[]{0x10, 0x20, 0x30};
+    TEST_ASSERT_TRUE(nvs.try_set_string("str", "hello").has_value());
+    TEST_ASSERT_TRUE(nvs.try_set_blob("blob", blob).has_value());
+    TEST_ASSERT_TRUE(nvs.try_commit().has_value());
+
+    char buf[16];
+    auto str = nvs.try_get_string("str", buf);
+    TEST_ASSERT_TRUE(str.has_value());
+    TEST_ASSERT_EQUAL(5, str->size());
+    TEST_ASSERT_EQUAL_STRING("hello", buf);
+
+    // No room for the terminator
+    char small[5];
+    auto too_small = nvs.try_get_string("str", small);
+    TEST_ASSERT_FALSE(too_small.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(nvs::errc::invalid_length), too_small.error().value());
+
+    uint8_t data[8];
+    auto out = nvs.try_get_blob("blob", data);
+    TEST_ASSERT_TRUE(out.has_value());
+    TEST_ASSERT_EQUAL(3, out->size());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(blob, out->data(), 3);
+
+    auto missing = nvs.try_get_blob("missing", data);
+    TEST_ASSERT_FALSE(missing.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(nvs::errc::not_found), missing.error().value());
+}
+
+TEST_CASE("nvs entries visits every key in the namespace", "[idfxx][nvs]") {
+    ensure_nvs_init();
+
+    auto nvs_handle = nvs::make("test_iter");
+    TEST_ASSERT_TRUE(nvs_handle.has_value());
+    auto& nvs = *nvs_handle;
+    TEST_ASSERT_TRUE(nvs.try_erase_all().has_value());
+    TEST_ASSERT_TRUE(nvs.try_commit().has_value());
+
+    {
+        auto empty = nvs.try_entries();
+        TEST_ASSERT_TRUE(empty.has_value());
+        TEST_ASSERT_TRUE(empty->begin() == empty->end());
+    }
+
+    TEST_ASSERT_TRUE(nvs.try_set_value<uint16_t>("port", 80).has_value());
+    TEST_ASSERT_TRUE(nvs.try_set_string("host", "example").has_value());
+    TEST_ASSERT_TRUE(nvs.try_commit().has_value());
+
+    auto range = nvs.try_entries();
+    TEST_ASSERT_TRUE(range.has_value());
+    int count = 0;
+    for (auto e : *range) {
+        if (e.key == "port") {
+            TEST_ASSERT_EQUAL(std::to_underlying(nvs::entry_type::u16), std::to_underlying(e.type));
+            TEST_ASSERT_EQUAL(2, e.size);
+        } else if (e.key == "host") {
+            TEST_ASSERT_EQUAL(std::to_underlying(nvs::entry_type::str), std::to_underlying(e.type));
+            TEST_ASSERT_EQUAL(8, e.size); // includes the terminator
+        } else {
+            TEST_FAIL_MESSAGE("unexpected key");
+        }
+        ++count;
+    }
+    TEST_ASSERT_EQUAL(2, count);
+
+    // Filtered by type
+    auto strings = nvs.try_entries(nvs::entry_type::str);
+    TEST_ASSERT_TRUE(strings.has_value());
+    count = 0;
+    for (auto e : *strings) {
+        TEST_ASSERT_TRUE(e.key == "host");
+        ++count;
+    }
+    TEST_ASSERT_EQUAL(1, count);
+}
+
 // =============================================================================
 // Partition-based API tests
 // =============================================================================
@@ -24,6 +24,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <esp_app_desc.h>
+#include <optional>
 #include <span>
 #include <string_view>
 
@@ -146,6 +147,21 @@ private:
  * upd.end();
  * idfxx::ota::set_boot_partition(part);
  * @endcode
+ *
+ * To verify the image against a known digest without reading the partition
+ * back to hash it, enable streaming SHA-256 before the first write and pass
+ * the expected digest to end(). A mismatch aborts the update before
+ * finalization; on a match, end() still runs ESP-IDF's own image validation,
+ * which reads the image back:
+ *
+ * @code
+ * idfxx::ota::update upd(part);
+ * upd.enable_sha256();
+ * for (auto chunk : download) {
+ *     upd.write(chunk);
+ * }
+ * upd.end(expected_sha256);
+ * @endcode
  */
 class update {
 public:
@@ -358,6 +374,43 @@ public:
      */
     [[nodiscard]] result<void> try_set_final_partition(const partition& final_part, bool copy = true);
 
+    // =========================================================================
+    // Streaming digest
+    // =========================================================================
+
+#ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
+    /**
+     * @brief Enables streaming SHA-256 over the written image.
+     *
+     * Must be called before the first write(). Each block passed to write()
+     * is fed to a hardware-accelerated SHA-256 context as it is written, so
+     * end(std::span<const uint8_t, 32>) can check it against a known digest
+     * without a separate pass to hash the partition. Writes must then be sequential:
+     * write_with_offset() is only accepted at the current end of the image.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on failure.
+     */
+    void enable_sha256();
+#endif
+
+    /**
+     * @brief Enables streaming SHA-256 over the written image.
+     *
+     * Must be called before the first write(). Each block passed to write()
+     * is fed to a hardware-accelerated SHA-256 context as it is written, so
+     * try_end(std::span<const uint8_t, 32>) can check it against a known digest
+     * without a separate pass to hash the partition. Writes must then be sequential:
+     * try_write_with_offset() is only accepted at the current end of the image.
+     *
+     * @return Success, or an error.
+     * @retval idfxx::errc::invalid_state if data has already been written or the session has ended.
+     */
+    [[nodiscard]] result<void> try_enable_sha256();
+
+    /** @brief Returns true if streaming SHA-256 is enabled for this session. */
+    [[nodiscard]] bool sha256_enabled() const noexcept { return _sha256.has_value(); }
+
     // =========================================================================
     // Write
     // =========================================================================
@@ -477,6 +530,21 @@ public:
      */
     void end();
 
+    /**
+     * @brief Verifies the streamed digest, then finalizes the OTA update.
+     *
+     * Requires enable_sha256() to have been called before the first write.
+     * If the SHA-256 of the written data does not match @p expected_sha256,
+     * the update is aborted and never finalized. Otherwise the update is
+     * finalized as by end(), including ESP-IDF's image validation.
+     *
+     * @param expected_sha256 Expected SHA-256 digest of the complete image.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on failure.
+     */
+    void end(std::span<const uint8_t, 32> expected_sha256);
+
     /**
      * @brief Aborts the OTA update and frees associated resources.
      *
@@ -496,6 +564,24 @@ public:
      */
     [[nodiscard]] result<void> try_end();
 
+    /**
+     * @brief Verifies the streamed digest, then finalizes the OTA update.
+     *
+     * Requires try_enable_sha256() to have been called before the first write.
+     * If the SHA-256 of the written data does not match @p expected_sha256,
+     * the update is aborted and never finalized. Otherwise the update is
+     * finalized as by try_end(), including ESP-IDF's image validation. In
+     * either case the handle is invalidated and the session is complete.
+     *
+     * @param expected_sha256 Expected SHA-256 digest of the complete image.
+     *
+     * @return Success, or an error.
+     * @retval idfxx::errc::invalid_crc if the written data does not match the expected digest.
+     * @retval idfxx::errc::invalid_state if streaming SHA-256 was not enabled.
+     * @retval ota::errc::validate_failed if the image is invalid.
+     */
+    [[nodiscard]] result<void> try_end(std::span<const uint8_t, 32> expected_sha256);
+
     /**
      * @brief Aborts the OTA update and frees associated resources.
      *
@@ -507,6 +593,8 @@ private:
     explicit update(esp_ota_handle_t handle);
 
     esp_ota_handle_t _handle = 0;
+    size_t _written = 0;
+    std::optional<partition::sha256_context> _sha256;
 };
 
 // =============================================================================
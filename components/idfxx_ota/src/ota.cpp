@@ -4,6 +4,7 @@
 #include <idfxx/error>
 #include <idfxx/ota>
 
+#include <cinttypes>
 #include <esp_app_desc.h>
 #include <esp_log.h>
 #include <esp_ota_ops.h>
@@ -127,7 +128,9 @@ update::update(esp_ota_handle_t handle)
     : _handle(handle) {}
 
 update::update(update&& other) noexcept
-    : _handle(std::exchange(other._handle, 0)) {}
+    : _handle(std::exchange(other._handle, 0))
+    , _written(std::exchange(other._written, 0))
+    , _sha256(std::exchange(other._sha256, std::nullopt)) {}
 
 update& update::operator=(update&& other) noexcept {
     if (this != &other) {
@@ -135,6 +138,8 @@ update& update::operator=(update&& other) noexcept {
             esp_ota_abort(_handle);
         }
         _handle = std::exchange(other._handle, 0);
+        _written = std::exchange(other._written, 0);
+        _sha256 = std::exchange(other._sha256, std::nullopt);
     }
     return *this;
 }
@@ -227,6 +232,27 @@ result<void> update::try_set_final_partition(const partition& final_part, bool c
     return checked(esp_ota_set_final_partition(_handle, final_part.idf_handle(), copy), "esp_ota_set_final_partition");
 }
 
+#ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
+void update::enable_sha256() {
+    unwrap(try_enable_sha256());
+}
+#endif
+
+result<void> update::try_enable_sha256() {
+    if (_handle == 0 || _written != 0) {
+        return error(idfxx::errc::invalid_state);
+    }
+    if (_sha256) {
+        return {};
+    }
+    auto hash = partition::sha256_context::make();
+    if (!hash) {
+        return error(hash.error());
+    }
+    _sha256.emplace(std::move(*hash));
+    return {};
+}
+
 #ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
 void update::write(const void* data, size_t size) {
     unwrap(try_write(data, size));
@@ -249,7 +275,14 @@ result<void> update::try_write(const void* data, size_t size) {
     if (_handle == 0) {
         return error(idfxx::errc::invalid_state);
     }
-    return checked(esp_ota_write(_handle, data, size), "esp_ota_write");
+    if (auto r = checked(esp_ota_write(_handle, data, size), "esp_ota_write"); !r) {
+        return r;
+    }
+    _written += size;
+    if (_sha256) {
+        return _sha256->try_update({static_cast<const uint8_t*>(data), size});
+    }
+    return {};
 }
 
 result<void> update::try_write(std::span<const uint8_t> data) {
@@ -260,7 +293,19 @@ result<void> update::try_write_with_offset(uint32_t offset, const void* data, si
     if (_handle == 0) {
         return error(idfxx::errc::invalid_state);
     }
-    return checked(esp_ota_write_with_offset(_handle, data, size, offset), "esp_ota_write_with_offset");
+    // A streaming digest only covers the image if it is written front to back
+    if (_sha256 && offset != _sha256->size()) {
+        ESP_LOGD(TAG, "non-sequential write at 0x%" PRIx32 " with streaming sha256 enabled", offset);
+        return error(idfxx::errc::invalid_arg);
+    }
+    if (auto r = checked(esp_ota_write_with_offset(_handle, data, size, offset), "esp_ota_write_with_offset"); !r) {
+        return r;
+    }
+    _written += size;
+    if (_sha256) {
+        return _sha256->try_update({static_cast<const uint8_t*>(data), size});
+    }
+    return {};
 }
 
 result<void> update::try_write_with_offset(uint32_t offset, std::span<const uint8_t> data) {
@@ -272,6 +317,10 @@ void update::end() {
     unwrap(try_end());
 }
 
+void update::end(std::span<const uint8_t, 32> expected_sha256) {
+    unwrap(try_end(expected_sha256));
+}
+
 void update::abort() {
     unwrap(try_abort());
 }
@@ -286,6 +335,19 @@ result<void> update::try_end() {
     return checked(esp_ota_end(handle), "esp_ota_end");
 }
 
+result<void> update::try_end(std::span<const uint8_t, 32> expected_sha256) {
+    if (_handle == 0 || !_sha256) {
+        return error(idfxx::errc::invalid_state);
+    }
+    auto hash = std::exchange(_sha256, std::nullopt);
+    if (auto r = hash->try_verify(expected_sha256); !r) {
+        ESP_LOGD(TAG, "image sha256 mismatch after %zu bytes, aborting update", hash->size());
+        (void)try_abort();
+        return r;
+    }
+    return try_end();
+}
+
 result<void> update::try_abort() {
     if (_handle == 0) {
         return error(idfxx::errc::invalid_state);
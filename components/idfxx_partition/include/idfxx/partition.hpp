@@ -14,18 +14,22 @@
  * Provides partition lookup by type, subtype, and label, with read/write/erase
  * operations and memory mapping.
  *
- * Depends on @ref idfxx_core for error handling.
+ * Depends on @ref idfxx_core for error handling and futures, and on
+ * @ref idfxx_task for the flash worker task behind the async operations.
  * @{
  */
 
 #include <idfxx/error>
+#include <idfxx/future>
 
 #include <array>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
 #include <esp_partition.h>
+#include <memory>
 #include <span>
+#include <stop_token>
 #include <string_view>
 #include <type_traits>
 #include <vector>
@@ -115,6 +119,7 @@ public:
     };
 
     class mmap_handle;
+    class sha256_context;
 
     // =========================================================================
     // Discovery
@@ -288,6 +293,24 @@ public:
      */
     void write(size_t offset, std::span<const uint8_t> src) { unwrap(try_write(offset, src)); }
 
+    /**
+     * @brief Writes data to the partition and feeds it to a SHA-256 context.
+     *
+     * The written bytes are hashed as they are written, so the digest of a
+     * sequence of writes can be verified without reading the partition back.
+     * Data is only hashed once the write has succeeded.
+     *
+     * @param offset Byte offset within the partition.
+     * @param src    Source span.
+     * @param hash   SHA-256 context to update with the written bytes.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on failure.
+     */
+    void write(size_t offset, std::span<const uint8_t> src, sha256_context& hash) {
+        unwrap(try_write(offset, src, hash));
+    }
+
     /**
      * @brief Reads data from the partition without decryption.
      *
@@ -415,6 +438,22 @@ public:
      */
     [[nodiscard]] result<void> try_write(size_t offset, std::span<const uint8_t> src);
 
+    /**
+     * @brief Writes data to the partition and feeds it to a SHA-256 context.
+     *
+     * The written bytes are hashed as they are written, so the digest of a
+     * sequence of writes can be verified without reading the partition back.
+     * Data is only hashed once the write has succeeded.
+     *
+     * @param offset Byte offset within the partition.
+     * @param src    Source span.
+     * @param hash   SHA-256 context to update with the written bytes.
+     *
+     * @return Success, or an error.
+     * @retval idfxx::errc::invalid_state if the hash context has already been finished.
+     */
+    [[nodiscard]] result<void> try_write(size_t offset, std::span<const uint8_t> src, sha256_context& hash);
+
     /**
      * @brief Reads data from the partition without decryption.
      *
@@ -498,6 +537,120 @@ public:
      */
     [[nodiscard]] bool check_identity(const partition& other) const;
 
+    // =========================================================================
+    // Asynchronous I/O
+    // =========================================================================
+
+    // Async operations run on a single, lazily started flash worker task in
+    // submission order, so operations on a partition never overtake one
+    // another. They are split into chunks (4 KB for reads and writes, 64 KB
+    // for erases) and the stop token is checked between chunks; a cancelled
+    // operation completes with `errc::not_finished` and may have been
+    // partially applied. Dropping the future does not cancel the operation.
+
+#ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
+    /**
+     * @brief Queues a read on the flash worker task.
+     *
+     * @p dst must remain valid until the returned future completes.
+     *
+     * @param offset Byte offset within the partition.
+     * @param dst    Destination span.
+     * @param stop   Token to cancel the read between chunks.
+     *
+     * @return A future completing when the read has finished.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on failure.
+     */
+    [[nodiscard]] future<void> read_async(size_t offset, std::span<uint8_t> dst, std::stop_token stop = {}) const {
+        return unwrap(try_read_async(offset, dst, std::move(stop)));
+    }
+
+    /**
+     * @brief Queues a write (with encryption if applicable) on the flash worker task.
+     *
+     * @p src must remain valid until the returned future completes.
+     *
+     * @param offset Byte offset within the partition.
+     * @param src    Source span.
+     * @param stop   Token to cancel the write between chunks.
+     *
+     * @return A future completing when the write has finished.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on failure.
+     */
+    [[nodiscard]] future<void> write_async(size_t offset, std::span<const uint8_t> src, std::stop_token stop = {}) {
+        return unwrap(try_write_async(offset, src, std::move(stop)));
+    }
+
+    /**
+     * @brief Queues an erase on the flash worker task.
+     *
+     * Both offset and size must be aligned to erase_size().
+     *
+     * @param offset Byte offset within the partition (must be erase-aligned).
+     * @param size   Number of bytes to erase (must be erase-aligned).
+     * @param stop   Token to cancel the erase between blocks.
+     *
+     * @return A future completing when the erase has finished.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on failure.
+     */
+    [[nodiscard]] future<void> erase_async(size_t offset, size_t size, std::stop_token stop = {}) {
+        return unwrap(try_erase_async(offset, size, std::move(stop)));
+    }
+#endif
+
+    /**
+     * @brief Queues a read on the flash worker task.
+     *
+     * @p dst must remain valid until the returned future completes.
+     *
+     * @param offset Byte offset within the partition.
+     * @param dst    Destination span.
+     * @param stop   Token to cancel the read between chunks.
+     *
+     * @return A future completing when the read has finished, or an error.
+     * @retval idfxx::errc::invalid_size if the range extends past the end of the partition.
+     */
+    [[nodiscard]] result<future<void>>
+    try_read_async(size_t offset, std::span<uint8_t> dst, std::stop_token stop = {}) const;
+
+    /**
+     * @brief Queues a write (with encryption if applicable) on the flash worker task.
+     *
+     * @p src must remain valid until the returned future completes.
+     *
+     * @param offset Byte offset within the partition.
+     * @param src    Source span.
+     * @param stop   Token to cancel the write between chunks.
+     *
+     * @return A future completing when the write has finished, or an error.
+     * @retval idfxx::errc::invalid_size if the range extends past the end of the partition.
+     * @retval idfxx::errc::not_allowed if the partition is read-only.
+     */
+    [[nodiscard]] result<future<void>>
+    try_write_async(size_t offset, std::span<const uint8_t> src, std::stop_token stop = {});
+
+    /**
+     * @brief Queues an erase on the flash worker task.
+     *
+     * Both offset and size must be aligned to erase_size().
+     *
+     * @param offset Byte offset within the partition (must be erase-aligned).
+     * @param size   Number of bytes to erase (must be erase-aligned).
+     * @param stop   Token to cancel the erase between blocks.
+     *
+     * @return A future completing when the erase has finished, or an error.
+     * @retval idfxx::errc::invalid_arg if offset or size is not erase-aligned.
+     * @retval idfxx::errc::invalid_size if the range extends past the end of the partition.
+     * @retval idfxx::errc::not_allowed if the partition is read-only.
+     */
+    [[nodiscard]] result<future<void>> try_erase_async(size_t offset, size_t size, std::stop_token stop = {});
+
 private:
     explicit constexpr partition(const esp_partition_t* part)
         : _part(part) {}
@@ -588,6 +741,143 @@ private:
     esp_partition_mmap_handle_t _handle = 0;
 };
 
+/**
+ * @headerfile <idfxx/partition>
+ * @brief Incremental SHA-256 digest computation.
+ *
+ * Accumulates a SHA-256 digest over data supplied in blocks, using the
+ * hardware SHA accelerator where the target provides one. Intended for
+ * verifying flash writes on the fly: feed each block as it is written (see
+ * partition::try_write(size_t, std::span<const uint8_t>, sha256_context&)),
+ * then compare the result against an expected digest instead of reading the
+ * data back and hashing it a second time. Move-only.
+ *
+ * @code
+ * auto part = idfxx::partition::find("storage");
+ * idfxx::partition::sha256_context hash;
+ * for (size_t off = 0; auto chunk : chunks) {
+ *     part.write(off, chunk, hash);
+ *     off += chunk.size();
+ * }
+ * hash.verify(expected_digest);
+ * @endcode
+ */
+class partition::sha256_context {
+public:
+    /** @brief Size of a SHA-256 digest in bytes. */
+    static constexpr size_t digest_size = 32;
+
+#ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
+    /**
+     * @brief Starts a new SHA-256 computation.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on failure.
+     */
+    [[nodiscard]] sha256_context();
+#endif
+
+    /**
+     * @brief Starts a new SHA-256 computation.
+     *
+     * @return The hash context, or an error.
+     */
+    [[nodiscard]] static result<sha256_context> make();
+
+    ~sha256_context();
+
+    sha256_context(const sha256_context&) = delete;
+    sha256_context& operator=(const sha256_context&) = delete;
+
+    /** @brief Move constructor. */
+    sha256_context(sha256_context&& other) noexcept;
+
+    /** @brief Move assignment. Discards any computation in progress. */
+    sha256_context& operator=(sha256_context&& other) noexcept;
+
+    /** @brief Returns the total number of bytes fed to the context so far. */
+    [[nodiscard]] size_t size() const noexcept { return _size; }
+
+    /** @brief Returns true once the digest has been finished. */
+    [[nodiscard]] bool finished() const noexcept { return _impl == nullptr; }
+
+#ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
+    /**
+     * @brief Feeds a block of data to the digest.
+     *
+     * @param data Data to hash.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on failure.
+     */
+    void update(std::span<const uint8_t> data) { unwrap(try_update(data)); }
+
+    /**
+     * @brief Finishes the computation and returns the digest.
+     *
+     * The context cannot be updated after this call.
+     *
+     * @return The 32-byte SHA-256 digest.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on failure.
+     */
+    [[nodiscard]] std::array<uint8_t, digest_size> finish() { return unwrap(try_finish()); }
+
+    /**
+     * @brief Finishes the computation and compares the digest to an expected value.
+     *
+     * @param expected The expected 32-byte SHA-256 digest.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error with idfxx::errc::invalid_crc if the digests differ.
+     */
+    void verify(std::span<const uint8_t, digest_size> expected) { unwrap(try_verify(expected)); }
+#endif
+
+    /**
+     * @brief Feeds a block of data to the digest.
+     *
+     * @param data Data to hash.
+     *
+     * @return Success, or an error.
+     * @retval idfxx::errc::invalid_state if the digest has already been finished.
+     */
+    [[nodiscard]] result<void> try_update(std::span<const uint8_t> data);
+
+    /**
+     * @brief Finishes the computation and returns the digest.
+     *
+     * The context cannot be updated after this call.
+     *
+     * @return The 32-byte SHA-256 digest, or an error.
+     * @retval idfxx::errc::invalid_state if the digest has already been finished.
+     */
+    [[nodiscard]] result<std::array<uint8_t, digest_size>> try_finish();
+
+    /**
+     * @brief Finishes the computation and compares the digest to an expected value.
+     *
+     * The comparison does not short-circuit, so its timing does not depend on
+     * where the digests first differ.
+     *
+     * @param expected The expected 32-byte SHA-256 digest.
+     *
+     * @return Success if the digests match, or an error.
+     * @retval idfxx::errc::invalid_crc if the digests differ.
+     * @retval idfxx::errc::invalid_state if the digest has already been finished.
+     */
+    [[nodiscard]] result<void> try_verify(std::span<const uint8_t, digest_size> expected);
+
+private:
+    struct impl;
+
+    explicit sha256_context(std::unique_ptr<impl> impl);
+
+    std::unique_ptr<impl> _impl;
+    size_t _size = 0;
+};
+
 #ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
 inline partition::mmap_handle partition::mmap(size_t offset, size_t size, enum mmap_memory memory) const {
     return unwrap(try_mmap(offset, size, memory));
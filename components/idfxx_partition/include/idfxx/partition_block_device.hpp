@@ -0,0 +1,251 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+#pragma once
+
+/**
+ * @headerfile <idfxx/partition_block_device>
+ * @file partition_block_device.hpp
+ * @brief Sector-cached buffered access to a flash partition.
+ *
+ * @addtogroup idfxx_partition
+ * @{
+ */
+
+#include <idfxx/error>
+#include <idfxx/flags>
+#include <idfxx/memory>
+#include <idfxx/partition>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+namespace idfxx {
+
+/**
+ * @headerfile <idfxx/partition_block_device>
+ * @brief Byte-addressable, write-back cached view of a flash partition.
+ *
+ * Raw partition writes require the caller to deal with erase granularity:
+ * changing a few bytes means reading the surrounding sector, erasing it, and
+ * writing it back. This class keeps a small LRU cache of whole-sector buffers
+ * and does that read-modify-write internally, so callers can write arbitrary
+ * byte ranges at arbitrary offsets.
+ *
+ * Writes land in the cached sector and are only written back when the sector
+ * is evicted or when @ref flush / @ref try_flush is called, so repeated writes
+ * to the same sector coalesce into a single erase. When a write-back only
+ * clears bits relative to the current flash contents (for example, appending
+ * into previously erased space), the sector is programmed in place without an
+ * erase. Encrypted partitions always take the erase path.
+ *
+ * Reads are served from the cache when the sector is resident, and otherwise
+ * go straight to flash without displacing cached sectors.
+ *
+ * The destructor flushes any dirty sectors on a best-effort basis; call
+ * @ref flush / @ref try_flush explicitly to observe write-back errors. Not
+ * thread-safe: serialize access externally if shared between tasks. Move-only.
+ *
+ * @code
+ * auto part = idfxx::partition::find("config");
+ * idfxx::partition_block_device dev(part, {.cache_sectors = 2});
+ *
+ * dev.write(0x10, {reinterpret_cast<const uint8_t*>(&settings), sizeof(settings)});
+ * dev.write(0x80, calibration_bytes); // same sector: no extra erase
+ * dev.flush();
+ * @endcode
+ */
+class partition_block_device {
+public:
+    /**
+     * @headerfile <idfxx/partition_block_device>
+     * @brief Block device configuration.
+     */
+    struct config {
+        /// Number of sector buffers in the LRU cache (at least 1). Each costs one erase block of RAM.
+        size_t cache_sectors = 2;
+        /// Memory capabilities for the sector buffers.
+        flags<memory::capabilities> buffer_mem = memory::capabilities::dram;
+    };
+
+    /**
+     * @headerfile <idfxx/partition_block_device>
+     * @brief Cumulative cache and flash activity counters.
+     */
+    struct stats {
+        uint32_t cache_hits = 0;   ///< Reads or writes served by a resident sector.
+        uint32_t cache_misses = 0; ///< Sectors loaded from flash to service a write.
+        uint32_t write_backs = 0;  ///< Dirty sectors written back to flash.
+        uint32_t erases = 0;       ///< Sector erases performed.
+        /// Erases avoided by coalescing: writes that needed an erase but landed in a cached
+        /// sector already awaiting one, so one erase covered both.
+        uint32_t erases_saved = 0;
+
+        /** @brief Compares two sets of counters for equality. */
+        [[nodiscard]] constexpr bool operator==(const stats&) const noexcept = default;
+    };
+
+#ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
+    /**
+     * @brief Creates a block device over a partition with the default configuration.
+     *
+     * @param part Partition to access.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on failure.
+     * @throws std::bad_alloc if the sector buffers cannot be allocated.
+     */
+    [[nodiscard]] explicit partition_block_device(partition part);
+
+    /**
+     * @brief Creates a block device over a partition.
+     *
+     * @param part   Partition to access.
+     * @param config Cache configuration.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on failure.
+     * @throws std::bad_alloc if the sector buffers cannot be allocated.
+     */
+    [[nodiscard]] explicit partition_block_device(partition part, const config& config);
+#endif
+
+    /**
+     * @brief Creates a block device over a partition with the default configuration.
+     *
+     * @param part Partition to access.
+     *
+     * @return The block device, or an error.
+     * @retval idfxx::errc::not_allowed if the partition is read-only.
+     */
+    [[nodiscard]] static result<partition_block_device> make(partition part);
+
+    /**
+     * @brief Creates a block device over a partition.
+     *
+     * @param part   Partition to access.
+     * @param config Cache configuration.
+     *
+     * @return The block device, or an error.
+     * @retval idfxx::errc::invalid_arg if `cache_sectors` is zero.
+     * @retval idfxx::errc::not_allowed if the partition is read-only.
+     */
+    [[nodiscard]] static result<partition_block_device> make(partition part, const config& config);
+
+    /**
+     * @brief Flushes dirty sectors and releases the sector buffers.
+     *
+     * Write-back errors are logged and otherwise ignored.
+     */
+    ~partition_block_device();
+
+    partition_block_device(const partition_block_device&) = delete;
+    partition_block_device& operator=(const partition_block_device&) = delete;
+
+    /** @brief Move constructor. Transfers the cache, including any dirty sectors. */
+    partition_block_device(partition_block_device&& other) noexcept;
+
+    /** @brief Move assignment. Flushes this device's dirty sectors before taking over. */
+    partition_block_device& operator=(partition_block_device&& other) noexcept;
+
+    /** @brief Returns the underlying partition. */
+    [[nodiscard]] const partition& part() const noexcept;
+
+    /** @brief Returns the device size in bytes (the partition size). */
+    [[nodiscard]] size_t size() const noexcept;
+
+    /** @brief Returns the sector (erase block) size in bytes. */
+    [[nodiscard]] size_t sector_size() const noexcept;
+
+    /** @brief Returns true if any cached sector has not yet been written back. */
+    [[nodiscard]] bool dirty() const noexcept;
+
+    /** @brief Returns the cumulative cache and flash activity counters. */
+    [[nodiscard]] const stats& statistics() const noexcept;
+
+#ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
+    /**
+     * @brief Reads data, observing any writes not yet flushed.
+     *
+     * @param offset Byte offset within the partition.
+     * @param dst    Destination span.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on failure.
+     */
+    void read(size_t offset, std::span<uint8_t> dst) { unwrap(try_read(offset, dst)); }
+
+    /**
+     * @brief Writes data into the sector cache.
+     *
+     * May write back an evicted sector to make room.
+     *
+     * @param offset Byte offset within the partition.
+     * @param src    Source span.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on failure.
+     */
+    void write(size_t offset, std::span<const uint8_t> src) { unwrap(try_write(offset, src)); }
+
+    /**
+     * @brief Writes all dirty sectors back to flash.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on failure.
+     */
+    void flush() { unwrap(try_flush()); }
+#endif
+
+    /**
+     * @brief Reads data, observing any writes not yet flushed.
+     *
+     * @param offset Byte offset within the partition.
+     * @param dst    Destination span.
+     *
+     * @return Success, or an error.
+     * @retval idfxx::errc::invalid_size if the range extends past the end of the partition.
+     */
+    [[nodiscard]] result<void> try_read(size_t offset, std::span<uint8_t> dst);
+
+    /**
+     * @brief Writes data into the sector cache.
+     *
+     * May write back an evicted sector to make room. If that write-back
+     * fails, the evicted sector stays cached and dirty and the error is
+     * returned. When the write touches no more sectors than the cache
+     * holds, every touched sector is made resident first, so on error none
+     * of this write has been applied. A longer write is applied one sector
+     * at a time and may be partially applied when an error is returned.
+     *
+     * @param offset Byte offset within the partition.
+     * @param src    Source span.
+     *
+     * @return Success, or an error.
+     * @retval idfxx::errc::invalid_size if the range extends past the end of the partition.
+     */
+    [[nodiscard]] result<void> try_write(size_t offset, std::span<const uint8_t> src);
+
+    /**
+     * @brief Writes all dirty sectors back to flash, in ascending address order.
+     *
+     * Sectors stay cached (and clean) afterwards.
+     *
+     * @return Success, or an error.
+     */
+    [[nodiscard]] result<void> try_flush();
+
+private:
+    /// @cond INTERNAL
+    struct state;
+    explicit partition_block_device(std::unique_ptr<state> s) noexcept;
+    /// @endcond
+
+    std::unique_ptr<state> _state;
+};
+
+} // namespace idfxx
+
+/** @} */ // end of idfxx_partition
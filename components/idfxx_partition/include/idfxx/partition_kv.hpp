@@ -0,0 +1,256 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+#pragma once
+
+/**
+ * @headerfile <idfxx/partition_kv>
+ * @file partition_kv.hpp
+ * @brief Read-only key/value tables served from memory-mapped flash.
+ *
+ * @addtogroup idfxx_partition
+ * @{
+ */
+
+#include <idfxx/error>
+#include <idfxx/partition>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace idfxx {
+
+/**
+ * @headerfile <idfxx/partition_kv>
+ * @brief Read-only key/value table stored in a data partition.
+ *
+ * The table is an immutable image: a header, an index of fixed-size entries
+ * sorted by key hash, and a heap holding the key and value bytes. Opening
+ * the table validates the header, memory-maps the image and checks that
+ * every index entry lies within it, after which
+ * lookups are a binary search over the index in flash, returning values as
+ * views straight into the mapping. Nothing is parsed or copied into RAM.
+ *
+ * Images are produced either on the host with `scripts/kv_build.py` and
+ * flashed into the partition, or on the device with @ref partition_kv_builder.
+ *
+ * Values are aligned to 4 bytes within the image, so tables of 32-bit
+ * words or floats can be reinterpreted in place.
+ *
+ * @code
+ * idfxx::partition_kv profiles(idfxx::partition::find("profiles"));
+ *
+ * if (auto name = profiles.find_string("device.42.name")) {
+ *     show(*name);
+ * }
+ * @endcode
+ */
+class partition_kv {
+public:
+    /**
+     * @headerfile <idfxx/partition_kv>
+     * @brief A key and its value, as views into the mapped image.
+     */
+    struct entry {
+        std::string_view key;           ///< Key bytes.
+        std::span<const uint8_t> value; ///< Value bytes.
+    };
+
+#ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
+    /**
+     * @brief Opens the table stored in a partition.
+     *
+     * @param part   Partition holding the image.
+     * @param verify Also check the CRC of the whole image, which reads all of it once.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on failure.
+     */
+    [[nodiscard]] explicit partition_kv(partition part, bool verify = false);
+#endif
+
+    /**
+     * @brief Opens the table stored in a partition.
+     *
+     * @param part   Partition holding the image.
+     * @param verify Also check the CRC of the whole image, which reads all of it once.
+     *
+     * @return The table, or an error.
+     * @retval idfxx::errc::not_found if the partition does not hold a table image.
+     * @retval idfxx::errc::invalid_version if the image uses an unsupported format version.
+     * @retval idfxx::errc::invalid_crc if the header, or with @p verify the image, is corrupt.
+     * @retval idfxx::errc::invalid_size if the image does not fit in the partition, or its
+     *         layout or any index entry lies outside the image.
+     */
+    [[nodiscard]] static result<partition_kv> make(partition part, bool verify = false);
+
+    partition_kv(const partition_kv&) = delete;
+    partition_kv& operator=(const partition_kv&) = delete;
+
+    /** @brief Move constructor. */
+    partition_kv(partition_kv&&) noexcept = default;
+
+    /** @brief Move assignment. */
+    partition_kv& operator=(partition_kv&&) noexcept = default;
+
+    /** @brief Returns the number of entries. */
+    [[nodiscard]] size_t size() const noexcept { return _count; }
+
+    /** @brief Returns true if the table has no entries. */
+    [[nodiscard]] bool empty() const noexcept { return _count == 0; }
+
+    /**
+     * @brief Looks up a key.
+     *
+     * @param key Key to find.
+     *
+     * @return A view of the value, or `std::nullopt` if the key is absent.
+     */
+    [[nodiscard]] std::optional<std::span<const uint8_t>> find(std::string_view key) const noexcept;
+
+    /**
+     * @brief Looks up a key whose value is text.
+     *
+     * @param key Key to find.
+     *
+     * @return A view of the value as characters, or `std::nullopt` if the key is absent.
+     */
+    [[nodiscard]] std::optional<std::string_view> find_string(std::string_view key) const noexcept;
+
+    /**
+     * @brief Returns true if the table contains a key.
+     *
+     * @param key Key to find.
+     */
+    [[nodiscard]] bool contains(std::string_view key) const noexcept { return find(key).has_value(); }
+
+    /**
+     * @brief Returns the entry at a position in index order.
+     *
+     * Entries are ordered by key hash, not by key; iterate over
+     * `[0, size())` to visit every entry.
+     *
+     * @param i Position, less than size().
+     */
+    [[nodiscard]] entry at(size_t i) const noexcept;
+
+    /**
+     * @brief Computes the key hash used by the index (32-bit FNV-1a).
+     *
+     * @param key Key to hash.
+     */
+    [[nodiscard]] static constexpr uint32_t hash(std::string_view key) noexcept {
+        uint32_t h = 0x811c9dc5;
+        for (char c : key) {
+            h = (h ^ static_cast<uint8_t>(c)) * 0x01000193;
+        }
+        return h;
+    }
+
+private:
+    /// @cond INTERNAL
+    partition_kv(partition::mmap_handle map, size_t count, size_t heap_offset) noexcept;
+    /// @endcond
+
+    partition::mmap_handle _map;
+    size_t _count;
+    size_t _heap_offset;
+};
+
+/**
+ * @headerfile <idfxx/partition_kv>
+ * @brief Builds a @ref partition_kv image on the device.
+ *
+ * Collects entries in RAM, then lays out and writes the whole image to a
+ * partition. The header is written last, so an interrupted build leaves a
+ * partition that @ref partition_kv::make reports as `not_found` rather than
+ * a truncated table. Move-only.
+ *
+ * @code
+ * idfxx::partition_kv_builder b;
+ * b.add("greeting.en", "Hello");
+ * b.add("greeting.fr", "Bonjour");
+ * b.write(idfxx::partition::find("strings"));
+ * @endcode
+ */
+class partition_kv_builder {
+public:
+    /** @brief Creates an empty builder. */
+    partition_kv_builder() = default;
+
+    partition_kv_builder(const partition_kv_builder&) = delete;
+    partition_kv_builder& operator=(const partition_kv_builder&) = delete;
+
+    /** @brief Move constructor. */
+    partition_kv_builder(partition_kv_builder&&) noexcept = default;
+
+    /** @brief Move assignment. */
+    partition_kv_builder& operator=(partition_kv_builder&&) noexcept = default;
+
+    /**
+     * @brief Adds an entry.
+     *
+     * @param key   Key; must be unique within the table.
+     * @param value Value bytes, copied into the builder.
+     */
+    void add(std::string_view key, std::span<const uint8_t> value);
+
+    /**
+     * @brief Adds an entry with a text value.
+     *
+     * @param key   Key; must be unique within the table.
+     * @param value Value text, copied into the builder.
+     */
+    void add(std::string_view key, std::string_view value) {
+        add(key, {reinterpret_cast<const uint8_t*>(value.data()), value.size()});
+    }
+
+    /** @brief Returns the number of entries added so far. */
+    [[nodiscard]] size_t size() const noexcept { return _entries.size(); }
+
+    /** @brief Returns the size in bytes of the image that would be written. */
+    [[nodiscard]] size_t image_size() const noexcept;
+
+#ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
+    /**
+     * @brief Erases the start of a partition and writes the image to it.
+     *
+     * @param part Destination partition.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on failure.
+     */
+    void write(partition part) const { unwrap(try_write(part)); }
+#endif
+
+    /**
+     * @brief Erases the start of a partition and writes the image to it.
+     *
+     * @param part Destination partition.
+     *
+     * @return Success, or an error.
+     * @retval idfxx::errc::invalid_arg if two entries share a key.
+     * @retval idfxx::errc::invalid_size if the image does not fit in the partition.
+     * @retval idfxx::errc::not_allowed if the partition is read-only.
+     */
+    [[nodiscard]] result<void> try_write(partition part) const;
+
+private:
+    /// @cond INTERNAL
+    struct pending {
+        std::string key;
+        std::vector<uint8_t> value;
+    };
+    /// @endcond
+
+    std::vector<pending> _entries;
+};
+
+} // namespace idfxx
+
+/** @} */ // end of idfxx_partition
@@ -0,0 +1,279 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+#pragma once
+
+/**
+ * @headerfile <idfxx/partition_log>
+ * @file partition_log.hpp
+ * @brief Append-only time-series record log on a flash partition.
+ *
+ * @addtogroup idfxx_partition
+ * @{
+ */
+
+#include <idfxx/error>
+#include <idfxx/partition>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+
+namespace idfxx {
+
+/**
+ * @headerfile <idfxx/partition_log>
+ * @brief Append-only, sector-rotating log of fixed-size timestamped records.
+ *
+ * Records are written sequentially through the partition's erase sectors and
+ * wrap around when the partition fills, erasing the oldest sector. Every
+ * sector is therefore erased once per pass over the partition, spreading
+ * wear evenly. Each sector starts with a small header carrying a sequence
+ * number; each record is framed with its timestamp and a CRC-32.
+ *
+ * Appended records are buffered in RAM and written in batches, so one flash
+ * write covers many records. Records still buffered are lost on power loss;
+ * call @ref flush / @ref try_flush at points that must be durable.
+ *
+ * Opening the log reads each sector's header and first timestamp, which
+ * forms a sparse in-RAM time index (one entry per sector), and then scans
+ * only the newest sector to find the append position. A record torn by
+ * power loss fails its CRC and is skipped.
+ *
+ * The whole partition is memory-mapped while the log is open, so queries
+ * return records as spans directly into flash without copying.
+ *
+ * Timestamps are caller-defined (e.g. Unix milliseconds) but must not
+ * decrease, including across restarts, since the newest timestamp is
+ * recovered when the log is opened. Encrypted partitions are not supported.
+ * Not thread-safe: serialize access externally if shared between tasks.
+ * Move-only.
+ *
+ * @code
+ * idfxx::partition_log log(idfxx::partition::find("samples"), {.record_size = sizeof(sample)});
+ *
+ * log.append(unix_time_ms(), {reinterpret_cast<const uint8_t*>(&s), sizeof(s)});
+ *
+ * auto c = log.query(t0, t1);
+ * while (auto rec = c.next()) {
+ *     process(rec->timestamp, rec->data);
+ * }
+ * @endcode
+ */
+class partition_log {
+    /// @cond INTERNAL
+    struct state;
+    /// @endcond
+
+public:
+    /**
+     * @headerfile <idfxx/partition_log>
+     * @brief Log configuration.
+     */
+    struct config {
+        /// Payload bytes per record. Must match the size the log was written with.
+        size_t record_size = 0;
+        /// Records buffered in RAM before they are written to flash (at least 1).
+        size_t batch_records = 16;
+    };
+
+    /**
+     * @headerfile <idfxx/partition_log>
+     * @brief A record returned by a query.
+     */
+    struct record {
+        uint64_t timestamp;            ///< Record timestamp.
+        std::span<const uint8_t> data; ///< Payload (`record_size` bytes).
+    };
+
+    /**
+     * @headerfile <idfxx/partition_log>
+     * @brief Forward iterator over the records in a time range.
+     *
+     * Records are yielded oldest first. Any append, flush or clear on the
+     * log invalidates the cursor and the spans it has returned.
+     */
+    class cursor {
+    public:
+        /**
+         * @brief Returns the next record in the range.
+         *
+         * @return The record, or `std::nullopt` when the range is exhausted.
+         */
+        [[nodiscard]] std::optional<record> next() noexcept;
+
+    private:
+        friend class partition_log;
+
+        cursor(const state* log, size_t entry, size_t offset, uint64_t from, uint64_t to) noexcept
+            : _log(log)
+            , _entry(entry)
+            , _offset(offset)
+            , _from(from)
+            , _to(to) {}
+
+        const state* _log;
+        size_t _entry;
+        size_t _offset;
+        uint64_t _from;
+        uint64_t _to;
+    };
+
+#ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
+    /**
+     * @brief Opens (or formats, if empty) a log on a partition.
+     *
+     * @param part   Data partition to store the log in.
+     * @param config Log configuration.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on failure.
+     */
+    [[nodiscard]] explicit partition_log(partition part, const config& config);
+#endif
+
+    /**
+     * @brief Opens (or formats, if empty) a log on a partition.
+     *
+     * @param part   Data partition to store the log in.
+     * @param config Log configuration.
+     *
+     * @return The log, or an error.
+     * @retval idfxx::errc::invalid_arg if `record_size` or `batch_records` is zero.
+     * @retval idfxx::errc::invalid_size if the partition has fewer than two sectors or a
+     *         record does not fit in a sector.
+     * @retval idfxx::errc::invalid_state if the partition holds a log with a different record size.
+     * @retval idfxx::errc::not_allowed if the partition is read-only.
+     * @retval idfxx::errc::not_supported if the partition is encrypted.
+     */
+    [[nodiscard]] static result<partition_log> make(partition part, const config& config);
+
+    /**
+     * @brief Flushes buffered records and unmaps the partition.
+     *
+     * Write errors are logged and otherwise ignored.
+     */
+    ~partition_log();
+
+    partition_log(const partition_log&) = delete;
+    partition_log& operator=(const partition_log&) = delete;
+
+    /** @brief Move constructor. */
+    partition_log(partition_log&& other) noexcept;
+
+    /** @brief Move assignment. Flushes this log's buffered records first. */
+    partition_log& operator=(partition_log&& other) noexcept;
+
+    /** @brief Returns the underlying partition. */
+    [[nodiscard]] const partition& part() const noexcept;
+
+    /** @brief Returns the payload size of each record. */
+    [[nodiscard]] size_t record_size() const noexcept;
+
+    /** @brief Returns the number of records that fit in one sector. */
+    [[nodiscard]] size_t records_per_sector() const noexcept;
+
+    /** @brief Returns the number of sectors the log rotates through. */
+    [[nodiscard]] size_t sector_count() const noexcept;
+
+    /** @brief Returns the number of appended records not yet written to flash. */
+    [[nodiscard]] size_t pending() const noexcept;
+
+    /** @brief Returns true if the log holds no records, including buffered ones. */
+    [[nodiscard]] bool empty() const noexcept;
+
+    /** @brief Returns the timestamp of the oldest record, if any. */
+    [[nodiscard]] std::optional<uint64_t> oldest() const noexcept;
+
+    /** @brief Returns the timestamp of the newest record, if any. */
+    [[nodiscard]] std::optional<uint64_t> newest() const noexcept;
+
+    /**
+     * @brief Returns a cursor over records with `from <= timestamp < to`.
+     *
+     * The sparse time index locates the first sector to scan, so the cost is
+     * proportional to the records in range rather than the log size.
+     * Buffered records are included.
+     *
+     * @param from Inclusive lower timestamp bound.
+     * @param to   Exclusive upper timestamp bound.
+     *
+     * @return A cursor over the matching records.
+     */
+    [[nodiscard]] cursor query(uint64_t from = 0, uint64_t to = UINT64_MAX) const noexcept;
+
+#ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
+    /**
+     * @brief Appends a record.
+     *
+     * @param timestamp Record timestamp. Must not be less than the newest record's.
+     * @param data      Payload of exactly `record_size` bytes.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on failure.
+     */
+    void append(uint64_t timestamp, std::span<const uint8_t> data) { unwrap(try_append(timestamp, data)); }
+
+    /**
+     * @brief Writes buffered records to flash.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on failure.
+     */
+    void flush() { unwrap(try_flush()); }
+
+    /**
+     * @brief Erases every record, including buffered ones.
+     *
+     * @note Only available when CONFIG_COMPILER_CXX_EXCEPTIONS is enabled in menuconfig.
+     * @throws std::system_error on failure.
+     */
+    void clear() { unwrap(try_clear()); }
+#endif
+
+    /**
+     * @brief Appends a record.
+     *
+     * The record is buffered and written once `batch_records` records are
+     * pending or the current sector fills. Starting a new sector erases the
+     * oldest one when the partition is full.
+     *
+     * @param timestamp Record timestamp. Must not be less than the newest record's.
+     * @param data      Payload of exactly `record_size` bytes.
+     *
+     * @return Success, or an error.
+     * @retval idfxx::errc::invalid_size if `data` is not `record_size` bytes.
+     * @retval idfxx::errc::invalid_arg if `timestamp` is older than the newest record or is `UINT64_MAX`.
+     */
+    [[nodiscard]] result<void> try_append(uint64_t timestamp, std::span<const uint8_t> data);
+
+    /**
+     * @brief Writes buffered records to flash.
+     *
+     * If the write fails, the buffered records are dropped and the rest of
+     * the current sector is abandoned, since it may be partially programmed.
+     *
+     * @return Success, or an error.
+     */
+    [[nodiscard]] result<void> try_flush();
+
+    /**
+     * @brief Erases every record, including buffered ones.
+     *
+     * @return Success, or an error.
+     */
+    [[nodiscard]] result<void> try_clear();
+
+private:
+    /// @cond INTERNAL
+    explicit partition_log(std::unique_ptr<state> s) noexcept;
+    /// @endcond
+
+    std::unique_ptr<state> _state;
+};
+
+} // namespace idfxx
+
+/** @} */ // end of idfxx_partition
@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: Apache-2.0
+"""Build an idfxx::partition_kv image for flashing into a data partition.
+
+Usage:
+    kv_build.py [--json FILE]... [--string KEY=VALUE]... [--file KEY=PATH]... -o OUT.bin
+
+--json adds every member of a JSON object: string values are stored as UTF-8
+text, and any other value is stored as its compact JSON encoding. --string
+adds a text value and --file adds a file's contents as a binary value. Keys
+must be unique across all inputs.
+
+Flash the result with, for example:
+    parttool.py write_partition --partition-name=profiles --input=OUT.bin
+
+The layout matches src/partition_kv.cpp (all fields little-endian):
+    header  32 bytes: magic "KVX1", version, flags, count, index_offset,
+                      heap_offset, total_size, data_crc, header_crc
+    index   20 bytes per entry, sorted by (FNV-1a hash, key bytes):
+                      hash, key_offset, key_size, value_offset, value_size
+    heap    key and value bytes, each padded to 4 bytes; offsets relative to heap
+"""
+
+import argparse
+import json
+import struct
+import sys
+import zlib
+
+MAGIC = 0x3158564B  # "KVX1"
+VERSION = 1
+HEADER = struct.Struct("<IHHIIIIII")
+ENTRY = struct.Struct("<IIIII")
+VALUE_ALIGNMENT = 4
+
+
+def fnv1a(data):
+    h = 0x811C9DC5
+    for b in data:
+        h = ((h ^ b) * 0x01000193) & 0xFFFFFFFF
+    return h
+
+
+def align(n):
+    return (n + VALUE_ALIGNMENT - 1) // VALUE_ALIGNMENT * VALUE_ALIGNMENT
+
+
+def build(entries):
+    """Return the image bytes for a dict of bytes keys to bytes values."""
+    order = sorted(entries.items(), key=lambda kv: (fnv1a(kv[0]), kv[0]))
+
+    index = bytearray()
+    heap = bytearray()
+    for key, value in order:
+        key_offset = len(heap)
+        heap += key + bytes(align(len(key)) - len(key))
+        value_offset = len(heap)
+        heap += value + bytes(align(len(value)) - len(value))
+        index += ENTRY.pack(fnv1a(key), key_offset, len(key), value_offset, len(value))
+
+    index_offset = HEADER.size
+    heap_offset = index_offset + len(index)
+    total_size = heap_offset + len(heap)
+    data_crc = zlib.crc32(index + heap)
+    fields = [MAGIC, VERSION, 0, len(order), index_offset, heap_offset, total_size, data_crc]
+    header_crc = zlib.crc32(HEADER.pack(*fields, 0)[: HEADER.size - 4])
+    return HEADER.pack(*fields, header_crc) + index + heap
+
+
+def split_pair(arg):
+    key, sep, value = arg.partition("=")
+    if not sep:
+        sys.exit(f"error: expected KEY=VALUE, got {arg!r}")
+    return key, value
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--json", action="append", default=[], metavar="FILE")
+    parser.add_argument("--string", action="append", default=[], metavar="KEY=VALUE")
+    parser.add_argument("--file", action="append", default=[], metavar="KEY=PATH")
+    parser.add_argument("-o", "--output", required=True)
+    args = parser.parse_args()
+
+    entries = {}
+
+    def add(key, value):
+        k = key.encode()
+        if k in entries:
+            sys.exit(f"error: duplicate key {key!r}")
+        entries[k] = value
+
+    for path in args.json:
+        with open(path, encoding="utf-8") as f:
+            obj = json.load(f)
+        if not isinstance(obj, dict):
+            sys.exit(f"error: {path}: top level must be an object")
+        for key, value in obj.items():
+            if isinstance(value, str):
+                add(key, value.encode())
+            else:
+                add(key, json.dumps(value, separators=(",", ":")).encode())
+    for arg in args.string:
+        key, value = split_pair(arg)
+        add(key, value.encode())
+    for arg in args.file:
+        key, path = split_pair(arg)
+        with open(path, "rb") as f:
+            add(key, f.read())
+
+    image = build(entries)
+    with open(args.output, "wb") as f:
+        f.write(image)
+    print(f"{args.output}: {len(entries)} entries, {len(image)} bytes", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
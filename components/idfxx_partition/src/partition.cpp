@@ -6,10 +6,17 @@
 
 #include <algorithm>
 #include <array>
+#include <esp_idf_version.h>
 #include <esp_log.h>
 #include <esp_partition.h>
 #include <utility>
 
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(6, 0, 0)
+#include <psa/crypto.h>
+#else
+#include <mbedtls/sha256.h>
+#endif
+
 // Verify type enum values match ESP-IDF constants
 static_assert(std::to_underlying(idfxx::partition::type::app) == ESP_PARTITION_TYPE_APP);
 static_assert(std::to_underlying(idfxx::partition::type::data) == ESP_PARTITION_TYPE_DATA);
@@ -188,6 +195,16 @@ result<void> partition::try_read_raw(size_t offset, std::span<uint8_t> dst) cons
     return try_read_raw(offset, dst.data(), dst.size());
 }
 
+result<void> partition::try_write(size_t offset, std::span<const uint8_t> src, sha256_context& hash) {
+    if (hash.finished()) {
+        return error(errc::invalid_state);
+    }
+    if (auto r = try_write(offset, src.data(), src.size()); !r) {
+        return r;
+    }
+    return hash.try_update(src);
+}
+
 result<void> partition::try_write_raw(size_t offset, const void* src, size_t size) {
     return checked(esp_partition_write_raw(_part, offset, src, size), "write_raw");
 }
@@ -266,4 +283,120 @@ esp_partition_mmap_handle_t partition::mmap_handle::release() noexcept {
     return handle;
 }
 
+// =========================================================================
+// sha256_context
+// =========================================================================
+
+// Both backends route SHA-256 through the hardware accelerator when the target
+// has one (CONFIG_MBEDTLS_HARDWARE_SHA on 5.x, the ESP PSA driver on 6.x).
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(6, 0, 0)
+struct partition::sha256_context::impl {
+    psa_hash_operation_t op = PSA_HASH_OPERATION_INIT;
+
+    ~impl() { psa_hash_abort(&op); }
+
+    esp_err_t start() {
+        if (psa_crypto_init() != PSA_SUCCESS || psa_hash_setup(&op, PSA_ALG_SHA_256) != PSA_SUCCESS) {
+            return ESP_FAIL;
+        }
+        return ESP_OK;
+    }
+
+    esp_err_t update(std::span<const uint8_t> data) {
+        return psa_hash_update(&op, data.data(), data.size()) == PSA_SUCCESS ? ESP_OK : ESP_FAIL;
+    }
+
+    esp_err_t finish(std::span<uint8_t, sha256_context::digest_size> out) {
+        size_t len = 0;
+        return psa_hash_finish(&op, out.data(), out.size(), &len) == PSA_SUCCESS ? ESP_OK : ESP_FAIL;
+    }
+};
+#else
+struct partition::sha256_context::impl {
+    mbedtls_sha256_context ctx;
+
+    impl() { mbedtls_sha256_init(&ctx); }
+    ~impl() { mbedtls_sha256_free(&ctx); }
+
+    esp_err_t start() { return mbedtls_sha256_starts(&ctx, 0) == 0 ? ESP_OK : ESP_FAIL; }
+
+    esp_err_t update(std::span<const uint8_t> data) {
+        return mbedtls_sha256_update(&ctx, data.data(), data.size()) == 0 ? ESP_OK : ESP_FAIL;
+    }
+
+    esp_err_t finish(std::span<uint8_t, sha256_context::digest_size> out) {
+        return mbedtls_sha256_finish(&ctx, out.data()) == 0 ? ESP_OK : ESP_FAIL;
+    }
+};
+#endif
+
+#ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
+partition::sha256_context::sha256_context()
+    : sha256_context(unwrap(make())) {}
+#endif
+
+result<partition::sha256_context> partition::sha256_context::make() {
+    auto state = std::make_unique<impl>();
+    if (auto r = checked(state->start(), "sha256 start"); !r) {
+        return error(r.error());
+    }
+    return sha256_context{std::move(state)};
+}
+
+partition::sha256_context::sha256_context(std::unique_ptr<impl> state)
+    : _impl(std::move(state)) {}
+
+partition::sha256_context::~sha256_context() = default;
+
+partition::sha256_context::sha256_context(sha256_context&& other) noexcept
+    : _impl(std::move(other._impl))
+    , _size(std::exchange(other._size, 0)) {}
+
+partition::sha256_context& partition::sha256_context::operator=(sha256_context&& other) noexcept {
+    if (this != &other) {
+        _impl = std::move(other._impl);
+        _size = std::exchange(other._size, 0);
+    }
+    return *this;
+}
+
+result<void> partition::sha256_context::try_update(std::span<const uint8_t> data) {
+    if (_impl == nullptr) {
+        return error(errc::invalid_state);
+    }
+    if (auto r = checked(_impl->update(data), "sha256 update"); !r) {
+        return r;
+    }
+    _size += data.size();
+    return {};
+}
+
+result<std::array<uint8_t, partition::sha256_context::digest_size>> partition::sha256_context::try_finish() {
+    if (_impl == nullptr) {
+        return error(errc::invalid_state);
+    }
+    auto state = std::move(_impl);
+    std::array<uint8_t, digest_size> digest{};
+    if (auto r = checked(state->finish(digest), "sha256 finish"); !r) {
+        return error(r.error());
+    }
+    return digest;
+}
+
+result<void> partition::sha256_context::try_verify(std::span<const uint8_t, digest_size> expected) {
+    auto digest = try_finish();
+    if (!digest) {
+        return error(digest.error());
+    }
+    uint8_t diff = 0;
+    for (size_t i = 0; i < digest_size; ++i) {
+        diff |= (*digest)[i] ^ expected[i];
+    }
+    if (diff != 0) {
+        ESP_LOGD(TAG, "sha256 digest mismatch after %zu bytes", _size);
+        return error(errc::invalid_crc);
+    }
+    return {};
+}
+
 } // namespace idfxx
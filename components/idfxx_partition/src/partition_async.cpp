@@ -0,0 +1,203 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+#include <idfxx/error>
+#include <idfxx/future>
+#include <idfxx/partition>
+#include <idfxx/task>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <esp_log.h>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace {
+const char* TAG = "idfxx::partition";
+}
+
+namespace idfxx {
+
+namespace {
+
+// Reads and writes are split so a stop request is observed within one chunk.
+constexpr size_t io_chunk_size = 4096;
+// Erasing 64 KB takes long enough that checking more often buys little, and
+// it lets the flash driver use block erase where the chip supports it.
+constexpr size_t erase_chunk_size = 64 * 1024;
+
+enum class op_kind { read, write, erase };
+
+// One queued operation. Shared between the worker queue and every copy of
+// the caller's future, so either side may outlive the other.
+struct async_op {
+    op_kind kind;
+    partition part;
+    size_t offset;
+    size_t size;
+    uint8_t* dst = nullptr;
+    const uint8_t* src = nullptr;
+    std::stop_token stop;
+
+    std::mutex mu;
+    std::condition_variable cv;
+    std::atomic<bool> done{false};
+    std::error_code ec;
+
+    async_op(op_kind kind, partition part, size_t offset, size_t size, std::stop_token stop)
+        : kind(kind)
+        , part(part)
+        , offset(offset)
+        , size(size)
+        , stop(std::move(stop)) {}
+
+    void complete(result<void> r) {
+        {
+            std::lock_guard lock(mu);
+            if (!r) {
+                ec = r.error();
+            }
+            done.store(true, std::memory_order_release);
+        }
+        cv.notify_all();
+    }
+
+    result<void> execute() {
+        size_t chunk = io_chunk_size;
+        if (kind == op_kind::erase) {
+            size_t sector = part.erase_size();
+            chunk = std::max(sector, erase_chunk_size / sector * sector);
+        }
+        for (size_t pos = 0; pos < size; pos += chunk) {
+            if (stop.stop_requested()) {
+                ESP_LOGD(TAG, "%s: async op cancelled after %zu of %zu bytes", part.label().data(), pos, size);
+                return error(errc::not_finished);
+            }
+            size_t n = std::min(chunk, size - pos);
+            result<void> r;
+            switch (kind) {
+            case op_kind::read:
+                r = part.try_read(offset + pos, dst + pos, n);
+                break;
+            case op_kind::write:
+                r = part.try_write(offset + pos, src + pos, n);
+                break;
+            case op_kind::erase:
+                r = part.try_erase_range(offset + pos, n);
+                break;
+            }
+            if (!r) {
+                return r;
+            }
+        }
+        return {};
+    }
+};
+
+// Process-wide FIFO of pending operations, drained by a single worker task.
+// A single queue gives per-partition ordering for free and also serializes
+// access to the flash chip, which the SPI flash driver does anyway.
+class flash_worker {
+public:
+    static flash_worker& instance() {
+        // Started on first use and never stopped.
+        static flash_worker* worker = [] {
+            auto* w = new flash_worker;
+            task::spawn({.name = "idfxx_flash", .stack_size = 4096}, [w](task::self&) { w->run(); });
+            return w;
+        }();
+        return *worker;
+    }
+
+    void submit(std::shared_ptr<async_op> op) {
+        {
+            std::lock_guard lock(_mu);
+            _queue.push_back(std::move(op));
+        }
+        _cv.notify_one();
+    }
+
+private:
+    [[noreturn]] void run() {
+        for (;;) {
+            std::shared_ptr<async_op> op;
+            {
+                std::unique_lock lock(_mu);
+                _cv.wait(lock, [this] { return !_queue.empty(); });
+                op = std::move(_queue.front());
+                _queue.pop_front();
+            }
+            op->complete(op->execute());
+        }
+    }
+
+    std::mutex _mu;
+    std::condition_variable _cv;
+    std::deque<std::shared_ptr<async_op>> _queue;
+};
+
+future<void> submit(std::shared_ptr<async_op> op) {
+    flash_worker::instance().submit(op);
+    auto waiter = [op](std::optional<std::chrono::milliseconds> timeout) -> result<void> {
+        std::unique_lock lock(op->mu);
+        auto is_done = [&op] { return op->done.load(std::memory_order_relaxed); };
+        if (timeout) {
+            if (!op->cv.wait_for(lock, *timeout, is_done)) {
+                return error(errc::timeout);
+            }
+        } else {
+            op->cv.wait(lock, is_done);
+        }
+        if (op->ec) {
+            return error(op->ec);
+        }
+        return {};
+    };
+    auto done_check = [op]() noexcept { return op->done.load(std::memory_order_acquire); };
+    return future<void>(std::move(waiter), std::move(done_check));
+}
+
+bool in_range(const partition& part, size_t offset, size_t size) {
+    return offset <= part.size() && size <= part.size() - offset;
+}
+
+} // namespace
+
+result<future<void>> partition::try_read_async(size_t offset, std::span<uint8_t> dst, std::stop_token stop) const {
+    if (!in_range(*this, offset, dst.size())) {
+        return error(errc::invalid_size);
+    }
+    auto op = std::make_shared<async_op>(op_kind::read, *this, offset, dst.size(), std::move(stop));
+    op->dst = dst.data();
+    return submit(std::move(op));
+}
+
+result<future<void>> partition::try_write_async(size_t offset, std::span<const uint8_t> src, std::stop_token stop) {
+    if (!in_range(*this, offset, src.size())) {
+        return error(errc::invalid_size);
+    }
+    if (readonly()) {
+        return error(errc::not_allowed);
+    }
+    auto op = std::make_shared<async_op>(op_kind::write, *this, offset, src.size(), std::move(stop));
+    op->src = src.data();
+    return submit(std::move(op));
+}
+
+result<future<void>> partition::try_erase_async(size_t offset, size_t size, std::stop_token stop) {
+    if (offset % erase_size() != 0 || size % erase_size() != 0) {
+        return error(errc::invalid_arg);
+    }
+    if (!in_range(*this, offset, size)) {
+        return error(errc::invalid_size);
+    }
+    if (readonly()) {
+        return error(errc::not_allowed);
+    }
+    return submit(std::make_shared<async_op>(op_kind::erase, *this, offset, size, std::move(stop)));
+}
+
+} // namespace idfxx
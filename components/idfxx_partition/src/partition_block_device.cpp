@@ -0,0 +1,325 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+#include <idfxx/error>
+#include <idfxx/memory>
+#include <idfxx/partition_block_device>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+#include <esp_log.h>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace {
+const char* TAG = "idfxx::partition_block_device";
+}
+
+namespace idfxx {
+
+namespace {
+
+constexpr uint32_t no_sector = std::numeric_limits<uint32_t>::max();
+
+struct cached_sector {
+    uint8_t* data = nullptr;
+    uint32_t index = no_sector;
+    uint32_t last_use = 0;
+    // Byte range within the sector that differs from flash
+    uint32_t dirty_begin = 0;
+    uint32_t dirty_end = 0;
+    bool needs_erase = false;
+
+    [[nodiscard]] bool dirty() const noexcept { return dirty_end > dirty_begin; }
+};
+
+struct buffer_deleter {
+    void operator()(uint8_t* p) const noexcept { idfxx::free(p); }
+};
+
+} // namespace
+
+struct partition_block_device::state {
+    partition part;
+    size_t sector_size;
+    std::unique_ptr<uint8_t[], buffer_deleter> buffers;
+    std::vector<cached_sector> sectors;
+    uint32_t clock = 0;
+    struct stats stats{};
+
+    state(partition p, size_t sector_size, std::unique_ptr<uint8_t[], buffer_deleter> buffers, size_t count)
+        : part(p)
+        , sector_size(sector_size)
+        , buffers(std::move(buffers))
+        , sectors(count) {
+        for (size_t i = 0; i < count; ++i) {
+            sectors[i].data = this->buffers.get() + i * sector_size;
+        }
+    }
+
+    cached_sector* find(uint32_t index) noexcept {
+        for (auto& s : sectors) {
+            if (s.index == index) {
+                s.last_use = ++clock;
+                return &s;
+            }
+        }
+        return nullptr;
+    }
+
+    result<void> write_back(cached_sector& s) {
+        if (!s.dirty()) {
+            return {};
+        }
+        size_t base = size_t{s.index} * sector_size;
+        if (s.needs_erase) {
+            if (auto r = part.try_erase_range(base, sector_size); !r) {
+                return r;
+            }
+            ++stats.erases;
+            if (auto r = part.try_write(base, s.data, sector_size); !r) {
+                return r;
+            }
+        } else {
+            // Only 1->0 bit transitions: program the changed range in place
+            if (auto r = part.try_write(base + s.dirty_begin, s.data + s.dirty_begin, s.dirty_end - s.dirty_begin);
+                !r) {
+                return r;
+            }
+        }
+        ++stats.write_backs;
+        s.dirty_begin = s.dirty_end = 0;
+        s.needs_erase = false;
+        return {};
+    }
+
+    // Makes `index` resident, evicting the least recently used sector if needed. When
+    // `overwrite` is set the whole sector is about to be replaced, so it is not read.
+    result<cached_sector*> load(uint32_t index, bool overwrite) {
+        auto victim = std::ranges::min_element(sectors, {}, [](const cached_sector& s) {
+            return s.index == no_sector ? 0 : s.last_use;
+        });
+        if (auto r = write_back(*victim); !r) {
+            ESP_LOGD(TAG, "write-back of sector %" PRIu32 " failed on eviction", victim->index);
+            return error(r.error());
+        }
+        victim->index = no_sector;
+        victim->needs_erase = overwrite;
+        if (!overwrite) {
+            if (auto r = part.try_read(size_t{index} * sector_size, victim->data, sector_size); !r) {
+                return error(r.error());
+            }
+        }
+        victim->index = index;
+        victim->last_use = ++clock;
+        ++stats.cache_misses;
+        return &*victim;
+    }
+
+    // Returns `index` from the cache, loading it if it is not resident.
+    result<cached_sector*> resident(uint32_t index, bool overwrite) {
+        if (auto* s = find(index)) {
+            ++stats.cache_hits;
+            return s;
+        }
+        return load(index, overwrite);
+    }
+
+    void flush_quietly() noexcept {
+        if (auto r = flush(); !r) {
+            ESP_LOGW(TAG, "discarding unflushed sectors: %s", r.error().message().c_str());
+        }
+    }
+
+    result<void> flush() {
+        std::vector<cached_sector*> dirty;
+        for (auto& s : sectors) {
+            if (s.dirty()) {
+                dirty.push_back(&s);
+            }
+        }
+        std::ranges::sort(dirty, {}, &cached_sector::index);
+        for (auto* s : dirty) {
+            if (auto r = write_back(*s); !r) {
+                return r;
+            }
+        }
+        return {};
+    }
+};
+
+#ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
+partition_block_device::partition_block_device(partition part)
+    : partition_block_device(part, config{}) {}
+
+partition_block_device::partition_block_device(partition part, const config& config)
+    : partition_block_device(unwrap(make(part, config))) {}
+#endif
+
+result<partition_block_device> partition_block_device::make(partition part) {
+    return make(part, config{});
+}
+
+result<partition_block_device> partition_block_device::make(partition part, const config& config) {
+    if (config.cache_sectors == 0 || part.erase_size() == 0) {
+        return error(errc::invalid_arg);
+    }
+    if (part.readonly()) {
+        return error(errc::not_allowed);
+    }
+    size_t sector_size = part.erase_size();
+    std::unique_ptr<uint8_t[], buffer_deleter> buffers{
+        static_cast<uint8_t*>(idfxx::malloc(config.cache_sectors * sector_size, config.buffer_mem))
+    };
+    if (!buffers) {
+        raise_no_mem();
+    }
+    return partition_block_device{std::make_unique<state>(part, sector_size, std::move(buffers), config.cache_sectors)
+    };
+}
+
+partition_block_device::partition_block_device(std::unique_ptr<state> s) noexcept
+    : _state(std::move(s)) {}
+
+partition_block_device::~partition_block_device() {
+    if (_state) {
+        _state->flush_quietly();
+    }
+}
+
+partition_block_device::partition_block_device(partition_block_device&& other) noexcept = default;
+
+partition_block_device& partition_block_device::operator=(partition_block_device&& other) noexcept {
+    if (this != &other) {
+        if (_state) {
+            _state->flush_quietly();
+        }
+        _state = std::move(other._state);
+    }
+    return *this;
+}
+
+const partition& partition_block_device::part() const noexcept {
+    return _state->part;
+}
+
+size_t partition_block_device::size() const noexcept {
+    return _state->part.size();
+}
+
+size_t partition_block_device::sector_size() const noexcept {
+    return _state->sector_size;
+}
+
+bool partition_block_device::dirty() const noexcept {
+    return std::ranges::any_of(_state->sectors, &cached_sector::dirty);
+}
+
+const partition_block_device::stats& partition_block_device::statistics() const noexcept {
+    return _state->stats;
+}
+
+result<void> partition_block_device::try_read(size_t offset, std::span<uint8_t> dst) {
+    auto& st = *_state;
+    if (offset > st.part.size() || dst.size() > st.part.size() - offset) {
+        return error(errc::invalid_size);
+    }
+    while (!dst.empty()) {
+        auto index = static_cast<uint32_t>(offset / st.sector_size);
+        size_t in_sector = offset % st.sector_size;
+        size_t n = std::min(dst.size(), st.sector_size - in_sector);
+        if (auto* s = st.find(index)) {
+            std::memcpy(dst.data(), s->data + in_sector, n);
+            ++st.stats.cache_hits;
+        } else if (auto r = st.part.try_read(offset, dst.data(), n); !r) {
+            return r;
+        }
+        offset += n;
+        dst = dst.subspan(n);
+    }
+    return {};
+}
+
+result<void> partition_block_device::try_write(size_t offset, std::span<const uint8_t> src) {
+    auto& st = *_state;
+    if (offset > st.part.size() || src.size() > st.part.size() - offset) {
+        return error(errc::invalid_size);
+    }
+    if (src.empty()) {
+        return {};
+    }
+
+    // When every touched sector fits in the cache at once, make them all
+    // resident before changing any, so a failed load or eviction leaves the
+    // write entirely unapplied.
+    const size_t first = offset / st.sector_size;
+    const size_t last = (offset + src.size() - 1) / st.sector_size;
+    const bool preload = last - first < st.sectors.size();
+    if (preload) {
+        for (size_t index = first; index <= last; ++index) {
+            size_t begin = std::max(offset, index * st.sector_size);
+            size_t end = std::min(offset + src.size(), (index + 1) * st.sector_size);
+            if (auto r = st.resident(static_cast<uint32_t>(index), end - begin == st.sector_size); !r) {
+                // Sectors loaded for an overwrite that will not happen hold no flash contents
+                for (auto& s : st.sectors) {
+                    if (s.needs_erase && !s.dirty()) {
+                        s.index = no_sector;
+                    }
+                }
+                return error(r.error());
+            }
+        }
+    }
+
+    while (!src.empty()) {
+        auto index = static_cast<uint32_t>(offset / st.sector_size);
+        auto in_sector = static_cast<uint32_t>(offset % st.sector_size);
+        auto n = static_cast<uint32_t>(std::min(src.size(), st.sector_size - in_sector));
+
+        cached_sector* s = nullptr;
+        if (preload) {
+            s = st.find(index);
+        } else {
+            auto r = st.resident(index, n == st.sector_size);
+            if (!r) {
+                return error(r.error());
+            }
+            s = *r;
+        }
+
+        // A sector loaded for a full overwrite holds no flash contents to
+        // compare against. Otherwise, NOR flash can only clear bits without
+        // an erase, and encrypted data bears no bitwise relation to the
+        // plaintext.
+        uint8_t* dst = s->data + in_sector;
+        bool erase = (s->needs_erase && !s->dirty()) || st.part.encrypted();
+        for (uint32_t i = 0; !erase && i < n; ++i) {
+            erase = (dst[i] & src[i]) != src[i];
+        }
+        if (erase && s->needs_erase && s->dirty()) {
+            // This write shares the erase the sector already needs.
+            ++st.stats.erases_saved;
+        }
+        s->needs_erase = s->needs_erase || erase;
+        if (s->dirty()) {
+            s->dirty_begin = std::min(s->dirty_begin, in_sector);
+            s->dirty_end = std::max(s->dirty_end, in_sector + n);
+        } else {
+            s->dirty_begin = in_sector;
+            s->dirty_end = in_sector + n;
+        }
+        std::memcpy(dst, src.data(), n);
+
+        offset += n;
+        src = src.subspan(n);
+    }
+    return {};
+}
+
+result<void> partition_block_device::try_flush() {
+    return _state->flush();
+}
+
+} // namespace idfxx
@@ -0,0 +1,235 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+#include <idfxx/error>
+#include <idfxx/partition_kv>
+
+#include <algorithm>
+#include <cstddef>
+#include <esp_log.h>
+#include <esp_rom_crc.h>
+#include <utility>
+
+namespace {
+const char* TAG = "idfxx::partition_kv";
+}
+
+namespace idfxx {
+
+namespace {
+
+// Image layout (little-endian), shared with scripts/kv_build.py:
+//
+//   [image_header][index_entry * count][heap]
+//
+// Index entries are sorted by (hash, key bytes). Key and value offsets are
+// relative to the heap; keys and values are each padded to a 4-byte boundary.
+constexpr uint32_t image_magic = 0x3158564b; // "KVX1"
+constexpr uint16_t format_version = 1;
+constexpr size_t value_alignment = 4;
+
+struct image_header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t flags;
+    uint32_t count;
+    uint32_t index_offset;
+    uint32_t heap_offset;
+    uint32_t total_size;
+    uint32_t data_crc;   // over [index_offset, total_size)
+    uint32_t header_crc; // over the preceding fields
+};
+static_assert(sizeof(image_header) == 32);
+
+struct index_entry {
+    uint32_t hash;
+    uint32_t key_offset;
+    uint32_t key_size;
+    uint32_t value_offset;
+    uint32_t value_size;
+};
+static_assert(sizeof(index_entry) == 20);
+
+uint32_t crc32(const void* data, size_t size) {
+    return esp_rom_crc32_le(0, static_cast<const uint8_t*>(data), size);
+}
+
+constexpr size_t align(size_t n) {
+    return (n + value_alignment - 1) / value_alignment * value_alignment;
+}
+
+const index_entry* entries(const partition::mmap_handle& map) {
+    return reinterpret_cast<const index_entry*>(static_cast<const uint8_t*>(map.data()) + sizeof(image_header));
+}
+
+// True if [offset, offset + size) lies within a heap of `heap_size` bytes.
+constexpr bool in_heap(uint32_t offset, uint32_t size, size_t heap_size) {
+    return offset <= heap_size && size <= heap_size - offset;
+}
+
+} // namespace
+
+#ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
+partition_kv::partition_kv(partition part, bool verify)
+    : partition_kv(unwrap(make(part, verify))) {}
+#endif
+
+result<partition_kv> partition_kv::make(partition part, bool verify) {
+    image_header h;
+    if (auto r = part.try_read(0, &h, sizeof(h)); !r) {
+        return error(r.error());
+    }
+    if (h.magic != image_magic) {
+        return error(errc::not_found);
+    }
+    if (h.header_crc != crc32(&h, offsetof(image_header, header_crc))) {
+        return error(errc::invalid_crc);
+    }
+    if (h.version != format_version) {
+        ESP_LOGD(TAG, "unsupported image version %u", unsigned{h.version});
+        return error(errc::invalid_version);
+    }
+    if (h.total_size > part.size() || h.index_offset != sizeof(h) || h.heap_offset < h.index_offset ||
+        h.heap_offset > h.total_size || (h.heap_offset - h.index_offset) / sizeof(index_entry) < h.count) {
+        return error(errc::invalid_size);
+    }
+    auto map = part.try_mmap(0, h.total_size);
+    if (!map) {
+        return error(map.error());
+    }
+    // Lookups hand out views without further checks, so every entry must
+    // stay within the heap.
+    size_t heap_size = h.total_size - h.heap_offset;
+    for (const auto& e : std::span<const index_entry>{entries(*map), h.count}) {
+        if (!in_heap(e.key_offset, e.key_size, heap_size) || !in_heap(e.value_offset, e.value_size, heap_size)) {
+            ESP_LOGD(TAG, "index entry out of bounds");
+            return error(errc::invalid_size);
+        }
+    }
+    if (verify) {
+        auto* base = static_cast<const uint8_t*>(map->data());
+        if (h.data_crc != crc32(base + h.index_offset, h.total_size - h.index_offset)) {
+            return error(errc::invalid_crc);
+        }
+    }
+    return partition_kv{std::move(*map), h.count, h.heap_offset};
+}
+
+partition_kv::partition_kv(partition::mmap_handle map, size_t count, size_t heap_offset) noexcept
+    : _map(std::move(map))
+    , _count(count)
+    , _heap_offset(heap_offset) {}
+
+partition_kv::entry partition_kv::at(size_t i) const noexcept {
+    const auto& e = entries(_map)[i];
+    auto* heap = static_cast<const uint8_t*>(_map.data()) + _heap_offset;
+    return {
+        {reinterpret_cast<const char*>(heap + e.key_offset), e.key_size},
+        {heap + e.value_offset, e.value_size},
+    };
+}
+
+std::optional<std::span<const uint8_t>> partition_kv::find(std::string_view key) const noexcept {
+    std::span<const index_entry> index{entries(_map), _count};
+    uint32_t h = hash(key);
+    auto it = std::ranges::lower_bound(index, h, {}, &index_entry::hash);
+    for (; it != index.end() && it->hash == h; ++it) {
+        auto e = at(static_cast<size_t>(it - index.begin()));
+        if (e.key == key) {
+            return e.value;
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<std::string_view> partition_kv::find_string(std::string_view key) const noexcept {
+    auto v = find(key);
+    if (!v) {
+        return std::nullopt;
+    }
+    return std::string_view{reinterpret_cast<const char*>(v->data()), v->size()};
+}
+
+// =========================================================================
+// partition_kv_builder
+// =========================================================================
+
+void partition_kv_builder::add(std::string_view key, std::span<const uint8_t> value) {
+    _entries.push_back({std::string(key), std::vector<uint8_t>(value.begin(), value.end())});
+}
+
+size_t partition_kv_builder::image_size() const noexcept {
+    size_t size = sizeof(image_header) + _entries.size() * sizeof(index_entry);
+    for (const auto& e : _entries) {
+        size += align(e.key.size()) + align(e.value.size());
+    }
+    return size;
+}
+
+result<void> partition_kv_builder::try_write(partition part) const {
+    if (part.readonly()) {
+        return error(errc::not_allowed);
+    }
+    size_t total = image_size();
+    if (total > part.size()) {
+        return error(errc::invalid_size);
+    }
+
+    std::vector<const pending*> order;
+    order.reserve(_entries.size());
+    for (const auto& e : _entries) {
+        order.push_back(&e);
+    }
+    std::ranges::sort(order, [](const pending* a, const pending* b) {
+        uint32_t ha = partition_kv::hash(a->key);
+        uint32_t hb = partition_kv::hash(b->key);
+        return ha != hb ? ha < hb : a->key < b->key;
+    });
+    if (std::ranges::adjacent_find(order, {}, &pending::key) != order.end()) {
+        return error(errc::invalid_arg);
+    }
+
+    // The heap offset is 4-byte aligned since both the header and entries are.
+    size_t index_offset = sizeof(image_header);
+    size_t heap_offset = index_offset + order.size() * sizeof(index_entry);
+    std::vector<uint8_t> image(total, 0);
+    auto* index = reinterpret_cast<index_entry*>(image.data() + index_offset);
+    size_t pos = 0;
+    for (size_t i = 0; i < order.size(); ++i) {
+        const auto& e = *order[i];
+        index[i].hash = partition_kv::hash(e.key);
+        index[i].key_offset = pos;
+        index[i].key_size = e.key.size();
+        std::ranges::copy(e.key, image.begin() + heap_offset + pos);
+        pos += align(e.key.size());
+        index[i].value_offset = pos;
+        index[i].value_size = e.value.size();
+        std::ranges::copy(e.value, image.begin() + heap_offset + pos);
+        pos += align(e.value.size());
+    }
+
+    image_header h{
+        .magic = image_magic,
+        .version = format_version,
+        .flags = 0,
+        .count = static_cast<uint32_t>(order.size()),
+        .index_offset = static_cast<uint32_t>(index_offset),
+        .heap_offset = static_cast<uint32_t>(heap_offset),
+        .total_size = static_cast<uint32_t>(total),
+        .data_crc = crc32(image.data() + index_offset, total - index_offset),
+        .header_crc = 0,
+    };
+    h.header_crc = crc32(&h, offsetof(image_header, header_crc));
+
+    size_t erase = (total + part.erase_size() - 1) / part.erase_size() * part.erase_size();
+    if (auto r = part.try_erase_range(0, erase); !r) {
+        return r;
+    }
+    if (auto r = part.try_write(index_offset, image.data() + index_offset, total - index_offset); !r) {
+        return r;
+    }
+    ESP_LOGD(TAG, "%s: wrote %zu entries, %zu bytes", part.label().data(), order.size(), total);
+    return part.try_write(0, &h, sizeof(h));
+}
+
+} // namespace idfxx
@@ -0,0 +1,431 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+#include <idfxx/error>
+#include <idfxx/partition_log>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstddef>
+#include <cstring>
+#include <esp_log.h>
+#include <esp_rom_crc.h>
+#include <utility>
+#include <vector>
+
+namespace {
+const char* TAG = "idfxx::partition_log";
+}
+
+namespace idfxx {
+
+namespace {
+
+// On-flash layout (little-endian):
+//
+//   sector: [sector_header][frame][frame]...[unused tail]
+//   frame:  [timestamp:u64][payload:record_size][zero pad to 4][crc32:u32]
+//
+// The frame CRC covers everything before it. Unwritten frames read as 0xFF.
+constexpr uint32_t sector_magic = 0x474f4c58; // "XLOG"
+constexpr uint16_t format_version = 1;
+
+struct sector_header {
+    uint32_t magic;
+    uint32_t seq;
+    uint16_t record_size;
+    uint16_t version;
+    uint32_t crc;
+};
+static_assert(sizeof(sector_header) == 16);
+
+constexpr size_t header_size = sizeof(sector_header);
+constexpr size_t timestamp_size = sizeof(uint64_t);
+constexpr size_t crc_size = sizeof(uint32_t);
+
+uint32_t crc32(const void* data, size_t size) {
+    return esp_rom_crc32_le(0, static_cast<const uint8_t*>(data), size);
+}
+
+uint32_t header_crc(const sector_header& h) {
+    return crc32(&h, offsetof(sector_header, crc));
+}
+
+bool erased(const uint8_t* p, size_t size) {
+    return std::all_of(p, p + size, [](uint8_t b) { return b == 0xFF; });
+}
+
+struct index_entry {
+    uint32_t sector;
+    uint32_t seq;
+    std::optional<uint64_t> first_ts; // unset until the sector holds a record
+};
+
+} // namespace
+
+struct partition_log::state {
+    partition part;
+    partition::mmap_handle map;
+    const uint8_t* base;
+    size_t sector_size;
+    size_t sector_count;
+    size_t record_size;
+    size_t frame_size;
+    size_t records_per_sector;
+    size_t batch_records;
+
+    // Sectors holding log data, oldest first; back() is the sector being appended to.
+    std::vector<index_entry> index;
+    // Offset within the head sector of the first frame not yet written to flash.
+    size_t write_pos = 0;
+    std::vector<uint8_t> batch;
+    size_t batch_count = 0;
+    std::optional<uint64_t> newest_ts;
+
+    state(partition p, partition::mmap_handle m, size_t sector_size, size_t sector_count, const config& cfg)
+        : part(p)
+        , map(std::move(m))
+        , base(static_cast<const uint8_t*>(map.data()))
+        , sector_size(sector_size)
+        , sector_count(sector_count)
+        , record_size(cfg.record_size)
+        , frame_size((timestamp_size + cfg.record_size + 3) / 4 * 4 + crc_size)
+        , records_per_sector((sector_size - header_size) / frame_size)
+        , batch_records(cfg.batch_records)
+        , batch(cfg.batch_records * frame_size) {}
+
+    [[nodiscard]] const uint8_t* sector_data(uint32_t sector) const noexcept { return base + sector * sector_size; }
+
+    [[nodiscard]] const sector_header* valid_header(uint32_t sector) const noexcept {
+        auto* h = reinterpret_cast<const sector_header*>(sector_data(sector));
+        if (h->magic != sector_magic || h->crc != header_crc(*h)) {
+            return nullptr;
+        }
+        return h;
+    }
+
+    [[nodiscard]] bool frame_valid(const uint8_t* f) const noexcept {
+        uint32_t crc;
+        std::memcpy(&crc, f + frame_size - crc_size, crc_size);
+        return crc == crc32(f, frame_size - crc_size);
+    }
+
+    [[nodiscard]] static uint64_t frame_timestamp(const uint8_t* f) noexcept {
+        uint64_t ts;
+        std::memcpy(&ts, f, timestamp_size);
+        return ts;
+    }
+
+    void encode_frame(uint8_t* out, uint64_t ts, std::span<const uint8_t> data) const noexcept {
+        std::memcpy(out, &ts, timestamp_size);
+        std::memcpy(out + timestamp_size, data.data(), record_size);
+        std::memset(out + timestamp_size + record_size, 0, frame_size - crc_size - timestamp_size - record_size);
+        uint32_t crc = crc32(out, frame_size - crc_size);
+        std::memcpy(out + frame_size - crc_size, &crc, crc_size);
+    }
+
+    // Walks the written frames of a sector, calling `fn(frame)` for each one
+    // with a valid CRC, and returns the offset just past the last written frame.
+    template<typename F>
+    size_t scan(uint32_t sector, F&& fn) const {
+        const uint8_t* s = sector_data(sector);
+        size_t end = header_size;
+        for (size_t off = header_size; off + frame_size <= sector_size; off += frame_size) {
+            const uint8_t* f = s + off;
+            if (erased(f, frame_size)) {
+                break;
+            }
+            end = off + frame_size;
+            if (frame_valid(f)) {
+                if (!fn(f)) {
+                    break;
+                }
+            } else {
+                ESP_LOGD(TAG, "skipping corrupt record in sector %" PRIu32 " at 0x%zx", sector, off);
+            }
+        }
+        return end;
+    }
+
+    [[nodiscard]] size_t slots_left() const noexcept {
+        return (sector_size - write_pos) / frame_size - batch_count;
+    }
+
+    result<void> recover() {
+        for (uint32_t i = 0; i < sector_count; ++i) {
+            auto* h = valid_header(i);
+            if (h == nullptr) {
+                continue;
+            }
+            if (h->version != format_version || h->record_size != record_size) {
+                ESP_LOGD(
+                    TAG,
+                    "sector %" PRIu32 " holds format %u with %u-byte records",
+                    i,
+                    unsigned{h->version},
+                    unsigned{h->record_size}
+                );
+                return error(errc::invalid_state);
+            }
+            index.push_back({i, h->seq, std::nullopt});
+        }
+        std::ranges::sort(index, {}, &index_entry::seq);
+        for (auto& e : index) {
+            scan(e.sector, [&e](const uint8_t* f) {
+                e.first_ts = frame_timestamp(f);
+                return false;
+            });
+        }
+        if (index.empty()) {
+            return {};
+        }
+
+        // Only the head sector can be partially written.
+        write_pos = scan(index.back().sector, [this](const uint8_t* f) {
+            newest_ts = frame_timestamp(f);
+            return true;
+        });
+        for (auto it = index.rbegin(); !newest_ts && it != index.rend(); ++it) {
+            scan(it->sector, [this](const uint8_t* f) {
+                newest_ts = frame_timestamp(f);
+                return true;
+            });
+        }
+        ESP_LOGD(
+            TAG,
+            "%s: recovered %zu sectors, head %" PRIu32 " at 0x%zx",
+            part.label().data(),
+            index.size(),
+            index.back().sector,
+            write_pos
+        );
+        return {};
+    }
+
+    // Starts a new head sector, erasing the oldest one once the partition is full.
+    result<void> rotate() {
+        uint32_t sector = index.empty() ? 0 : (index.back().sector + 1) % sector_count;
+        uint32_t seq = index.empty() ? 1 : index.back().seq + 1;
+        std::erase_if(index, [sector](const index_entry& e) { return e.sector == sector; });
+        if (auto r = part.try_erase_range(sector * sector_size, sector_size); !r) {
+            return r;
+        }
+        sector_header h{sector_magic, seq, static_cast<uint16_t>(record_size), format_version, 0};
+        h.crc = header_crc(h);
+        if (auto r = part.try_write(sector * sector_size, &h, sizeof(h)); !r) {
+            return r;
+        }
+        index.push_back({sector, seq, std::nullopt});
+        write_pos = header_size;
+        return {};
+    }
+
+    result<void> flush() {
+        if (batch_count == 0) {
+            return {};
+        }
+        size_t n = batch_count * frame_size;
+        batch_count = 0;
+        auto r = part.try_write(index.back().sector * sector_size + write_pos, batch.data(), n);
+        if (!r) {
+            // The slots may be partially programmed; never write them again.
+            write_pos = sector_size;
+            return r;
+        }
+        write_pos += n;
+        return {};
+    }
+
+    void flush_quietly() noexcept {
+        if (auto r = flush(); !r) {
+            ESP_LOGW(TAG, "discarding buffered records: %s", r.error().message().c_str());
+        }
+    }
+};
+
+#ifdef CONFIG_COMPILER_CXX_EXCEPTIONS
+partition_log::partition_log(partition part, const config& config)
+    : partition_log(unwrap(make(part, config))) {}
+#endif
+
+result<partition_log> partition_log::make(partition part, const config& config) {
+    if (config.record_size == 0 || config.batch_records == 0) {
+        return error(errc::invalid_arg);
+    }
+    if (part.readonly()) {
+        return error(errc::not_allowed);
+    }
+    if (part.encrypted()) {
+        // Erased flash does not decrypt to 0xFF, so unwritten frames cannot be detected.
+        return error(errc::not_supported);
+    }
+    size_t sector_size = part.erase_size();
+    size_t sector_count = sector_size == 0 ? 0 : part.size() / sector_size;
+    size_t frame_size = (timestamp_size + config.record_size + 3) / 4 * 4 + crc_size;
+    if (sector_count < 2 || header_size + frame_size > sector_size || config.record_size > UINT16_MAX) {
+        return error(errc::invalid_size);
+    }
+    auto map = part.try_mmap(0, sector_count * sector_size);
+    if (!map) {
+        return error(map.error());
+    }
+    auto s = std::make_unique<state>(part, std::move(*map), sector_size, sector_count, config);
+    if (auto r = s->recover(); !r) {
+        return error(r.error());
+    }
+    return partition_log{std::move(s)};
+}
+
+partition_log::partition_log(std::unique_ptr<state> s) noexcept
+    : _state(std::move(s)) {}
+
+partition_log::~partition_log() {
+    if (_state) {
+        _state->flush_quietly();
+    }
+}
+
+partition_log::partition_log(partition_log&& other) noexcept = default;
+
+partition_log& partition_log::operator=(partition_log&& other) noexcept {
+    if (this != &other) {
+        if (_state) {
+            _state->flush_quietly();
+        }
+        _state = std::move(other._state);
+    }
+    return *this;
+}
+
+const partition& partition_log::part() const noexcept {
+    return _state->part;
+}
+
+size_t partition_log::record_size() const noexcept {
+    return _state->record_size;
+}
+
+size_t partition_log::records_per_sector() const noexcept {
+    return _state->records_per_sector;
+}
+
+size_t partition_log::sector_count() const noexcept {
+    return _state->sector_count;
+}
+
+size_t partition_log::pending() const noexcept {
+    return _state->batch_count;
+}
+
+bool partition_log::empty() const noexcept {
+    return !_state->newest_ts.has_value();
+}
+
+std::optional<uint64_t> partition_log::oldest() const noexcept {
+    for (const auto& e : _state->index) {
+        if (e.first_ts) {
+            return e.first_ts;
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<uint64_t> partition_log::newest() const noexcept {
+    return _state->newest_ts;
+}
+
+partition_log::cursor partition_log::query(uint64_t from, uint64_t to) const noexcept {
+    const auto& index = _state->index;
+    // Last sector whose first record is at or before `from`; sectors with no
+    // records yet can only be at the head and sort last.
+    auto it = std::ranges::upper_bound(index, from, {}, [](const index_entry& e) {
+        return e.first_ts.value_or(UINT64_MAX);
+    });
+    size_t entry = it == index.begin() ? 0 : static_cast<size_t>(it - index.begin()) - 1;
+    return cursor{_state.get(), entry, entry < index.size() ? header_size : 0, from, to};
+}
+
+std::optional<partition_log::record> partition_log::cursor::next() noexcept {
+    const auto& s = *_log;
+    while (_entry < s.index.size()) {
+        bool head = _entry + 1 == s.index.size();
+        size_t end = head ? s.write_pos : s.sector_size;
+        const uint8_t* sector = s.sector_data(s.index[_entry].sector);
+        while (_offset + s.frame_size <= end) {
+            const uint8_t* f = sector + _offset;
+            if (erased(f, s.frame_size)) {
+                break;
+            }
+            _offset += s.frame_size;
+            if (!s.frame_valid(f)) {
+                continue;
+            }
+            uint64_t ts = state::frame_timestamp(f);
+            if (ts >= _to) {
+                _entry = SIZE_MAX;
+                return std::nullopt;
+            }
+            if (ts >= _from) {
+                return record{ts, {f + timestamp_size, s.record_size}};
+            }
+        }
+        ++_entry;
+        _offset = _entry < s.index.size() ? header_size : 0;
+    }
+    if (_entry == s.index.size()) {
+        // Buffered records, already known to be intact
+        while (_offset < s.batch_count * s.frame_size) {
+            const uint8_t* f = s.batch.data() + _offset;
+            _offset += s.frame_size;
+            uint64_t ts = state::frame_timestamp(f);
+            if (ts >= _to) {
+                break;
+            }
+            if (ts >= _from) {
+                return record{ts, {f + timestamp_size, s.record_size}};
+            }
+        }
+        _entry = SIZE_MAX;
+    }
+    return std::nullopt;
+}
+
+result<void> partition_log::try_append(uint64_t timestamp, std::span<const uint8_t> data) {
+    auto& s = *_state;
+    if (data.size() != s.record_size) {
+        return error(errc::invalid_size);
+    }
+    if (timestamp == UINT64_MAX || (s.newest_ts && timestamp < *s.newest_ts)) {
+        return error(errc::invalid_arg);
+    }
+    if (s.index.empty() || s.slots_left() == 0) {
+        if (auto r = s.rotate(); !r) {
+            return r;
+        }
+    }
+    s.encode_frame(s.batch.data() + s.batch_count * s.frame_size, timestamp, data);
+    ++s.batch_count;
+    if (!s.index.back().first_ts) {
+        s.index.back().first_ts = timestamp;
+    }
+    s.newest_ts = timestamp;
+    if (s.batch_count == s.batch_records || s.slots_left() == 0) {
+        return s.flush();
+    }
+    return {};
+}
+
+result<void> partition_log::try_flush() {
+    return _state->flush();
+}
+
+result<void> partition_log::try_clear() {
+    auto& s = *_state;
+    s.batch_count = 0;
+    s.index.clear();
+    s.write_pos = 0;
+    s.newest_ts.reset();
+    return s.part.try_erase_range(0, s.sector_count * s.sector_size);
+}
+
+} // namespace idfxx
@@ -0,0 +1,242 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+// Unit tests for idfxx partition_block_device
+// Uses ESP-IDF Unity test framework with compile-time static_asserts
+//
+// Tests that write use the "scratch" data partition from the test partition
+// tables, erasing it first.
+
+#include "idfxx/partition_block_device"
+#include "unity.h"
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+using namespace idfxx;
+
+// =============================================================================
+// Compile-time tests (static_assert)
+// These verify correctness at compile time - if this file compiles, they pass.
+// =============================================================================
+
+// partition_block_device is not default constructible
+static_assert(!std::is_default_constructible_v<partition_block_device>);
+
+// partition_block_device is move-only
+static_assert(!std::is_copy_constructible_v<partition_block_device>);
+static_assert(!std::is_copy_assignable_v<partition_block_device>);
+static_assert(std::is_nothrow_move_constructible_v<partition_block_device>);
+static_assert(std::is_nothrow_move_assignable_v<partition_block_device>);
+
+// statistics start at zero
+static_assert(partition_block_device::stats{} == partition_block_device::stats{0, 0, 0, 0, 0});
+
+// =============================================================================
+// Runtime tests (Unity TEST_CASE)
+// =============================================================================
+
+namespace {
+
+partition scratch() {
+    auto part = partition::try_find("scratch");
+    TEST_ASSERT_TRUE(part.has_value());
+    TEST_ASSERT_TRUE(part->try_erase_range(0, part->size()).has_value());
+    return *part;
+}
+
+} // namespace
+
+TEST_CASE("partition_block_device rejects zero cache sectors", "[idfxx][partition]") {
+    auto part = partition::try_find(partition::type::app, partition::subtype::app_ota_0);
+    TEST_ASSERT_TRUE(part.has_value());
+
+    auto dev = partition_block_device::make(*part, {.cache_sectors = 0});
+    TEST_ASSERT_FALSE(dev.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(errc::invalid_arg), dev.error().value());
+}
+
+TEST_CASE("partition_block_device reports partition geometry", "[idfxx][partition]") {
+    auto part = partition::try_find(partition::type::app, partition::subtype::app_ota_0);
+    TEST_ASSERT_TRUE(part.has_value());
+
+    auto dev = partition_block_device::make(*part);
+    TEST_ASSERT_TRUE(dev.has_value());
+    TEST_ASSERT_EQUAL(part->size(), dev->size());
+    TEST_ASSERT_EQUAL(part->erase_size(), dev->sector_size());
+    TEST_ASSERT_TRUE(dev->part() == *part);
+    TEST_ASSERT_FALSE(dev->dirty());
+}
+
+TEST_CASE("partition_block_device try_read matches partition read", "[idfxx][partition]") {
+    auto part = partition::try_find(partition::type::app, partition::subtype::app_ota_0);
+    TEST_ASSERT_TRUE(part.has_value());
+
+    auto dev = partition_block_device::make(*part);
+    TEST_ASSERT_TRUE(dev.has_value());
+
+    // Straddle a sector boundary
+    size_t offset = dev->sector_size() - 8;
+    std::array<uint8_t, 16> direct{};
+    std::array<uint8_t, 16> buffered{};
+    TEST_ASSERT_TRUE(part->try_read(offset, direct).has_value());
+    TEST_ASSERT_TRUE(dev->try_read(offset, buffered).has_value());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(direct.data(), buffered.data(), direct.size());
+
+    // Uncached reads go straight to flash without touching the cache
+    TEST_ASSERT_TRUE(dev->statistics() == partition_block_device::stats{});
+}
+
+TEST_CASE("partition_block_device rejects out-of-range access", "[idfxx][partition]") {
+    auto part = partition::try_find(partition::type::app, partition::subtype::app_ota_0);
+    TEST_ASSERT_TRUE(part.has_value());
+
+    auto dev = partition_block_device::make(*part);
+    TEST_ASSERT_TRUE(dev.has_value());
+
+    std::array<uint8_t, 4> buf{};
+    auto r = dev->try_read(dev->size() - 2, buf);
+    TEST_ASSERT_FALSE(r.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(errc::invalid_size), r.error().value());
+
+    auto w = dev->try_write(dev->size(), buf);
+    TEST_ASSERT_FALSE(w.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(errc::invalid_size), w.error().value());
+    TEST_ASSERT_FALSE(dev->dirty());
+}
+
+TEST_CASE("partition_block_device read-modify-write preserves the rest of the sector", "[idfxx][partition]") {
+    auto part = scratch();
+    std::array<uint8_t, 16> original;
+    original.fill(0x0F);
+    TEST_ASSERT_TRUE(part.try_write(0, original.data(), original.size()).has_value());
+
+    auto dev = partition_block_device::make(part);
+    TEST_ASSERT_TRUE(dev.has_value());
+
+    // Setting bits needs an erase of the whole sector
+    std::array<uint8_t, 4> update{0xF0, 0xF1, 0xF2, 0xF3};
+    TEST_ASSERT_TRUE(dev->try_write(4, update).has_value());
+    TEST_ASSERT_TRUE(dev->dirty());
+
+    std::array<uint8_t, 16> readback{};
+    TEST_ASSERT_TRUE(dev->try_read(0, readback).has_value());
+    TEST_ASSERT_EQUAL_HEX8(0x0F, readback[3]);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(update.data(), readback.data() + 4, update.size());
+    TEST_ASSERT_EQUAL_HEX8(0x0F, readback[8]);
+
+    TEST_ASSERT_TRUE(dev->try_flush().has_value());
+    TEST_ASSERT_FALSE(dev->dirty());
+    TEST_ASSERT_EQUAL(1, dev->statistics().erases);
+    TEST_ASSERT_EQUAL(1, dev->statistics().write_backs);
+
+    std::array<uint8_t, 16> flash{};
+    TEST_ASSERT_TRUE(part.try_read(0, flash).has_value());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(readback.data(), flash.data(), flash.size());
+}
+
+TEST_CASE("partition_block_device programs bit-clearing writes in place", "[idfxx][partition]") {
+    auto part = scratch();
+    auto dev = partition_block_device::make(part);
+    TEST_ASSERT_TRUE(dev.has_value());
+
+    std::array<uint8_t, 4> first{0x12, 0x34, 0x56, 0x78};
+    std::array<uint8_t, 4> second{0x9A, 0xBC, 0xDE, 0xF0};
+    TEST_ASSERT_TRUE(dev->try_write(0, first).has_value());
+    TEST_ASSERT_TRUE(dev->try_write(64, second).has_value());
+    TEST_ASSERT_TRUE(dev->try_flush().has_value());
+
+    // Nothing needed an erase, so none was performed or saved
+    TEST_ASSERT_EQUAL(0, dev->statistics().erases);
+    TEST_ASSERT_EQUAL(0, dev->statistics().erases_saved);
+    TEST_ASSERT_EQUAL(1, dev->statistics().write_backs);
+
+    std::array<uint8_t, 4> flash{};
+    TEST_ASSERT_TRUE(part.try_read(0, flash).has_value());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(first.data(), flash.data(), flash.size());
+    TEST_ASSERT_TRUE(part.try_read(64, flash).has_value());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(second.data(), flash.data(), flash.size());
+}
+
+TEST_CASE("partition_block_device coalesces erases within a sector", "[idfxx][partition]") {
+    auto part = scratch();
+    std::array<uint8_t, 12> zeros{};
+    TEST_ASSERT_TRUE(part.try_write(0, zeros.data(), zeros.size()).has_value());
+
+    auto dev = partition_block_device::make(part);
+    TEST_ASSERT_TRUE(dev.has_value());
+
+    // Three writes that each need an erase share a single one
+    std::array<uint8_t, 4> ones{0xFF, 0xFF, 0xFF, 0xFF};
+    TEST_ASSERT_TRUE(dev->try_write(0, ones).has_value());
+    TEST_ASSERT_TRUE(dev->try_write(4, ones).has_value());
+    TEST_ASSERT_TRUE(dev->try_write(8, ones).has_value());
+    // A bit-clearing write into the same sector saves nothing
+    std::array<uint8_t, 1> low{0x00};
+    TEST_ASSERT_TRUE(dev->try_write(0, low).has_value());
+    TEST_ASSERT_TRUE(dev->try_flush().has_value());
+
+    const auto& stats = dev->statistics();
+    TEST_ASSERT_EQUAL(1, stats.erases);
+    TEST_ASSERT_EQUAL(2, stats.erases_saved);
+    TEST_ASSERT_EQUAL(1, stats.write_backs);
+    TEST_ASSERT_EQUAL(1, stats.cache_misses);
+    TEST_ASSERT_EQUAL(3, stats.cache_hits);
+
+    std::array<uint8_t, 12> flash{};
+    TEST_ASSERT_TRUE(part.try_read(0, flash).has_value());
+    TEST_ASSERT_EQUAL_HEX8(0x00, flash[0]);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, flash[1]);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, flash[11]);
+}
+
+TEST_CASE("partition_block_device writes back the evicted sector", "[idfxx][partition]") {
+    auto part = scratch();
+    auto dev = partition_block_device::make(part, {.cache_sectors = 1});
+    TEST_ASSERT_TRUE(dev.has_value());
+
+    std::array<uint8_t, 4> first{1, 2, 3, 4};
+    std::array<uint8_t, 4> second{5, 6, 7, 8};
+    TEST_ASSERT_TRUE(dev->try_write(0, first).has_value());
+    TEST_ASSERT_EQUAL(0, dev->statistics().write_backs);
+
+    // Loading the next sector evicts the first, writing it to flash
+    TEST_ASSERT_TRUE(dev->try_write(dev->sector_size(), second).has_value());
+    TEST_ASSERT_EQUAL(1, dev->statistics().write_backs);
+    TEST_ASSERT_EQUAL(2, dev->statistics().cache_misses);
+
+    std::array<uint8_t, 4> flash{};
+    TEST_ASSERT_TRUE(part.try_read(0, flash).has_value());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(first.data(), flash.data(), flash.size());
+    TEST_ASSERT_TRUE(part.try_read(dev->sector_size(), flash).has_value());
+    TEST_ASSERT_EQUAL_HEX8(0xFF, flash[0]);
+
+    TEST_ASSERT_TRUE(dev->try_flush().has_value());
+    TEST_ASSERT_TRUE(part.try_read(dev->sector_size(), flash).has_value());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(second.data(), flash.data(), flash.size());
+}
+
+TEST_CASE("partition_block_device writes across a sector boundary", "[idfxx][partition]") {
+    auto part = scratch();
+    auto dev = partition_block_device::make(part, {.cache_sectors = 2});
+    TEST_ASSERT_TRUE(dev.has_value());
+
+    std::array<uint8_t, 16> data;
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i);
+    }
+    size_t offset = dev->sector_size() - 8;
+    TEST_ASSERT_TRUE(dev->try_write(offset, data).has_value());
+    TEST_ASSERT_EQUAL(2, dev->statistics().cache_misses);
+
+    std::array<uint8_t, 16> readback{};
+    TEST_ASSERT_TRUE(dev->try_read(offset, readback).has_value());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data.data(), readback.data(), data.size());
+
+    TEST_ASSERT_TRUE(dev->try_flush().has_value());
+    TEST_ASSERT_EQUAL(2, dev->statistics().write_backs);
+    TEST_ASSERT_TRUE(part.try_read(offset, readback).has_value());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data.data(), readback.data(), data.size());
+}
@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+// Unit tests for idfxx partition_kv
+// Uses ESP-IDF Unity test framework with compile-time static_asserts
+//
+// Tests that write use the "scratch" data partition from the test partition
+// tables.
+
+#include "idfxx/partition_kv"
+#include "unity.h"
+
+#include <array>
+#include <cstdint>
+#include <esp_rom_crc.h>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+using namespace idfxx;
+
+// =============================================================================
+// Compile-time tests (static_assert)
+// These verify correctness at compile time - if this file compiles, they pass.
+// =============================================================================
+
+// partition_kv is move-only
+static_assert(!std::is_default_constructible_v<partition_kv>);
+static_assert(!std::is_copy_constructible_v<partition_kv>);
+static_assert(!std::is_copy_assignable_v<partition_kv>);
+static_assert(std::is_nothrow_move_constructible_v<partition_kv>);
+static_assert(std::is_nothrow_move_assignable_v<partition_kv>);
+
+// partition_kv_builder is move-only
+static_assert(std::is_default_constructible_v<partition_kv_builder>);
+static_assert(!std::is_copy_constructible_v<partition_kv_builder>);
+static_assert(std::is_nothrow_move_constructible_v<partition_kv_builder>);
+
+// The index hash is 32-bit FNV-1a, matching scripts/kv_build.py
+static_assert(partition_kv::hash("") == 0x811c9dc5);
+static_assert(partition_kv::hash("a") == 0xe40c292c);
+static_assert(partition_kv::hash("foobar") == 0xbf9cf968);
+
+// =============================================================================
+// Runtime tests (Unity TEST_CASE)
+// =============================================================================
+
+namespace {
+
+partition scratch() {
+    auto part = partition::try_find("scratch");
+    TEST_ASSERT_TRUE(part.has_value());
+    return *part;
+}
+
+// Hand-built single-entry image with the given layout, for corrupt-image tests.
+// Fields follow the image header and index entry layouts in partition_kv.cpp.
+void write_raw_image(partition part, uint32_t heap_offset, uint32_t key_offset, uint32_t key_size) {
+    std::array<uint32_t, 13> words{
+        0x3158564b,  // magic "KVX1"
+        1,           // version 1, flags 0
+        1,           // count
+        32,          // index_offset
+        heap_offset, // heap_offset
+        32 + 20 + 8, // total_size: header, one entry, 8-byte heap
+        0,           // data_crc (not verified)
+        0,           // header_crc
+        partition_kv::hash("k"),
+        key_offset,
+        key_size,
+        4, // value_offset
+        4, // value_size
+    };
+    words[7] = esp_rom_crc32_le(0, reinterpret_cast<const uint8_t*>(words.data()), 28);
+    std::array<uint8_t, 8> heap{'k', 0, 0, 0, 'v', 'v', 'v', 'v'};
+    TEST_ASSERT_TRUE(part.try_erase_range(0, part.erase_size()).has_value());
+    TEST_ASSERT_TRUE(part.try_write(0, words.data(), sizeof(words)).has_value());
+    TEST_ASSERT_TRUE(part.try_write(sizeof(words), heap.data(), heap.size()).has_value());
+}
+
+} // namespace
+
+TEST_CASE("partition_kv make on a partition without an image returns not_found", "[idfxx][partition]") {
+    auto part = partition::try_find(partition::type::app, partition::subtype::app_ota_0);
+    TEST_ASSERT_TRUE(part.has_value());
+
+    auto kv = partition_kv::make(*part);
+    TEST_ASSERT_FALSE(kv.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(errc::not_found), kv.error().value());
+}
+
+TEST_CASE("partition_kv_builder image_size accounts for header, index and padding", "[idfxx][partition]") {
+    partition_kv_builder b;
+    TEST_ASSERT_EQUAL(0, b.size());
+    TEST_ASSERT_EQUAL(32, b.image_size());
+
+    b.add("abc", "hello");
+    std::array<uint8_t, 8> words{};
+    b.add("w", words);
+    TEST_ASSERT_EQUAL(2, b.size());
+    // header + 2 index entries + "abc"(4) + "hello"(8) + "w"(4) + words(8)
+    TEST_ASSERT_EQUAL(32 + 2 * 20 + 4 + 8 + 4 + 8, b.image_size());
+}
+
+TEST_CASE("partition_kv opens an image written by partition_kv_builder", "[idfxx][partition]") {
+    auto part = scratch();
+
+    partition_kv_builder b;
+    b.add("greeting.en", "Hello");
+    b.add("greeting.fr", "Bonjour");
+    std::array<uint8_t, 8> words{1, 2, 3, 4, 5, 6, 7, 8};
+    b.add("words", words);
+    b.add("empty", std::span<const uint8_t>{});
+    TEST_ASSERT_TRUE(b.try_write(part).has_value());
+
+    auto kv = partition_kv::make(part, true);
+    TEST_ASSERT_TRUE(kv.has_value());
+    TEST_ASSERT_EQUAL(4, kv->size());
+
+    auto en = kv->find_string("greeting.en");
+    TEST_ASSERT_TRUE(en.has_value());
+    TEST_ASSERT_TRUE(*en == "Hello");
+    auto fr = kv->find_string("greeting.fr");
+    TEST_ASSERT_TRUE(fr.has_value());
+    TEST_ASSERT_TRUE(*fr == "Bonjour");
+
+    auto w = kv->find("words");
+    TEST_ASSERT_TRUE(w.has_value());
+    TEST_ASSERT_EQUAL(words.size(), w->size());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(words.data(), w->data(), words.size());
+    // Values are 4-byte aligned within the mapping
+    TEST_ASSERT_EQUAL(0, reinterpret_cast<uintptr_t>(w->data()) % 4);
+
+    auto empty = kv->find("empty");
+    TEST_ASSERT_TRUE(empty.has_value());
+    TEST_ASSERT_EQUAL(0, empty->size());
+
+    TEST_ASSERT_FALSE(kv->find("greeting.de").has_value());
+    TEST_ASSERT_FALSE(kv->contains("greeting"));
+}
+
+TEST_CASE("partition_kv_builder rejects duplicate keys", "[idfxx][partition]") {
+    partition_kv_builder b;
+    b.add("k", "a");
+    b.add("k", "b");
+    auto r = b.try_write(scratch());
+    TEST_ASSERT_FALSE(r.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(errc::invalid_arg), r.error().value());
+}
+
+TEST_CASE("partition_kv make rejects a heap before the index", "[idfxx][partition]") {
+    auto part = scratch();
+    write_raw_image(part, 16, 0, 1);
+
+    auto kv = partition_kv::make(part);
+    TEST_ASSERT_FALSE(kv.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(errc::invalid_size), kv.error().value());
+}
+
+TEST_CASE("partition_kv make rejects index entries outside the heap", "[idfxx][partition]") {
+    auto part = scratch();
+
+    // Well-formed, to show the hand-built image itself is valid
+    write_raw_image(part, 52, 0, 1);
+    auto kv = partition_kv::make(part);
+    TEST_ASSERT_TRUE(kv.has_value());
+    TEST_ASSERT_TRUE(kv->contains("k"));
+
+    // Key runs past the end of the heap
+    write_raw_image(part, 52, 4, 8);
+    kv = partition_kv::make(part);
+    TEST_ASSERT_FALSE(kv.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(errc::invalid_size), kv.error().value());
+
+    // Offset plus size wraps around
+    write_raw_image(part, 52, 4, 0xFFFFFFFF);
+    kv = partition_kv::make(part);
+    TEST_ASSERT_FALSE(kv.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(errc::invalid_size), kv.error().value());
+}
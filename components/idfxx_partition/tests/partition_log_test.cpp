@@ -0,0 +1,267 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2026 Chris Leishman
+
+// Unit tests for idfxx partition_log
+// Uses ESP-IDF Unity test framework with compile-time static_asserts
+//
+// Tests that write use the "scratch" data partition from the test partition
+// tables, erasing it first.
+
+#include "idfxx/partition_log"
+#include "unity.h"
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace idfxx;
+
+// =============================================================================
+// Compile-time tests (static_assert)
+// These verify correctness at compile time - if this file compiles, they pass.
+// =============================================================================
+
+// partition_log is not default constructible
+static_assert(!std::is_default_constructible_v<partition_log>);
+
+// partition_log is move-only
+static_assert(!std::is_copy_constructible_v<partition_log>);
+static_assert(!std::is_copy_assignable_v<partition_log>);
+static_assert(std::is_nothrow_move_constructible_v<partition_log>);
+static_assert(std::is_nothrow_move_assignable_v<partition_log>);
+
+// cursors are cheap value types
+static_assert(std::is_trivially_copyable_v<partition_log::cursor>);
+
+// =============================================================================
+// Runtime tests (Unity TEST_CASE)
+// =============================================================================
+
+TEST_CASE("partition_log rejects zero-sized records", "[idfxx][partition]") {
+    auto part = partition::try_find(partition::type::app, partition::subtype::app_ota_0);
+    TEST_ASSERT_TRUE(part.has_value());
+
+    auto log = partition_log::make(*part, {.record_size = 0});
+    TEST_ASSERT_FALSE(log.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(errc::invalid_arg), log.error().value());
+}
+
+TEST_CASE("partition_log rejects zero batch size", "[idfxx][partition]") {
+    auto part = partition::try_find(partition::type::app, partition::subtype::app_ota_0);
+    TEST_ASSERT_TRUE(part.has_value());
+
+    auto log = partition_log::make(*part, {.record_size = 16, .batch_records = 0});
+    TEST_ASSERT_FALSE(log.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(errc::invalid_arg), log.error().value());
+}
+
+TEST_CASE("partition_log rejects records larger than a sector", "[idfxx][partition]") {
+    auto part = partition::try_find(partition::type::app, partition::subtype::app_ota_0);
+    TEST_ASSERT_TRUE(part.has_value());
+
+    auto log = partition_log::make(*part, {.record_size = part->erase_size()});
+    TEST_ASSERT_FALSE(log.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(errc::invalid_size), log.error().value());
+}
+
+namespace {
+
+// Erases the scratch partition so each test starts from an empty log.
+partition scratch() {
+    auto part = partition::try_find("scratch");
+    TEST_ASSERT_TRUE(part.has_value());
+    TEST_ASSERT_TRUE(part->try_erase_range(0, part->size()).has_value());
+    return *part;
+}
+
+// Payload whose bytes identify the record it was appended with.
+template<size_t N>
+std::array<uint8_t, N> payload(uint64_t ts) {
+    std::array<uint8_t, N> data;
+    data.fill(static_cast<uint8_t>(ts));
+    return data;
+}
+
+std::vector<uint64_t> timestamps(const partition_log& log, uint64_t from = 0, uint64_t to = UINT64_MAX) {
+    std::vector<uint64_t> out;
+    auto c = log.query(from, to);
+    while (auto rec = c.next()) {
+        TEST_ASSERT_EQUAL(log.record_size(), rec->data.size());
+        TEST_ASSERT_EQUAL(static_cast<uint8_t>(rec->timestamp), rec->data[0]);
+        out.push_back(rec->timestamp);
+    }
+    return out;
+}
+
+} // namespace
+
+TEST_CASE("partition_log buffers appends and writes them in batches", "[idfxx][partition]") {
+    auto part = scratch();
+    auto log = partition_log::make(part, {.record_size = 8, .batch_records = 4});
+    TEST_ASSERT_TRUE(log.has_value());
+    TEST_ASSERT_TRUE(log->empty());
+    TEST_ASSERT_FALSE(log->oldest().has_value());
+
+    for (uint64_t ts = 100; ts < 110; ++ts) {
+        TEST_ASSERT_TRUE(log->try_append(ts, payload<8>(ts)).has_value());
+    }
+    TEST_ASSERT_EQUAL(2, log->pending()); // two batches of four written
+    TEST_ASSERT_EQUAL(100, *log->oldest());
+    TEST_ASSERT_EQUAL(109, *log->newest());
+
+    // Queries include buffered records
+    auto all = timestamps(*log);
+    TEST_ASSERT_EQUAL(10, all.size());
+    TEST_ASSERT_EQUAL(100, all.front());
+    TEST_ASSERT_EQUAL(109, all.back());
+
+    TEST_ASSERT_TRUE(log->try_flush().has_value());
+    TEST_ASSERT_EQUAL(0, log->pending());
+    TEST_ASSERT_EQUAL(10, timestamps(*log).size());
+}
+
+TEST_CASE("partition_log rejects bad appends", "[idfxx][partition]") {
+    auto part = scratch();
+    auto log = partition_log::make(part, {.record_size = 8});
+    TEST_ASSERT_TRUE(log.has_value());
+
+    TEST_ASSERT_TRUE(log->try_append(50, payload<8>(50)).has_value());
+    auto older = log->try_append(49, payload<8>(49));
+    TEST_ASSERT_FALSE(older.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(errc::invalid_arg), older.error().value());
+
+    auto short_data = log->try_append(51, payload<4>(51));
+    TEST_ASSERT_FALSE(short_data.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(errc::invalid_size), short_data.error().value());
+
+    // Equal timestamps are allowed
+    TEST_ASSERT_TRUE(log->try_append(50, payload<8>(50)).has_value());
+}
+
+TEST_CASE("partition_log recovers flushed records on reopen", "[idfxx][partition]") {
+    auto part = scratch();
+    {
+        auto log = partition_log::make(part, {.record_size = 8, .batch_records = 4});
+        TEST_ASSERT_TRUE(log.has_value());
+        for (uint64_t ts = 1; ts <= 6; ++ts) {
+            TEST_ASSERT_TRUE(log->try_append(ts, payload<8>(ts)).has_value());
+        }
+        // The destructor flushes the two buffered records
+    }
+
+    auto log = partition_log::make(part, {.record_size = 8, .batch_records = 4});
+    TEST_ASSERT_TRUE(log.has_value());
+    TEST_ASSERT_EQUAL(0, log->pending());
+    TEST_ASSERT_EQUAL(1, *log->oldest());
+    TEST_ASSERT_EQUAL(6, *log->newest());
+    TEST_ASSERT_EQUAL(6, timestamps(*log).size());
+
+    // Appending continues after the recovered records
+    TEST_ASSERT_FALSE(log->try_append(5, payload<8>(5)).has_value());
+    TEST_ASSERT_TRUE(log->try_append(7, payload<8>(7)).has_value());
+    TEST_ASSERT_TRUE(log->try_flush().has_value());
+    auto all = timestamps(*log);
+    TEST_ASSERT_EQUAL(7, all.size());
+    TEST_ASSERT_EQUAL(7, all.back());
+
+    // A different record size does not match the recovered sectors
+    auto other = partition_log::make(part, {.record_size = 12});
+    TEST_ASSERT_FALSE(other.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(errc::invalid_state), other.error().value());
+}
+
+TEST_CASE("partition_log queries a time range across sectors", "[idfxx][partition]") {
+    auto part = scratch();
+    // Large records so a handful fill a sector
+    auto log = partition_log::make(part, {.record_size = 1000, .batch_records = 2});
+    TEST_ASSERT_TRUE(log.has_value());
+    TEST_ASSERT_EQUAL(4, log->records_per_sector());
+
+    for (uint64_t i = 0; i < 20; ++i) {
+        TEST_ASSERT_TRUE(log->try_append(i * 10, payload<1000>(i * 10)).has_value());
+    }
+
+    auto range = timestamps(*log, 55, 125);
+    TEST_ASSERT_EQUAL(7, range.size());
+    TEST_ASSERT_EQUAL(60, range.front());
+    TEST_ASSERT_EQUAL(120, range.back());
+
+    TEST_ASSERT_EQUAL(0, timestamps(*log, 500).size());
+    TEST_ASSERT_EQUAL(1, timestamps(*log, 0, 1).size());
+}
+
+TEST_CASE("partition_log skips records that fail their CRC", "[idfxx][partition]") {
+    auto part = scratch();
+    {
+        auto log = partition_log::make(part, {.record_size = 8, .batch_records = 1});
+        TEST_ASSERT_TRUE(log.has_value());
+        for (uint64_t ts = 1; ts <= 4; ++ts) {
+            TEST_ASSERT_TRUE(log->try_append(ts, payload<8>(ts)).has_value());
+        }
+    }
+
+    // Clear bits in the second record's payload (flash programs 1 -> 0 only).
+    // The log starts in the first sector; frames of timestamp, payload and
+    // CRC follow its 16-byte header.
+    constexpr size_t frame_size = 8 + 8 + 4;
+    const uint8_t zero = 0;
+    TEST_ASSERT_TRUE(part.try_write(16 + frame_size + 8, &zero, 1).has_value());
+
+    auto log = partition_log::make(part, {.record_size = 8, .batch_records = 1});
+    TEST_ASSERT_TRUE(log.has_value());
+    auto all = timestamps(*log);
+    TEST_ASSERT_EQUAL(3, all.size());
+    TEST_ASSERT_EQUAL(1, all[0]);
+    TEST_ASSERT_EQUAL(3, all[1]);
+    TEST_ASSERT_EQUAL(4, all[2]);
+}
+
+TEST_CASE("partition_log rotates through sectors, erasing the oldest", "[idfxx][partition]") {
+    auto part = scratch();
+    auto log = partition_log::make(part, {.record_size = 1000, .batch_records = 4});
+    TEST_ASSERT_TRUE(log.has_value());
+    const size_t per_sector = log->records_per_sector();
+    const size_t capacity = log->sector_count() * per_sector;
+
+    // Fill every sector, then wrap into the first two again
+    const uint64_t total = capacity + per_sector + 1;
+    for (uint64_t ts = 0; ts < total; ++ts) {
+        TEST_ASSERT_TRUE(log->try_append(ts, payload<1000>(ts)).has_value());
+    }
+    TEST_ASSERT_TRUE(log->try_flush().has_value());
+
+    // Two sectors' worth of the oldest records have been erased
+    const uint64_t oldest = 2 * per_sector;
+    TEST_ASSERT_EQUAL(oldest, *log->oldest());
+    TEST_ASSERT_EQUAL(total - 1, *log->newest());
+    auto all = timestamps(*log);
+    TEST_ASSERT_EQUAL(total - oldest, all.size());
+    for (size_t i = 0; i < all.size(); ++i) {
+        TEST_ASSERT_EQUAL(oldest + i, all[i]);
+    }
+
+    // Recovery finds the wrapped head
+    log = partition_log::make(part, {.record_size = 1000, .batch_records = 4});
+    TEST_ASSERT_TRUE(log.has_value());
+    TEST_ASSERT_EQUAL(oldest, *log->oldest());
+    TEST_ASSERT_EQUAL(total - 1, *log->newest());
+    TEST_ASSERT_EQUAL(total - oldest, timestamps(*log).size());
+}
+
+TEST_CASE("partition_log clear erases every record", "[idfxx][partition]") {
+    auto part = scratch();
+    auto log = partition_log::make(part, {.record_size = 8});
+    TEST_ASSERT_TRUE(log.has_value());
+    TEST_ASSERT_TRUE(log->try_append(1, payload<8>(1)).has_value());
+    TEST_ASSERT_TRUE(log->try_flush().has_value());
+
+    TEST_ASSERT_TRUE(log->try_clear().has_value());
+    TEST_ASSERT_TRUE(log->empty());
+    TEST_ASSERT_EQUAL(0, timestamps(*log).size());
+
+    log = partition_log::make(part, {.record_size = 8});
+    TEST_ASSERT_TRUE(log.has_value());
+    TEST_ASSERT_TRUE(log->empty());
+}
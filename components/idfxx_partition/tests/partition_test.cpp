@@ -7,6 +7,9 @@
 #include "idfxx/partition"
 #include "unity.h"
 
+#include <array>
+#include <span>
+#include <stop_token>
 #include <type_traits>
 #include <utility>
 
@@ -37,6 +40,13 @@ static_assert(!std::is_copy_assignable_v<partition::mmap_handle>);
 static_assert(std::is_move_constructible_v<partition::mmap_handle>);
 static_assert(std::is_move_assignable_v<partition::mmap_handle>);
 
+// sha256_context is move-only
+static_assert(!std::is_copy_constructible_v<partition::sha256_context>);
+static_assert(!std::is_copy_assignable_v<partition::sha256_context>);
+static_assert(std::is_move_constructible_v<partition::sha256_context>);
+static_assert(std::is_move_assignable_v<partition::sha256_context>);
+static_assert(partition::sha256_context::digest_size == 32);
+
 // app_ota helper produces correct values
 static_assert(app_ota(0) == partition::subtype::app_ota_0);
 static_assert(app_ota(1) == partition::subtype::app_ota_1);
@@ -164,6 +174,123 @@ TEST_CASE("partition try_sha256 on ota_0 app", "[idfxx][partition][hw]") {
     TEST_ASSERT_TRUE(has_nonzero);
 }
 
+// SHA-256("abc") from FIPS 180-2
+static constexpr std::array<uint8_t, 32> sha256_abc = {
+    0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+    0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad,
+};
+
+TEST_CASE("partition sha256_context digests data fed in blocks", "[idfxx][partition]") {
+    auto hash = partition::sha256_context::make();
+    TEST_ASSERT_TRUE(hash.has_value());
+
+    const std::array<uint8_t, 3> abc = {'a', 'b', 'c'};
+    TEST_ASSERT_TRUE(hash->try_update(std::span{abc}.first(1)).has_value());
+    TEST_ASSERT_TRUE(hash->try_update(std::span{abc}.subspan(1)).has_value());
+    TEST_ASSERT_EQUAL(3, hash->size());
+
+    auto digest = hash->try_finish();
+    TEST_ASSERT_TRUE(digest.has_value());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(sha256_abc.data(), digest->data(), digest->size());
+    TEST_ASSERT_TRUE(hash->finished());
+}
+
+TEST_CASE("partition sha256_context try_verify detects mismatch", "[idfxx][partition]") {
+    const std::array<uint8_t, 3> abc = {'a', 'b', 'c'};
+
+    auto good = partition::sha256_context::make();
+    TEST_ASSERT_TRUE(good.has_value());
+    TEST_ASSERT_TRUE(good->try_update(abc).has_value());
+    TEST_ASSERT_TRUE(good->try_verify(sha256_abc).has_value());
+
+    auto bad = partition::sha256_context::make();
+    TEST_ASSERT_TRUE(bad.has_value());
+    TEST_ASSERT_TRUE(bad->try_update(std::span{abc}.first(2)).has_value());
+    auto r = bad->try_verify(sha256_abc);
+    TEST_ASSERT_FALSE(r.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(errc::invalid_crc), r.error().value());
+}
+
+TEST_CASE("partition sha256_context rejects use after finish", "[idfxx][partition]") {
+    auto hash = partition::sha256_context::make();
+    TEST_ASSERT_TRUE(hash.has_value());
+    TEST_ASSERT_TRUE(hash->try_finish().has_value());
+
+    const std::array<uint8_t, 1> byte = {0};
+    auto r = hash->try_update(byte);
+    TEST_ASSERT_FALSE(r.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(errc::invalid_state), r.error().value());
+
+    auto part = partition::try_find(partition::type::app, partition::subtype::app_ota_0);
+    TEST_ASSERT_TRUE(part.has_value());
+    auto w = part->try_write(0, byte, *hash);
+    TEST_ASSERT_FALSE(w.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(errc::invalid_state), w.error().value());
+}
+
+TEST_CASE("partition try_read_async matches synchronous read", "[idfxx][partition]") {
+    auto part = partition::try_find(partition::type::app, partition::subtype::app_ota_0);
+    TEST_ASSERT_TRUE(part.has_value());
+
+    // Spans several worker chunks; static to keep them off the test task stack
+    static std::array<uint8_t, 10000> direct{};
+    static std::array<uint8_t, 10000> async{};
+    TEST_ASSERT_TRUE(part->try_read(0, direct).has_value());
+
+    auto f = part->try_read_async(0, async);
+    TEST_ASSERT_TRUE(f.has_value());
+    TEST_ASSERT_TRUE(f->try_wait().has_value());
+    TEST_ASSERT_TRUE(f->done());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(direct.data(), async.data(), direct.size());
+}
+
+TEST_CASE("partition async operations complete in submission order", "[idfxx][partition]") {
+    auto part = partition::try_find(partition::type::app, partition::subtype::app_ota_0);
+    TEST_ASSERT_TRUE(part.has_value());
+
+    static std::array<uint8_t, 8192> first{};
+    std::array<uint8_t, 16> second{};
+    auto f1 = part->try_read_async(0, first);
+    auto f2 = part->try_read_async(0, second);
+    TEST_ASSERT_TRUE(f1.has_value());
+    TEST_ASSERT_TRUE(f2.has_value());
+
+    TEST_ASSERT_TRUE(f2->try_wait().has_value());
+    TEST_ASSERT_TRUE(f1->done());
+}
+
+TEST_CASE("partition async read honours a stop request", "[idfxx][partition]") {
+    auto part = partition::try_find(partition::type::app, partition::subtype::app_ota_0);
+    TEST_ASSERT_TRUE(part.has_value());
+
+    std::stop_source stop;
+    stop.request_stop();
+    std::array<uint8_t, 16> buf{};
+    auto f = part->try_read_async(0, buf, stop.get_token());
+    TEST_ASSERT_TRUE(f.has_value());
+    auto r = f->try_wait();
+    TEST_ASSERT_FALSE(r.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(errc::not_finished), r.error().value());
+}
+
+TEST_CASE("partition async operations validate arguments", "[idfxx][partition]") {
+    auto part = partition::try_find(partition::type::app, partition::subtype::app_ota_0);
+    TEST_ASSERT_TRUE(part.has_value());
+
+    std::array<uint8_t, 16> buf{};
+    auto r = part->try_read_async(part->size() - 8, buf);
+    TEST_ASSERT_FALSE(r.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(errc::invalid_size), r.error().value());
+
+    auto w = part->try_write_async(part->size(), buf);
+    TEST_ASSERT_FALSE(w.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(errc::invalid_size), w.error().value());
+
+    auto e = part->try_erase_async(1, part->erase_size());
+    TEST_ASSERT_FALSE(e.has_value());
+    TEST_ASSERT_EQUAL(std::to_underlying(errc::invalid_arg), e.error().value());
+}
+
 // =============================================================================
 // Exception-based API tests
 // =============================================================================
@@ -209,4 +336,13 @@ TEST_CASE("partition read on ota_0 app", "[idfxx][partition]") {
     TEST_ASSERT_TRUE(has_nonzero);
 }
 
+TEST_CASE("partition read_async then wait", "[idfxx][partition]") {
+    auto p = partition::find(partition::type::app, partition::subtype::app_ota_0);
+    std::array<uint8_t, 16> direct{};
+    std::array<uint8_t, 16> async{};
+    p.read(0, direct);
+    p.read_async(0, async).wait();
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(direct.data(), async.data(), direct.size());
+}
+
 #endif // CONFIG_COMPILER_CXX_EXCEPTIONS